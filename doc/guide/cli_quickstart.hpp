@@ -184,6 +184,40 @@ Dr. Strangelove or: How I Learned to Stop Worrying and Love the Bomb (1964)
 Schindler's List (1993)
 @endcode
 
+@section cli_quickstart_serve Serving a model
+
+Each run of a program loads its input model again, which can take longer than
+the predictions themselves.  With @c --serve, a program loads its models once
+and then runs for each request it receives, from standard input (with
+@c --serve @c -) or from connections to a Unix domain socket (with
+@c --serve @c /path/to/socket, and a thread for each connection).  Here we
+serve the random forest trained above:
+
+@code{.sh}
+$ mlpack_random_forest --input_model_file rf-model.bin --serve /tmp/rf.sock
+@endcode
+
+A request is a list of commands, one on each line, that ends with @c end.  An
+input matrix is given with @c matrix, its name (without @c _file), its number
+of points and of dimensions, and @c csv or @c binary (doubles in the byte order
+of the host), followed by its data; other inputs are given as
+@c "param <name> <value>", and @c output limits the outputs that are sent back:
+
+@code{.unparsed}
+matrix test 2 3 csv
+0.5,1.2,3.0
+0.1,0.7,2.2
+output predictions
+end
+@endcode
+
+The response has the same format, with a @c "value <name> <value>" line for
+outputs that are not matrices, and ends with @c end; if the request fails, it
+is @c "error <message>" followed by @c end.  @c "format binary" in a request
+asks for binary matrices in the response.  Only models should be given on the
+command line, since other input files are loaded again by each request that
+uses them.
+
 @section cli_quickstart_nextsteps Next steps with mlpack
 
 Now that you have done some simple work with mlpack, you have seen how it can
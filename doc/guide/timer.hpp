@@ -63,4 +63,41 @@ void mlpackMain()
 If the --verbose flag was given to this executable, the time that
 \c "some_timer" ran for would be printed at the end of the program's output.
 
+@section tracing Tracing
+
+The timers only keep the total time of each name.  For a closer look, the
+mlpack::Tracer records every run of every timer as a span, nested in the spans
+that were running on the same thread when it started.  Code can also record
+spans with mlpack::TraceSpan, which begins a span when it is created and ends
+it when it goes out of scope:
+
+@code
+void DoSomeStuff()
+{
+  TraceSpan span("some_stuff");
+  // ...
+}
+@endcode
+
+Each thread records its spans in its own buffer, without locking.  The tracer
+gives the count, total, median, 90th and 99th percentile and maximum duration
+of each stack of span names, and can save the whole trace as Chrome
+trace-event JSON (which can be opened in chrome://tracing or Perfetto) or as
+folded stacks for flame graph tools.
+
+The command-line and Python bindings record a trace when the \c
+MLPACK_TRACE_FILE environment variable is set (for Python, only for calls with
+\c verbose=True), and save it to the file it names: as JSON if the name ends in
+\c .json, and as folded stacks otherwise.  With --verbose, the command-line
+bindings also print the statistics of each stack:
+
+@code
+$ MLPACK_TRACE_FILE=knn.json mlpack_knn -r dataset.csv -k 5 -n n.csv -v
+<...>
+[INFO ] Program trace (count, total, median, 90th percentile, 99th percentile,
+max):
+[INFO ]   total_time: 1, 0.149816s, 0.149816s, 0.149816s, 0.149816s, 0.149816s
+[INFO ]   total_time;computing_neighbors: 1, 0.01065s, 0.01065s, ...
+@endcode
+
 */
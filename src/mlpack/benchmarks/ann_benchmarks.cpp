@@ -0,0 +1,111 @@
+/**
+ * @file benchmarks/ann_benchmarks.cpp
+ *
+ * Micro-benchmarks of the forward and backward passes of neural network
+ * layers.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann/layer/layer.hpp>
+
+#include "benchmark.hpp"
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+using namespace mlpack::ann;
+
+/**
+ * The forward pass of a linear layer.  The first argument is the number of
+ * inputs and outputs, and the second is the batch size.
+ */
+MLPACK_BENCHMARK(LinearForward, { 64, 1 }, { 64, 64 }, { 1024, 64 })
+{
+  const size_t size = state.Range(0);
+  Linear<> layer(size, size);
+  layer.Parameters().randu();
+  layer.Reset();
+
+  const arma::mat input(size, state.Range(1), arma::fill::randu);
+  arma::mat output;
+  while (state.KeepRunning())
+  {
+    layer.Forward(input, output);
+    DoNotOptimize(output.memptr());
+  }
+
+  state.SetItemsProcessed(state.Iterations() * input.n_cols);
+}
+
+/**
+ * The backward pass of a linear layer, with its gradient.  The first argument
+ * is the number of inputs and outputs, and the second is the batch size.
+ */
+MLPACK_BENCHMARK(LinearBackward, { 64, 1 }, { 64, 64 }, { 1024, 64 })
+{
+  const size_t size = state.Range(0);
+  Linear<> layer(size, size);
+  layer.Parameters().randu();
+  layer.Reset();
+
+  const arma::mat input(size, state.Range(1), arma::fill::randu);
+  const arma::mat error(size, state.Range(1), arma::fill::randu);
+  arma::mat output, delta, gradient(layer.Parameters().n_elem, 1);
+  layer.Forward(input, output);
+  while (state.KeepRunning())
+  {
+    layer.Backward(output, error, delta);
+    layer.Gradient(input, error, gradient);
+    DoNotOptimize(delta.memptr());
+    DoNotOptimize(gradient.memptr());
+  }
+
+  state.SetItemsProcessed(state.Iterations() * input.n_cols);
+}
+
+/**
+ * The forward pass of a 3x3 convolution layer.  The first argument is the
+ * width and height of the input, the second is the number of input and output
+ * maps, and the third is the batch size.
+ */
+MLPACK_BENCHMARK(ConvolutionForward, { 28, 1, 1 }, { 28, 8, 16 },
+    { 64, 16, 8 })
+{
+  const size_t size = state.Range(0);
+  const size_t maps = state.Range(1);
+  Convolution<> layer(maps, maps, 3, 3, 1, 1, 0, 0, size, size);
+  layer.Parameters().randu();
+  layer.Reset();
+
+  const arma::mat input(size * size * maps, state.Range(2),
+      arma::fill::randu);
+  arma::mat output;
+  while (state.KeepRunning())
+  {
+    layer.Forward(input, output);
+    DoNotOptimize(output.memptr());
+  }
+
+  state.SetItemsProcessed(state.Iterations() * input.n_cols);
+}
+
+/**
+ * The forward pass of a ReLU layer.  The first argument is the number of
+ * elements.
+ */
+MLPACK_BENCHMARK(ReLUForward, { 1024 }, { 1048576 })
+{
+  ReLULayer<> layer;
+  const arma::mat input(state.Range(0), 1, arma::fill::randn);
+  arma::mat output;
+  while (state.KeepRunning())
+  {
+    layer.Forward(input, output);
+    DoNotOptimize(output.memptr());
+  }
+
+  state.SetItemsProcessed(state.Iterations() * input.n_elem);
+}
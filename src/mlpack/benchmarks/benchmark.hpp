@@ -0,0 +1,254 @@
+/**
+ * @file benchmarks/benchmark.hpp
+ *
+ * A small benchmark framework, in the style of Google Benchmark: benchmarks are
+ * functions that are registered with sets of arguments, and that time a loop
+ * over BenchmarkState::KeepRunning().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BENCHMARKS_BENCHMARK_HPP
+#define MLPACK_BENCHMARKS_BENCHMARK_HPP
+
+#include <mlpack/core.hpp>
+
+#include <chrono>
+#include <ctime>
+
+namespace mlpack {
+namespace benchmark {
+
+/**
+ * The state of a run of a benchmark: its arguments, and the clocks of the
+ * timed loop.  A benchmark sets up its data, then runs the code to time in a
+ * loop:
+ *
+ * @code
+ * while (state.KeepRunning())
+ * {
+ *   // Code to time.
+ * }
+ * @endcode
+ *
+ * Only the loop is timed; PauseTiming() and ResumeTiming() can leave work in
+ * the loop out of the timing.
+ */
+class BenchmarkState
+{
+ public:
+  /**
+   * Create the state of a run of the given number of iterations.
+   *
+   * @param args Arguments of the benchmark.
+   * @param iterations Number of iterations of the timed loop.
+   */
+  BenchmarkState(const std::vector<size_t>& args, const size_t iterations) :
+      args(args),
+      iterations(iterations),
+      remaining(iterations),
+      started(false),
+      running(false),
+      realTime(0.0),
+      cpuTime(0.0),
+      itemsProcessed(0)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Return true while iterations remain.  The clocks are started on the first
+   * call and stopped on the last.
+   */
+  bool KeepRunning()
+  {
+    if (!started)
+    {
+      started = true;
+      ResumeTiming();
+    }
+
+    if (remaining == 0)
+    {
+      if (running)
+        PauseTiming();
+      return false;
+    }
+
+    --remaining;
+    return true;
+  }
+
+  //! Stop the clocks, to leave work out of the timing.
+  void PauseTiming()
+  {
+    realTime += std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - realStart).count();
+    cpuTime += (double) (std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    running = false;
+  }
+
+  //! Restart the clocks.
+  void ResumeTiming()
+  {
+    running = true;
+    cpuStart = std::clock();
+    realStart = std::chrono::steady_clock::now();
+  }
+
+  //! Set the number of items processed by all the iterations, to report a
+  //! throughput.
+  void SetItemsProcessed(const size_t items) { itemsProcessed = items; }
+
+  //! Get the argument with the given index.
+  size_t Range(const size_t i) const { return args[i]; }
+  //! Get the number of iterations of the timed loop.
+  size_t Iterations() const { return iterations; }
+  //! Get the wall clock time of the timed loop, in seconds.
+  double RealTime() const { return realTime; }
+  //! Get the CPU time of the process during the timed loop, in seconds.
+  double CPUTime() const { return cpuTime; }
+  //! Get the number of items processed.
+  size_t ItemsProcessed() const { return itemsProcessed; }
+
+ private:
+  //! Arguments of the benchmark.
+  std::vector<size_t> args;
+  //! Number of iterations.
+  size_t iterations;
+  //! Number of iterations left.
+  size_t remaining;
+  //! Whether the loop has started.
+  bool started;
+  //! Whether the clocks are running.
+  bool running;
+  //! Time the wall clock was last started at.
+  std::chrono::steady_clock::time_point realStart;
+  //! Time the CPU clock was last started at.
+  std::clock_t cpuStart;
+  //! Wall clock time so far, in seconds.
+  double realTime;
+  //! CPU time so far, in seconds.
+  double cpuTime;
+  //! Number of items processed.
+  size_t itemsProcessed;
+};
+
+//! The type of a benchmark function.
+typedef void (*BenchmarkFunction)(BenchmarkState&);
+
+/**
+ * A registered benchmark.  A micro-benchmark times a small piece of code;
+ * a macro-benchmark runs a whole method, and its first argument is a number
+ * of points, which the runner scales with --scale.
+ */
+struct BenchmarkInfo
+{
+  //! Name of the benchmark.
+  std::string name;
+  //! The benchmark function.
+  BenchmarkFunction function;
+  //! Sets of arguments to run the benchmark with.
+  std::vector<std::vector<size_t>> args;
+  //! Whether the benchmark is a macro-benchmark.
+  bool macro;
+};
+
+//! Get all registered benchmarks.
+inline std::vector<BenchmarkInfo>& Benchmarks()
+{
+  static std::vector<BenchmarkInfo> benchmarks;
+  return benchmarks;
+}
+
+/**
+ * Registering a benchmark is done by creating a static BenchmarkRegistrar;
+ * use the MLPACK_BENCHMARK() macros instead.
+ */
+class BenchmarkRegistrar
+{
+ public:
+  BenchmarkRegistrar(const std::string& name,
+                     BenchmarkFunction function,
+                     const std::vector<std::vector<size_t>>& args,
+                     const bool macro)
+  {
+    BenchmarkInfo info;
+    info.name = name;
+    info.function = function;
+    info.args = args;
+    info.macro = macro;
+    Benchmarks().push_back(info);
+  }
+};
+
+/**
+ * Keep the compiler from optimizing away the computation of the given value.
+ */
+template<typename T>
+inline void DoNotOptimize(const T& value)
+{
+  #if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+  #else
+    static volatile const void* sink;
+    sink = &value;
+  #endif
+}
+
+} // namespace benchmark
+} // namespace mlpack
+
+#define MLPACK_BENCHMARK_CONCAT_(A, B) A##B
+#define MLPACK_BENCHMARK_CONCAT(A, B) MLPACK_BENCHMARK_CONCAT_(A, B)
+
+/**
+ * Define and register a micro-benchmark with the given sets of arguments, each
+ * in braces:
+ *
+ * @code
+ * MLPACK_BENCHMARK(KDTreeBuild, { 1000 }, { 10000 })
+ * {
+ *   ...
+ * }
+ * @endcode
+ */
+#define MLPACK_BENCHMARK(NAME, ...) \
+    static void NAME(mlpack::benchmark::BenchmarkState& state); \
+    static mlpack::benchmark::BenchmarkRegistrar \
+        MLPACK_BENCHMARK_CONCAT(NAME, Registrar)(#NAME, &NAME, \
+        { __VA_ARGS__ }, false); \
+    static void NAME(mlpack::benchmark::BenchmarkState& state)
+
+/**
+ * Define and register a macro-benchmark; its first argument is the number of
+ * points, which is scaled by --scale.
+ */
+#define MLPACK_MACRO_BENCHMARK(NAME, ...) \
+    static void NAME(mlpack::benchmark::BenchmarkState& state); \
+    static mlpack::benchmark::BenchmarkRegistrar \
+        MLPACK_BENCHMARK_CONCAT(NAME, Registrar)(#NAME, &NAME, \
+        { __VA_ARGS__ }, true); \
+    static void NAME(mlpack::benchmark::BenchmarkState& state)
+
+/**
+ * Register an instance of a benchmark function template, for the given type
+ * (which must not contain commas; use a typedef), as a micro-benchmark.
+ */
+#define MLPACK_BENCHMARK_TEMPLATE(FUNCTION, TYPE, ...) \
+    static mlpack::benchmark::BenchmarkRegistrar \
+        MLPACK_BENCHMARK_CONCAT(benchmarkRegistrar, __LINE__)( \
+        #FUNCTION "<" #TYPE ">", &FUNCTION<TYPE>, { __VA_ARGS__ }, false)
+
+/**
+ * Register an instance of a benchmark function template, for the given type,
+ * as a macro-benchmark.
+ */
+#define MLPACK_MACRO_BENCHMARK_TEMPLATE(FUNCTION, TYPE, ...) \
+    static mlpack::benchmark::BenchmarkRegistrar \
+        MLPACK_BENCHMARK_CONCAT(benchmarkRegistrar, __LINE__)( \
+        #FUNCTION "<" #TYPE ">", &FUNCTION<TYPE>, { __VA_ARGS__ }, true)
+
+#endif
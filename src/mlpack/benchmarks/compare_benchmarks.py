@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+"""
+compare_benchmarks.py: compare the results of two runs of mlpack_benchmarks.
+
+Usage: compare_benchmarks.py [--threshold=0.05] [--metric=real_time]
+           baseline.json contender.json
+
+The results are the JSON files written by `mlpack_benchmarks --json=FILE`.  For
+each benchmark in both files, the relative change of its time is printed, and
+the benchmark is flagged as a regression if its time grew by more than the
+threshold (or as an improvement if it shrank by more than the threshold).  If
+the runs were repeated, the median is compared.  The exit code is 1 if there is
+any regression, so the script can be used to gate changes.
+
+mlpack is free software; you may redistribute it and/or modify it under the
+terms of the 3-clause BSD license.  You should have received a copy of the
+3-clause BSD license along with mlpack.  If not, see
+http://www.opensource.org/licenses/BSD-3-Clause for more information.
+"""
+import argparse
+import json
+import statistics
+import sys
+
+def load_times(filename, metric):
+  """
+  Load the time of each benchmark in the given file: the median aggregate if
+  there is one, and the median of the repetitions otherwise.
+  """
+  with open(filename) as f:
+    results = json.load(f)
+
+  medians = {}
+  runs = {}
+  order = []
+  for benchmark in results['benchmarks']:
+    name = benchmark.get('run_name', benchmark['name'])
+    if name not in runs and name not in medians:
+      order.append(name)
+
+    if benchmark.get('run_type') == 'aggregate':
+      if benchmark.get('aggregate_name') == 'median':
+        medians[name] = benchmark[metric]
+    else:
+      runs.setdefault(name, []).append(benchmark[metric])
+
+  times = {}
+  for name in order:
+    times[name] = medians[name] if name in medians else \
+        statistics.median(runs[name])
+  return order, times
+
+def main():
+  parser = argparse.ArgumentParser(
+      description='Compare the results of two runs of mlpack_benchmarks.')
+  parser.add_argument('baseline', help='JSON results of the baseline build')
+  parser.add_argument('contender', help='JSON results of the build to check')
+  parser.add_argument('--threshold', type=float, default=0.05,
+      help='relative change of time above which a benchmark is flagged '
+      '(default 0.05)')
+  parser.add_argument('--metric', choices=['real_time', 'cpu_time'],
+      default='real_time', help='time to compare (default real_time)')
+  args = parser.parse_args()
+
+  order, baseline = load_times(args.baseline, args.metric)
+  _, contender = load_times(args.contender, args.metric)
+
+  width = max([len(name) for name in order] + [9])
+  print('%-*s %15s %15s %9s' % (width, 'Benchmark', 'Baseline (ns)',
+      'Contender (ns)', 'Change'))
+
+  regressions = 0
+  for name in order:
+    if name not in contender:
+      print('%-*s %15.0f %15s %9s' % (width, name, baseline[name], '-', '-'))
+      continue
+
+    old = baseline[name]
+    new = contender[name]
+    change = (new - old) / old if old > 0 else 0.0
+    flag = ''
+    if change > args.threshold:
+      flag = '  REGRESSION'
+      regressions += 1
+    elif change < -args.threshold:
+      flag = '  improvement'
+    print('%-*s %15.0f %15.0f %+8.1f%%%s' % (width, name, old, new,
+        100 * change, flag))
+
+  for name in contender:
+    if name not in baseline:
+      print('%-*s %15s %15.0f %9s' % (width, name, '-', contender[name], '-'))
+
+  if regressions > 0:
+    print('\n%d benchmark(s) regressed by more than %.1f%%.' % (regressions,
+        100 * args.threshold))
+    return 1
+  return 0
+
+if __name__ == '__main__':
+  sys.exit(main())
@@ -0,0 +1,80 @@
+/**
+ * @file benchmarks/decision_tree_benchmarks.cpp
+ *
+ * Micro-benchmarks of the split policies of decision trees.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/decision_tree/decision_tree.hpp>
+
+#include "benchmark.hpp"
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+using namespace mlpack::tree;
+
+typedef BestBinaryNumericSplit<GiniGain> GiniNumericSplit;
+typedef BestBinaryNumericSplit<InformationGain> InformationNumericSplit;
+
+/**
+ * Find the best binary split of a random numeric dimension.  The first
+ * argument is the number of points, and the second is the number of classes.
+ */
+template<typename SplitType>
+static void NumericSplit(benchmark::BenchmarkState& state)
+{
+  const size_t numClasses = state.Range(1);
+  const arma::rowvec values(state.Range(0), arma::fill::randu);
+  const arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(
+      values.n_elem, arma::distr_param(0, (int) numClasses - 1));
+  const arma::rowvec weights;
+
+  arma::vec classProbabilities;
+  typename SplitType::AuxiliarySplitInfo aux;
+  while (state.KeepRunning())
+  {
+    DoNotOptimize(SplitType::template SplitIfBetter<false>(
+        -DBL_MAX, values, labels, numClasses, weights, 1, 1e-7,
+        classProbabilities, aux));
+  }
+
+  state.SetItemsProcessed(state.Iterations() * values.n_elem);
+}
+
+MLPACK_BENCHMARK_TEMPLATE(NumericSplit, GiniNumericSplit, { 1000, 2 },
+    { 100000, 2 }, { 100000, 10 });
+MLPACK_BENCHMARK_TEMPLATE(NumericSplit, InformationNumericSplit,
+    { 1000, 2 }, { 100000, 2 }, { 100000, 10 });
+
+/**
+ * Find the split of a random categorical dimension.  The first argument is the
+ * number of points, the second is the number of classes, and the third is the
+ * number of categories.
+ */
+MLPACK_BENCHMARK(CategoricalSplit, { 1000, 2, 5 }, { 100000, 2, 5 },
+    { 100000, 10, 50 })
+{
+  const size_t numClasses = state.Range(1);
+  const size_t numCategories = state.Range(2);
+  const arma::rowvec values = arma::conv_to<arma::rowvec>::from(
+      arma::randi<arma::Row<size_t>>(state.Range(0),
+      arma::distr_param(0, (int) numCategories - 1)));
+  const arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(
+      values.n_elem, arma::distr_param(0, (int) numClasses - 1));
+  const arma::rowvec weights;
+
+  arma::vec classProbabilities;
+  AllCategoricalSplit<GiniGain>::AuxiliarySplitInfo aux;
+  while (state.KeepRunning())
+  {
+    DoNotOptimize(AllCategoricalSplit<GiniGain>::SplitIfBetter<false>(
+        -DBL_MAX, values, numCategories, labels, numClasses, weights, 1, 1e-7,
+        classProbabilities, aux));
+  }
+
+  state.SetItemsProcessed(state.Iterations() * values.n_elem);
+}
@@ -0,0 +1,184 @@
+/**
+ * @file benchmarks/macro_benchmarks.cpp
+ *
+ * Macro-benchmarks: whole methods run end to end on synthetic data.  The first
+ * argument of each is the number of points, which is scaled by --scale.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann/ffn.hpp>
+#include <mlpack/methods/ann/layer/layer.hpp>
+#include <mlpack/methods/ann/loss_functions/mean_squared_error.hpp>
+#include <mlpack/methods/kmeans/kmeans.hpp>
+#include <mlpack/methods/kmeans/elkan_kmeans.hpp>
+#include <mlpack/methods/kmeans/hamerly_kmeans.hpp>
+#include <mlpack/methods/kmeans/pelleg_moore_kmeans.hpp>
+#include <mlpack/methods/kmeans/dual_tree_kmeans.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+#include <mlpack/methods/random_forest/random_forest.hpp>
+
+#include <cstdio>
+
+#include "benchmark.hpp"
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+
+/**
+ * Generate the given number of points in the given number of Gaussian
+ * clusters, with the label of the cluster of each point.
+ */
+static void GaussianClusters(const size_t dimensionality,
+                             const size_t numPoints,
+                             const size_t numClusters,
+                             arma::mat& data,
+                             arma::Row<size_t>& labels)
+{
+  const arma::mat centroids = 10 * arma::randu<arma::mat>(dimensionality,
+      numClusters);
+  data.randn(dimensionality, numPoints);
+  labels.set_size(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    labels[i] = math::RandInt(numClusters);
+    data.col(i) += centroids.col(labels[i]);
+  }
+}
+
+/**
+ * Build the trees and find the 5 nearest neighbors of every point, with the
+ * dual-tree algorithm.  The second argument is the dimensionality.
+ */
+MLPACK_MACRO_BENCHMARK(KNNAllNeighbors, { 10000, 3 }, { 10000, 10 })
+{
+  arma::mat data;
+  arma::Row<size_t> labels;
+  GaussianClusters(state.Range(1), state.Range(0), 10, data, labels);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  while (state.KeepRunning())
+  {
+    neighbor::KNN knn(data);
+    knn.Search(5, neighbors, distances);
+    DoNotOptimize(neighbors.memptr());
+  }
+
+  state.SetItemsProcessed(state.Iterations() * data.n_cols);
+}
+
+/**
+ * Cluster points with k-means, with the given Lloyd step.  The second argument
+ * is the dimensionality, and the third is the number of clusters.
+ */
+template<template<class, class> class LloydStepType>
+static void KMeansCluster(benchmark::BenchmarkState& state)
+{
+  arma::mat data;
+  arma::Row<size_t> labels;
+  GaussianClusters(state.Range(1), state.Range(0), state.Range(2), data,
+      labels);
+
+  arma::Row<size_t> assignments;
+  while (state.KeepRunning())
+  {
+    // Each run starts from the same initial centroids.
+    state.PauseTiming();
+    math::RandomSeed(42);
+    state.ResumeTiming();
+
+    kmeans::KMeans<metric::EuclideanDistance, kmeans::SampleInitialization,
+        kmeans::MaxVarianceNewCluster, LloydStepType> k(100);
+    k.Cluster(data, state.Range(2), assignments);
+    DoNotOptimize(assignments.memptr());
+  }
+
+  state.SetItemsProcessed(state.Iterations() * data.n_cols);
+}
+
+using kmeans::NaiveKMeans;
+using kmeans::ElkanKMeans;
+using kmeans::HamerlyKMeans;
+using kmeans::PellegMooreKMeans;
+using kmeans::DefaultDualTreeKMeans;
+
+MLPACK_MACRO_BENCHMARK_TEMPLATE(KMeansCluster, NaiveKMeans, { 10000, 5, 10 });
+MLPACK_MACRO_BENCHMARK_TEMPLATE(KMeansCluster, ElkanKMeans, { 10000, 5, 10 });
+MLPACK_MACRO_BENCHMARK_TEMPLATE(KMeansCluster, HamerlyKMeans,
+    { 10000, 5, 10 });
+MLPACK_MACRO_BENCHMARK_TEMPLATE(KMeansCluster, PellegMooreKMeans,
+    { 10000, 5, 10 });
+MLPACK_MACRO_BENCHMARK_TEMPLATE(KMeansCluster, DefaultDualTreeKMeans,
+    { 10000, 5, 10 });
+
+/**
+ * Train a random forest of 10 trees.  The second argument is the
+ * dimensionality, and the third is the number of classes.
+ */
+MLPACK_MACRO_BENCHMARK(RandomForestTrain, { 5000, 10, 3 })
+{
+  arma::mat data;
+  arma::Row<size_t> labels;
+  GaussianClusters(state.Range(1), state.Range(0), state.Range(2), data,
+      labels);
+
+  while (state.KeepRunning())
+  {
+    tree::RandomForest<> rf(data, labels, state.Range(2), 10);
+    DoNotOptimize(rf.NumTrees());
+  }
+
+  state.SetItemsProcessed(state.Iterations() * data.n_cols);
+}
+
+/**
+ * Train a feedforward network with one hidden layer of 64 units for one epoch
+ * of SGD.  The second argument is the dimensionality, and the third is the
+ * batch size.
+ */
+MLPACK_MACRO_BENCHMARK(FFNTrainEpoch, { 10000, 10, 1 }, { 10000, 10, 32 })
+{
+  const size_t dimensionality = state.Range(1);
+  const arma::mat data(dimensionality, state.Range(0), arma::fill::randu);
+  const arma::mat responses = arma::sum(arma::sin(data), 0);
+
+  while (state.KeepRunning())
+  {
+    state.PauseTiming();
+    ann::FFN<ann::MeanSquaredError<>> model;
+    model.Add<ann::Linear<>>(dimensionality, 64);
+    model.Add<ann::SigmoidLayer<>>();
+    model.Add<ann::Linear<>>(64, 1);
+    ens::StandardSGD optimizer(0.01, state.Range(2), data.n_cols, -1, false);
+    state.ResumeTiming();
+
+    DoNotOptimize(model.Train(data, responses, optimizer));
+  }
+
+  state.SetItemsProcessed(state.Iterations() * data.n_cols);
+}
+
+/**
+ * Load a CSV file of random numbers.  The second argument is the number of
+ * columns in the file.
+ */
+MLPACK_MACRO_BENCHMARK(LoadCSV, { 100000, 10 })
+{
+  const std::string filename = "mlpack_benchmark_load.csv";
+  const arma::mat data(state.Range(0), state.Range(1), arma::fill::randu);
+  data::Save(filename, data, true, false);
+
+  arma::mat loaded;
+  while (state.KeepRunning())
+  {
+    data::Load(filename, loaded, true, false);
+    DoNotOptimize(loaded.memptr());
+  }
+
+  std::remove(filename.c_str());
+  state.SetItemsProcessed(state.Iterations() * data.n_rows);
+}
@@ -0,0 +1,386 @@
+/**
+ * @file benchmarks/main.cpp
+ *
+ * The runner of the mlpack benchmarks.  Each benchmark is run with each of its
+ * sets of arguments, for enough iterations to take at least --min_time
+ * seconds; the results are printed, and can be saved as JSON, in the format of
+ * Google Benchmark, to be compared with compare_benchmarks.py.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/util/version.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+#include "benchmark.hpp"
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+using namespace std;
+
+namespace {
+
+//! The result of a run, or an aggregate of the runs, of a benchmark.
+struct Result
+{
+  //! Name of the run, with its aggregate.
+  string name;
+  //! Name of the benchmark with its arguments.
+  string runName;
+  //! Name of the aggregate, or empty for a run.
+  string aggregate;
+  //! Index of the repetition.
+  size_t repetition;
+  //! Number of iterations.
+  size_t iterations;
+  //! Wall clock time per iteration, in nanoseconds.
+  double realTime;
+  //! CPU time per iteration, in nanoseconds.
+  double cpuTime;
+  //! Items processed per second of wall clock time, or 0.
+  double itemsPerSecond;
+};
+
+//! Options of the runner.
+struct Options
+{
+  string filter = ".*";
+  double minTime = 0.5;
+  size_t repetitions = 1;
+  double scale = 1.0;
+  string json;
+  bool list = false;
+};
+
+void PrintUsage()
+{
+  cout << "Usage: mlpack_benchmarks [options]" << endl << endl
+      << "  --filter=REGEX      Run only benchmarks whose name matches REGEX."
+      << endl
+      << "  --min_time=SECONDS  Minimum time of each run (default 0.5)." << endl
+      << "  --repetitions=N     Repeat each run N times, and report the mean,"
+      << endl
+      << "                      median and standard deviation (default 1)."
+      << endl
+      << "  --scale=X           Multiply the number of points of the macro-"
+      << endl
+      << "                      benchmarks by X (default 1)." << endl
+      << "  --json=FILE         Save the results to FILE as JSON." << endl
+      << "  --list              List the benchmarks and exit." << endl;
+}
+
+Options ParseOptions(int argc, char** argv)
+{
+  Options options;
+  for (int i = 1; i < argc; ++i)
+  {
+    const string arg = argv[i];
+    const size_t equals = arg.find('=');
+    const string name = arg.substr(0, equals);
+    const string value = (equals == string::npos) ? "" :
+        arg.substr(equals + 1);
+
+    if (name == "--filter")
+      options.filter = value;
+    else if (name == "--min_time")
+      options.minTime = atof(value.c_str());
+    else if (name == "--repetitions")
+      options.repetitions = std::max(atoi(value.c_str()), 1);
+    else if (name == "--scale")
+      options.scale = atof(value.c_str());
+    else if (name == "--json")
+      options.json = value;
+    else if (name == "--list")
+      options.list = true;
+    else
+    {
+      PrintUsage();
+      exit((name == "--help") ? 0 : 1);
+    }
+  }
+
+  if (options.minTime <= 0.0 || options.scale <= 0.0)
+  {
+    cerr << "--min_time and --scale must be positive." << endl;
+    exit(1);
+  }
+
+  return options;
+}
+
+//! Get the arguments of a run, scaling the number of points of a
+//! macro-benchmark.
+vector<size_t> RunArgs(const BenchmarkInfo& info,
+                       const vector<size_t>& args,
+                       const double scale)
+{
+  vector<size_t> runArgs(args);
+  if (info.macro && !runArgs.empty())
+    runArgs[0] = std::max((size_t) (runArgs[0] * scale), (size_t) 1);
+  return runArgs;
+}
+
+string RunName(const BenchmarkInfo& info, const vector<size_t>& args)
+{
+  ostringstream oss;
+  oss << info.name;
+  for (const size_t arg : args)
+    oss << "/" << arg;
+  return oss.str();
+}
+
+//! Run the benchmark for the given number of iterations.
+BenchmarkState Run(const BenchmarkInfo& info,
+                   const vector<size_t>& args,
+                   const size_t iterations)
+{
+  // Each run sees the same data.
+  math::RandomSeed(42);
+  BenchmarkState state(args, iterations);
+  info.function(state);
+  return state;
+}
+
+Result MakeResult(const string& runName,
+                  const size_t repetition,
+                  const BenchmarkState& state)
+{
+  Result result;
+  result.name = runName;
+  result.runName = runName;
+  result.repetition = repetition;
+  result.iterations = state.Iterations();
+  result.realTime = 1e9 * state.RealTime() / state.Iterations();
+  result.cpuTime = 1e9 * state.CPUTime() / state.Iterations();
+  result.itemsPerSecond = (state.ItemsProcessed() > 0 &&
+      state.RealTime() > 0.0) ? state.ItemsProcessed() / state.RealTime() : 0.0;
+  return result;
+}
+
+/**
+ * Run the benchmark with the given arguments, increasing the number of
+ * iterations until a run takes at least the minimum time, as Google Benchmark
+ * does; then repeat that run.
+ */
+vector<Result> RunBenchmark(const BenchmarkInfo& info,
+                            const vector<size_t>& args,
+                            const Options& options)
+{
+  const string runName = RunName(info, args);
+  const size_t maxIterations = 1000000000;
+
+  size_t iterations = 1;
+  BenchmarkState state = Run(info, args, iterations);
+  while (state.RealTime() < options.minTime && iterations < maxIterations)
+  {
+    // Aim past the minimum time, so that the next run is likely the last; if
+    // the run was too short for its time to mean much, grow by 10x.
+    double multiplier = options.minTime * 1.4 /
+        std::max(state.RealTime(), 1e-9);
+    if (state.RealTime() / options.minTime <= 0.1)
+      multiplier = std::min(multiplier, 10.0);
+    iterations = std::min(std::max((size_t) (multiplier * iterations),
+        iterations + 1), maxIterations);
+    state = Run(info, args, iterations);
+  }
+
+  vector<Result> results;
+  results.push_back(MakeResult(runName, 0, state));
+  for (size_t r = 1; r < options.repetitions; ++r)
+    results.push_back(MakeResult(runName, r, Run(info, args, iterations)));
+
+  if (options.repetitions == 1)
+    return results;
+
+  // Add the mean, median and standard deviation of the repetitions.
+  arma::vec realTimes(results.size()), cpuTimes(results.size()),
+      itemsPerSecond(results.size());
+  for (size_t r = 0; r < results.size(); ++r)
+  {
+    realTimes[r] = results[r].realTime;
+    cpuTimes[r] = results[r].cpuTime;
+    itemsPerSecond[r] = results[r].itemsPerSecond;
+  }
+
+  const char* aggregates[] = { "mean", "median", "stddev" };
+  for (size_t a = 0; a < 3; ++a)
+  {
+    Result aggregate = results[0];
+    aggregate.aggregate = aggregates[a];
+    aggregate.name = runName + "_" + aggregate.aggregate;
+    if (a == 0)
+    {
+      aggregate.realTime = arma::mean(realTimes);
+      aggregate.cpuTime = arma::mean(cpuTimes);
+      aggregate.itemsPerSecond = arma::mean(itemsPerSecond);
+    }
+    else if (a == 1)
+    {
+      aggregate.realTime = arma::median(realTimes);
+      aggregate.cpuTime = arma::median(cpuTimes);
+      aggregate.itemsPerSecond = arma::median(itemsPerSecond);
+    }
+    else
+    {
+      aggregate.realTime = arma::stddev(realTimes);
+      aggregate.cpuTime = arma::stddev(cpuTimes);
+      aggregate.itemsPerSecond = arma::stddev(itemsPerSecond);
+    }
+    results.push_back(aggregate);
+  }
+
+  return results;
+}
+
+void PrintResult(const Result& result)
+{
+  cout << left << setw(60) << result.name << right << fixed
+      << setprecision(0) << setw(15) << result.realTime << " ns"
+      << setw(15) << result.cpuTime << " ns" << setw(12) << result.iterations;
+  if (result.itemsPerSecond > 0.0)
+  {
+    cout << setprecision(3) << scientific << setw(14)
+        << result.itemsPerSecond << " items/s";
+  }
+  cout << endl;
+}
+
+void WriteJSONString(ostream& stream, const string& str)
+{
+  stream << '"';
+  for (const char c : str)
+  {
+    if (c == '"' || c == '\\')
+      stream << '\\';
+    stream << c;
+  }
+  stream << '"';
+}
+
+void WriteJSON(const string& filename, const vector<Result>& results)
+{
+  ofstream stream(filename);
+  if (!stream.is_open())
+  {
+    cerr << "Cannot open '" << filename << "' for writing." << endl;
+    exit(1);
+  }
+
+  const time_t now = time(NULL);
+  char date[64];
+  strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+  stream << "{" << endl << "  \"context\": {" << endl
+      << "    \"date\": \"" << date << "\"," << endl
+      << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ","
+      << endl
+      << "    \"mlpack_version\": ";
+  WriteJSONString(stream, util::GetVersion());
+  stream << "," << endl
+      << "    \"library_build_type\": "
+      #ifdef DEBUG
+        << "\"debug\""
+      #else
+        << "\"release\""
+      #endif
+      << endl << "  }," << endl << "  \"benchmarks\": [";
+
+  stream << setprecision(17);
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    const Result& result = results[i];
+    stream << ((i == 0) ? "" : ",") << endl << "    {" << endl
+        << "      \"name\": ";
+    WriteJSONString(stream, result.name);
+    stream << "," << endl << "      \"run_name\": ";
+    WriteJSONString(stream, result.runName);
+    stream << "," << endl << "      \"run_type\": \""
+        << (result.aggregate.empty() ? "iteration" : "aggregate") << "\","
+        << endl;
+    if (result.aggregate.empty())
+    {
+      stream << "      \"repetition_index\": " << result.repetition << ","
+          << endl;
+    }
+    else
+    {
+      stream << "      \"aggregate_name\": \"" << result.aggregate << "\","
+          << endl;
+    }
+    stream << "      \"iterations\": " << result.iterations << "," << endl
+        << "      \"real_time\": " << result.realTime << "," << endl
+        << "      \"cpu_time\": " << result.cpuTime << "," << endl;
+    if (result.itemsPerSecond > 0.0)
+    {
+      stream << "      \"items_per_second\": " << result.itemsPerSecond << ","
+          << endl;
+    }
+    stream << "      \"time_unit\": \"ns\"" << endl << "    }";
+  }
+  stream << endl << "  ]" << endl << "}" << endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  const Options options = ParseOptions(argc, argv);
+
+  regex filter;
+  try
+  {
+    filter = regex(options.filter);
+  }
+  catch (const regex_error& e)
+  {
+    cerr << "Invalid --filter regular expression: " << e.what() << endl;
+    return 1;
+  }
+
+  // Run the benchmarks in order of name, so that the output is the same no
+  // matter how the files were linked.
+  vector<BenchmarkInfo> benchmarks = Benchmarks();
+  std::stable_sort(benchmarks.begin(), benchmarks.end(),
+      [](const BenchmarkInfo& a, const BenchmarkInfo& b)
+      { return a.name < b.name; });
+
+  vector<Result> results;
+  for (const BenchmarkInfo& info : benchmarks)
+  {
+    for (const vector<size_t>& baseArgs : info.args)
+    {
+      const vector<size_t> args = RunArgs(info, baseArgs, options.scale);
+      const string runName = RunName(info, args);
+      if (!regex_search(runName, filter))
+        continue;
+
+      if (options.list)
+      {
+        cout << runName << endl;
+        continue;
+      }
+
+      const vector<Result> runResults = RunBenchmark(info, args, options);
+      for (const Result& result : runResults)
+        PrintResult(result);
+      results.insert(results.end(), runResults.begin(), runResults.end());
+    }
+  }
+
+  if (!options.json.empty())
+    WriteJSON(options.json, results);
+
+  return 0;
+}
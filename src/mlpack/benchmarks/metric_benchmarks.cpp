@@ -0,0 +1,77 @@
+/**
+ * @file benchmarks/metric_benchmarks.cpp
+ *
+ * Micro-benchmarks of the distance metrics.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/core/metrics/mahalanobis_distance.hpp>
+
+#include "benchmark.hpp"
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+using namespace mlpack::metric;
+
+/**
+ * Evaluate the given metric between pairs of random points.  The first argument
+ * is the dimensionality of the points.
+ */
+template<typename MetricType>
+static void MetricEvaluate(benchmark::BenchmarkState& state)
+{
+  // Enough pairs that the points don't all stay in the L1 cache.
+  const size_t dimensionality = state.Range(0);
+  const size_t numPairs = 256;
+  arma::mat a(dimensionality, numPairs, arma::fill::randu);
+  arma::mat b(dimensionality, numPairs, arma::fill::randu);
+
+  MetricType metric;
+  size_t i = 0;
+  while (state.KeepRunning())
+  {
+    DoNotOptimize(metric.Evaluate(a.col(i), b.col(i)));
+    i = (i + 1) % numPairs;
+  }
+
+  state.SetItemsProcessed(state.Iterations());
+}
+
+MLPACK_BENCHMARK_TEMPLATE(MetricEvaluate, ManhattanDistance, { 3 }, { 32 },
+    { 512 });
+MLPACK_BENCHMARK_TEMPLATE(MetricEvaluate, SquaredEuclideanDistance, { 3 },
+    { 32 }, { 512 });
+MLPACK_BENCHMARK_TEMPLATE(MetricEvaluate, EuclideanDistance, { 3 }, { 32 },
+    { 512 });
+MLPACK_BENCHMARK_TEMPLATE(MetricEvaluate, ChebyshevDistance, { 3 }, { 32 },
+    { 512 });
+
+/**
+ * Evaluate the Mahalanobis distance with a random positive definite covariance
+ * matrix.  The first argument is the dimensionality of the points.
+ */
+MLPACK_BENCHMARK(MahalanobisEvaluate, { 3 }, { 32 }, { 512 })
+{
+  const size_t dimensionality = state.Range(0);
+  const size_t numPairs = 256;
+  arma::mat a(dimensionality, numPairs, arma::fill::randu);
+  arma::mat b(dimensionality, numPairs, arma::fill::randu);
+
+  arma::mat q(dimensionality, dimensionality, arma::fill::randu);
+  MahalanobisDistance<> metric(q * q.t() +
+      arma::eye<arma::mat>(dimensionality, dimensionality));
+
+  size_t i = 0;
+  while (state.KeepRunning())
+  {
+    DoNotOptimize(metric.Evaluate(a.col(i), b.col(i)));
+    i = (i + 1) % numPairs;
+  }
+
+  state.SetItemsProcessed(state.Iterations());
+}
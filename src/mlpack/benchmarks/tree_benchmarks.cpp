@@ -0,0 +1,92 @@
+/**
+ * @file benchmarks/tree_benchmarks.cpp
+ *
+ * Micro-benchmarks of the bounds and of tree construction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/tree/binary_space_tree.hpp>
+#include <mlpack/core/tree/cover_tree.hpp>
+#include <mlpack/core/tree/rectangle_tree.hpp>
+
+#include "benchmark.hpp"
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+using namespace mlpack::bound;
+using namespace mlpack::tree;
+
+typedef HRectBound<metric::EuclideanDistance> HRectBoundType;
+typedef BallBound<metric::EuclideanDistance> BallBoundType;
+
+/**
+ * Compute the minimum and maximum distances between pairs of bounds, each of
+ * which holds a few random points.  The first argument is the dimensionality.
+ */
+template<typename BoundType>
+static void BoundDistances(benchmark::BenchmarkState& state)
+{
+  const size_t dimensionality = state.Range(0);
+  const size_t numBounds = 256;
+  std::vector<BoundType> bounds(numBounds, BoundType(dimensionality));
+  for (size_t i = 0; i < numBounds; ++i)
+  {
+    arma::mat points(dimensionality, 5, arma::fill::randn);
+    points.each_col() += arma::vec(dimensionality, arma::fill::randu) * 10;
+    bounds[i] |= points;
+  }
+
+  size_t i = 0;
+  while (state.KeepRunning())
+  {
+    const BoundType& a = bounds[i];
+    const BoundType& b = bounds[(i + 1) % numBounds];
+    DoNotOptimize(a.MinDistance(b));
+    DoNotOptimize(a.MaxDistance(b));
+    i = (i + 1) % numBounds;
+  }
+
+  state.SetItemsProcessed(state.Iterations());
+}
+
+MLPACK_BENCHMARK_TEMPLATE(BoundDistances, HRectBoundType, { 3 }, { 32 },
+    { 256 });
+MLPACK_BENCHMARK_TEMPLATE(BoundDistances, BallBoundType, { 3 }, { 32 },
+    { 256 });
+
+typedef KDTree<metric::EuclideanDistance, EmptyStatistic, arma::mat>
+    KDTreeType;
+typedef BallTree<metric::EuclideanDistance, EmptyStatistic, arma::mat>
+    BallTreeType;
+typedef StandardCoverTree<metric::EuclideanDistance, EmptyStatistic,
+    arma::mat> CoverTreeType;
+typedef RTree<metric::EuclideanDistance, EmptyStatistic, arma::mat> RTreeType;
+
+/**
+ * Build a tree on uniformly random points.  The first argument is the number
+ * of points, and the second is the dimensionality.
+ */
+template<typename TreeType>
+static void TreeBuild(benchmark::BenchmarkState& state)
+{
+  const arma::mat data(state.Range(1), state.Range(0), arma::fill::randu);
+  while (state.KeepRunning())
+  {
+    TreeType tree(data);
+    DoNotOptimize(tree.NumDescendants());
+  }
+
+  state.SetItemsProcessed(state.Iterations() * data.n_cols);
+}
+
+MLPACK_BENCHMARK_TEMPLATE(TreeBuild, KDTreeType, { 1000, 3 }, { 10000, 3 },
+    { 10000, 32 });
+MLPACK_BENCHMARK_TEMPLATE(TreeBuild, BallTreeType, { 1000, 3 }, { 10000, 3 },
+    { 10000, 32 });
+MLPACK_BENCHMARK_TEMPLATE(TreeBuild, CoverTreeType, { 1000, 3 }, { 10000, 3 },
+    { 10000, 32 });
+MLPACK_BENCHMARK_TEMPLATE(TreeBuild, RTreeType, { 1000, 3 }, { 10000, 3 });
@@ -31,6 +31,7 @@
 #include "get_allocated_memory.hpp"
 #include "delete_allocated_memory.hpp"
 #include "in_place_copy.hpp"
+#include "serve_param.hpp"
 
 namespace mlpack {
 namespace bindings {
@@ -161,6 +162,12 @@ class CLIOption
     IO::GetSingleton().functionMap[tname]["DeleteAllocatedMemory"] =
         &DeleteAllocatedMemory<N>;
     IO::GetSingleton().functionMap[tname]["InPlaceCopy"] = &InPlaceCopy<N>;
+    IO::GetSingleton().functionMap[tname]["ServeSetParam"] =
+        &ServeSetParam<N>;
+    IO::GetSingleton().functionMap[tname]["ServeGetParam"] =
+        &ServeGetParam<N>;
+    IO::GetSingleton().functionMap[tname]["ServeLoadParam"] =
+        &ServeLoadParam<N>;
   }
 };
 
@@ -3,7 +3,8 @@
  * @author Ryan Curtin
  * @author Matthew Amidon
  *
- * Terminate the program; handle --verbose option; print output parameters.
+ * Terminate the program; handle --verbose option; print output parameters;
+ * save the trace.
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
@@ -27,13 +28,29 @@ inline void EndProgram()
 {
   // Stop the CLI timers.
   IO::GetSingleton().timer.StopAllTimers();
+  IO::GetSingleton().tracer.EndAll();
 
-  // Print any output.
+  // Save the trace, if one was recorded.
+  const char* traceFile = getenv("MLPACK_TRACE_FILE");
+  if (IO::GetSingleton().tracer.Enabled() && traceFile != NULL)
+  {
+    try
+    {
+      IO::GetSingleton().tracer.Save(traceFile);
+    }
+    catch (std::exception& e)
+    {
+      Log::Warn << e.what() << "; the trace is not saved." << std::endl;
+    }
+  }
+
+  // Print any output.  In serve mode the outputs were sent back in the
+  // responses.
   std::map<std::string, util::ParamData>& parameters = IO::Parameters();
   for (auto& it : parameters)
   {
     util::ParamData& d = it.second;
-    if (!d.input)
+    if (!d.input && !IO::HasParam("serve"))
       IO::GetSingleton().functionMap[d.tname]["OutputParam"](d, NULL, NULL);
   }
 
@@ -64,6 +81,23 @@ inline void EndProgram()
       Log::Info << "  " << it2.first << ": ";
       IO::GetSingleton().timer.PrintTimer(it2.first);
     }
+
+    if (IO::GetSingleton().tracer.Enabled())
+    {
+      Log::Info << "Program trace (count, total, median, 90th percentile, "
+          << "99th percentile, max):" << std::endl;
+      for (auto& it3 : IO::GetSingleton().tracer.Statistics())
+      {
+        using Seconds = std::chrono::duration<double>;
+        const SpanStatistics& s = it3.second;
+        Log::Info << "  " << it3.first << ": " << s.count << ", "
+            << Seconds(s.total).count() << "s, "
+            << Seconds(s.median).count() << "s, "
+            << Seconds(s.p90).count() << "s, "
+            << Seconds(s.p99).count() << "s, "
+            << Seconds(s.max).count() << "s" << std::endl;
+      }
+    }
   }
 
   // Lastly clean up any memory.  If we are holding any pointers, then we "own"
@@ -101,10 +101,9 @@ void OutputParamImpl(
       std::get<0>(std::get<1>(*boost::any_cast<TupleType>(&data.value)));
   const arma::mat& matrix = std::get<1>(tuple);
 
-  // The mapping isn't taken into account.  We should write a data::Save()
-  // overload for this.
+  // The mapping is only stored if the output format can hold it (.mlbin).
   if (filename != "")
-    data::Save(filename, matrix, false, !data.noTranspose);
+    data::Save(filename, matrix, std::get<0>(tuple), false, !data.noTranspose);
 }
 
 } // namespace cli
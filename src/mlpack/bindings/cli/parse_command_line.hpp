@@ -28,6 +28,10 @@ PARAM_STRING_IN("info", "Print help on a specific option.", "", "");
 PARAM_FLAG("verbose", "Display informational messages and the full list of "
     "parameters and timers at the end of execution.", "v");
 PARAM_FLAG("version", "Display the version of mlpack.", "V");
+PARAM_STRING_IN("serve", "Instead of running once, load the input models and "
+    "run for each request read from standard input (if '-' is given) or from "
+    "connections to the Unix domain socket with the given path, sending back "
+    "the outputs.", "", "");
 
 /**
  * Parse the command line, setting all of the options inside of the CLI object
@@ -129,6 +133,10 @@ void ParseCommandLine(int argc, char** argv)
     Log::Info.ignoreInput = false;
   }
 
+  // Record a trace of the timers if a file to save it to was given.
+  if (getenv("MLPACK_TRACE_FILE") != NULL)
+    IO::GetSingleton().tracer.Enabled() = true;
+
   // Now, issue an error if we forgot any required options.
   for (std::map<std::string, util::ParamData>::const_iterator iter =
        parameters.begin(); iter != parameters.end(); ++iter)
@@ -171,7 +171,10 @@ std::string PrintTypeDoc(
   return "A filename containing an mlpack model.  These can have one of three "
       "formats: binary (.bin), text (.txt), and XML (.xml).  The XML format "
       "produces the largest (but most human-readable) files, while the binary "
-      "format can be significantly more compact and quicker to load and save.";
+      "format can be significantly more compact and quicker to load and save.  "
+      "Large models can also be saved in mlpack's bulk format (.mlpk, or "
+      ".mlpkz to compress large matrices), whose large matrices are mapped "
+      "from the file instead of being read when the model is loaded.";
 }
 
 } // namespace cli
@@ -0,0 +1,684 @@
+/**
+ * @file bindings/cli/serve.hpp
+ *
+ * The serve mode of command-line programs: the input models are loaded once,
+ * and then the program is run for each request read from standard input or
+ * from connections to a Unix domain socket, and its outputs are sent back.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_SERVE_HPP
+#define MLPACK_BINDINGS_CLI_SERVE_HPP
+
+#include <mlpack/core/util/io.hpp>
+#include <mlpack/core/data/binary_matrix.hpp>
+#include "serve_param.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#ifdef _WIN32
+  #include <fcntl.h>
+  #include <io.h>
+#else
+  #include <sys/socket.h>
+  #include <sys/stat.h>
+  #include <sys/un.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+
+//! A request of the serve mode.
+struct ServeRequest
+{
+  //! Values of the input parameters given in the request.
+  std::vector<std::pair<std::string, ServeValue>> inputs;
+  //! Names of the outputs to send back; if empty, all outputs are sent.
+  std::vector<std::string> outputs;
+  //! Whether matrices are sent back in the binary format.
+  bool binary = false;
+};
+
+/**
+ * The state of the parameters between requests: after a request, the
+ * parameters are restored to their state after the models were loaded.
+ */
+struct ServeState
+{
+  //! The parameters after the models were loaded.
+  std::map<std::string, util::ParamData> parameters;
+  //! The memory held by the input parameters, which is kept.
+  std::set<void*> memory;
+  //! Only one request runs at a time, since the parameters are global; the
+  //! connections only read and write their requests concurrently.
+  std::mutex runMutex;
+  //! Set when the server stops, so that no more requests are run.
+  bool stopping = false;
+};
+
+/**
+ * Read a line, without its newline, from the given stream.  Return false if
+ * the stream has ended.
+ */
+inline bool ServeReadLine(FILE* in, std::string& line)
+{
+  line.clear();
+  int c;
+  while ((c = getc(in)) != EOF && c != '\n')
+    line += (char) c;
+
+  if (!line.empty() && line[line.size() - 1] == '\r')
+    line.erase(line.size() - 1);
+  return (c != EOF || !line.empty());
+}
+
+/**
+ * Read the data of a matrix with the given number of lines and of values on
+ * each line.  The matrix has one column for each line.
+ */
+inline void ServeReadMatrix(FILE* in,
+                            const size_t lines,
+                            const size_t fields,
+                            const bool binary,
+                            arma::mat& matrix)
+{
+  matrix.set_size(fields, lines);
+  if (binary)
+  {
+    if (fread(matrix.memptr(), sizeof(double), matrix.n_elem, in) !=
+        matrix.n_elem)
+      throw std::runtime_error("the binary data of a matrix ended early");
+    return;
+  }
+
+  std::string line;
+  for (size_t i = 0; i < lines; ++i)
+  {
+    if (!ServeReadLine(in, line))
+      throw std::runtime_error("the data of a matrix ended early");
+
+    const char* p = line.c_str();
+    for (size_t j = 0; j < fields; ++j)
+    {
+      char* end;
+      matrix(j, i) = strtod(p, &end);
+      if (end == p)
+      {
+        throw std::invalid_argument("line '" + line + "' of a matrix does not "
+            "hold " + std::to_string(fields) + " values");
+      }
+
+      p = end;
+      while (*p == ' ' || *p == '\t')
+        ++p;
+      if (j + 1 < fields && *p++ != ',')
+      {
+        throw std::invalid_argument("line '" + line + "' of a matrix does not "
+            "hold " + std::to_string(fields) + " values");
+      }
+    }
+
+    if (*p != '\0')
+    {
+      throw std::invalid_argument("line '" + line + "' of a matrix holds more "
+          "than " + std::to_string(fields) + " values");
+    }
+  }
+}
+
+/**
+ * Read a request.  Return false if the stream ended before the request
+ * started; throw an exception if the request is malformed, in which case the
+ * rest of the stream can't be trusted.
+ */
+inline bool ServeReadRequest(FILE* in, ServeRequest& request)
+{
+  std::string line;
+  bool started = false;
+  while (ServeReadLine(in, line))
+  {
+    std::istringstream iss(line);
+    std::string command;
+    if (!(iss >> command))
+      continue; // Blank lines are ignored.
+    started = true;
+
+    if (command == "end")
+    {
+      return true;
+    }
+    else if (command == "param")
+    {
+      std::string name;
+      ServeValue value;
+      if (!(iss >> name))
+        throw std::invalid_argument("malformed command '" + line + "'");
+      std::getline(iss >> std::ws, value.text);
+      value.hasValue = true;
+      request.inputs.push_back(std::make_pair(name, std::move(value)));
+    }
+    else if (command == "matrix")
+    {
+      std::string name, format;
+      size_t lines, fields;
+      if (!(iss >> name >> lines >> fields >> format) ||
+          (format != "csv" && format != "binary"))
+        throw std::invalid_argument("malformed command '" + line + "'");
+
+      ServeValue value;
+      ServeReadMatrix(in, lines, fields, format == "binary", value.matrix);
+      value.hasValue = true;
+      value.isMatrix = true;
+      request.inputs.push_back(std::make_pair(name, std::move(value)));
+    }
+    else if (command == "output")
+    {
+      std::string name;
+      while (iss >> name)
+        request.outputs.push_back(name);
+    }
+    else if (command == "format")
+    {
+      std::string format;
+      if (!(iss >> format) || (format != "csv" && format != "binary"))
+        throw std::invalid_argument("malformed command '" + line + "'");
+      request.binary = (format == "binary");
+    }
+    else
+    {
+      throw std::invalid_argument("unknown command '" + command + "'");
+    }
+  }
+
+  if (started)
+    throw std::runtime_error("the request did not end with 'end'");
+  return false;
+}
+
+/**
+ * Free any model that the program allocated during the request, stop the
+ * timers it left running, and restore the parameters.
+ */
+inline void ServeCleanup(ServeState& state)
+{
+  std::map<std::string, util::ParamData>& parameters = IO::Parameters();
+
+  // We may hold the same new pointer twice, so it must be deleted only once.
+  std::unordered_map<void*, util::ParamData*> memoryAddresses;
+  for (auto& it : parameters)
+  {
+    util::ParamData& d = it.second;
+
+    void* result;
+    IO::GetSingleton().functionMap[d.tname]["GetAllocatedMemory"](d, NULL,
+        (void*) &result);
+    if (result != NULL && state.memory.count(result) == 0 &&
+        memoryAddresses.count(result) == 0)
+      memoryAddresses[result] = &d;
+  }
+
+  for (auto& it : memoryAddresses)
+  {
+    util::ParamData& d = *it.second;
+    IO::GetSingleton().functionMap[d.tname]["DeleteAllocatedMemory"](d, NULL,
+        NULL);
+  }
+
+  IO::GetSingleton().timer.StopThreadTimers(std::this_thread::get_id());
+  parameters = state.parameters;
+}
+
+/**
+ * Run the program for the given request, and get the values of its outputs.
+ */
+inline void ServeRun(void (*mlpackMain)(),
+                     ServeState& state,
+                     const ServeRequest& request,
+                     std::vector<std::pair<std::string, ServeValue>>& outputs)
+{
+  std::lock_guard<std::mutex> lock(state.runMutex);
+  if (state.stopping)
+    throw std::runtime_error("the server is stopping");
+
+  std::map<std::string, util::ParamData>& parameters = IO::Parameters();
+  try
+  {
+    for (const auto& input : request.inputs)
+    {
+      if (parameters.count(input.first) == 0 ||
+          !parameters.at(input.first).input)
+      {
+        throw std::invalid_argument("unknown input parameter '" + input.first +
+            "'");
+      }
+
+      util::ParamData& d = parameters.at(input.first);
+      IO::GetSingleton().functionMap[d.tname]["ServeSetParam"](d,
+          (const void*) &input.second, NULL);
+    }
+
+    // Programs may only compute the outputs that were asked for, so the
+    // outputs to send back are marked as passed.
+    for (const std::string& name : request.outputs)
+    {
+      if (parameters.count(name) == 0 || parameters.at(name).input)
+        throw std::invalid_argument("unknown output parameter '" + name + "'");
+      parameters.at(name).wasPassed = true;
+    }
+    if (request.outputs.empty())
+    {
+      for (auto& it : parameters)
+        if (!it.second.input)
+          it.second.wasPassed = true;
+    }
+
+    mlpackMain();
+
+    for (auto& it : parameters)
+    {
+      util::ParamData& d = it.second;
+      if (d.input || !d.wasPassed)
+        continue;
+
+      ServeValue value;
+      IO::GetSingleton().functionMap[d.tname]["ServeGetParam"](d, NULL,
+          (void*) &value);
+      if (value.hasValue)
+        outputs.push_back(std::make_pair(d.name, std::move(value)));
+    }
+  }
+  catch (...)
+  {
+    ServeCleanup(state);
+    throw;
+  }
+
+  ServeCleanup(state);
+}
+
+//! Write the outputs of a request.
+inline void ServeWriteResponse(
+    FILE* out,
+    const std::vector<std::pair<std::string, ServeValue>>& outputs,
+    const bool binary)
+{
+  for (const auto& output : outputs)
+  {
+    const ServeValue& value = output.second;
+    if (!value.isMatrix)
+    {
+      fprintf(out, "value %s %s\n", output.first.c_str(), value.text.c_str());
+      continue;
+    }
+
+    const arma::mat& matrix = value.matrix;
+    const std::string header = "matrix " + output.first + " " +
+        std::to_string(matrix.n_cols) + " " + std::to_string(matrix.n_rows) +
+        (binary ? " binary\n" : " csv\n");
+    fputs(header.c_str(), out);
+    if (binary)
+    {
+      fwrite(matrix.memptr(), sizeof(double), matrix.n_elem, out);
+      continue;
+    }
+
+    for (size_t i = 0; i < matrix.n_cols; ++i)
+    {
+      for (size_t j = 0; j < matrix.n_rows; ++j)
+        fprintf(out, (j == 0) ? "%.17g" : ",%.17g", matrix(j, i));
+      fputc('\n', out);
+    }
+  }
+
+  fputs("end\n", out);
+  fflush(out);
+}
+
+//! Write the response to a request that failed.
+inline void ServeWriteError(FILE* out, std::string message)
+{
+  std::replace(message.begin(), message.end(), '\n', ' ');
+  fprintf(out, "error %s\nend\n", message.c_str());
+  fflush(out);
+}
+
+/**
+ * Answer the requests read from the given stream until it ends, or until a
+ * request is malformed.
+ */
+inline void ServeConnection(FILE* in,
+                            FILE* out,
+                            void (*mlpackMain)(),
+                            ServeState& state)
+{
+  while (true)
+  {
+    ServeRequest request;
+    try
+    {
+      if (!ServeReadRequest(in, request))
+        return;
+    }
+    catch (std::exception& e)
+    {
+      ServeWriteError(out, e.what());
+      return;
+    }
+
+    // Requests of other connections can be read and written while this one
+    // runs, but ServeRun() runs one request at a time.
+    std::vector<std::pair<std::string, ServeValue>> outputs;
+    try
+    {
+      ServeRun(mlpackMain, state, request, outputs);
+    }
+    catch (std::exception& e)
+    {
+      ServeWriteError(out, e.what());
+      continue;
+    }
+
+    ServeWriteResponse(out, outputs, request.binary);
+  }
+}
+
+/**
+ * Answer the requests read from standard input on standard output.  Anything
+ * else the program prints is sent to standard error instead.
+ */
+inline void ServeStandardStreams(void (*mlpackMain)(), ServeState& state)
+{
+  std::cout.flush();
+  fflush(stdout);
+  #ifdef _WIN32
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+    FILE* out = _fdopen(_dup(_fileno(stdout)), "wb");
+    _dup2(_fileno(stderr), _fileno(stdout));
+  #else
+    FILE* out = fdopen(dup(fileno(stdout)), "w");
+    dup2(fileno(stderr), fileno(stdout));
+  #endif
+  if (out == NULL)
+    Log::Fatal << "Cannot open standard output for responses." << std::endl;
+
+  // The requests run on their own thread, like the requests of a socket, so
+  // that the timers they leave running after an error can be stopped without
+  // stopping the timers of the main thread.
+  std::thread thread(ServeConnection, stdin, out, mlpackMain,
+      std::ref(state));
+  thread.join();
+  fclose(out);
+}
+
+#ifndef _WIN32
+
+//! Whether the server received a signal to stop.
+inline volatile std::sig_atomic_t& ServeStopSignal()
+{
+  static volatile std::sig_atomic_t stop = 0;
+  return stop;
+}
+
+//! A connection to the socket of the server, answered by its own thread.
+struct ServeSocketConnection
+{
+  //! The thread that answers the requests of the connection.
+  std::thread thread;
+  //! The descriptor of the connection.
+  int fd;
+  //! Whether the thread has closed the descriptor (guarded by a lock).
+  bool closed;
+};
+
+//! Handle SIGINT and SIGTERM by stopping the server.
+inline void ServeHandleSignal(int /* signal */)
+{
+  ServeStopSignal() = 1;
+}
+
+/**
+ * Answer requests on connections to the Unix domain socket with the given path,
+ * with a thread for each connection, until SIGINT or SIGTERM is received.  The
+ * connections that are still open are then shut down, and their threads are
+ * joined before returning.  The program itself still runs one request at a
+ * time, so connections only overlap the reading and writing of requests.
+ */
+inline void ServeSocket(const std::string& path,
+                        void (*mlpackMain)(),
+                        ServeState& state)
+{
+  sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(address.sun_path))
+    Log::Fatal << "The socket path '" << path << "' is too long." << std::endl;
+  memcpy(address.sun_path, path.c_str(), path.size());
+
+  // Remove a socket left by an earlier server; any other file is kept.
+  struct stat fileInfo;
+  if (lstat(path.c_str(), &fileInfo) == 0 && S_ISSOCK(fileInfo.st_mode))
+    unlink(path.c_str());
+
+  const int server = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (server < 0 || bind(server, (sockaddr*) &address, sizeof(address)) < 0 ||
+      listen(server, SOMAXCONN) < 0)
+  {
+    Log::Fatal << "Cannot listen on the socket '" << path << "': "
+        << strerror(errno) << "." << std::endl;
+  }
+
+  // A client that disconnects must not kill the server, and the signals to
+  // stop must interrupt accept().
+  signal(SIGPIPE, SIG_IGN);
+  ServeStopSignal() = 0;
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = ServeHandleSignal;
+  sigemptyset(&action.sa_mask);
+  sigaction(SIGINT, &action, NULL);
+  sigaction(SIGTERM, &action, NULL);
+
+  // The thread of each connection is kept, so that it can be stopped and
+  // joined before the server returns.
+  std::list<ServeSocketConnection> connections;
+  std::mutex connectionsMutex;
+
+  Log::Info << "Serving requests on '" << path << "'." << std::endl;
+  while (!ServeStopSignal())
+  {
+    const int connection = accept(server, NULL, NULL);
+    if (connection < 0)
+    {
+      if (errno == EINTR || errno == ECONNABORTED)
+        continue;
+      Log::Warn << "Cannot accept a connection: " << strerror(errno) << "."
+          << std::endl;
+      break;
+    }
+
+    // Threads of connections that have ended can be joined now.
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+    for (auto it = connections.begin(); it != connections.end(); )
+    {
+      if (it->closed)
+      {
+        it->thread.join();
+        it = connections.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+
+    connections.emplace_back();
+    ServeSocketConnection& c = connections.back();
+    c.fd = connection;
+    c.closed = false;
+    c.thread = std::thread([&c, &connectionsMutex, mlpackMain, &state]()
+    {
+      FILE* in = fdopen(c.fd, "r");
+      FILE* out = fdopen(dup(c.fd), "w");
+      if (in != NULL && out != NULL)
+        ServeConnection(in, out, mlpackMain, state);
+
+      // The descriptor is closed under the lock, so that the server never
+      // shuts down a descriptor that was reused.
+      std::lock_guard<std::mutex> lock(connectionsMutex);
+      if (in != NULL)
+        fclose(in);
+      else
+        close(c.fd);
+      if (out != NULL)
+        fclose(out);
+      c.closed = true;
+    });
+  }
+
+  Log::Info << "Stopping the server." << std::endl;
+  close(server);
+  unlink(path.c_str());
+
+  // Connections that are still open can't run requests anymore, since the
+  // parameters are about to be cleaned up.
+  {
+    std::lock_guard<std::mutex> lock(state.runMutex);
+    state.stopping = true;
+  }
+
+  // Shutting down the open connections makes their threads stop waiting for
+  // requests; the state they use must outlive them.
+  {
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+    for (ServeSocketConnection& c : connections)
+      if (!c.closed)
+        shutdown(c.fd, SHUT_RDWR);
+  }
+  for (ServeSocketConnection& c : connections)
+    c.thread.join();
+}
+
+#endif
+
+/**
+ * Load the input models given on the command line, and keep the state of the
+ * parameters and the memory of the models, which every request then reuses.
+ */
+inline void ServeInitialize(ServeState& state)
+{
+  std::map<std::string, util::ParamData>& parameters = IO::Parameters();
+
+  // Load the models once; they are used by every request.
+  for (auto& it : parameters)
+  {
+    util::ParamData& d = it.second;
+    IO::GetSingleton().functionMap[d.tname]["ServeLoadParam"](d, NULL, NULL);
+  }
+
+  state.parameters = parameters;
+  for (auto& it : parameters)
+  {
+    util::ParamData& d = it.second;
+
+    void* result;
+    IO::GetSingleton().functionMap[d.tname]["GetAllocatedMemory"](d, NULL,
+        (void*) &result);
+    if (result != NULL)
+      state.memory.insert(result);
+  }
+}
+
+/**
+ * Run the serve mode, given with --serve: load the input models, then run the
+ * program for each request, and send back its outputs.  If the value of
+ * --serve is "-", requests are read from standard input, and the responses are
+ * written to standard output; otherwise it is the path of a Unix domain socket
+ * to listen on, and each connection is handled by its own thread.  Since the
+ * parameters are global, the requests of all connections are run one at a time;
+ * the threads only let connections read and write their requests concurrently.
+ *
+ * A request is a list of commands, one on each line, that ends with "end":
+ *
+ *  - "param <name> <value>" sets an input parameter that is not a matrix, for
+ *    instance "param k 5"; the elements of a vector are separated by spaces.
+ *  - "matrix <name> <lines> <values> csv" sets an input matrix, whose data is
+ *    given on the next <lines> lines, each holding <values> comma-separated
+ *    values, like a CSV file.
+ *  - "matrix <name> <lines> <values> binary" sets an input matrix, whose data
+ *    follows as <lines> * <values> doubles in the byte order of the host, one
+ *    line after another.
+ *  - "output <name> ..." asks for the given outputs only; by default, all of
+ *    the outputs are sent back.
+ *  - "format <csv|binary>" sets the format of the matrices of the response; the
+ *    default is csv.
+ *
+ * The names are those of the parameters, without "_file".  The response holds
+ * a "matrix" command (with its data) for each output matrix, and a
+ * "value <name> <value>" line for any other output, then "end".  If the
+ * request fails, the response is "error <message>", then "end"; if it is
+ * malformed, the connection is closed after that.
+ *
+ * Matrices that are not given in a request are loaded from the files given on
+ * the command line each time they are used, so only models should be given on
+ * the command line.
+ *
+ * @param mlpackMain The function of the program to run for each request.
+ */
+inline void Serve(void (*mlpackMain)())
+{
+  std::map<std::string, util::ParamData>& parameters = IO::Parameters();
+
+  // Outputs are sent back in the responses, not saved to files.
+  for (auto& it : parameters)
+  {
+    util::ParamData& d = it.second;
+    if (!d.input && d.wasPassed)
+    {
+      std::string cliName;
+      IO::GetSingleton().functionMap[d.tname]["MapParameterName"](d, NULL,
+          (void*) &cliName);
+      Log::Fatal << "--" << cliName << " can't be given with --serve; outputs "
+          << "are sent back in the responses." << std::endl;
+    }
+  }
+
+  ServeState state;
+  ServeInitialize(state);
+
+  const std::string address = IO::GetParam<std::string>("serve");
+  if (address == "-")
+  {
+    ServeStandardStreams(mlpackMain, state);
+  }
+  else
+  {
+    #ifdef _WIN32
+      Log::Fatal << "Unix domain sockets are not supported on Windows; use "
+          << "--serve - to read requests from standard input." << std::endl;
+    #else
+      ServeSocket(address, mlpackMain, state);
+    #endif
+  }
+}
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif
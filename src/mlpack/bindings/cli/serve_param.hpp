@@ -0,0 +1,331 @@
+/**
+ * @file bindings/cli/serve_param.hpp
+ *
+ * Use template metaprogramming to set and get the values of parameters from the
+ * requests and responses of the serve mode (see serve.hpp).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_SERVE_PARAM_HPP
+#define MLPACK_BINDINGS_CLI_SERVE_PARAM_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/is_std_vector.hpp>
+#include "get_param.hpp"
+
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+
+/**
+ * The value of a parameter in a request or a response of the serve mode.  A
+ * matrix holds one column for each line of the data, like a matrix loaded from
+ * a file before it is transposed; any other value is held as text.
+ */
+struct ServeValue
+{
+  //! Whether the parameter has a value that can be sent.
+  bool hasValue = false;
+  //! Whether the value is a matrix.
+  bool isMatrix = false;
+  //! The matrix, with one column for each line of the data.
+  arma::mat matrix;
+  //! The value of a parameter that is not a matrix.
+  std::string text;
+};
+
+//! Parse a value that is not a string or a flag.
+template<typename T>
+void ParseServeValue(const std::string& text, T& value)
+{
+  std::istringstream iss(text);
+  if (!(iss >> value) || !(iss >> std::ws).eof())
+    throw std::invalid_argument("cannot parse '" + text + "'");
+}
+
+//! Parse a string value; this is the whole text.
+inline void ParseServeValue(const std::string& text, std::string& value)
+{
+  value = text;
+}
+
+//! Parse a flag.
+inline void ParseServeValue(const std::string& text, bool& value)
+{
+  if (text == "true" || text == "1")
+    value = true;
+  else if (text == "false" || text == "0")
+    value = false;
+  else
+    throw std::invalid_argument("cannot parse '" + text + "' as a flag");
+}
+
+/**
+ * Set a parameter that is not a matrix or a model from its text.
+ */
+template<typename T>
+void ServeSetParamImpl(
+    util::ParamData& d,
+    const ServeValue& value,
+    const typename boost::disable_if<arma::is_arma_type<T>>::type* = 0,
+    const typename boost::disable_if<util::IsStdVector<T>>::type* = 0,
+    const typename boost::disable_if<data::HasSerialize<T>>::type* = 0,
+    const typename boost::disable_if<std::is_same<T,
+        std::tuple<data::DatasetInfo, arma::mat>>>::type* = 0)
+{
+  if (value.isMatrix)
+    throw std::invalid_argument("'" + d.name + "' is not a matrix");
+
+  ParseServeValue(value.text, *boost::any_cast<T>(&d.value));
+}
+
+/**
+ * Set a vector parameter from its text, whose elements are separated by
+ * spaces.
+ */
+template<typename T>
+void ServeSetParamImpl(
+    util::ParamData& d,
+    const ServeValue& value,
+    const typename boost::enable_if<util::IsStdVector<T>>::type* = 0)
+{
+  if (value.isMatrix)
+    throw std::invalid_argument("'" + d.name + "' is not a matrix");
+
+  T& vector = *boost::any_cast<T>(&d.value);
+  vector.clear();
+  std::istringstream iss(value.text);
+  std::string element;
+  while (iss >> element)
+  {
+    typename T::value_type v;
+    ParseServeValue(element, v);
+    vector.push_back(v);
+  }
+}
+
+/**
+ * Set a matrix parameter.  The matrix is marked as loaded, so that it is not
+ * loaded from a file.
+ */
+template<typename T>
+void ServeSetParamImpl(
+    util::ParamData& d,
+    const ServeValue& value,
+    const typename boost::enable_if<arma::is_arma_type<T>>::type* = 0)
+{
+  if (!value.isMatrix)
+    throw std::invalid_argument("'" + d.name + "' must be given as a matrix");
+
+  typedef std::tuple<T, typename ParameterType<T>::type> TupleType;
+  TupleType& tuple = *boost::any_cast<TupleType>(&d.value);
+  T& matrix = std::get<0>(tuple);
+
+  // Vectors and matrices are read like data::Load() reads them from a file.
+  if (arma::is_Row<T>::value || arma::is_Col<T>::value)
+    matrix = arma::conv_to<T>::from(arma::vectorise(value.matrix));
+  else if (d.noTranspose)
+    matrix = arma::conv_to<T>::from(arma::trans(value.matrix));
+  else
+    matrix = arma::conv_to<T>::from(value.matrix);
+
+  std::get<1>(std::get<1>(tuple)) = matrix.n_rows;
+  std::get<2>(std::get<1>(tuple)) = matrix.n_cols;
+  d.loaded = true;
+}
+
+/**
+ * Set a matrix/DatasetInfo parameter.  A request cannot hold categorical
+ * features, so every dimension is numeric.
+ */
+template<typename T>
+void ServeSetParamImpl(
+    util::ParamData& d,
+    const ServeValue& value,
+    const typename boost::enable_if<std::is_same<T,
+        std::tuple<data::DatasetInfo, arma::mat>>>::type* = 0)
+{
+  if (!value.isMatrix)
+    throw std::invalid_argument("'" + d.name + "' must be given as a matrix");
+
+  typedef std::tuple<T, std::tuple<std::string, size_t, size_t>> TupleType;
+  TupleType& tuple = *boost::any_cast<TupleType>(&d.value);
+  arma::mat& matrix = std::get<1>(std::get<0>(tuple));
+  matrix = d.noTranspose ? arma::mat(arma::trans(value.matrix)) : value.matrix;
+  std::get<0>(std::get<0>(tuple)) = data::DatasetInfo(matrix.n_rows);
+
+  std::get<1>(std::get<1>(tuple)) = matrix.n_rows;
+  std::get<2>(std::get<1>(tuple)) = matrix.n_cols;
+  d.loaded = true;
+}
+
+/**
+ * Models can't be given in a request.
+ */
+template<typename T>
+void ServeSetParamImpl(
+    util::ParamData& d,
+    const ServeValue& /* value */,
+    const typename boost::disable_if<arma::is_arma_type<T>>::type* = 0,
+    const typename boost::enable_if<data::HasSerialize<T>>::type* = 0)
+{
+  throw std::invalid_argument("model '" + d.name + "' cannot be given in a "
+      "request");
+}
+
+/**
+ * Set the value of an input parameter from a request of the serve mode, and
+ * mark it as passed.
+ *
+ * @param d Parameter information.
+ * @param input Pointer to the ServeValue to set the parameter to.
+ * @param * (output) Unused parameter.
+ */
+template<typename T>
+void ServeSetParam(util::ParamData& d, const void* input, void* /* output */)
+{
+  ServeSetParamImpl<typename std::remove_pointer<T>::type>(d,
+      *((const ServeValue*) input));
+  d.wasPassed = true;
+}
+
+/**
+ * Get the value of a parameter that is not a matrix or a model as text.
+ */
+template<typename T>
+void ServeGetParamImpl(
+    util::ParamData& d,
+    ServeValue& value,
+    const typename boost::disable_if<arma::is_arma_type<T>>::type* = 0,
+    const typename boost::disable_if<util::IsStdVector<T>>::type* = 0,
+    const typename boost::disable_if<data::HasSerialize<T>>::type* = 0,
+    const typename boost::disable_if<std::is_same<T,
+        std::tuple<data::DatasetInfo, arma::mat>>>::type* = 0)
+{
+  std::ostringstream oss;
+  oss << std::setprecision(17) << *boost::any_cast<T>(&d.value);
+  value.hasValue = true;
+  value.text = oss.str();
+}
+
+/**
+ * Get the value of a vector parameter as text, with the elements separated by
+ * spaces.
+ */
+template<typename T>
+void ServeGetParamImpl(
+    util::ParamData& d,
+    ServeValue& value,
+    const typename boost::enable_if<util::IsStdVector<T>>::type* = 0)
+{
+  const T& vector = *boost::any_cast<T>(&d.value);
+  std::ostringstream oss;
+  oss << std::setprecision(17);
+  for (size_t i = 0; i < vector.size(); ++i)
+    oss << ((i == 0) ? "" : " ") << vector[i];
+  value.hasValue = true;
+  value.text = oss.str();
+}
+
+/**
+ * Get a matrix parameter, with one column for each line that data::Save()
+ * would write.
+ */
+template<typename T>
+void ServeGetParamImpl(
+    util::ParamData& d,
+    ServeValue& value,
+    const typename boost::enable_if<arma::is_arma_type<T>>::type* = 0)
+{
+  typedef std::tuple<T, typename ParameterType<T>::type> TupleType;
+  const T& matrix = std::get<0>(*boost::any_cast<TupleType>(&d.value));
+
+  if (arma::is_Row<T>::value || arma::is_Col<T>::value)
+    value.matrix = arma::conv_to<arma::rowvec>::from(matrix);
+  else if (d.noTranspose)
+    value.matrix = arma::trans(arma::conv_to<arma::mat>::from(matrix));
+  else
+    value.matrix = arma::conv_to<arma::mat>::from(matrix);
+  value.hasValue = true;
+  value.isMatrix = true;
+}
+
+/**
+ * Get the matrix of a matrix/DatasetInfo parameter.
+ */
+template<typename T>
+void ServeGetParamImpl(
+    util::ParamData& d,
+    ServeValue& value,
+    const typename boost::enable_if<std::is_same<T,
+        std::tuple<data::DatasetInfo, arma::mat>>>::type* = 0)
+{
+  typedef std::tuple<T, std::tuple<std::string, size_t, size_t>> TupleType;
+  const arma::mat& matrix =
+      std::get<1>(std::get<0>(*boost::any_cast<TupleType>(&d.value)));
+  value.matrix = d.noTranspose ? arma::mat(arma::trans(matrix)) : matrix;
+  value.hasValue = true;
+  value.isMatrix = true;
+}
+
+/**
+ * Models are not sent in a response.
+ */
+template<typename T>
+void ServeGetParamImpl(
+    util::ParamData& /* d */,
+    ServeValue& /* value */,
+    const typename boost::disable_if<arma::is_arma_type<T>>::type* = 0,
+    const typename boost::enable_if<data::HasSerialize<T>>::type* = 0)
+{
+  // Nothing to do.
+}
+
+/**
+ * Get the value of an output parameter for a response of the serve mode.
+ *
+ * @param d Parameter information.
+ * @param * (input) Unused parameter.
+ * @param output Pointer to the ServeValue to store the value in.
+ */
+template<typename T>
+void ServeGetParam(util::ParamData& d, const void* /* input */, void* output)
+{
+  ServeGetParamImpl<typename std::remove_pointer<T>::type>(d,
+      *((ServeValue*) output));
+}
+
+/**
+ * Load the given input parameter if it is a model; other parameters are loaded
+ * when they are used.
+ *
+ * @param d Parameter information.
+ * @param * (input) Unused parameter.
+ * @param * (output) Unused parameter.
+ */
+template<typename T>
+void ServeLoadParam(util::ParamData& d,
+                    const void* /* input */,
+                    void* /* output */)
+{
+  typedef typename std::remove_pointer<T>::type Type;
+  if (data::HasSerialize<Type>::value && !arma::is_arma_type<Type>::value &&
+      d.input && d.wasPassed)
+  {
+    void* result;
+    GetParam<T>(d, NULL, (void*) &result);
+  }
+}
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif
@@ -12,6 +12,12 @@ object, then the numpy object will "own" the matrix.
 Thus, know that if you convert a matrix type, remember that the resulting type
 is what "owns" the allocated memory.
 
+A C-contiguous numpy array with n rows and d columns has the same layout as a
+d x n column-major Armadillo matrix (one point per column), so it is used
+without a copy, even if it is a view of another array's memory.  (Read-only
+arrays are copied by to_matrix() in matrix_utils.py, since methods may modify
+their inputs.)
+
 mlpack is free software; you may redistribute it and/or modify it under the
 terms of the 3-clause BSD license.  You should have received a copy of the
 3-clause BSD license along with mlpack.  If not, see
@@ -48,8 +54,11 @@ cdef arma.Mat[double]* numpy_to_mat_d(numpy.ndarray[numpy.double_t, ndim=2] X, \
   """
   Convert a numpy ndarray to a matrix.  The memory will still be owned by numpy.
   """
-  if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
-    # If needed, make a copy where we own the memory.
+  if not X.flags.c_contiguous or \
+      (takeOwnership and not X.flags.owndata and not isWin):
+    # A C-contiguous array is used in place, even if it does not own its
+    # memory, unless we were asked to take ownership of the memory.  Otherwise
+    # make a copy where we own the memory.
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -68,9 +77,11 @@ cdef arma.Mat[size_t]* numpy_to_mat_s(numpy.ndarray[numpy.npy_intp, ndim=2] X, \
   """
   Convert a numpy ndarray to a matrix.  The memory will still be owned by numpy.
   """
-  if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  if not X.flags.c_contiguous or \
+      (takeOwnership and not X.flags.owndata and not isWin):
+    # A C-contiguous array is used in place, even if it does not own its
+    # memory, unless we were asked to take ownership of the memory.  Otherwise
+    # make a copy where we own the memory.
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -132,9 +143,11 @@ cdef arma.Row[double]* numpy_to_row_d(numpy.ndarray[numpy.double_t, ndim=1] X, \
   Convert a numpy one-dimensional ndarray to a row.  The memory will still be
   owned by numpy.
   """
-  if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  if not X.flags.c_contiguous or \
+      (takeOwnership and not X.flags.owndata and not isWin):
+    # A C-contiguous array is used in place, even if it does not own its
+    # memory, unless we were asked to take ownership of the memory.  Otherwise
+    # make a copy where we own the memory.
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -154,9 +167,11 @@ cdef arma.Row[size_t]* numpy_to_row_s(numpy.ndarray[numpy.npy_intp, ndim=1] X, \
   Convert a numpy one-dimensional ndarray to a row.  The memory will still be
   owned by numpy.
   """
-  if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  if not X.flags.c_contiguous or \
+      (takeOwnership and not X.flags.owndata and not isWin):
+    # A C-contiguous array is used in place, even if it does not own its
+    # memory, unless we were asked to take ownership of the memory.  Otherwise
+    # make a copy where we own the memory.
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -215,9 +230,11 @@ cdef arma.Col[double]* numpy_to_col_d(numpy.ndarray[numpy.double_t, ndim=1] X, \
   Convert a numpy one-dimensional ndarray to a column vector.  The memory will
   still be owned by numpy.
   """
-  if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  if not X.flags.c_contiguous or \
+      (takeOwnership and not X.flags.owndata and not isWin):
+    # A C-contiguous array is used in place, even if it does not own its
+    # memory, unless we were asked to take ownership of the memory.  Otherwise
+    # make a copy where we own the memory.
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -237,9 +254,11 @@ cdef arma.Col[size_t]* numpy_to_col_s(numpy.ndarray[numpy.npy_intp, ndim=1] X, \
   Convert a numpy one-dimensional ndarray to a column vector.  The memory will
   still be owned by numpy.
   """
-  if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  if not X.flags.c_contiguous or \
+      (takeOwnership and not X.flags.owndata and not isWin):
+    # A C-contiguous array is used in place, even if it does not own its
+    # memory, unless we were asked to take ownership of the memory.  Otherwise
+    # make a copy where we own the memory.
     X = X.copy(order="C")
     takeOwnership = True
 
@@ -101,6 +101,58 @@ inline void SetParamWithInfo(const std::string& identifier,
   }
 }
 
+/**
+ * Create an Armadillo object of the given size that uses the given memory and
+ * cannot be resized; the overloads separate vectors from matrices.
+ */
+template<typename T, typename eT>
+inline void ConstructWithMemory(T& m,
+                                eT* memory,
+                                const size_t nRows,
+                                const size_t nCols,
+                                const std::true_type /* isVector */)
+{
+  new (&m) T(memory, nRows * nCols, false, true);
+}
+
+template<typename T, typename eT>
+inline void ConstructWithMemory(T& m,
+                                eT* memory,
+                                const size_t nRows,
+                                const size_t nCols,
+                                const std::false_type /* isVector */)
+{
+  new (&m) T(memory, nRows, nCols, false, true);
+}
+
+/**
+ * Make the given output matrix parameter use the given memory, so that the
+ * result of the binding is written there instead of to a newly allocated
+ * matrix.  The matrix cannot be resized, so an exception is thrown if the
+ * result has a different size.
+ *
+ * @param identifier Name of parameter.
+ * @param memory Memory to use; it must hold nRows * nCols elements.
+ * @param nRows Number of rows of the output.
+ * @param nCols Number of columns of the output.
+ */
+template<typename T, typename eT>
+inline void SetParamMemory(const std::string& identifier,
+                           eT* memory,
+                           const size_t nRows,
+                           const size_t nCols)
+{
+  static_assert(std::is_same<eT, typename T::elem_type>::value,
+      "SetParamMemory(): eT must be the element type of T");
+
+  // Armadillo can't point an existing object at other memory, so the
+  // parameter is rebuilt in place.
+  T& param = IO::GetParam<T>(identifier);
+  param.~T();
+  ConstructWithMemory(param, memory, nRows, nCols,
+      std::integral_constant<bool, T::is_row || T::is_col>());
+}
+
 /**
  * Return a pointer.  This function exists to work around Cython's seeming lack
  * of support for template pointer types.
@@ -128,14 +180,31 @@ T& GetParamWithInfo(const std::string& paramName)
 inline void EnableVerbose()
 {
   Log::Info.ignoreInput = false;
+  // Verbose calls are traced if a file to save the trace to was given.
+  if (getenv("MLPACK_TRACE_FILE") != NULL)
+    IO::GetSingleton().tracer.Enabled() = true;
 }
 
 /**
- * Turn verbose output off.
+ * Turn verbose output and tracing off.
  */
 inline void DisableVerbose()
 {
   Log::Info.ignoreInput = true;
+  IO::GetSingleton().tracer.Enabled() = false;
+}
+
+/**
+ * Save the trace of the call, if it was traced.
+ */
+inline void SaveTrace()
+{
+  const char* traceFile = getenv("MLPACK_TRACE_FILE");
+  if (!IO::GetSingleton().tracer.Enabled() || traceFile == NULL)
+    return;
+
+  IO::GetSingleton().tracer.EndAll();
+  IO::GetSingleton().tracer.Save(traceFile);
 }
 
 /**
@@ -153,6 +222,7 @@ inline void ResetTimers()
 {
   // Just get a new object---removes all old timers.
   IO::GetSingleton().timer.Reset();
+  IO::GetSingleton().tracer.Reset();
 }
 
 /**
@@ -4,7 +4,8 @@ matrix_utils.py: utilities for matrix conversion
 
 This file defines the to_matrix() function, which can be used to convert Pandas
 dataframes or other types of array-like objects to numpy ndarrays for use in
-mlpack bindings.
+mlpack bindings, and the check_output_matrix() function, which checks arrays
+given to hold the output matrices of bindings.
 
 mlpack is free software; you may redistribute it and/or modify it under the
 terms of the 3-clause BSD license.  You should have received a copy of the
@@ -39,7 +40,16 @@ except:
 
 def to_matrix(x, dtype=np.double, copy=False):
   """
-  Given some array-like X, return a numpy ndarray of the same type.
+  Given some array-like X, return a tuple containing a numpy ndarray of the
+  given type, and whether or not that ndarray is a new copy (whose memory
+  mlpack can take ownership of).
+
+  A writeable C-contiguous ndarray of the given type is returned as-is, even if
+  it is a view of another array's memory, unless copy is True; this includes
+  the values of a Pandas dataframe or series when they are stored that way.
+  Integer arrays whose elements have the same size as the given type are
+  reinterpreted without a copy.  Anything else is converted to the given type
+  in C order with a single copy.
   """
   # Make sure it's array-like at all.
   if not hasattr(x, '__len__') and \
@@ -47,28 +57,49 @@ def to_matrix(x, dtype=np.double, copy=False):
       not hasattr(x, '__array__'):
     raise TypeError("given argument is not array-like")
 
-  if (isinstance(x, np.ndarray) and x.dtype == dtype and x.flags.c_contiguous):
-    if copy: # Copy the matrix if required.
-      return x.copy("C"), True
-    else:
+  if isinstance(x, pd.core.series.Series) or isinstance(x, pd.DataFrame):
+    # This is a view of the dataframe's memory when all of its columns have the
+    # same dtype.  Usually that memory is in Fortran order, so it will still be
+    # copied below.
+    x = x.values
+
+  if isinstance(x, np.ndarray):
+    dt = np.dtype(dtype)
+    if x.dtype != dt and x.dtype.kind in 'iu' and dt.kind in 'iu' and \
+        x.dtype.itemsize == dt.itemsize:
+      x = x.view(dt)
+
+    # Methods may modify their inputs, so read-only arrays must be copied.
+    if not copy and x.dtype == dt and x.flags.c_contiguous and \
+        x.flags.writeable:
       return x, False
-  elif (isinstance(x, np.ndarray) and x.dtype == dtype and x.flags.f_contiguous):
-    # A copy is always necessary here.
-    return x.copy("C"), True
-  else:
-    if isinstance(x, pd.core.series.Series) or isinstance(x, pd.DataFrame):
-      # We can only avoid a copy if the dtype is the same and the copy flag is
-      # false.  I'm actually not sure if this is possible, since in everything I
-      # have found, Pandas stores with F_CONTIGUOUS not C_CONTIGUOUS.
-      y = x.values
-      if copy == False and y.dtype == dtype and y.flags.c_contiguous:
-        return np.ndarray(y.shape, buffer=x.values, dtype=dtype, order='C'),\
-            False
-      else:
-        # We have to make a copy or change the dtype, so just do this directly.
-        return np.array(y, dtype=dtype, order='C', copy=True), True
-    else:
-      return np.array(x, copy=True, dtype=dtype, order='C'), True
+
+  return np.array(x, copy=True, dtype=dtype, order='C'), True
+
+def check_output_matrix(x, dtype, ndim, name):
+  """
+  Check that the given ndarray can be used as the preallocated memory of the
+  output matrix with the given name, and return it.  It must have the given
+  dtype and number of dimensions, and be writeable and C-contiguous.  Its shape
+  is checked when the method writes its output.
+  """
+  if not isinstance(x, np.ndarray):
+    raise TypeError("preallocated output '" + name + "' must be a numpy "
+        "ndarray!")
+
+  if x.dtype != np.dtype(dtype):
+    raise TypeError("preallocated output '" + name + "' must have dtype '" +
+        np.dtype(dtype).name + "', not '" + x.dtype.name + "'!")
+
+  if x.ndim != ndim:
+    raise ValueError("preallocated output '" + name + "' must have " +
+        str(ndim) + " dimension(s), not " + str(x.ndim) + "!")
+
+  if not x.flags.c_contiguous or not x.flags.writeable:
+    raise ValueError("preallocated output '" + name + "' must be writeable "
+        "and C-contiguous!")
+
+  return x
 
 
 def to_matrix_with_info(x, dtype, copy=False):
@@ -89,11 +120,9 @@ def to_matrix_with_info(x, dtype, copy=False):
     else:
       d = np.zeros([x.shape[1]], dtype=np.bool)
 
-    # Copy the matrix if needed.
-    if copy:
-      return (x.copy(order="C"), True, d)
-    else:
-      return (x, False, d)
+    # Convert or copy the matrix only if needed.
+    t = to_matrix(x, dtype=dtype, copy=copy)
+    return (t[0], t[1], d)
 
   if isinstance(x, pd.DataFrame) or isinstance(x, pd.Series):
     # It's a pandas dataframe.  So we need to see if any of the dtypes are
@@ -0,0 +1,100 @@
+/**
+ * @file bindings/python/print_output_memory.hpp
+ *
+ * Print the code in a Python binding .pyx file that makes an output matrix
+ * parameter use the memory of an array given by the caller.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_PYTHON_PRINT_OUTPUT_MEMORY_HPP
+#define MLPACK_BINDINGS_PYTHON_PRINT_OUTPUT_MEMORY_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "get_cython_type.hpp"
+#include "get_numpy_type.hpp"
+
+namespace mlpack {
+namespace bindings {
+namespace python {
+
+/**
+ * Print nothing for a parameter that is not a matrix; only matrices can be
+ * preallocated.
+ */
+template<typename T>
+void PrintOutputMemory(
+    util::ParamData& /* d */,
+    const size_t /* indent */,
+    const typename boost::disable_if<arma::is_arma_type<T>>::type* = 0)
+{
+  // Nothing to do.
+}
+
+/**
+ * Print the code that makes a matrix output parameter use the memory of the
+ * array given for it in the 'out' argument, if any.
+ */
+template<typename T>
+void PrintOutputMemory(
+    util::ParamData& d,
+    const size_t indent,
+    const typename boost::enable_if<arma::is_arma_type<T>>::type* = 0)
+{
+  const std::string prefix(indent, ' ');
+  const bool isVector = (T::is_row || T::is_col);
+  const std::string elemType = GetCythonType<typename T::elem_type>(d);
+
+  /**
+   * This gives us code like:
+   *
+   * if out is not None and 'param_name' in out:
+   *   param_name_out = check_output_matrix(out['param_name'], np.double, 2,
+   *       'param_name')
+   *   SetParamMemory[arma.Mat[double], double](<const string> 'param_name',
+   *       <double*> np.PyArray_DATA(<np.ndarray> param_name_out),
+   *       param_name_out.shape[1], param_name_out.shape[0])
+   *
+   * A numpy array with one point per row is the transpose of the matrix, so
+   * the rows of the matrix are the columns of the array.
+   */
+  std::cout << prefix << "if out is not None and '" << d.name << "' in out:"
+      << std::endl;
+  std::cout << prefix << "  " << d.name << "_out = check_output_matrix(out['"
+      << d.name << "'], " << GetNumpyType<typename T::elem_type>() << ", "
+      << (isVector ? 1 : 2) << ", '" << d.name << "')" << std::endl;
+  std::cout << prefix << "  SetParamMemory[" << GetCythonType<T>(d) << ", "
+      << elemType << "](<const string> '" << d.name << "', <" << elemType
+      << "*> np.PyArray_DATA(<np.ndarray> " << d.name << "_out), ";
+  if (isVector)
+    std::cout << d.name << "_out.shape[0], 1)" << std::endl;
+  else
+    std::cout << d.name << "_out.shape[1], " << d.name << "_out.shape[0])"
+        << std::endl;
+}
+
+/**
+ * Given parameter information and the current number of spaces for
+ * indentation, print the code to make the output matrix parameter use the
+ * memory of a preallocated array to cout.
+ *
+ * @param d Parameter data struct.
+ * @param input Pointer to size_t holding the indentation.
+ * @param * (output) Unused parameter.
+ */
+template<typename T>
+void PrintOutputMemory(util::ParamData& d,
+                       const void* input,
+                       void* /* output */)
+{
+  PrintOutputMemory<typename std::remove_pointer<T>::type>(d,
+      *((size_t*) input));
+}
+
+} // namespace python
+} // namespace bindings
+} // namespace mlpack
+
+#endif
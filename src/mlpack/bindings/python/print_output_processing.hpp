@@ -90,16 +90,25 @@ void PrintOutputProcessing(
 {
   const std::string prefix(indent, ' ');
 
+  // If the caller gave an array to hold the output, the output was written
+  // there (see PrintOutputMemory()), so that array is returned.
+  std::cout << prefix << "if out is not None and '" << d.name << "' in out:"
+      << std::endl;
   if (onlyOutput)
   {
     /**
      * This gives us code like:
      *
-     * result = arma_numpy.mat_to_numpy_X(IO.GetParam[mat]("name"))
+     * if out is not None and 'name' in out:
+     *   result = name_out
+     * else:
+     *   result = arma_numpy.mat_to_numpy_X(IO.GetParam[mat]("name"))
      *
      * where X indicates the type to convert to.
      */
-    std::cout << prefix << "result = arma_numpy." << GetArmaType<T>()
+    std::cout << prefix << "  result = " << d.name << "_out" << std::endl;
+    std::cout << prefix << "else:" << std::endl;
+    std::cout << prefix << "  result = arma_numpy." << GetArmaType<T>()
         << "_to_numpy_" << GetNumpyTypeChar<T>() << "(IO.GetParam["
         << GetCythonType<T>(d) << "](\"" << d.name << "\"))" << std::endl;
   }
@@ -108,12 +117,18 @@ void PrintOutputProcessing(
     /**
      * This gives us code like:
      *
-     * result['param_name'] =
-     *     arma_numpy.mat_to_numpy_X(IO.GetParam[mat]('name')
+     * if out is not None and 'param_name' in out:
+     *   result['param_name'] = param_name_out
+     * else:
+     *   result['param_name'] =
+     *       arma_numpy.mat_to_numpy_X(IO.GetParam[mat]('name')
      *
      * where X indicates the type to convert to.
      */
-    std::cout << prefix << "result['" << d.name
+    std::cout << prefix << "  result['" << d.name << "'] = " << d.name
+        << "_out" << std::endl;
+    std::cout << prefix << "else:" << std::endl;
+    std::cout << prefix << "  result['" << d.name
         << "'] = arma_numpy." << GetArmaType<T>() << "_to_numpy_"
         << GetNumpyTypeChar<T>() << "(IO.GetParam[" << GetCythonType<T>(d)
         << "]('" << d.name << "'))" << std::endl;
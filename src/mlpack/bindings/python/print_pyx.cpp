@@ -14,6 +14,7 @@
 #include <mlpack/core/util/io.hpp>
 #include <mlpack/core/util/hyphenate_string.hpp>
 #include <set>
+#include <sstream>
 
 using namespace mlpack::util;
 using namespace std;
@@ -69,6 +70,15 @@ void PrintPYX(const util::BindingDetails& doc,
       inputOptions.push_back(it->first);
   }
 
+  // The output matrices can be written to arrays given by the caller.
+  vector<string> outputMatrices;
+  for (size_t i = 0; i < outputOptions.size(); ++i)
+  {
+    util::ParamData& d = parameters.at(outputOptions[i]);
+    if (d.cppType.compare(0, 6, "arma::") == 0)
+      outputMatrices.push_back(d.name);
+  }
+
   // First, we must generate the header comment.
 
   // Now import all the necessary packages.
@@ -76,10 +86,11 @@ void PrintPYX(const util::BindingDetails& doc,
   cout << "cimport arma_numpy" << endl;
   cout << "from io cimport IO" << endl;
   cout << "from io cimport SetParam, SetParamPtr, SetParamWithInfo, "
-      << "GetParamPtr" << endl;
+      << "SetParamMemory, GetParamPtr" << endl;
   cout << "from io cimport EnableVerbose, DisableVerbose, DisableBacktrace, "
-      << "ResetTimers, EnableTimers" << endl;
-  cout << "from matrix_utils import to_matrix, to_matrix_with_info" << endl;
+      << "ResetTimers, EnableTimers, SaveTrace" << endl;
+  cout << "from matrix_utils import to_matrix, to_matrix_with_info, "
+      << "check_output_matrix" << endl;
   cout << "from preprocess_json_params import process_params_out, "
       << "process_params_in" << endl;
   cout << "from serialization cimport SerializeIn, SerializeOut, "
@@ -139,6 +150,8 @@ void PrintPYX(const util::BindingDetails& doc,
 
     IO::GetSingleton().functionMap[d.tname]["PrintDefn"](d, NULL, NULL);
   }
+  if (!outputMatrices.empty())
+    cout << "," << endl << std::string(indent, ' ') << "out=None";
 
   // Print closing brace for function definition.
   cout << "):" << endl;
@@ -170,6 +183,17 @@ void PrintPYX(const util::BindingDetails& doc,
         NULL);
     cout << endl;
   }
+  if (!outputMatrices.empty())
+  {
+    std::ostringstream oss;
+    oss << " - out (dict): Arrays to write output matrices to, instead of "
+        << "allocating new arrays, keyed by the names of the outputs (";
+    for (size_t i = 0; i < outputMatrices.size(); ++i)
+      oss << ((i == 0) ? "'" : ", '") << outputMatrices[i] << "'";
+    oss << ").  Each array must be writeable and C-contiguous, with the dtype "
+        << "and shape of the output, and is returned in the result.";
+    cout << "  " << util::HyphenateString(oss.str(), 8) << endl;
+  }
   cout << endl;
   cout << "  Output parameters:" << endl;
   cout << endl;
@@ -219,6 +243,30 @@ void PrintPYX(const util::BindingDetails& doc,
         (void*) &indent, NULL);
   }
 
+  // Make output matrices use the memory of any arrays given for them.
+  if (!outputMatrices.empty())
+  {
+    cout << "  if out is not None:" << endl;
+    cout << "    if not isinstance(out, dict):" << endl;
+    cout << "      raise TypeError(\"'out' must have type 'dict'!\")" << endl;
+    cout << "    for name in out:" << endl;
+    cout << "      if name not in [";
+    for (size_t i = 0; i < outputMatrices.size(); ++i)
+      cout << ((i == 0) ? "'" : ", '") << outputMatrices[i] << "'";
+    cout << "]:" << endl;
+    cout << "        raise ValueError(\"'\" + str(name) + \"' is not an output "
+        << "matrix!\")" << endl;
+    for (size_t i = 0; i < outputOptions.size(); ++i)
+    {
+      util::ParamData& d = parameters.at(outputOptions[i]);
+
+      size_t indent = 2;
+      IO::GetSingleton().functionMap[d.tname]["PrintOutputMemory"](d,
+          (void*) &indent, NULL);
+    }
+    cout << endl;
+  }
+
   // Set all output options as passed.
   cout << "  # Mark all output options as passed." << endl;
   for (size_t i = 0; i < outputOptions.size(); ++i)
@@ -241,6 +289,7 @@ void PrintPYX(const util::BindingDetails& doc,
   // Call the method.
   cout << "  # Call the mlpack program." << endl;
   cout << "  mlpackMain()" << endl;
+  cout << "  SaveTrace()" << endl;
 
   // Do any output processing and return.
   cout << "  # Initialize result dictionary." << endl;
@@ -20,6 +20,7 @@
 #include "print_defn.hpp"
 #include "print_doc.hpp"
 #include "print_input_processing.hpp"
+#include "print_output_memory.hpp"
 #include "print_output_processing.hpp"
 #include "import_decl.hpp"
 
@@ -100,6 +101,8 @@ class PyOption
         &PrintOutputProcessing<T>;
     IO::GetSingleton().functionMap[data.tname]["PrintInputProcessing"] =
         &PrintInputProcessing<T>;
+    IO::GetSingleton().functionMap[data.tname]["PrintOutputMemory"] =
+        &PrintOutputMemory<T>;
     IO::GetSingleton().functionMap[data.tname]["ImportDecl"] = &ImportDecl<T>;
 
     // Add the ParamData object, then store.  This is necessary because we may
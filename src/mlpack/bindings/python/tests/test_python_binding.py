@@ -1432,5 +1432,140 @@ class TestPythonBinding(unittest.TestCase):
                                                    matrix_and_info_in=x,
                                                    check_input_matrices=True))
 
+  def testNumpyMatrixView(self):
+    """
+    A C-contiguous view of part of an array should be used without a copy, and
+    give the same results as the array it views.
+    """
+    x = np.random.rand(200, 5)
+    z = copy.deepcopy(x)[50:150]
+    self.assertFalse(z.flags.owndata)
+
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 mat_req_in=[[1.0]],
+                                 col_req_in=[1.0],
+                                 matrix_in=z)
+
+    self.assertEqual(output['matrix_out'].shape[0], 100)
+    self.assertEqual(output['matrix_out'].shape[1], 4)
+    for i in [0, 1, 3]:
+      for j in range(100):
+        self.assertEqual(x[50 + j, i], output['matrix_out'][j, i])
+
+    for j in range(100):
+      self.assertEqual(2 * x[50 + j, 2], output['matrix_out'][j, 2])
+
+  def testReadOnlyMatrix(self):
+    """
+    A read-only array must be copied, and must not be modified.
+    """
+    x = np.random.rand(100, 5)
+    z = copy.deepcopy(x)
+    z.setflags(write=False)
+
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 mat_req_in=[[1.0]],
+                                 col_req_in=[1.0],
+                                 matrix_in=z)
+
+    self.assertTrue((z == x).all())
+    for j in range(100):
+      self.assertEqual(2 * x[j, 2], output['matrix_out'][j, 2])
+
+  def testUnsignedNumpyUmatrix(self):
+    """
+    An unsigned integer array with elements of the same size as np.intp should
+    be accepted as an unsigned matrix.
+    """
+    x = np.random.randint(0, high=500, size=[100, 5]).astype(np.uintp)
+    z = copy.deepcopy(x)
+
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 mat_req_in=[[1.0]],
+                                 col_req_in=[1.0],
+                                 umatrix_in=z)
+
+    self.assertEqual(output['umatrix_out'].shape[0], 100)
+    self.assertEqual(output['umatrix_out'].shape[1], 4)
+    for j in range(100):
+      self.assertEqual(2 * x[j, 2], output['umatrix_out'][j, 2])
+
+  def testPreallocatedOutputs(self):
+    """
+    Output matrices should be written to the arrays given in 'out', and those
+    arrays should be returned.
+    """
+    x = np.random.rand(100, 5)
+    y = np.random.rand(100)
+    matrix_out = np.zeros((100, 4))
+    row_out = np.zeros(100)
+
+    for trial in range(2):
+      output = test_python_binding(string_in='hello',
+                                   int_in=12,
+                                   double_in=4.0,
+                                   mat_req_in=[[1.0]],
+                                   col_req_in=[1.0],
+                                   matrix_in=copy.deepcopy(x),
+                                   row_in=copy.deepcopy(y),
+                                   out={'matrix_out': matrix_out,
+                                        'row_out': row_out})
+
+      self.assertTrue(output['matrix_out'] is matrix_out)
+      self.assertTrue(output['row_out'] is row_out)
+      for i in [0, 1, 3]:
+        for j in range(100):
+          self.assertEqual(x[j, i], matrix_out[j, i])
+      for j in range(100):
+        self.assertEqual(2 * x[j, 2], matrix_out[j, 2])
+        self.assertEqual(2 * y[j], row_out[j])
+
+  def testPreallocatedOutputWrongShape(self):
+    """
+    An output array of the wrong shape should give an error.
+    """
+    x = np.random.rand(100, 5)
+    self.assertRaises(RuntimeError,
+                      lambda : test_python_binding(string_in='hello',
+                                                   int_in=12,
+                                                   double_in=4.0,
+                                                   mat_req_in=[[1.0]],
+                                                   col_req_in=[1.0],
+                                                   matrix_in=x,
+                                                   out={'matrix_out':
+                                                       np.zeros((100, 5))}))
+
+  def testPreallocatedOutputWrongType(self):
+    """
+    Output arrays of the wrong dtype, or for names that are not output
+    matrices, should give errors.
+    """
+    x = np.random.rand(100, 5)
+    self.assertRaises(TypeError,
+                      lambda : test_python_binding(string_in='hello',
+                                                   int_in=12,
+                                                   double_in=4.0,
+                                                   mat_req_in=[[1.0]],
+                                                   col_req_in=[1.0],
+                                                   matrix_in=x,
+                                                   out={'matrix_out':
+                                                       np.zeros((100, 4),
+                                                       dtype=np.float32)}))
+    self.assertRaises(ValueError,
+                      lambda : test_python_binding(string_in='hello',
+                                                   int_in=12,
+                                                   double_in=4.0,
+                                                   mat_req_in=[[1.0]],
+                                                   col_req_in=[1.0],
+                                                   matrix_in=x,
+                                                   out={'string_out':
+                                                       np.zeros((100, 4))}))
+
 if __name__ == '__main__':
   unittest.main()
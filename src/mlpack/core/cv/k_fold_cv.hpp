@@ -44,6 +44,26 @@ namespace cv {
  * the @c Shuffle() function.  Shuffling is performed at construction time if
  * the parameter @c shuffle is set to @c true in the constructor.
  *
+ * Only one copy of the data is held.  By default the folds are run one after
+ * another, and before each fold the columns of the data are rotated in place
+ * so that its training subset and its validation subset are both contiguous
+ * aliases of the data; no fold needs any copy of its own.  If @c Parallel() is
+ * set to @c true, the folds are trained and evaluated concurrently instead,
+ * each with its own model.  The data is then left in place, so the training
+ * subset of each fold (except the first two) is gathered from the two column
+ * ranges around its validation subset; only one such subset is held per
+ * running thread, whatever the value of k.  The score of each fold is the same
+ * in both modes, unless training is random.  In the parallel mode, MLAlgorithm
+ * must be safe to train from many threads at once; each fold draws the numbers
+ * of math::Random() and the like from its own math::RandomStream, so the
+ * scores do not depend on the number of threads.
+ *
+ * @code
+ * KFoldCV<SoftmaxRegression<>, Accuracy> cv(10, data, labels, numClasses);
+ * cv.Parallel() = true;
+ * double softmaxAccuracy = cv.Evaluate(lambda);
+ * @endcode
+ *
  * @tparam MLAlgorithm A machine learning algorithm.
  * @tparam Metric A metric to assess the quality of a trained model.
  * @tparam MatType The type of data.
@@ -177,9 +197,34 @@ class KFoldCV
   template<typename... MLAlgorithmArgs>
   double Evaluate(const MLAlgorithmArgs& ...args);
 
+  /**
+   * Run k-fold cross-validation on only some of the folds; this is a cheaper
+   * estimate of the score that Evaluate() gives.  The folds are run one after
+   * another, and the model of the last one is stored in the given model.
+   * Neither the data nor Model() is changed, so this may be called from many
+   * threads at once (if the training of MLAlgorithm is safe to run
+   * concurrently).  As in Evaluate(), folds with invalid (NaN or infinite)
+   * scores are left out of the average.
+   *
+   * @param budget The proportion (more than 0 and at most 1) of the k folds to
+   *     run; at least one fold is run.
+   * @param model Model to store the model of the last fold in.
+   * @param args Arguments for MLAlgorithm (in addition to the passed
+   *     ones in the constructor).
+   */
+  template<typename... MLAlgorithmArgs>
+  double EvaluateWithBudget(const double budget,
+                            MLAlgorithm& model,
+                            const MLAlgorithmArgs& ...args);
+
   //! Access and modify a model from the last run of k-fold cross-validation.
   MLAlgorithm& Model();
 
+  //! Get whether the folds are trained and evaluated in parallel.
+  bool Parallel() const { return parallel; }
+  //! Modify whether the folds are trained and evaluated in parallel.
+  bool& Parallel() { return parallel; }
+
  private:
   //! A short alias for CVBase.
   using Base = CVBase<MLAlgorithm, MatType, PredictionsType, WeightsType>;
@@ -209,19 +254,25 @@ class KFoldCV
   //! The number of bins in the dataset.
   const size_t k;
 
-  //! The extended (by repeating the first k - 2 bins) data points.
+  //! The data points.
   MatType xs;
-  //! The extended (by repeating the first k - 2 bins) predictions.
+  //! The predictions.
   PredictionsType ys;
-  //! The extended (by repeating the first k - 2 bins) weights.
+  //! The weights.
   WeightsType weights;
 
-  //! The original size of the dataset.
+  //! The size of the last bin in terms of data points.
   size_t lastBinSize;
 
   //! The size of each bin in terms of data points.
   size_t binSize;
 
+  //! The number of columns the data is currently rotated to the left by.
+  size_t rotation;
+
+  //! Whether the folds are trained and evaluated in parallel.
+  bool parallel;
+
   //! A pointer to a model from the last run of k-fold cross-validation.
   std::unique_ptr<MLAlgorithm> modelPtr;
 
@@ -247,11 +298,38 @@ class KFoldCV
           const bool shuffle);
 
   /**
-   * Initialize the given destination matrix with the given source joined with
-   * its first k - 2 bins.
+   * Initialize the sizes of the bins for a dataset with the given number of
+   * points.  An empty dataset is rejected with std::invalid_argument.
    */
-  template<typename DataType>
-  void InitKFoldCVMat(const DataType& source, DataType& destination);
+  void InitBins(const size_t numPoints);
+
+  /**
+   * Train a model on the ith training subset in the case of non-weighted
+   * learning.
+   */
+  template<typename... MLAlgorithmArgs,
+           bool Enabled = !Base::MIE::SupportsWeights,
+           typename = typename std::enable_if<Enabled>::type>
+  MLAlgorithm TrainFold(const size_t i,
+                        const MLAlgorithmArgs& ...mlAlgorithmArgs);
+
+  /**
+   * Train a model on the ith training subset in the case of supporting
+   * weighted learning.
+   */
+  template<typename... MLAlgorithmArgs,
+           bool Enabled = Base::MIE::SupportsWeights,
+           typename = typename std::enable_if<Enabled>::type,
+           typename = void>
+  MLAlgorithm TrainFold(const size_t i,
+                        const MLAlgorithmArgs& ...mlAlgorithmArgs);
+
+  /**
+   * Train and evaluate a model for each fold, serially or in parallel, and
+   * return the score of each fold.  The model of the last fold is kept.
+   */
+  template<typename... MLAlgorithmArgs>
+  arma::vec EvaluateFolds(const MLAlgorithmArgs& ...mlAlgorithmArgs);
 
   /**
    * Train and run evaluation in the case of non-weighted learning.
@@ -271,7 +349,36 @@ class KFoldCV
   double TrainAndEvaluate(const MLAlgorithmArgs& ...mlAlgorithmArgs);
 
   /**
-   * Calculate the index of the first column of the ith validation subset.
+   * Rotate the columns of the data in place, so that they end up rotated to
+   * the left by the given number of columns from their original order.
+   */
+  void RotateTo(const size_t cols);
+
+  /**
+   * Rotate the columns of the given matrix to the left by the given number of
+   * columns.
+   */
+  template<typename DataType>
+  static void RotateColumns(DataType& m, const size_t cols);
+
+  /**
+   * Do nothing; this overload is called for the weights of models that don't
+   * support weighted learning.
+   */
+  static void RotateColumns(void*& /* weights */, const size_t /* cols */) { }
+
+  /**
+   * Calculate the index of the first column of the ith training subset in the
+   * data as it is currently rotated.
+   *
+   * In the original order of the data, the ith training subset starts at the
+   * ith bin and wraps around to the start of the data if i > 1.
+   */
+  inline size_t TrainingSubsetFirstCol(const size_t i);
+
+  /**
+   * Calculate the index of the first column of the ith validation subset in
+   * the data as it is currently rotated.
    *
    * We take the ith validation subset after the ith training subset if
    * i < k - 1 and before it otherwise.
@@ -279,14 +386,16 @@ class KFoldCV
   inline size_t ValidationSubsetFirstCol(const size_t i);
 
   /**
-   * Get the ith training subset from a variable of a matrix type.
+   * Get the ith training subset from a variable of a matrix type.  This is an
+   * alias of the data unless the subset wraps around the end of the data.
    */
   template<typename ElementType>
   inline arma::Mat<ElementType> GetTrainingSubset(arma::Mat<ElementType>& m,
                                                   const size_t i);
 
   /**
-   * Get the ith training subset from a variable of a row type.
+   * Get the ith training subset from a variable of a row type.  This is an
+   * alias of the data unless the subset wraps around the end of the data.
    */
   template<typename ElementType>
   inline arma::Row<ElementType> GetTrainingSubset(arma::Row<ElementType>& r,
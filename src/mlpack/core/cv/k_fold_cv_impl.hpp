@@ -135,15 +135,18 @@ KFoldCV<MLAlgorithm,
                               const PredictionsType& ys,
                               const bool shuffle) :
     base(std::move(base)),
-    k(k)
+    k(k),
+    xs(xs),
+    ys(ys),
+    rotation(0),
+    parallel(false)
 {
   if (k < 2)
     throw std::invalid_argument("KFoldCV: k should not be less than 2");
 
   Base::AssertDataConsistency(xs, ys);
 
-  InitKFoldCVMat(xs, this->xs);
-  InitKFoldCVMat(ys, this->ys);
+  InitBins(xs.n_cols);
 
   // Do we need to shuffle the dataset?
   if (shuffle)
@@ -166,13 +169,16 @@ KFoldCV<MLAlgorithm,
                               const WeightsType& weights,
                               const bool shuffle) :
     base(std::move(base)),
-    k(k)
+    k(k),
+    xs(xs),
+    ys(ys),
+    weights(weights),
+    rotation(0),
+    parallel(false)
 {
   Base::AssertWeightsConsistency(xs, weights);
 
-  InitKFoldCVMat(xs, this->xs);
-  InitKFoldCVMat(ys, this->ys);
-  InitKFoldCVMat(weights, this->weights);
+  InitBins(xs.n_cols);
 
   // Do we need to shuffle the dataset?
   if (shuffle)
@@ -194,6 +200,62 @@ double KFoldCV<MLAlgorithm,
   return TrainAndEvaluate(args...);
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs>
+double KFoldCV<MLAlgorithm,
+               Metric,
+               MatType,
+               PredictionsType,
+               WeightsType>::EvaluateWithBudget(
+    const double budget,
+    MLAlgorithm& model,
+    const MLAlgorithmArgs&... args)
+{
+  if (budget <= 0.0 || budget > 1.0)
+    throw std::invalid_argument("KFoldCV::EvaluateWithBudget(): the budget "
+        "should be more than 0 and at most 1");
+
+  // The data is not rotated here, so the training subsets of all but the
+  // first two folds are gathered rather than aliased.
+  const size_t numFolds = std::max((size_t) 1,
+      (size_t) std::round(budget * k));
+  arma::vec evaluations(numFolds);
+  for (size_t i = 0; i < numFolds; ++i)
+  {
+    MLAlgorithm&& foldModel = TrainFold(i, args...);
+    evaluations(i) = Metric::Evaluate(foldModel, GetValidationSubset(xs, i),
+        GetValidationSubset(ys, i));
+    if (i == numFolds - 1)
+      model = std::move(foldModel);
+  }
+
+  // As in TrainAndEvaluate(), folds with invalid scores are not averaged.
+  size_t numInvalidScores = 0;
+  for (size_t i = 0; i < numFolds; ++i)
+  {
+    if (std::isnan(evaluations(i)) || std::isinf(evaluations(i)))
+    {
+      ++numInvalidScores;
+      Log::Warn << "KFoldCV::EvaluateWithBudget(): fold " << i << " returned "
+          << "a score of " << evaluations(i) << "; ignoring when computing "
+          << "the average score." << std::endl;
+    }
+  }
+
+  if (numInvalidScores == numFolds)
+  {
+    Log::Warn << "KFoldCV::EvaluateWithBudget(): all folds returned invalid "
+        << "scores!  Returning 0.0 as overall score." << std::endl;
+    return 0.0;
+  }
+
+  return arma::mean(evaluations.elem(arma::find_finite(evaluations)));
+}
+
 template<typename MLAlgorithm,
          typename Metric,
          typename MatType,
@@ -217,19 +279,127 @@ template<typename MLAlgorithm,
          typename MatType,
          typename PredictionsType,
          typename WeightsType>
-template<typename DataType>
 void KFoldCV<MLAlgorithm,
              Metric,
              MatType,
              PredictionsType,
-             WeightsType>::InitKFoldCVMat(const DataType& source,
-                                          DataType& destination)
+             WeightsType>::InitBins(const size_t numPoints)
 {
-  binSize = source.n_cols / k;
-  lastBinSize = source.n_cols - ((k - 1) * binSize);
+  // The fold boundaries are taken modulo the number of points.
+  if (numPoints == 0)
+    throw std::invalid_argument("KFoldCV: the dataset should not be empty");
 
-  destination = (k == 2) ? source : arma::join_rows(source,
-      source.cols(0, source.n_cols - lastBinSize - 1));
+  binSize = numPoints / k;
+  lastBinSize = numPoints - ((k - 1) * binSize);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs, bool Enabled, typename>
+MLAlgorithm KFoldCV<MLAlgorithm,
+                    Metric,
+                    MatType,
+                    PredictionsType,
+                    WeightsType>::TrainFold(const size_t i,
+                                            const MLAlgorithmArgs&... args)
+{
+  return base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
+      args...);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs, bool Enabled, typename, typename>
+MLAlgorithm KFoldCV<MLAlgorithm,
+                    Metric,
+                    MatType,
+                    PredictionsType,
+                    WeightsType>::TrainFold(const size_t i,
+                                            const MLAlgorithmArgs&... args)
+{
+  return (weights.n_elem > 0) ?
+      base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
+          GetTrainingSubset(weights, i), args...) :
+      base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
+          args...);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs>
+arma::vec KFoldCV<MLAlgorithm,
+                  Metric,
+                  MatType,
+                  PredictionsType,
+                  WeightsType>::EvaluateFolds(const MLAlgorithmArgs&... args)
+{
+  arma::vec evaluations(k);
+
+  if (!parallel)
+  {
+    for (size_t i = 0; i < k; ++i)
+    {
+      // Rotate the data so that the training subset is at the start and the
+      // validation subset is at the end.
+      RotateTo((i == 0) ? 0 : binSize * i);
+
+      MLAlgorithm&& model = TrainFold(i, args...);
+      evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
+          GetValidationSubset(ys, i));
+      if (i == k - 1)
+        modelPtr.reset(new MLAlgorithm(std::move(model)));
+    }
+
+    RotateTo(0);
+    return evaluations;
+  }
+
+  // Every thread reads the data in its original order.
+  RotateTo(0);
+
+  // Each fold draws from its own random stream, so the results don't depend on
+  // the number of threads.
+  const size_t seed = math::RandomStreamSeed();
+
+  // An exception can't leave the parallel loop, so the first one is kept and
+  // thrown afterwards.
+  std::exception_ptr exception;
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) k; ++i)
+  {
+    try
+    {
+      math::RandomStream stream(seed, i);
+      math::RandomStreamScope scope(stream);
+      MLAlgorithm model = TrainFold(i, args...);
+      evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
+          GetValidationSubset(ys, i));
+      if ((size_t) i == k - 1)
+        modelPtr.reset(new MLAlgorithm(std::move(model)));
+    }
+    catch (...)
+    {
+      #pragma omp critical
+      {
+        if (!exception)
+          exception = std::current_exception();
+      }
+    }
+  }
+
+  if (exception)
+    std::rethrow_exception(exception);
+
+  return evaluations;
 }
 
 template<typename MLAlgorithm,
@@ -244,15 +414,11 @@ double KFoldCV<MLAlgorithm,
                 PredictionsType,
                 WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
 {
-  arma::vec evaluations(k);
+  const arma::vec evaluations = EvaluateFolds(args...);
 
   size_t numInvalidScores = 0;
   for (size_t i = 0; i < k; ++i)
   {
-    MLAlgorithm&& model  = base.Train(GetTrainingSubset(xs, i),
-        GetTrainingSubset(ys, i), args...);
-    evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
-        GetValidationSubset(ys, i));
     if (std::isnan(evaluations(i)) || std::isinf(evaluations(i)))
     {
       ++numInvalidScores;
@@ -260,8 +426,6 @@ double KFoldCV<MLAlgorithm,
           << "a score of " << evaluations(i) << "; ignoring when computing "
           << "the average score." << std::endl;
     }
-    if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
   }
 
   if (numInvalidScores == k)
@@ -286,22 +450,7 @@ double KFoldCV<MLAlgorithm,
                 PredictionsType,
                 WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
 {
-  arma::vec evaluations(k);
-
-  for (size_t i = 0; i < k; ++i)
-  {
-    MLAlgorithm&& model = (weights.n_elem > 0) ?
-        base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
-            GetTrainingSubset(weights, i), args...) :
-        base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
-            args...);
-    evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
-        GetValidationSubset(ys, i));
-    if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
-  }
-
-  return arma::mean(evaluations);
+  return arma::mean(EvaluateFolds(args...));
 }
 
 template<typename MLAlgorithm,
@@ -316,14 +465,10 @@ void KFoldCV<MLAlgorithm,
              PredictionsType,
              WeightsType>::Shuffle()
 {
-  MatType xsOrig = xs.cols(0, (k - 1) * binSize + lastBinSize - 1);
-  PredictionsType ysOrig = ys.cols(0, (k - 1) * binSize + lastBinSize - 1);
+  math::ShuffleData(xs, ys, xs, ys);
 
-  // Now shuffle the data.
-  math::ShuffleData(xsOrig, ysOrig, xsOrig, ysOrig);
-
-  InitKFoldCVMat(xsOrig, xs);
-  InitKFoldCVMat(ysOrig, ys);
+  // Any order of the shuffled data is as good as the original one.
+  rotation = 0;
 }
 
 template<typename MLAlgorithm,
@@ -338,22 +483,69 @@ void KFoldCV<MLAlgorithm,
              PredictionsType,
              WeightsType>::Shuffle()
 {
-  MatType xsOrig = xs.cols(0, (k - 1) * binSize + lastBinSize - 1);
-  PredictionsType ysOrig = ys.cols(0, (k - 1) * binSize + lastBinSize - 1);
-  WeightsType weightsOrig;
   if (weights.n_elem > 0)
-    weightsOrig = weights.cols(0, (k - 1) * binSize + lastBinSize - 1);
-
-  // Now shuffle the data.
-  if (weights.n_elem > 0)
-    math::ShuffleData(xsOrig, ysOrig, weightsOrig, xsOrig, ysOrig, weightsOrig);
+    math::ShuffleData(xs, ys, weights, xs, ys, weights);
   else
-    math::ShuffleData(xsOrig, ysOrig, xsOrig, ysOrig);
+    math::ShuffleData(xs, ys, xs, ys);
 
-  InitKFoldCVMat(xsOrig, xs);
-  InitKFoldCVMat(ysOrig, ys);
-  if (weights.n_elem > 0)
-    InitKFoldCVMat(weightsOrig, weights);
+  // Any order of the shuffled data is as good as the original one.
+  rotation = 0;
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+void KFoldCV<MLAlgorithm,
+             Metric,
+             MatType,
+             PredictionsType,
+             WeightsType>::RotateTo(const size_t cols)
+{
+  const size_t shift = (cols + xs.n_cols - rotation) % xs.n_cols;
+  if (shift == 0)
+    return;
+
+  RotateColumns(xs, shift);
+  RotateColumns(ys, shift);
+  RotateColumns(weights, shift);
+  rotation = cols;
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename DataType>
+void KFoldCV<MLAlgorithm,
+             Metric,
+             MatType,
+             PredictionsType,
+             WeightsType>::RotateColumns(DataType& m, const size_t cols)
+{
+  // The columns are contiguous in memory, so this needs no extra space.
+  if (m.n_elem > 0)
+  {
+    std::rotate(m.memptr(), m.memptr() + cols * m.n_rows,
+        m.memptr() + m.n_elem);
+  }
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+size_t KFoldCV<MLAlgorithm,
+               Metric,
+               MatType,
+               PredictionsType,
+               WeightsType>::TrainingSubsetFirstCol(const size_t i)
+{
+  const size_t firstCol = (i == 0) ? 0 : binSize * i;
+  return (firstCol + xs.n_cols - rotation) % xs.n_cols;
 }
 
 template<typename MLAlgorithm,
@@ -368,7 +560,8 @@ size_t KFoldCV<MLAlgorithm,
                WeightsType>::ValidationSubsetFirstCol(const size_t i)
 {
   // Use as close to the beginning of the dataset as we can.
-  return (i == 0) ? binSize * (k - 1) : binSize * (i - 1);
+  const size_t firstCol = (i == 0) ? binSize * (k - 1) : binSize * (i - 1);
+  return (firstCol + xs.n_cols - rotation) % xs.n_cols;
 }
 
 template<typename MLAlgorithm,
@@ -391,8 +584,17 @@ arma::Mat<ElementType> KFoldCV<MLAlgorithm,
   const size_t subsetSize = (i != 0) ? lastBinSize + (k - 2) * binSize :
       (k - 1) * binSize;
 
-  return arma::Mat<ElementType>(m.colptr(binSize * i), m.n_rows, subsetSize,
-      false, true);
+  const size_t firstCol = TrainingSubsetFirstCol(i);
+  if (firstCol + subsetSize <= m.n_cols)
+  {
+    return arma::Mat<ElementType>(m.colptr(firstCol), m.n_rows, subsetSize,
+        false, true);
+  }
+
+  arma::Mat<ElementType> subset = arma::join_rows(
+      m.cols(firstCol, m.n_cols - 1),
+      m.cols(0, firstCol + subsetSize - m.n_cols - 1));
+  return subset;
 }
 
 template<typename MLAlgorithm,
@@ -415,7 +617,14 @@ arma::Row<ElementType> KFoldCV<MLAlgorithm,
   const size_t subsetSize = (i != 0) ? lastBinSize + (k - 2) * binSize :
       (k - 1) * binSize;
 
-  return arma::Row<ElementType>(r.colptr(binSize * i), subsetSize, false, true);
+  const size_t firstCol = TrainingSubsetFirstCol(i);
+  if (firstCol + subsetSize <= r.n_cols)
+    return arma::Row<ElementType>(r.colptr(firstCol), subsetSize, false, true);
+
+  arma::Row<ElementType> subset = arma::join_rows(
+      r.cols(firstCol, r.n_cols - 1),
+      r.cols(0, firstCol + subsetSize - r.n_cols - 1));
+  return subset;
 }
 
 template<typename MLAlgorithm,
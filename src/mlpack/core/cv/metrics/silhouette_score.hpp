@@ -36,6 +36,14 @@ namespace cv {
  * @f}
  *
  * The Overall Silhouette Score is the mean of individual silhoutte scores.
+ *
+ * When the distances are not precomputed, they are never all held in memory:
+ * the points are taken in blocks, in parallel, and the distances from each
+ * block to the whole dataset are computed one block at a time and summed for
+ * each cluster.  This takes O(n) memory instead of O(n^2).  Euclidean distances
+ * are computed with matrix multiplications.  For very large datasets,
+ * SampledOverall() estimates the overall score from the scores of a random
+ * sample of the points, with a confidence bound.
  */
 class SilhouetteScore
 {
@@ -53,6 +61,33 @@ class SilhouetteScore
                         const arma::Row<size_t>& labels,
                         const Metric& metric);
 
+  /**
+   * Estimate the overall silhouette score as the mean silhouette score of
+   * numSamples points drawn at random without replacement.  The score of each
+   * drawn point is exact, so this takes O(numSamples * n) time.  The estimate
+   * is within the returned bound of the overall score with at least the given
+   * probability; the bound is Hoeffding's, since silhouette scores lie in
+   * [-1, 1].  If numSamples is at least the number of points, the overall
+   * score is computed exactly and the bound is 0.
+   *
+   * @param X Column-major data used for clustering.
+   * @param labels Labels assigned to data by clustering.
+   * @param metric Metric to be used to calculate dissimilarity.
+   * @param numSamples Number of points to draw.
+   * @param bound Variable to store the half-width of the confidence interval
+   *     in.
+   * @param confidence Probability with which the overall score lies in the
+   *     confidence interval (more than 0 and less than 1).
+   * @return (double) estimated silhouette score.
+   */
+  template<typename DataType, typename Metric>
+  static double SampledOverall(const DataType& X,
+                               const arma::Row<size_t>& labels,
+                               const Metric& metric,
+                               const size_t numSamples,
+                               double& bound,
+                               const double confidence = 0.95);
+
   /**
    * Find the individual silhouette scores for precomputted dissimilarites.
    *
@@ -78,6 +113,22 @@ class SilhouetteScore
                                    const arma::Row<size_t>& labels,
                                    const Metric& metric);
 
+  /**
+   * Find silhouette score of the given elements only, with respect to the
+   * whole dataset (distance not precomputed).
+   *
+   * @param X Column-major data used for clustering.
+   * @param labels Labels assigned to data by clustering.
+   * @param points Indices of the elements to score.
+   * @param metric Metric to be used to calculate dissimilarity.
+   * @return (arma::rowvec) silhouette score of each given element.
+   */
+  template<typename DataType, typename Metric>
+  static arma::rowvec SamplesScore(const DataType& X,
+                                   const arma::Row<size_t>& labels,
+                                   const arma::uvec& points,
+                                   const Metric& metric);
+
   /**
    * Find mean distance of element from a given cluster.
    *
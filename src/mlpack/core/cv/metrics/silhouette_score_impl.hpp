@@ -16,6 +16,45 @@
 
 namespace mlpack {
 namespace cv {
+namespace details {
+
+/**
+ * Compute the distances between the given query points and reference points
+ * with the given metric.
+ */
+template<typename QueryType, typename ReferenceType, typename Metric>
+void SilhouetteDistances(const QueryType& queries,
+                         const ReferenceType& references,
+                         const Metric& metric,
+                         arma::Mat<typename QueryType::elem_type>& distances)
+{
+  distances.set_size(queries.n_cols, references.n_cols);
+  for (size_t j = 0; j < references.n_cols; ++j)
+    for (size_t i = 0; i < queries.n_cols; ++i)
+      distances(i, j) = metric.Evaluate(queries.col(i), references.col(j));
+}
+
+/**
+ * Compute the Euclidean distances between the given query points and
+ * reference points as ||q||^2 + ||r||^2 - 2 q^T r, with one matrix
+ * multiplication.
+ */
+template<typename QueryType, typename ReferenceType>
+void SilhouetteDistances(const QueryType& queries,
+                         const ReferenceType& references,
+                         const metric::EuclideanDistance& /* metric */,
+                         arma::Mat<typename QueryType::elem_type>& distances)
+{
+  distances = -2 * (queries.t() * references);
+  distances.each_col() += arma::sum(arma::square(queries), 0).t();
+  distances.each_row() += arma::sum(arma::square(references), 0);
+
+  // Rounding can make the squared distances of close points negative.
+  distances = arma::sqrt(arma::clamp(distances, 0,
+      std::numeric_limits<typename QueryType::elem_type>::max()));
+}
+
+} // namespace details
 
 template<typename DataType, typename Metric>
 double SilhouetteScore::Overall(const DataType& X,
@@ -26,6 +65,42 @@ double SilhouetteScore::Overall(const DataType& X,
   return arma::mean(SamplesScore(X, labels, metric));
 }
 
+template<typename DataType, typename Metric>
+double SilhouetteScore::SampledOverall(const DataType& X,
+                                       const arma::Row<size_t>& labels,
+                                       const Metric& metric,
+                                       const size_t numSamples,
+                                       double& bound,
+                                       const double confidence)
+{
+  util::CheckSameSizes(X, labels, "SilhouetteScore::SampledOverall()");
+  if (numSamples == 0)
+  {
+    throw std::invalid_argument("SilhouetteScore::SampledOverall(): at least "
+        "one point should be sampled");
+  }
+  if (confidence <= 0.0 || confidence >= 1.0)
+  {
+    throw std::invalid_argument("SilhouetteScore::SampledOverall(): the "
+        "confidence should be more than 0 and less than 1");
+  }
+
+  if (numSamples >= X.n_cols)
+  {
+    bound = 0.0;
+    return Overall(X, labels, metric);
+  }
+
+  // Visiting the drawn points in order is kinder to the cache.
+  const arma::uvec points = arma::sort(arma::randperm<arma::uvec>(X.n_cols,
+      numSamples));
+
+  // Hoeffding's inequality also holds for sampling without replacement, and
+  // each score lies in an interval of width 2.
+  bound = std::sqrt(2.0 * std::log(2.0 / (1.0 - confidence)) / numSamples);
+  return arma::mean(SamplesScore(X, labels, points, metric));
+}
+
 template<typename DataType>
 arma::rowvec SilhouetteScore::SamplesScore(const DataType& distances,
                                            const arma::Row<size_t>& labels)
@@ -77,8 +152,100 @@ arma::rowvec SilhouetteScore::SamplesScore(const DataType& X,
                                            const Metric& metric)
 {
   util::CheckSameSizes(X, labels, "SilhouetteScore::SamplesScore()");
-  DataType distances = PairwiseDistances(X, metric);
-  return SamplesScore(distances, labels);
+  if (X.n_cols == 0)
+    return arma::rowvec();
+
+  return SamplesScore(X, labels, arma::regspace<arma::uvec>(0, X.n_cols - 1),
+      metric);
+}
+
+template<typename DataType, typename Metric>
+arma::rowvec SilhouetteScore::SamplesScore(const DataType& X,
+                                           const arma::Row<size_t>& labels,
+                                           const arma::uvec& points,
+                                           const Metric& metric)
+{
+  util::CheckSameSizes(X, labels, "SilhouetteScore::SamplesScore()");
+  using ElemType = typename DataType::elem_type;
+
+  // Number the clusters from 0, and count the elements of each.
+  const arma::Row<size_t> uniqueLabels = arma::unique(labels);
+  const size_t numClusters = uniqueLabels.n_elem;
+  arma::Row<size_t> clusters(labels.n_elem);
+  arma::vec clusterSizes(numClusters, arma::fill::zeros);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+  {
+    clusters[i] = std::lower_bound(uniqueLabels.begin(), uniqueLabels.end(),
+        labels[i]) - uniqueLabels.begin();
+    ++clusterSizes[clusters[i]];
+  }
+
+  // Blocks of this size keep each distance block in the cache.
+  const size_t blockSize = 512;
+  const size_t numBlocks = (points.n_elem + blockSize - 1) / blockSize;
+
+  arma::rowvec sampleScores(points.n_elem);
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    const size_t begin = b * blockSize;
+    const size_t end = std::min((size_t) points.n_elem, begin + blockSize);
+    const arma::uvec blockPoints = points.subvec(begin, end - 1);
+    const arma::Mat<ElemType> queries = X.cols(blockPoints);
+
+    // Sum of the distances from each element of the block to the elements of
+    // each cluster.
+    arma::mat sums(blockPoints.n_elem, numClusters, arma::fill::zeros);
+    arma::Mat<ElemType> distances;
+    for (size_t r = 0; r < X.n_cols; r += blockSize)
+    {
+      const size_t rEnd = std::min((size_t) X.n_cols, r + blockSize);
+      details::SilhouetteDistances(queries, X.cols(r, rEnd - 1), metric,
+          distances);
+
+      // The distance of an element to itself has to be exactly 0.
+      for (size_t i = 0; i < blockPoints.n_elem; ++i)
+        if (blockPoints[i] >= r && blockPoints[i] < rEnd)
+          distances(i, blockPoints[i] - r) = 0;
+
+      for (size_t j = 0; j < distances.n_cols; ++j)
+      {
+        double* clusterSums = sums.colptr(clusters[r + j]);
+        const ElemType* column = distances.colptr(j);
+        for (size_t i = 0; i < distances.n_rows; ++i)
+          clusterSums[i] += column[i];
+      }
+    }
+
+    for (size_t i = 0; i < blockPoints.n_elem; ++i)
+    {
+      const size_t cluster = clusters[blockPoints[i]];
+      const double intraClusterDistance = (clusterSizes[cluster] > 1) ?
+          sums(i, cluster) / (clusterSizes[cluster] - 1) : 0.0;
+      if (intraClusterDistance == 0)
+      {
+        // i is the only element in the cluster.
+        sampleScores[begin + i] = 0.0;
+        continue;
+      }
+
+      double minInterClusterDistance = DBL_MAX;
+      for (size_t c = 0; c < numClusters; ++c)
+      {
+        if (c != cluster)
+        {
+          minInterClusterDistance = std::min(minInterClusterDistance,
+              sums(i, c) / clusterSizes[c]);
+        }
+      }
+
+      sampleScores[begin + i] = (minInterClusterDistance -
+          intraClusterDistance) / std::max(intraClusterDistance,
+          minInterClusterDistance);
+    }
+  }
+
+  return sampleScores;
 }
 
 double SilhouetteScore::MeanDistanceFromCluster(const arma::colvec& distances,
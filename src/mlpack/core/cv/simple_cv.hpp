@@ -208,6 +208,24 @@ class SimpleCV
   template<typename... MLAlgorithmArgs>
   double Evaluate(const MLAlgorithmArgs&... args);
 
+  /**
+   * Train on a part of the training set and assess performance on the whole
+   * validation set; this is a cheaper estimate of the performance that
+   * Evaluate() gives.  The trained model is stored in the given model, and this
+   * object is not changed, so this may be called from many threads at once
+   * (if the training of MLAlgorithm is safe to run concurrently).
+   *
+   * @param budget The proportion (more than 0 and at most 1) of the training
+   *     set to train on; the first points of the training set are taken.
+   * @param model Model to store the trained model in.
+   * @param args Arguments for the given MLAlgorithm taken by its constructor
+   *     (in addition to the passed ones in the SimpleCV constructor).
+   */
+  template<typename... MLAlgorithmArgs>
+  double EvaluateWithBudget(const double budget,
+                            MLAlgorithm& model,
+                            const MLAlgorithmArgs&... args);
+
   //! Access and modify the last trained model.
   MLAlgorithm& Model();
 
@@ -286,21 +304,23 @@ class SimpleCV
                                    const size_t lastCol);
 
   /**
-   * Train and run evaluation in the case of non-weighted learning.
+   * Train on the first numPoints points of the training set in the case of
+   * non-weighted learning.
    */
   template<typename... MLAlgorithmArgs,
            bool Enabled = !Base::MIE::SupportsWeights,
            typename = typename std::enable_if<Enabled>::type>
-  double TrainAndEvaluate(const MLAlgorithmArgs&... args);
+  MLAlgorithm Train(const size_t numPoints, const MLAlgorithmArgs&... args);
 
   /**
-   * Train and run evaluation in the case of supporting weighted learning.
+   * Train on the first numPoints points of the training set in the case of
+   * supporting weighted learning.
    */
   template<typename... MLAlgorithmArgs,
            bool Enabled = Base::MIE::SupportsWeights,
            typename = typename std::enable_if<Enabled>::type,
            typename = void>
-  double TrainAndEvaluate(const MLAlgorithmArgs&... args);
+  MLAlgorithm Train(const size_t numPoints, const MLAlgorithmArgs&... args);
 };
 
 } // namespace cv
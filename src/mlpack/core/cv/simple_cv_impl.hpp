@@ -194,7 +194,35 @@ double SimpleCV<MLAlgorithm,
                 PredictionsType,
                 WeightsType>::Evaluate(const MLAlgorithmArgs&... args)
 {
-  return TrainAndEvaluate(args...);
+  modelPtr.reset(new MLAlgorithm(Train(trainingXs.n_cols, args...)));
+
+  return Metric::Evaluate(*modelPtr, validationXs, validationYs);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs>
+double SimpleCV<MLAlgorithm,
+                Metric,
+                MatType,
+                PredictionsType,
+                WeightsType>::EvaluateWithBudget(
+    const double budget,
+    MLAlgorithm& model,
+    const MLAlgorithmArgs&... args)
+{
+  if (budget <= 0.0 || budget > 1.0)
+    throw std::invalid_argument("SimpleCV::EvaluateWithBudget(): the budget "
+        "should be more than 0 and at most 1");
+
+  const size_t numPoints = std::max((size_t) 1,
+      (size_t) std::round(budget * trainingXs.n_cols));
+  model = Train(numPoints, args...);
+
+  return Metric::Evaluate(model, validationXs, validationYs);
 }
 
 template<typename MLAlgorithm,
@@ -287,15 +315,15 @@ template<typename MLAlgorithm,
          typename PredictionsType,
          typename WeightsType>
 template<typename... MLAlgorithmArgs, bool Enabled, typename>
-double SimpleCV<MLAlgorithm,
-                Metric,
-                MatType,
-                PredictionsType,
-                WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
+MLAlgorithm SimpleCV<MLAlgorithm,
+                     Metric,
+                     MatType,
+                     PredictionsType,
+                     WeightsType>::Train(const size_t numPoints,
+                                         const MLAlgorithmArgs&... args)
 {
-  modelPtr.reset(new MLAlgorithm(base.Train(trainingXs, trainingYs, args...)));
-
-  return Metric::Evaluate(*modelPtr, validationXs, validationYs);
+  return base.Train(GetSubset(trainingXs, 0, numPoints - 1),
+      GetSubset(trainingYs, 0, numPoints - 1), args...);
 }
 
 template<typename MLAlgorithm,
@@ -304,20 +332,22 @@ template<typename MLAlgorithm,
          typename PredictionsType,
          typename WeightsType>
 template<typename... MLAlgorithmArgs, bool Enabled, typename, typename>
-double SimpleCV<MLAlgorithm,
-                Metric,
-                MatType,
-                PredictionsType,
-                WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
+MLAlgorithm SimpleCV<MLAlgorithm,
+                     Metric,
+                     MatType,
+                     PredictionsType,
+                     WeightsType>::Train(const size_t numPoints,
+                                         const MLAlgorithmArgs&... args)
 {
   if (trainingWeights.n_elem > 0)
-    modelPtr.reset(new MLAlgorithm(
-        base.Train(trainingXs, trainingYs, trainingWeights, args...)));
-  else
-    modelPtr.reset(new MLAlgorithm(
-        base.Train(trainingXs, trainingYs, args...)));
+  {
+    return base.Train(GetSubset(trainingXs, 0, numPoints - 1),
+        GetSubset(trainingYs, 0, numPoints - 1),
+        GetSubset(trainingWeights, 0, numPoints - 1), args...);
+  }
 
-  return Metric::Evaluate(*modelPtr, validationXs, validationYs);
+  return base.Train(GetSubset(trainingXs, 0, numPoints - 1),
+      GetSubset(trainingYs, 0, numPoints - 1), args...);
 }
 
 } // namespace cv
@@ -0,0 +1,89 @@
+/**
+ * @file core/data/binary_matrix.cpp
+ *
+ * Reading of the header and DatasetInfo of .mlbin files.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "binary_matrix.hpp"
+
+#include <limits>
+
+namespace mlpack {
+namespace data {
+
+BinaryMatrixHeader ReadBinaryMatrixHeader(const MappedFile& file)
+{
+  const std::string& filename = file.Filename();
+
+  BinaryMatrixHeader header;
+  if (file.Size() < sizeof(BinaryMatrixHeader))
+  {
+    std::ostringstream oss;
+    oss << "'" << filename << "' is too short to be a .mlbin file.";
+    throw std::runtime_error(oss.str());
+  }
+  std::memcpy(&header, file.Data(), sizeof(BinaryMatrixHeader));
+
+  if (std::memcmp(header.magic, "MLPKMAT", 8) != 0)
+  {
+    std::ostringstream oss;
+    oss << "'" << filename << "' is not a .mlbin file.";
+    throw std::runtime_error(oss.str());
+  }
+
+  if (header.byteOrder != 0x01020304)
+  {
+    std::ostringstream oss;
+    oss << "'" << filename << "' was written on a machine with a different "
+        << "byte order.";
+    throw std::runtime_error(oss.str());
+  }
+
+  if (header.version > BinaryMatrixVersion)
+  {
+    std::ostringstream oss;
+    oss << "'" << filename << "' has .mlbin version " << header.version
+        << ", but only versions up to " << BinaryMatrixVersion << " are "
+        << "supported.";
+    throw std::runtime_error(oss.str());
+  }
+
+  const uint64_t size = file.Size();
+  if (header.infoSize > size || header.infoOffset > size - header.infoSize ||
+      header.dataSize > size || header.dataOffset > size - header.dataSize ||
+      header.elemSize == 0 || (header.nCols > 0 && header.nRows >
+      std::numeric_limits<size_t>::max() / header.nCols) ||
+      (header.nRows * header.nCols) != header.dataSize / header.elemSize)
+  {
+    std::ostringstream oss;
+    oss << "'" << filename << "' is truncated or corrupt.";
+    throw std::runtime_error(oss.str());
+  }
+
+  return header;
+}
+
+void ReadBinaryMatrixInfo(const MappedFile& file,
+                          const BinaryMatrixHeader& header,
+                          DatasetInfo& info,
+                          const bool transpose)
+{
+  if (header.infoSize > 0)
+  {
+    std::istringstream infoStream(std::string(file.Data() + header.infoOffset,
+        header.infoSize));
+    cereal::BinaryInputArchive ar(infoStream);
+    ar(cereal::make_nvp("info", info));
+  }
+  else
+  {
+    info.SetDimensionality(transpose ? header.nRows : header.nCols);
+  }
+}
+
+} // namespace data
+} // namespace mlpack
@@ -0,0 +1,201 @@
+/**
+ * @file core/data/binary_matrix.hpp
+ *
+ * mlpack's own binary matrix format (.mlbin).  The file holds a small header,
+ * an optional serialized DatasetInfo, and the matrix itself in column-major
+ * order starting at a page boundary, so that the matrix can be used directly
+ * from a memory mapping of the file without being read or copied.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_BINARY_MATRIX_HPP
+#define MLPACK_CORE_DATA_BINARY_MATRIX_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <memory>
+
+#include "dataset_mapper.hpp"
+#include "mapped_file.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The header at the start of a .mlbin file.  All fields are stored in the byte
+ * order of the machine that wrote the file; byteOrder is used to detect files
+ * written on a machine with a different byte order.
+ *
+ * The matrix is stored as it is seen by mlpack (one point per column) when it
+ * is saved with transpose = true, which is the default.  This means that a
+ * MappedMatrix can alias the mapped memory directly.
+ */
+struct BinaryMatrixHeader
+{
+  //! Always "MLPKMAT" followed by a null character.
+  char magic[8];
+  //! Version of the format.
+  uint32_t version;
+  //! The value 0x01020304, as written by the saving machine.
+  uint32_t byteOrder;
+  //! Kind of element: 0 for unsigned integers, 1 for signed integers, 2 for
+  //! floating point numbers.
+  uint32_t elemKind;
+  //! Size of each element in bytes.
+  uint32_t elemSize;
+  //! Number of rows of the matrix.
+  uint64_t nRows;
+  //! Number of columns of the matrix.
+  uint64_t nCols;
+  //! Offset of the serialized DatasetInfo from the start of the file.
+  uint64_t infoOffset;
+  //! Size of the serialized DatasetInfo in bytes (0 if there is none).
+  uint64_t infoSize;
+  //! Offset of the matrix data from the start of the file (a multiple of
+  //! BinaryMatrixAlignment).
+  uint64_t dataOffset;
+  //! Size of the matrix data in bytes.
+  uint64_t dataSize;
+};
+
+//! Alignment of the matrix data inside a .mlbin file.  This is the page size
+//! on nearly every system, so the data can be mapped page by page.
+static const size_t BinaryMatrixAlignment = 4096;
+
+//! Current version of the .mlbin format.
+static const uint32_t BinaryMatrixVersion = 1;
+
+/**
+ * Save the given matrix to a .mlbin file.  If info is not NULL, it is stored
+ * with the matrix.  Throws a std::runtime_error on failure.
+ *
+ * @param filename Name of file to save to.
+ * @param matrix Matrix to save.
+ * @param info DatasetInfo to store with the matrix (may be NULL).
+ * @param transpose If false, the matrix is transposed before saving.
+ */
+template<typename eT>
+void SaveBinaryMatrix(const std::string& filename,
+                      const arma::Mat<eT>& matrix,
+                      const DatasetInfo* info,
+                      const bool transpose);
+
+/**
+ * Load a matrix from a .mlbin file.  The file is mapped, and its contents are
+ * copied (or converted, if the element type is different) into the memory of
+ * the matrix; the mapping is released before returning.  To use the mapping
+ * directly instead of copying it, see MappedMatrix.  If info is not NULL, it
+ * is filled with the DatasetInfo stored in the file (or, if there is none, set
+ * to the dimensionality of the matrix with all dimensions numeric).  Throws a
+ * std::runtime_error on failure.
+ *
+ * @param filename Name of file to load.
+ * @param matrix Matrix to load into.
+ * @param info DatasetInfo to load into (may be NULL).
+ * @param transpose If false, the matrix is transposed after loading.
+ */
+template<typename eT>
+void LoadBinaryMatrix(const std::string& filename,
+                      arma::Mat<eT>& matrix,
+                      DatasetInfo* info,
+                      const bool transpose);
+
+/**
+ * Read the header of a .mlbin file and check that it is valid for this machine
+ * and consistent with the size of the file.  Throws a std::runtime_error if
+ * not.
+ *
+ * @param file Mapping of the .mlbin file.
+ */
+BinaryMatrixHeader ReadBinaryMatrixHeader(const MappedFile& file);
+
+/**
+ * Fill the given DatasetInfo with the one stored in a .mlbin file.  If there is
+ * none, the DatasetInfo is set to the dimensionality of the matrix, with all
+ * dimensions numeric.
+ *
+ * @param file Mapping of the .mlbin file.
+ * @param header Header of the file, from ReadBinaryMatrixHeader().
+ * @param info DatasetInfo to fill.
+ * @param transpose If false, the matrix is transposed after loading.
+ */
+void ReadBinaryMatrixInfo(const MappedFile& file,
+                          const BinaryMatrixHeader& header,
+                          DatasetInfo& info,
+                          const bool transpose);
+
+/**
+ * A matrix from a .mlbin file that uses a memory mapping of the file instead of
+ * memory of its own: nothing is read until the matrix is accessed, and changes
+ * to the matrix do not change the file.  The mapping is owned by the
+ * MappedMatrix and released when it is destroyed, so the matrix given by
+ * Matrix() must not be used after that.
+ *
+ * The matrix is a strict alias of the mapping (as with the Armadillo
+ * constructor with copy_aux_mem = false and strict = true): it should not be
+ * resized, and copying or moving the matrix itself copies its memory, so that
+ * nothing outside of the MappedMatrix ever points into the mapping.  If
+ * transpose is false or the element type of the file is different, the
+ * contents are converted into memory of the matrix's own instead, as
+ * LoadBinaryMatrix() does, and IsMapped() returns false.
+ *
+ * A MappedMatrix may be moved, which keeps the matrix where it is, but not
+ * copied.
+ */
+template<typename eT>
+class MappedMatrix
+{
+ public:
+  //! Create an empty matrix, with no mapping.
+  MappedMatrix();
+
+  /**
+   * Map the given .mlbin file.  If info is not NULL, it is filled as with
+   * LoadBinaryMatrix().  Throws a std::runtime_error on failure.
+   *
+   * @param filename Name of file to map.
+   * @param info DatasetInfo to load into (may be NULL).
+   * @param transpose If false, the matrix is transposed (and copied).
+   */
+  MappedMatrix(const std::string& filename,
+               DatasetInfo* info = NULL,
+               const bool transpose = true);
+
+  //! Take ownership of the matrix and mapping of another MappedMatrix, which
+  //! is left empty.
+  MappedMatrix(MappedMatrix&& other);
+
+  //! Take ownership of the matrix and mapping of another MappedMatrix, which
+  //! is left empty.
+  MappedMatrix& operator=(MappedMatrix&& other);
+
+  // Copying a mapping is not allowed.
+  MappedMatrix(const MappedMatrix& other) = delete;
+  MappedMatrix& operator=(const MappedMatrix& other) = delete;
+
+  //! Get the matrix.
+  const arma::Mat<eT>& Matrix() const { return *matrix; }
+  //! Modify the elements of the matrix (this never modifies the file).
+  arma::Mat<eT>& Matrix() { return *matrix; }
+
+  //! Return whether the matrix aliases a mapping of the file.
+  bool IsMapped() const { return (file.get() != NULL); }
+
+ private:
+  //! The mapping of the file, if the matrix aliases it.
+  std::unique_ptr<MappedFile> file;
+  //! The matrix.  It is held by pointer so that it stays where it is when the
+  //! MappedMatrix is moved; it is destroyed before the mapping.
+  std::unique_ptr<arma::Mat<eT>> matrix;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "binary_matrix_impl.hpp"
+
+#endif
@@ -0,0 +1,269 @@
+/**
+ * @file core/data/binary_matrix_impl.hpp
+ *
+ * Implementation of loading and saving of .mlbin files.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_BINARY_MATRIX_IMPL_HPP
+#define MLPACK_CORE_DATA_BINARY_MATRIX_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "binary_matrix.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+namespace mlpack {
+namespace data {
+
+namespace details {
+
+//! Return the kind of element stored for eT (see BinaryMatrixHeader).
+template<typename eT>
+inline uint32_t BinaryMatrixElemKind()
+{
+  return std::is_floating_point<eT>::value ? 2 :
+      (std::is_signed<eT>::value ? 1 : 0);
+}
+
+//! Return whether the elements stored in a .mlbin file have type eT.
+template<typename eT>
+inline bool BinaryMatrixSameType(const BinaryMatrixHeader& header)
+{
+  return (header.elemKind == BinaryMatrixElemKind<eT>()) &&
+      (header.elemSize == sizeof(eT));
+}
+
+//! Convert stored elements of type FileT into the given matrix.
+template<typename eT, typename FileT>
+void ConvertBinaryMatrix(char* data,
+                         const BinaryMatrixHeader& header,
+                         arma::Mat<eT>& matrix,
+                         const bool transpose)
+{
+  const arma::Mat<FileT> stored(reinterpret_cast<FileT*>(data), header.nRows,
+      header.nCols, false, true);
+  if (transpose)
+    matrix = arma::conv_to<arma::Mat<eT>>::from(stored);
+  else
+    matrix = arma::conv_to<arma::Mat<eT>>::from(arma::trans(stored));
+}
+
+//! Convert the stored elements, whatever their type, into the given matrix.
+template<typename eT>
+void ConvertBinaryMatrix(char* data,
+                         const BinaryMatrixHeader& header,
+                         arma::Mat<eT>& matrix,
+                         const bool transpose)
+{
+  const uint32_t kind = header.elemKind;
+  const uint32_t size = header.elemSize;
+  if (kind == 0 && size == 1)
+    ConvertBinaryMatrix<eT, arma::u8>(data, header, matrix, transpose);
+  else if (kind == 0 && size == 4)
+    ConvertBinaryMatrix<eT, arma::u32>(data, header, matrix, transpose);
+  else if (kind == 0 && size == 8)
+    ConvertBinaryMatrix<eT, arma::u64>(data, header, matrix, transpose);
+  else if (kind == 1 && size == 4)
+    ConvertBinaryMatrix<eT, arma::s32>(data, header, matrix, transpose);
+  else if (kind == 1 && size == 8)
+    ConvertBinaryMatrix<eT, arma::s64>(data, header, matrix, transpose);
+  else if (kind == 2 && size == 4)
+    ConvertBinaryMatrix<eT, float>(data, header, matrix, transpose);
+  else if (kind == 2 && size == 8)
+    ConvertBinaryMatrix<eT, double>(data, header, matrix, transpose);
+  else
+  {
+    std::ostringstream oss;
+    oss << "LoadBinaryMatrix(): unsupported element type (kind " << kind
+        << ", size " << size << ").";
+    throw std::runtime_error(oss.str());
+  }
+}
+
+} // namespace details
+
+template<typename eT>
+void SaveBinaryMatrix(const std::string& filename,
+                      const arma::Mat<eT>& matrix,
+                      const DatasetInfo* info,
+                      const bool transpose)
+{
+  // Serialize the DatasetInfo first, so we know where the data will start.
+  std::string infoBytes;
+  if (info != NULL)
+  {
+    std::ostringstream infoStream;
+    {
+      cereal::BinaryOutputArchive ar(infoStream);
+      ar(cereal::make_nvp("info", const_cast<DatasetInfo&>(*info)));
+    }
+    infoBytes = infoStream.str();
+  }
+
+  BinaryMatrixHeader header;
+  std::memset(&header, 0, sizeof(BinaryMatrixHeader));
+  std::memcpy(header.magic, "MLPKMAT", 8);
+  header.version = BinaryMatrixVersion;
+  header.byteOrder = 0x01020304;
+  header.elemKind = details::BinaryMatrixElemKind<eT>();
+  header.elemSize = sizeof(eT);
+  header.nRows = transpose ? matrix.n_rows : matrix.n_cols;
+  header.nCols = transpose ? matrix.n_cols : matrix.n_rows;
+  header.infoOffset = sizeof(BinaryMatrixHeader);
+  header.infoSize = infoBytes.size();
+  const uint64_t infoEnd = header.infoOffset + header.infoSize;
+  header.dataOffset = BinaryMatrixAlignment *
+      ((infoEnd + BinaryMatrixAlignment - 1) / BinaryMatrixAlignment);
+  header.dataSize = matrix.n_elem * sizeof(eT);
+
+  // The file may currently be mapped, so we write a new file and move it into
+  // place instead of truncating the old one under the mapping.
+  const std::string tmpFilename = filename + ".tmp";
+  std::ofstream stream(tmpFilename.c_str(), std::ios::out | std::ios::binary |
+      std::ios::trunc);
+  if (!stream.is_open())
+  {
+    std::ostringstream oss;
+    oss << "Cannot open file '" << filename << "' for writing. ";
+    throw std::runtime_error(oss.str());
+  }
+
+  stream.write(reinterpret_cast<const char*>(&header),
+      sizeof(BinaryMatrixHeader));
+  stream.write(infoBytes.data(), infoBytes.size());
+  const std::string padding(header.dataOffset - infoEnd, '\0');
+  stream.write(padding.data(), padding.size());
+
+  if (transpose)
+  {
+    stream.write(reinterpret_cast<const char*>(matrix.memptr()),
+        header.dataSize);
+  }
+  else
+  {
+    // Write the transposed matrix a block of rows at a time, so that we never
+    // need a full transposed copy.
+    const size_t rowBytes = std::max((size_t) 1, matrix.n_cols * sizeof(eT));
+    const size_t blockRows = std::max((size_t) 1, (size_t) (1 << 24) /
+        rowBytes);
+    for (size_t r = 0; r < matrix.n_rows; r += blockRows)
+    {
+      const size_t lastRow = std::min(r + blockRows,
+          (size_t) matrix.n_rows) - 1;
+      const arma::Mat<eT> block = arma::trans(matrix.rows(r, lastRow));
+      stream.write(reinterpret_cast<const char*>(block.memptr()),
+          block.n_elem * sizeof(eT));
+    }
+  }
+
+  stream.close();
+  if (stream.fail())
+  {
+    std::remove(tmpFilename.c_str());
+    std::ostringstream oss;
+    oss << "Error writing to '" << filename << "'. ";
+    throw std::runtime_error(oss.str());
+  }
+
+#ifdef _WIN32
+  // Windows does not allow renaming onto an existing file.
+  std::remove(filename.c_str());
+#endif
+  if (std::rename(tmpFilename.c_str(), filename.c_str()) != 0)
+  {
+    std::remove(tmpFilename.c_str());
+    std::ostringstream oss;
+    oss << "Cannot open file '" << filename << "' for writing. ";
+    throw std::runtime_error(oss.str());
+  }
+}
+
+template<typename eT>
+void LoadBinaryMatrix(const std::string& filename,
+                      arma::Mat<eT>& matrix,
+                      DatasetInfo* info,
+                      const bool transpose)
+{
+  MappedFile file(filename);
+  const BinaryMatrixHeader header = ReadBinaryMatrixHeader(file);
+
+  if (info != NULL)
+    ReadBinaryMatrixInfo(file, header, *info, transpose);
+
+  char* data = file.Data() + header.dataOffset;
+  if (transpose && details::BinaryMatrixSameType<eT>(header))
+  {
+    matrix.set_size(header.nRows, header.nCols);
+    if (header.dataSize > 0)
+      std::memcpy(matrix.memptr(), data, header.dataSize);
+  }
+  else
+  {
+    details::ConvertBinaryMatrix(data, header, matrix, transpose);
+  }
+}
+
+template<typename eT>
+MappedMatrix<eT>::MappedMatrix() : matrix(new arma::Mat<eT>())
+{
+  // Nothing to do.
+}
+
+template<typename eT>
+MappedMatrix<eT>::MappedMatrix(const std::string& filename,
+                               DatasetInfo* info,
+                               const bool transpose)
+{
+  std::unique_ptr<MappedFile> mapped(new MappedFile(filename));
+  const BinaryMatrixHeader header = ReadBinaryMatrixHeader(*mapped);
+
+  if (info != NULL)
+    ReadBinaryMatrixInfo(*mapped, header, *info, transpose);
+
+  char* data = mapped->Data() + header.dataOffset;
+  if (transpose && details::BinaryMatrixSameType<eT>(header) &&
+      header.dataSize > 0)
+  {
+    // Moving the MappedFile does not move the mapping.
+    matrix.reset(new arma::Mat<eT>(reinterpret_cast<eT*>(data), header.nRows,
+        header.nCols, false, true));
+    file = std::move(mapped);
+  }
+  else
+  {
+    matrix.reset(new arma::Mat<eT>());
+    details::ConvertBinaryMatrix(data, header, *matrix, transpose);
+  }
+}
+
+template<typename eT>
+MappedMatrix<eT>::MappedMatrix(MappedMatrix&& other) :
+    file(std::move(other.file)),
+    matrix(std::move(other.matrix))
+{
+  other.matrix.reset(new arma::Mat<eT>());
+}
+
+template<typename eT>
+MappedMatrix<eT>& MappedMatrix<eT>::operator=(MappedMatrix&& other)
+{
+  if (this != &other)
+  {
+    // Drop our matrix before the mapping it may alias.
+    matrix = std::move(other.matrix);
+    file = std::move(other.file);
+    other.matrix.reset(new arma::Mat<eT>());
+  }
+
+  return *this;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,355 @@
+/**
+ * @file core/data/bulk_model.cpp
+ *
+ * Implementation of the archives that write and read bulk model files.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "bulk_model.hpp"
+
+namespace mlpack {
+namespace data {
+
+namespace {
+
+//! Get the value stored in BulkModelSection::compression.
+uint32_t CompressionCode(const Compression compression)
+{
+  if (compression == Compression::gzip)
+    return 1;
+  else if (compression == Compression::zstd)
+    return 2;
+  else
+    return 0;
+}
+
+//! Get the compression from the value stored in BulkModelSection::compression.
+Compression CompressionFromCode(const uint32_t code)
+{
+  if (code == 1)
+    return Compression::gzip;
+  else if (code == 2)
+    return Compression::zstd;
+  else
+    return Compression::none;
+}
+
+/**
+ * Compress the given memory in chunks of BulkModelChunkSize bytes, in parallel,
+ * in the layout of a compressed section.  Returns false if the memory could
+ * not be compressed, or if compression saves less than an eighth of its size.
+ */
+bool CompressChunks(const char* data,
+                    const size_t size,
+                    const Compression compression,
+                    std::string& out)
+{
+  const size_t numChunks = (size + BulkModelChunkSize - 1) /
+      BulkModelChunkSize;
+  std::vector<std::string> chunks(numChunks);
+  std::vector<char> failed(numChunks, 0);
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    const size_t begin = c * BulkModelChunkSize;
+    const size_t length = std::min(BulkModelChunkSize, size - begin);
+    if (!CompressBlock(data + begin, length, compression, chunks[c]))
+      failed[c] = 1;
+  }
+
+  if (std::find(failed.begin(), failed.end(), 1) != failed.end())
+    return false;
+
+  std::vector<uint64_t> table(numChunks + 1);
+  table[0] = numChunks;
+  size_t totalSize = table.size() * sizeof(uint64_t);
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    table[c + 1] = chunks[c].size();
+    totalSize += chunks[c].size();
+  }
+
+  if (totalSize > size - size / 8)
+    return false;
+
+  out.clear();
+  out.reserve(totalSize);
+  out.append(reinterpret_cast<const char*>(table.data()),
+      table.size() * sizeof(uint64_t));
+  for (size_t c = 0; c < numChunks; ++c)
+    out.append(chunks[c]);
+
+  return true;
+}
+
+/**
+ * Decompress a section compressed by CompressChunks() into the given memory,
+ * in parallel.  A std::runtime_error is thrown if the section is corrupt.
+ */
+void DecompressChunks(const std::string& filename,
+                      const char* data,
+                      const size_t size,
+                      const Compression compression,
+                      char* out,
+                      const size_t rawSize)
+{
+  const std::string corrupt = "'" + filename + "' is truncated or corrupt.";
+
+  uint64_t numChunks;
+  if (size < sizeof(uint64_t))
+    throw std::runtime_error(corrupt);
+  std::memcpy(&numChunks, data, sizeof(uint64_t));
+  if (numChunks != (rawSize + BulkModelChunkSize - 1) / BulkModelChunkSize ||
+      numChunks > size / sizeof(uint64_t) - 1)
+    throw std::runtime_error(corrupt);
+
+  // Find where each chunk starts.
+  std::vector<uint64_t> chunkSizes(numChunks);
+  std::memcpy(chunkSizes.data(), data + sizeof(uint64_t),
+      numChunks * sizeof(uint64_t));
+  std::vector<size_t> chunkOffsets(numChunks);
+  size_t pos = (numChunks + 1) * sizeof(uint64_t);
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    if (chunkSizes[c] > size - pos)
+      throw std::runtime_error(corrupt);
+
+    chunkOffsets[c] = pos;
+    pos += chunkSizes[c];
+  }
+
+  // Exceptions can't leave the parallel loop, so we keep their messages.
+  std::vector<std::string> errors(numChunks);
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    const size_t begin = c * BulkModelChunkSize;
+    const size_t length = std::min(BulkModelChunkSize, rawSize - begin);
+    try
+    {
+      DecompressBlock(data + chunkOffsets[c], chunkSizes[c], compression,
+          out + begin, length);
+    }
+    catch (std::exception& e)
+    {
+      errors[c] = e.what();
+    }
+  }
+
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    if (!errors[c].empty())
+      throw std::runtime_error("Cannot load '" + filename + "': " + errors[c]);
+  }
+}
+
+} // namespace
+
+BulkOutputArchive::BulkOutputArchive(std::ostream& stream,
+                                     const Compression compression) :
+    cereal::OutputArchive<BulkOutputArchive,
+        cereal::AllowEmptyClassElision>(this),
+    stream(stream),
+    compression(compression),
+    position(sizeof(BulkModelHeader)),
+    sections(1)
+{
+  // The header is written by Finish(), once we know where the table is.
+  const std::string header(sizeof(BulkModelHeader), '\0');
+  stream.write(header.data(), header.size());
+}
+
+uint64_t BulkOutputArchive::SaveSection(const char* data,
+                                        const size_t size,
+                                        const uint32_t elemKind,
+                                        const uint32_t elemSize)
+{
+  BulkModelSection section = WriteSection(data, size);
+  section.elemKind = elemKind;
+  section.elemSize = elemSize;
+  sections.push_back(section);
+  return sections.size() - 1;
+}
+
+void BulkOutputArchive::Finish()
+{
+  sections[0] = WriteSection(structure.data(), structure.size());
+
+  // The table of sections goes after the last section.
+  BulkModelHeader header;
+  std::memset(&header, 0, sizeof(BulkModelHeader));
+  std::memcpy(header.magic, "MLPKMDL", 8);
+  header.version = BulkModelVersion;
+  header.byteOrder = 0x01020304;
+  header.tableOffset = position;
+  header.numSections = sections.size();
+
+  stream.write(reinterpret_cast<const char*>(sections.data()),
+      sections.size() * sizeof(BulkModelSection));
+  position += sections.size() * sizeof(BulkModelSection);
+
+  stream.seekp(0);
+  stream.write(reinterpret_cast<const char*>(&header),
+      sizeof(BulkModelHeader));
+}
+
+BulkModelSection BulkOutputArchive::WriteSection(const char* data,
+                                                 const size_t size)
+{
+  BulkModelSection section;
+  std::memset(&section, 0, sizeof(BulkModelSection));
+  section.rawSize = size;
+
+  std::string compressed;
+  const bool isCompressed = (compression != Compression::none) &&
+      CompressChunks(data, size, compression, compressed);
+
+  section.offset = BinaryMatrixAlignment *
+      ((position + BinaryMatrixAlignment - 1) / BinaryMatrixAlignment);
+  const std::string padding(section.offset - position, '\0');
+  stream.write(padding.data(), padding.size());
+
+  if (isCompressed)
+  {
+    section.compression = CompressionCode(compression);
+    section.size = compressed.size();
+    stream.write(compressed.data(), compressed.size());
+  }
+  else
+  {
+    section.size = size;
+    stream.write(data, size);
+  }
+
+  position = section.offset + section.size;
+  return section;
+}
+
+BulkInputArchive::BulkInputArchive(const std::string& filename,
+                                   const bool alias) :
+    cereal::InputArchive<BulkInputArchive,
+        cereal::AllowEmptyClassElision>(this),
+    filename(filename),
+    file(filename),
+    data(file.Data()),
+    alias(alias),
+    aliases(0),
+    structure(NULL),
+    structureSize(0),
+    position(0)
+{
+  BulkModelHeader header;
+  if (file.Size() < sizeof(BulkModelHeader))
+  {
+    std::ostringstream oss;
+    oss << "'" << filename << "' is too short to be a bulk model file.";
+    throw std::runtime_error(oss.str());
+  }
+  std::memcpy(&header, file.Data(), sizeof(BulkModelHeader));
+
+  if (std::memcmp(header.magic, "MLPKMDL", 8) != 0)
+  {
+    std::ostringstream oss;
+    oss << "'" << filename << "' is not a bulk model file.";
+    throw std::runtime_error(oss.str());
+  }
+
+  if (header.byteOrder != 0x01020304)
+  {
+    std::ostringstream oss;
+    oss << "'" << filename << "' was written on a machine with a different "
+        << "byte order.";
+    throw std::runtime_error(oss.str());
+  }
+
+  if (header.version > BulkModelVersion)
+  {
+    std::ostringstream oss;
+    oss << "'" << filename << "' has bulk model version " << header.version
+        << ", but only versions up to " << BulkModelVersion << " are "
+        << "supported.";
+    throw std::runtime_error(oss.str());
+  }
+
+  std::ostringstream corrupt;
+  corrupt << "'" << filename << "' is truncated or corrupt.";
+
+  const uint64_t size = file.Size();
+  if (header.numSections == 0 || header.tableOffset > size ||
+      header.numSections > (size - header.tableOffset) /
+      sizeof(BulkModelSection))
+    throw std::runtime_error(corrupt.str());
+
+  sections.resize(header.numSections);
+  std::memcpy(sections.data(), file.Data() + header.tableOffset,
+      sections.size() * sizeof(BulkModelSection));
+  for (size_t i = 0; i < sections.size(); ++i)
+  {
+    const BulkModelSection& section = sections[i];
+    if (section.size > size || section.offset > size - section.size ||
+        section.offset % BinaryMatrixAlignment != 0 ||
+        section.compression > 2 ||
+        (section.compression == 0 && section.size != section.rawSize))
+      throw std::runtime_error(corrupt.str());
+  }
+
+  // Decompress the structure if we need to.
+  if (sections[0].compression == 0)
+  {
+    structure = data + sections[0].offset;
+    structureSize = sections[0].size;
+  }
+  else
+  {
+    decompressed.resize(sections[0].rawSize);
+    ReadSection(sections[0], decompressed.data());
+    structure = decompressed.data();
+    structureSize = decompressed.size();
+  }
+}
+
+void BulkInputArchive::loadBinary(void* out, const size_t size)
+{
+  if (size > structureSize - position)
+  {
+    std::ostringstream oss;
+    oss << "'" << filename << "' is truncated or corrupt.";
+    throw std::runtime_error(oss.str());
+  }
+
+  std::memcpy(out, structure + position, size);
+  position += size;
+}
+
+const BulkModelSection& BulkInputArchive::Section(const uint64_t index) const
+{
+  if (index == 0 || index >= sections.size())
+  {
+    std::ostringstream oss;
+    oss << "'" << filename << "' is corrupt: there is no section " << index
+        << ".";
+    throw std::runtime_error(oss.str());
+  }
+
+  return sections[index];
+}
+
+void BulkInputArchive::ReadSection(const BulkModelSection& section,
+                                   char* out) const
+{
+  if (section.compression == 0)
+  {
+    std::memcpy(out, data + section.offset, section.size);
+  }
+  else
+  {
+    DecompressChunks(filename, data + section.offset, section.size,
+        CompressionFromCode(section.compression), out, section.rawSize);
+  }
+}
+
+} // namespace data
+} // namespace mlpack
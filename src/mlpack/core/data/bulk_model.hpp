@@ -0,0 +1,390 @@
+/**
+ * @file core/data/bulk_model.hpp
+ *
+ * mlpack's bulk model format (.mlpk and .mlpkz).  A model is serialized with
+ * cereal as usual, except that the memory of each large matrix is written as a
+ * raw section of the file that starts at a page boundary.  The serialized
+ * structure of the model only refers to the sections, so it stays small.  When
+ * the model is loaded, uncompressed sections are copied straight from a memory
+ * mapping of the file; in read-only mode, they are instead used directly from
+ * the mapping, so loading a large model reads nearly nothing until the
+ * matrices are used.  In a .mlpkz file, sections may instead be compressed, in
+ * chunks that are compressed and decompressed in parallel.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_BULK_MODEL_HPP
+#define MLPACK_CORE_DATA_BULK_MODEL_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <cereal/cereal.hpp>
+
+#include "binary_matrix.hpp"
+#include "decompress.hpp"
+#include "mapped_file.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The header at the start of a bulk model file.  As with .mlbin files, all
+ * fields are stored in the byte order of the machine that wrote the file.
+ */
+struct BulkModelHeader
+{
+  //! Always "MLPKMDL" followed by a null character.
+  char magic[8];
+  //! Version of the format.
+  uint32_t version;
+  //! The value 0x01020304, as written by the saving machine.
+  uint32_t byteOrder;
+  //! Offset of the table of sections from the start of the file.
+  uint64_t tableOffset;
+  //! Number of sections in the table.
+  uint64_t numSections;
+};
+
+/**
+ * An entry in the table of sections of a bulk model file.  Section 0 holds the
+ * serialized structure of the model; every other section holds the memory of a
+ * matrix.
+ *
+ * A compressed section starts with the number of chunks and the compressed
+ * size of each chunk (all uint64_t), followed by the compressed chunks.  Every
+ * chunk but the last holds BulkModelChunkSize bytes once decompressed.
+ */
+struct BulkModelSection
+{
+  //! Offset of the section from the start of the file (a multiple of
+  //! BinaryMatrixAlignment).
+  uint64_t offset;
+  //! Size of the section in the file in bytes.
+  uint64_t size;
+  //! Size of the section in bytes once decompressed.
+  uint64_t rawSize;
+  //! Compression of the section: 0 for none, 1 for zlib, 2 for zstd.
+  uint32_t compression;
+  //! Kind of element, as in BinaryMatrixHeader (0 for the structure).
+  uint32_t elemKind;
+  //! Size of each element in bytes (0 for the structure).
+  uint32_t elemSize;
+  //! Unused; always 0.
+  uint32_t reserved;
+};
+
+//! Current version of the bulk model format.
+static const uint32_t BulkModelVersion = 1;
+
+//! Matrices whose memory takes at least this many bytes are stored in sections
+//! of their own; smaller matrices are stored inside the structure.
+static const size_t BulkModelSectionThreshold = 4096;
+
+//! Size in bytes of the chunks that compressed sections are split into.
+static const size_t BulkModelChunkSize = 1 << 20;
+
+/**
+ * A cereal archive that writes a bulk model file.  Use SaveBulkModel() instead
+ * of using this directly.
+ */
+class BulkOutputArchive : public cereal::OutputArchive<BulkOutputArchive,
+    cereal::AllowEmptyClassElision>
+{
+ public:
+  /**
+   * Start writing a bulk model to the given stream, which must be at its
+   * beginning.  Call Finish() once the model has been serialized.
+   *
+   * @param stream Binary stream to write to.
+   * @param compression Compression to try for each section (if a section
+   *     does not get at least an eighth smaller, it is stored uncompressed).
+   */
+  BulkOutputArchive(std::ostream& stream, const Compression compression);
+
+  //! Append raw bytes to the serialized structure.
+  void saveBinary(const void* data, const size_t size)
+  {
+    structure.append(static_cast<const char*>(data), size);
+  }
+
+  /**
+   * Write the given memory to the file as a new section, and return the index
+   * of the section.
+   */
+  uint64_t SaveSection(const char* data,
+                       const size_t size,
+                       const uint32_t elemKind,
+                       const uint32_t elemSize);
+
+  //! Write the structure, the table of sections, and the header.
+  void Finish();
+
+ private:
+  //! Write the given memory at the next aligned position as a section.
+  BulkModelSection WriteSection(const char* data, const size_t size);
+
+  //! The stream to write to.
+  std::ostream& stream;
+  //! Compression to try for each section.
+  Compression compression;
+  //! Current position in the stream.
+  uint64_t position;
+  //! The serialized structure of the model.
+  std::string structure;
+  //! The table of sections; the entry for the structure is set by Finish().
+  std::vector<BulkModelSection> sections;
+};
+
+/**
+ * A cereal archive that reads a bulk model file.  Use LoadBulkModel() instead
+ * of using this directly.
+ */
+class BulkInputArchive : public cereal::InputArchive<BulkInputArchive,
+    cereal::AllowEmptyClassElision>
+{
+ public:
+  /**
+   * Open the given bulk model file and check its header and table of sections.
+   * A std::runtime_error is thrown if the file cannot be read or is not a
+   * valid bulk model file.
+   *
+   * @param filename Name of file to load.
+   * @param alias Whether matrices should alias uncompressed sections of the
+   *     mapping of the file instead of copying them (see LoadBulkModel()).
+   */
+  BulkInputArchive(const std::string& filename, const bool alias = false);
+
+  //! Read raw bytes from the serialized structure.
+  void loadBinary(void* out, const size_t size);
+
+  /**
+   * Load the given section into a matrix of the given size.  If aliasing was
+   * asked for, an uncompressed section becomes a strict alias of the mapping
+   * of the file; otherwise, the section is copied or decompressed into the
+   * memory of the matrix.
+   */
+  template<typename eT>
+  void LoadSection(const uint64_t index,
+                   const size_t nRows,
+                   const size_t nCols,
+                   arma::Mat<eT>& matrix);
+
+  //! Get the number of matrices that alias the mapping of the file.
+  size_t Aliases() const { return aliases; }
+
+  //! Modify the mapping of the file (e.g. to take ownership of it).
+  MappedFile& File() { return file; }
+
+ private:
+  //! Get the given section, checking that it is the section of a matrix.
+  const BulkModelSection& Section(const uint64_t index) const;
+
+  //! Copy or decompress the given section into the given memory.
+  void ReadSection(const BulkModelSection& section, char* out) const;
+
+  //! Name of the file.
+  std::string filename;
+  //! The mapping of the file.
+  MappedFile file;
+  //! Start of the contents of the file.
+  char* data;
+  //! Whether matrices should alias uncompressed sections.
+  bool alias;
+  //! Number of matrices that alias the mapping of the file.
+  size_t aliases;
+  //! The table of sections.
+  std::vector<BulkModelSection> sections;
+  //! The decompressed structure, if the structure is compressed.
+  std::vector<char> decompressed;
+  //! Start of the serialized structure.
+  const char* structure;
+  //! Size of the serialized structure.
+  size_t structureSize;
+  //! Position of the next byte to read from the structure.
+  size_t position;
+};
+
+/**
+ * Save the given model to a bulk model file.  If compress is true, sections
+ * are compressed with zstd or zlib, if mlpack was compiled with either;
+ * otherwise, they are stored uncompressed.  Throws a std::runtime_error or a
+ * cereal::Exception on failure.
+ *
+ * @param filename Name of file to save to.
+ * @param name Name of the model.
+ * @param t Model to save.
+ * @param compress Whether to compress the sections.
+ */
+template<typename T>
+void SaveBulkModel(const std::string& filename,
+                   const std::string& name,
+                   T& t,
+                   const bool compress);
+
+/**
+ * Load the given model from a bulk model file.  Every matrix of the model gets
+ * memory of its own, so the model may be used, moved and retrained like any
+ * other.  Throws a std::runtime_error or a cereal::Exception on failure.
+ *
+ * @param filename Name of file to load.
+ * @param name Name of the model.
+ * @param t Model to load into.
+ */
+template<typename T>
+void LoadBulkModel(const std::string& filename,
+                   const std::string& name,
+                   T& t);
+
+/**
+ * Load the given model from a bulk model file in read-only mode: large
+ * matrices in uncompressed sections become strict aliases of a memory mapping
+ * of the file (see MappedMatrix) instead of being copied, so nothing is read
+ * until they are used.  Changes to their elements do not change the file.
+ *
+ * The mapping is handed to `mapping`, which owns it from then on (it is set
+ * to NULL if no matrix aliases the file).  The model must not be used once
+ * `mapping` is destroyed, and it should not be retrained or loaded into
+ * again, since its aliased matrices can't be resized.  Throws a
+ * std::runtime_error or a cereal::Exception on failure.
+ *
+ * @param filename Name of file to load.
+ * @param name Name of the model.
+ * @param t Model to load into.
+ * @param mapping Set to the mapping that the matrices of the model alias.
+ */
+template<typename T>
+void LoadBulkModel(const std::string& filename,
+                   const std::string& name,
+                   T& t,
+                   std::unique_ptr<MappedFile>& mapping);
+
+} // namespace data
+} // namespace mlpack
+
+namespace cereal {
+
+//! Save arithmetic types as raw bytes.
+template<typename T>
+inline typename std::enable_if<std::is_arithmetic<T>::value>::type
+CEREAL_SAVE_FUNCTION_NAME(mlpack::data::BulkOutputArchive& ar, const T& t)
+{
+  ar.saveBinary(std::addressof(t), sizeof(t));
+}
+
+//! Load arithmetic types from raw bytes.
+template<typename T>
+inline typename std::enable_if<std::is_arithmetic<T>::value>::type
+CEREAL_LOAD_FUNCTION_NAME(mlpack::data::BulkInputArchive& ar, T& t)
+{
+  ar.loadBinary(std::addressof(t), sizeof(t));
+}
+
+//! Names are not stored.
+template<typename Archive, typename T>
+inline CEREAL_ARCHIVE_RESTRICT(mlpack::data::BulkInputArchive,
+                               mlpack::data::BulkOutputArchive)
+CEREAL_SERIALIZE_FUNCTION_NAME(Archive& ar, NameValuePair<T>& t)
+{
+  ar(t.value);
+}
+
+//! Sizes are stored like any other number.
+template<typename Archive, typename T>
+inline CEREAL_ARCHIVE_RESTRICT(mlpack::data::BulkInputArchive,
+                               mlpack::data::BulkOutputArchive)
+CEREAL_SERIALIZE_FUNCTION_NAME(Archive& ar, SizeTag<T>& t)
+{
+  ar(t.size);
+}
+
+//! Save binary data as raw bytes.
+template<typename T>
+inline void CEREAL_SAVE_FUNCTION_NAME(mlpack::data::BulkOutputArchive& ar,
+                                      const BinaryData<T>& bd)
+{
+  ar.saveBinary(bd.data, (size_t) bd.size);
+}
+
+//! Load binary data from raw bytes.
+template<typename T>
+inline void CEREAL_LOAD_FUNCTION_NAME(mlpack::data::BulkInputArchive& ar,
+                                      BinaryData<T>& bd)
+{
+  ar.loadBinary(bd.data, (size_t) bd.size);
+}
+
+/**
+ * Save a matrix to a bulk model file.  This is more specialized than the
+ * serialize() function for all archives in serialize_armadillo.hpp, so it is
+ * used instead of it.
+ */
+template<typename eT>
+void serialize(mlpack::data::BulkOutputArchive& ar, arma::Mat<eT>& mat)
+{
+  arma::uword n_rows = mat.n_rows;
+  arma::uword n_cols = mat.n_cols;
+  arma::uword vec_state = mat.vec_state;
+
+  ar(CEREAL_NVP(n_rows));
+  ar(CEREAL_NVP(n_cols));
+  ar(CEREAL_NVP(vec_state));
+
+  // The memory of large matrices goes in a section of its own; section 0 means
+  // that the memory is stored inside the structure.
+  uint64_t section = 0;
+  const size_t bytes = mat.n_elem * sizeof(eT);
+  if (std::is_arithmetic<eT>::value &&
+      bytes >= mlpack::data::BulkModelSectionThreshold)
+  {
+    section = ar.SaveSection(reinterpret_cast<const char*>(mat.memptr()),
+        bytes, mlpack::data::details::BinaryMatrixElemKind<eT>(), sizeof(eT));
+  }
+  ar(CEREAL_NVP(section));
+
+  if (section == 0)
+    SerializeMemory(ar, mat.memptr(), mat.n_elem, "elem");
+}
+
+/**
+ * Load a matrix from a bulk model file.  This is more specialized than the
+ * serialize() function for all archives in serialize_armadillo.hpp, so it is
+ * used instead of it.
+ */
+template<typename eT>
+void serialize(mlpack::data::BulkInputArchive& ar, arma::Mat<eT>& mat)
+{
+  arma::uword n_rows, n_cols, vec_state;
+  uint64_t section;
+
+  ar(CEREAL_NVP(n_rows));
+  ar(CEREAL_NVP(n_cols));
+  ar(CEREAL_NVP(vec_state));
+  ar(CEREAL_NVP(section));
+
+  if (section == 0)
+  {
+    mat.set_size(n_rows, n_cols);
+    SerializeMemory(ar, mat.memptr(), mat.n_elem, "elem");
+  }
+  else
+  {
+    ar.LoadSection(section, n_rows, n_cols, mat);
+  }
+
+  arma::access::rw(mat.vec_state) = vec_state;
+}
+
+} // namespace cereal
+
+CEREAL_REGISTER_ARCHIVE(mlpack::data::BulkOutputArchive)
+CEREAL_REGISTER_ARCHIVE(mlpack::data::BulkInputArchive)
+CEREAL_SETUP_ARCHIVE_TRAITS(mlpack::data::BulkInputArchive,
+                            mlpack::data::BulkOutputArchive)
+
+// Include implementation.
+#include "bulk_model_impl.hpp"
+
+#endif
@@ -0,0 +1,149 @@
+/**
+ * @file core/data/bulk_model_impl.hpp
+ *
+ * Implementation of loading and saving of bulk model files.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_BULK_MODEL_IMPL_HPP
+#define MLPACK_CORE_DATA_BULK_MODEL_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "bulk_model.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+namespace mlpack {
+namespace data {
+
+template<typename eT>
+void BulkInputArchive::LoadSection(const uint64_t index,
+                                   const size_t nRows,
+                                   const size_t nCols,
+                                   arma::Mat<eT>& matrix)
+{
+  const BulkModelSection& section = Section(index);
+  if (section.elemKind != details::BinaryMatrixElemKind<eT>() ||
+      section.elemSize != sizeof(eT) ||
+      section.rawSize != nRows * nCols * sizeof(eT))
+  {
+    std::ostringstream oss;
+    oss << "'" << filename << "' is corrupt: section " << index << " does "
+        << "not match the matrix that refers to it.";
+    throw std::runtime_error(oss.str());
+  }
+
+  // Matrices that use memory they can't let go of (like fixed-size matrices)
+  // get a copy instead of an alias.
+  if (alias && section.compression == 0 && matrix.mem_state <= 1)
+  {
+    // Make the matrix a strict alias of the mapping, as MappedMatrix does: the
+    // matrix never frees the memory, and moves and copies of it copy the
+    // memory instead of taking the alias along.
+    matrix.reset();
+    arma::access::rw(matrix.n_rows) = nRows;
+    arma::access::rw(matrix.n_cols) = nCols;
+    arma::access::rw(matrix.n_elem) = nRows * nCols;
+    arma::access::rw(matrix.mem_state) = 2;
+    arma::access::rw(matrix.mem) = reinterpret_cast<eT*>(data +
+        section.offset);
+    #if ARMA_VERSION_MAJOR >= 10
+      arma::access::rw(matrix.n_alloc) = 0;
+    #endif
+
+    ++aliases;
+  }
+  else
+  {
+    matrix.set_size(nRows, nCols);
+    ReadSection(section, reinterpret_cast<char*>(matrix.memptr()));
+  }
+}
+
+template<typename T>
+void SaveBulkModel(const std::string& filename,
+                   const std::string& name,
+                   T& t,
+                   const bool compress)
+{
+  // As with .mlbin files, the file may currently be mapped, so we write a new
+  // file and move it into place.
+  const std::string tmpFilename = filename + ".tmp";
+  std::ofstream stream(tmpFilename.c_str(), std::ios::out | std::ios::binary |
+      std::ios::trunc);
+  if (!stream.is_open())
+  {
+    std::ostringstream oss;
+    oss << "Cannot open file '" << filename << "' for writing. ";
+    throw std::runtime_error(oss.str());
+  }
+
+  try
+  {
+    BulkOutputArchive ar(stream, compress ? BlockCompression() :
+        Compression::none);
+    ar(cereal::make_nvp(name.c_str(), t));
+    ar.Finish();
+  }
+  catch (...)
+  {
+    stream.close();
+    std::remove(tmpFilename.c_str());
+    throw;
+  }
+
+  stream.close();
+  if (stream.fail())
+  {
+    std::remove(tmpFilename.c_str());
+    std::ostringstream oss;
+    oss << "Error writing to '" << filename << "'. ";
+    throw std::runtime_error(oss.str());
+  }
+
+#ifdef _WIN32
+  // Windows does not allow renaming onto an existing file.
+  std::remove(filename.c_str());
+#endif
+  if (std::rename(tmpFilename.c_str(), filename.c_str()) != 0)
+  {
+    std::remove(tmpFilename.c_str());
+    std::ostringstream oss;
+    oss << "Cannot open file '" << filename << "' for writing. ";
+    throw std::runtime_error(oss.str());
+  }
+}
+
+template<typename T>
+void LoadBulkModel(const std::string& filename,
+                   const std::string& name,
+                   T& t)
+{
+  BulkInputArchive ar(filename);
+  ar(cereal::make_nvp(name.c_str(), t));
+}
+
+template<typename T>
+void LoadBulkModel(const std::string& filename,
+                   const std::string& name,
+                   T& t,
+                   std::unique_ptr<MappedFile>& mapping)
+{
+  BulkInputArchive ar(filename, true);
+  ar(cereal::make_nvp(name.c_str(), t));
+
+  // Moving the MappedFile does not move the mapping, so the aliases stay valid.
+  if (ar.Aliases() > 0)
+    mapping.reset(new MappedFile(std::move(ar.File())));
+  else
+    mapping.reset();
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
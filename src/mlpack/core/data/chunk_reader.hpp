@@ -0,0 +1,247 @@
+/**
+ * @file core/data/chunk_reader.hpp
+ *
+ * Definition of the ChunkReader class, which reads a dataset from disk a block
+ * of points at a time, so that datasets larger than memory can be processed.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CHUNK_READER_HPP
+#define MLPACK_CORE_DATA_CHUNK_READER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <future>
+
+#include "dataset_mapper.hpp"
+#include "load_csv.hpp"
+#include "load_arff.hpp"
+#include "libsvm.hpp"
+#include "binary_matrix.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The ChunkReader reads a dataset a block of points at a time, instead of
+ * loading the whole matrix as data::Load() does.  Each call to Next() gives
+ * the next (at most) chunkSize points, one point per column; after the last
+ * chunk, Reset() starts another pass over the file.  This is meant for
+ * algorithms that only need to stream over the data once or a few times, such
+ * as mini-batch k-means or the PartialFit() methods of the scalers.
+ *
+ * The supported formats are:
+ *
+ *  - CSV, denoted by .csv
+ *  - TSV, denoted by .tsv
+ *  - ASCII (space-separated), denoted by .txt
+ *  - ARFF, denoted by .arff
+ *  - libsvm, denoted by .svm, .libsvm or .svmlight
+ *  - mlpack binary, denoted by .mlbin
+ *
+ * Any of these may be compressed with gzip or zstd (e.g. data.csv.gz); a
+ * compressed text file is decompressed as it is read, while a compressed
+ * .mlbin file is decompressed into memory.  A std::runtime_error is thrown if a
+ * compressed file turns out to be corrupt or truncated.
+ *
+ * Categorical dimensions are mapped with the given DatasetMapper, exactly as
+ * data::Load() would map them.  Because the type of each dimension must be
+ * known before the first chunk is returned, the constructor takes one pass over
+ * a text file to find the types (this pass is skipped if the DatasetMapper
+ * already has the right dimensionality, in which case its types are used as
+ * they are).  The types never change after that: Next() throws a
+ * std::runtime_error if a numeric dimension holds a value that is not a
+ * number.  The mappings of a chunk are never changed by later chunks, and
+ * every pass gives the same values.
+ *
+ * ARFF files are parsed as data::Load() parses them: the types of the
+ * dimensions and the listed categories come from the header, which is read by
+ * the constructor.  The points of a libsvm file are returned as dense columns,
+ * so the chunk size should take the dimensionality into account; the
+ * dimensionality is the largest index in the file (or that of the given
+ * DatasetMapper, if it is larger), and the indices are 0-based if the index 0
+ * appears anywhere in the file, as with LoadLibSVM().  The labels of a libsvm
+ * file are given by the overload of Next() that takes labels.
+ *
+ * With read-ahead enabled, the lines of the next chunk of a text file are read
+ * from disk by a background thread while the caller works on the current
+ * chunk; only the parsing happens in Next().  The DatasetMapper is only ever
+ * touched from Next() and the constructor.  .mlbin files are memory-mapped, so
+ * the operating system takes care of reading ahead for them.
+ *
+ * A simple use that computes the mean of a dataset is:
+ *
+ * @code
+ * data::DatasetInfo info;
+ * data::ChunkReader<> reader("dataset.csv", 10000, info);
+ *
+ * arma::mat chunk;
+ * arma::vec sum(reader.Dimensionality(), arma::fill::zeros);
+ * while (reader.Next(chunk))
+ *   sum += arma::sum(chunk, 1);
+ *
+ * arma::vec mean = sum / reader.NumPoints();
+ * @endcode
+ *
+ * All errors are reported by throwing std::runtime_error (or
+ * std::invalid_argument, if the DatasetMapper has the wrong dimensionality).
+ *
+ * @tparam eT Element type of the chunks.
+ * @tparam PolicyType Mapping policy of the DatasetMapper.
+ */
+template<typename eT = double, typename PolicyType = IncrementPolicy>
+class ChunkReader
+{
+ public:
+  /**
+   * Open the given file for reading in chunks.  For text files, this takes one
+   * pass over the file to find the number of points and (if needed) the type
+   * of each dimension.
+   *
+   * @param filename Name of the file to read.
+   * @param chunkSize Maximum number of points in each chunk.
+   * @param info DatasetMapper to map categorical dimensions with; it must stay
+   *     alive as long as the ChunkReader.
+   * @param readAhead If true, read the next chunk in the background.
+   */
+  ChunkReader(const std::string& filename,
+              const size_t chunkSize,
+              DatasetMapper<PolicyType>& info,
+              const bool readAhead = true);
+
+  //! Wait for any background read and release the file.
+  ~ChunkReader();
+
+  /**
+   * Get the next chunk of points into the given matrix, which will have
+   * Dimensionality() rows and at most ChunkSize() columns.  Returns false (and
+   * leaves the matrix empty) once all points of this pass have been returned.
+   *
+   * @param chunk Matrix to store the chunk in.
+   * @return Whether there were any points left to read.
+   */
+  bool Next(arma::Mat<eT>& chunk);
+
+  /**
+   * Get the next chunk of points and their labels, as with Next(chunk).  Only
+   * libsvm files hold labels; a std::runtime_error is thrown for other files.
+   *
+   * @param chunk Matrix to store the chunk in.
+   * @param labels Row vector to store the labels of the chunk in.
+   * @return Whether there were any points left to read.
+   */
+  template<typename LabelType>
+  bool Next(arma::Mat<eT>& chunk, arma::Row<LabelType>& labels);
+
+  //! Start a new pass over the data from the first point.
+  void Reset();
+
+  //! Get the dimensionality of the points.
+  size_t Dimensionality() const { return dimensionality; }
+  //! Get the total number of points in the file.
+  size_t NumPoints() const { return numPoints; }
+  //! Get the number of points returned so far in this pass.
+  size_t Position() const { return position; }
+  //! Get the maximum number of points in each chunk.
+  size_t ChunkSize() const { return chunkSize; }
+  //! Get the DatasetMapper used for categorical dimensions.
+  const DatasetMapper<PolicyType>& Info() const { return info; }
+
+ private:
+  // Copying a reader is not allowed.
+  ChunkReader(const ChunkReader& other);
+  ChunkReader& operator=(const ChunkReader& other);
+
+  //! The kinds of text files that can be read.
+  enum class TextFormat
+  {
+    delimited,
+    arff,
+    libsvm
+  };
+
+  //! Take a pass over a text file to find its size and dimension types.
+  void ScanText();
+
+  //! Read the header of an ARFF file, and take a pass over its data.
+  void ScanARFF();
+
+  //! Take a pass over a libsvm file to find its size and dimensionality.
+  void ScanLibSVM();
+
+  //! Return whether the given line of a text file holds a point.
+  bool IsPointLine(const std::string& line) const;
+
+  //! Read the raw lines of the next chunk of a text file into the given list.
+  void ReadLines(std::vector<std::string>& lines);
+
+  //! Get the lines of the next chunk of a text file, read ahead or not.
+  void NextLines(std::vector<std::string>& lines);
+
+  //! Start reading the next chunk of lines in the background.
+  void StartReadAhead();
+
+  //! Wait for the background read, if any, to finish.
+  void WaitReadAhead();
+
+  //! Parse the given lines into a chunk.
+  void ParseLines(const std::vector<std::string>& lines, arma::Mat<eT>& chunk);
+
+  //! Parse the given lines of a libsvm file into a chunk and its labels.
+  template<typename LabelType>
+  void ParseLibSVMLines(const std::vector<std::string>& lines,
+                        arma::Mat<eT>& chunk,
+                        arma::Row<LabelType>& labels);
+
+  //! Take the next chunk from the .mlbin mapping.
+  void NextBinary(arma::Mat<eT>& chunk);
+
+  //! Name of the file.
+  std::string filename;
+  //! Maximum number of points in each chunk.
+  size_t chunkSize;
+  //! DatasetMapper for categorical dimensions.
+  DatasetMapper<PolicyType>& info;
+  //! Whether to read the next chunk in the background.
+  bool readAhead;
+
+  //! Dimensionality of the points.
+  size_t dimensionality;
+  //! Number of points in the file.
+  size_t numPoints;
+  //! Number of points returned so far in this pass.
+  size_t position;
+
+  //! Kind of text file.
+  TextFormat textFormat;
+  //! Tokenizer for delimited text files (NULL for other files).
+  LoadCSV* loader;
+  //! Stream for text files (NULL for .mlbin files).
+  InputFile* stream;
+  //! Number of lines before the data of an ARFF file.
+  size_t headerLines;
+  //! Categories listed in the header of an ARFF file, by dimension.
+  std::map<size_t, std::vector<std::string>> categoryStrings;
+  //! Whether the indices of a libsvm file are 0-based.
+  bool zeroBased;
+  //! Lines of the next chunk, read ahead of time.
+  std::vector<std::string> nextLines;
+  //! Background read of nextLines, if one is running.
+  std::future<void> pending;
+
+  //! Mapping of a .mlbin file (NULL for text files).
+  MappedFile* mappedFile;
+  //! Header of the .mlbin file.
+  BinaryMatrixHeader header;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "chunk_reader_impl.hpp"
+
+#endif
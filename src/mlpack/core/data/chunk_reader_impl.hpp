@@ -0,0 +1,575 @@
+/**
+ * @file core/data/chunk_reader_impl.hpp
+ *
+ * Implementation of the ChunkReader class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CHUNK_READER_IMPL_HPP
+#define MLPACK_CORE_DATA_CHUNK_READER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "chunk_reader.hpp"
+#include "parse_number.hpp"
+
+namespace mlpack {
+namespace data {
+
+namespace details {
+
+//! Check that the given DatasetMapper fits a file with the given
+//! dimensionality, and throw if not.  Returns whether the mapper is empty.
+template<typename PolicyType>
+bool CheckChunkReaderInfo(const DatasetMapper<PolicyType>& info,
+                          const size_t dimensionality)
+{
+  if (info.Dimensionality() != 0 && info.Dimensionality() != dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "data::ChunkReader(): given DatasetInfo has dimensionality "
+        << info.Dimensionality() << ", but data has dimensionality "
+        << dimensionality;
+    throw std::invalid_argument(oss.str());
+  }
+
+  return (info.Dimensionality() == 0);
+}
+
+//! Use the DatasetInfo stored in a .mlbin file, if the given one is empty.
+inline void ReadChunkReaderInfo(const MappedFile& file,
+                                const BinaryMatrixHeader& header,
+                                DatasetInfo& info)
+{
+  if (CheckChunkReaderInfo(info, header.nRows))
+    ReadBinaryMatrixInfo(file, header, info, true);
+}
+
+//! Other kinds of DatasetMapper are not stored in .mlbin files, so only the
+//! dimensionality can be set.
+template<typename PolicyType>
+void ReadChunkReaderInfo(const MappedFile& /* file */,
+                         const BinaryMatrixHeader& header,
+                         DatasetMapper<PolicyType>& info)
+{
+  if (CheckChunkReaderInfo(info, header.nRows))
+    info.SetDimensionality(header.nRows);
+}
+
+} // namespace details
+
+template<typename eT, typename PolicyType>
+ChunkReader<eT, PolicyType>::ChunkReader(const std::string& filename,
+                                         const size_t chunkSize,
+                                         DatasetMapper<PolicyType>& info,
+                                         const bool readAhead) :
+    filename(filename),
+    chunkSize(chunkSize),
+    info(info),
+    readAhead(readAhead),
+    dimensionality(0),
+    numPoints(0),
+    position(0),
+    textFormat(TextFormat::delimited),
+    loader(NULL),
+    stream(NULL),
+    headerLines(0),
+    zeroBased(false),
+    mappedFile(NULL)
+{
+  if (chunkSize == 0)
+  {
+    throw std::invalid_argument("ChunkReader::ChunkReader(): chunkSize must "
+        "be positive!");
+  }
+
+  const std::string extension = UncompressedExtension(filename);
+  try
+  {
+    if (extension == "mlbin")
+    {
+      mappedFile = new MappedFile(filename);
+      header = ReadBinaryMatrixHeader(*mappedFile);
+      details::ReadChunkReaderInfo(*mappedFile, header, info);
+      dimensionality = header.nRows;
+      numPoints = header.nCols;
+    }
+    else if (extension == "csv" || extension == "tsv" || extension == "txt")
+    {
+      loader = new LoadCSV(filename);
+      stream = new InputFile(filename);
+      ScanText();
+    }
+    else if (extension == "arff" || extension == "svm" ||
+             extension == "libsvm" || extension == "svmlight")
+    {
+      textFormat = (extension == "arff") ? TextFormat::arff :
+          TextFormat::libsvm;
+      stream = new InputFile(filename);
+      if (!stream->is_open())
+      {
+        throw std::runtime_error("ChunkReader::ChunkReader(): cannot open '" +
+            filename + "'.");
+      }
+
+      if (textFormat == TextFormat::arff)
+        ScanARFF();
+      else
+        ScanLibSVM();
+    }
+    else
+    {
+      std::ostringstream oss;
+      oss << "ChunkReader::ChunkReader(): cannot read '" << filename << "' in "
+          << "chunks; only .csv, .tsv, .txt, .arff, .svm, .libsvm, .svmlight "
+          << "and .mlbin files are supported.";
+      throw std::runtime_error(oss.str());
+    }
+  }
+  catch (...)
+  {
+    delete loader;
+    delete stream;
+    delete mappedFile;
+    throw;
+  }
+
+  Reset();
+}
+
+template<typename eT, typename PolicyType>
+ChunkReader<eT, PolicyType>::~ChunkReader()
+{
+  // The background read uses the stream, so it must finish first.
+  if (pending.valid())
+    pending.wait();
+
+  delete loader;
+  delete stream;
+  delete mappedFile;
+}
+
+template<typename eT, typename PolicyType>
+bool ChunkReader<eT, PolicyType>::Next(arma::Mat<eT>& chunk)
+{
+  if (mappedFile != NULL)
+  {
+    NextBinary(chunk);
+  }
+  else if (textFormat == TextFormat::libsvm)
+  {
+    arma::Row<eT> labels; // Ignored.
+    return Next(chunk, labels);
+  }
+  else
+  {
+    std::vector<std::string> lines;
+    NextLines(lines);
+    ParseLines(lines, chunk);
+  }
+
+  position += chunk.n_cols;
+  return (chunk.n_cols > 0);
+}
+
+template<typename eT, typename PolicyType>
+template<typename LabelType>
+bool ChunkReader<eT, PolicyType>::Next(arma::Mat<eT>& chunk,
+                                       arma::Row<LabelType>& labels)
+{
+  if (mappedFile != NULL || textFormat != TextFormat::libsvm)
+  {
+    throw std::runtime_error("ChunkReader::Next(): only libsvm files have "
+        "labels!");
+  }
+
+  std::vector<std::string> lines;
+  NextLines(lines);
+  ParseLibSVMLines(lines, chunk, labels);
+
+  position += chunk.n_cols;
+  return (chunk.n_cols > 0);
+}
+
+template<typename eT, typename PolicyType>
+void ChunkReader<eT, PolicyType>::Reset()
+{
+  // Throw away anything that was read ahead.
+  if (pending.valid())
+    pending.wait();
+  pending = std::future<void>();
+  nextLines.clear();
+
+  position = 0;
+  if (stream != NULL)
+  {
+    // A compressed stream can only be rewound, so skip the header again.
+    stream->clear();
+    stream->seekg(0, std::ios::beg);
+    std::string line;
+    for (size_t i = 0; i < headerLines; ++i)
+      std::getline(*stream, line);
+
+    if (readAhead)
+      StartReadAhead();
+  }
+}
+
+template<typename eT, typename PolicyType>
+void ChunkReader<eT, PolicyType>::ScanText()
+{
+  // Only look for the types of dimensions if we don't have them already.
+  const bool scanTypes = (info.Dimensionality() == 0) &&
+      PolicyType::NeedsFirstPass;
+  std::vector<char> seen;
+
+  std::string line;
+  while (std::getline(*stream, line))
+  {
+    const char* begin = line.data();
+    const char* end = begin + line.size();
+
+    // The first line gives the dimensionality.
+    if (numPoints == 0)
+    {
+      dimensionality = loader->TokenizeLine(begin, end,
+          [](const size_t, const char*, const char*) { });
+      if (info.Dimensionality() == 0)
+      {
+        info.SetDimensionality(dimensionality);
+      }
+      else if (info.Dimensionality() != dimensionality)
+      {
+        std::ostringstream oss;
+        oss << "data::ChunkReader(): given DatasetInfo has dimensionality "
+            << info.Dimensionality() << ", but data has dimensionality "
+            << dimensionality;
+        throw std::invalid_argument(oss.str());
+      }
+
+      seen.resize(dimensionality, 0);
+    }
+
+    const size_t lineTokens = loader->TokenizeLine(begin, end,
+        [&](const size_t d, const char* tokenBegin, const char* tokenEnd)
+        {
+          if (!scanTypes || d >= dimensionality)
+            return;
+
+          // If the policy leaves numbers alone, only the first token of each
+          // dimension and the non-numeric tokens can change its type.
+          eT value;
+          if (!MapPolicyTraits<PolicyType>::PassesNumbersThrough || !seen[d] ||
+              !ParseNumber(tokenBegin, tokenEnd, value))
+          {
+            info.template MapFirstPass<eT>(std::string(tokenBegin, tokenEnd),
+                d);
+          }
+          seen[d] = 1;
+        });
+
+    if (lineTokens != dimensionality)
+    {
+      std::ostringstream oss;
+      oss << "ChunkReader::ScanText(): wrong number of dimensions ("
+          << lineTokens << ") on line " << numPoints << "; should be "
+          << dimensionality << " dimensions.";
+      throw std::runtime_error(oss.str());
+    }
+
+    ++numPoints;
+  }
+}
+
+template<typename eT, typename PolicyType>
+void ChunkReader<eT, PolicyType>::ScanARFF()
+{
+  std::vector<bool> types;
+  headerLines = details::ReadARFFHeader(*stream, dimensionality, types,
+      categoryStrings);
+
+  // As with data::Load(), the types come from the header.
+  details::CheckChunkReaderInfo(info, dimensionality);
+  details::InitARFFInfo<eT>(dimensionality, types, categoryStrings, info);
+
+  std::string line;
+  while (std::getline(*stream, line))
+  {
+    if (IsPointLine(line))
+      ++numPoints;
+  }
+}
+
+template<typename eT, typename PolicyType>
+void ChunkReader<eT, PolicyType>::ScanLibSVM()
+{
+  size_t maxIndex = 0;
+  bool anyIndex = false;
+  size_t lineNumber = 0;
+  std::string line;
+  while (std::getline(*stream, line))
+  {
+    const char* labelBegin;
+    const char* labelEnd;
+    try
+    {
+      if (details::TokenizeLibSVMLine(line.data(), line.data() + line.size(),
+          labelBegin, labelEnd, [&](const char* indexBegin,
+                                    const char* indexEnd,
+                                    const char* /* valueBegin */,
+                                    const char* /* valueEnd */)
+          {
+            const size_t index = details::ParseLibSVMIndex(indexBegin,
+                indexEnd);
+            maxIndex = std::max(maxIndex, index);
+            anyIndex = true;
+            if (index == 0)
+              zeroBased = true;
+          }))
+      {
+        ++numPoints;
+      }
+    }
+    catch (std::exception& e)
+    {
+      std::ostringstream oss;
+      oss << "ChunkReader::ScanLibSVM(): " << e.what() << " on line "
+          << lineNumber << " of '" << filename << "'.";
+      throw std::runtime_error(oss.str());
+    }
+
+    ++lineNumber;
+  }
+
+  dimensionality = !anyIndex ? 0 : (zeroBased ? maxIndex + 1 : maxIndex);
+
+  // A DatasetMapper from another file (such as a training set) may have more
+  // dimensions than this file uses.
+  if (info.Dimensionality() == 0)
+  {
+    info.SetDimensionality(dimensionality);
+  }
+  else if (info.Dimensionality() < dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "data::ChunkReader(): given DatasetInfo has dimensionality "
+        << info.Dimensionality() << ", but data has dimensionality "
+        << dimensionality;
+    throw std::invalid_argument(oss.str());
+  }
+  else
+  {
+    dimensionality = info.Dimensionality();
+  }
+}
+
+template<typename eT, typename PolicyType>
+bool ChunkReader<eT, PolicyType>::IsPointLine(const std::string& line) const
+{
+  if (textFormat == TextFormat::delimited)
+    return true;
+
+  // Blank lines and comments hold no points.
+  const char comment = (textFormat == TextFormat::arff) ? '%' : '#';
+  for (size_t i = 0; i < line.size(); ++i)
+  {
+    if (line[i] == comment)
+      return false;
+    else if (!std::isspace((unsigned char) line[i]))
+      return true;
+  }
+
+  return false;
+}
+
+template<typename eT, typename PolicyType>
+void ChunkReader<eT, PolicyType>::ReadLines(std::vector<std::string>& lines)
+{
+  lines.clear();
+  std::string line;
+  while (lines.size() < chunkSize && std::getline(*stream, line))
+  {
+    if (IsPointLine(line))
+      lines.push_back(line);
+  }
+}
+
+template<typename eT, typename PolicyType>
+void ChunkReader<eT, PolicyType>::NextLines(std::vector<std::string>& lines)
+{
+  if (readAhead)
+  {
+    // Take the lines that were read in the background, and start reading the
+    // ones after them while we parse.
+    if (!pending.valid())
+      StartReadAhead();
+    WaitReadAhead();
+
+    lines.clear();
+    lines.swap(nextLines);
+    if (!lines.empty())
+      StartReadAhead();
+  }
+  else
+  {
+    ReadLines(lines);
+  }
+}
+
+template<typename eT, typename PolicyType>
+void ChunkReader<eT, PolicyType>::StartReadAhead()
+{
+  pending = std::async(std::launch::async, [this]() { ReadLines(nextLines); });
+}
+
+template<typename eT, typename PolicyType>
+void ChunkReader<eT, PolicyType>::WaitReadAhead()
+{
+  // This rethrows any exception from the background read.
+  if (pending.valid())
+    pending.get();
+}
+
+template<typename eT, typename PolicyType>
+void ChunkReader<eT, PolicyType>::ParseLines(
+    const std::vector<std::string>& lines,
+    arma::Mat<eT>& chunk)
+{
+  chunk.set_size(dimensionality, lines.size());
+  for (size_t i = 0; i < lines.size(); ++i)
+  {
+    size_t lineTokens;
+    if (textFormat == TextFormat::arff)
+    {
+      lineTokens = details::ParseARFFLine(lines[i], headerLines + position + i,
+          categoryStrings, info, chunk, i);
+    }
+    else
+    {
+      const char* begin = lines[i].data();
+      const char* end = begin + lines[i].size();
+      lineTokens = loader->TokenizeLine(begin, end,
+          [&](const size_t d, const char* tokenBegin, const char* tokenEnd)
+          {
+            if (d >= dimensionality)
+              return;
+
+            // The types are fixed before the first chunk, so a numeric
+            // dimension can't become categorical here; this happens when the
+            // types come from the given DatasetMapper instead of a scan.
+            eT value;
+            if (MapPolicyTraits<PolicyType>::PassesNumbersThrough &&
+                info.Type(d) == Datatype::numeric)
+            {
+              if (!ParseNumber(tokenBegin, tokenEnd, value))
+              {
+                std::ostringstream oss;
+                oss << "ChunkReader::Next(): non-numeric value '"
+                    << std::string(tokenBegin, tokenEnd) << "' in numeric "
+                    << "dimension " << d << " on line " << (position + i)
+                    << ".";
+                throw std::runtime_error(oss.str());
+              }
+
+              chunk(d, i) = value;
+            }
+            else
+            {
+              chunk(d, i) = info.template MapString<eT>(
+                  std::string(tokenBegin, tokenEnd), d);
+            }
+          });
+    }
+
+    // The file may have changed since it was scanned.
+    if (lineTokens != dimensionality)
+    {
+      std::ostringstream oss;
+      oss << "ChunkReader::Next(): wrong number of dimensions (" << lineTokens
+          << ") on line " << (position + i) << "; should be "
+          << dimensionality << " dimensions.";
+      throw std::runtime_error(oss.str());
+    }
+  }
+}
+
+template<typename eT, typename PolicyType>
+template<typename LabelType>
+void ChunkReader<eT, PolicyType>::ParseLibSVMLines(
+    const std::vector<std::string>& lines,
+    arma::Mat<eT>& chunk,
+    arma::Row<LabelType>& labels)
+{
+  chunk.zeros(dimensionality, lines.size());
+  labels.set_size(lines.size());
+  for (size_t i = 0; i < lines.size(); ++i)
+  {
+    const char* labelBegin;
+    const char* labelEnd;
+    try
+    {
+      details::TokenizeLibSVMLine(lines[i].data(),
+          lines[i].data() + lines[i].size(), labelBegin, labelEnd,
+          [&](const char* indexBegin,
+              const char* indexEnd,
+              const char* valueBegin,
+              const char* valueEnd)
+          {
+            size_t index = details::ParseLibSVMIndex(indexBegin, indexEnd);
+            if (!zeroBased)
+              --index;
+
+            // The file may have changed since it was scanned.
+            if (index >= dimensionality)
+            {
+              throw std::runtime_error("index '" +
+                  std::string(indexBegin, indexEnd) + "' is out of range");
+            }
+
+            if (!ParseNumber(valueBegin, valueEnd, chunk(index, i)))
+            {
+              throw std::runtime_error("invalid value '" +
+                  std::string(valueBegin, valueEnd) + "'");
+            }
+          });
+
+      if (!ParseNumber(labelBegin, labelEnd, labels[i]))
+      {
+        throw std::runtime_error("invalid label '" +
+            std::string(labelBegin, labelEnd) + "'");
+      }
+    }
+    catch (std::exception& e)
+    {
+      std::ostringstream oss;
+      oss << "ChunkReader::Next(): " << e.what() << " for point "
+          << (position + i) << ".";
+      throw std::runtime_error(oss.str());
+    }
+  }
+}
+
+template<typename eT, typename PolicyType>
+void ChunkReader<eT, PolicyType>::NextBinary(arma::Mat<eT>& chunk)
+{
+  const size_t cols = std::min(chunkSize, numPoints - position);
+  if (cols == 0)
+  {
+    chunk.set_size(dimensionality, 0);
+    return;
+  }
+
+  // Convert the next columns straight from the mapping.
+  BinaryMatrixHeader chunkHeader = header;
+  chunkHeader.nCols = cols;
+  char* data = mappedFile->Data() + header.dataOffset +
+      position * header.nRows * header.elemSize;
+  details::ConvertBinaryMatrix(data, chunkHeader, chunk, true);
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,104 @@
+/**
+ * @file core/data/chunk_writer.hpp
+ *
+ * Definition of the ChunkWriter class, which writes a dataset to a text file a
+ * block of points at a time, as the points are computed.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CHUNK_WRITER_HPP
+#define MLPACK_CORE_DATA_CHUNK_WRITER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "extension.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The ChunkWriter is the counterpart of the ChunkReader: each call to Write()
+ * appends the points of a chunk (one point per column) to a text file, one
+ * point per line, so that a dataset too large for memory can be written as it
+ * is computed.  The values of a point are separated by commas if the name of
+ * the file ends in .csv, by tabs for .tsv, and by spaces otherwise; they are
+ * written with enough digits to be read back exactly.
+ *
+ * @code
+ * data::DatasetInfo info;
+ * data::ChunkReader<> reader("dataset.csv", 10000, info);
+ * data::ChunkWriter writer("scaled.csv");
+ *
+ * arma::mat chunk;
+ * while (reader.Next(chunk))
+ * {
+ *   chunk = arma::normalise(chunk);
+ *   writer.Write(chunk);
+ * }
+ * writer.Close();
+ * @endcode
+ *
+ * All errors are reported by throwing std::runtime_error.
+ */
+class ChunkWriter
+{
+ public:
+  /**
+   * Open the given file for writing, replacing anything it held.
+   *
+   * @param filename Name of the file to write.
+   */
+  ChunkWriter(const std::string& filename);
+
+  /**
+   * Write the points of the given dense chunk.
+   *
+   * @param chunk Points to write, one point per column.
+   */
+  template<typename eT>
+  void Write(const arma::Mat<eT>& chunk);
+
+  /**
+   * Write the points of the given sparse chunk; the zeros are written too.
+   *
+   * @param chunk Points to write, one point per column.
+   */
+  template<typename eT>
+  void Write(const arma::SpMat<eT>& chunk);
+
+  /**
+   * Flush and close the file, and check that everything was written.  This is
+   * also done by the destructor, but errors can't be reported there.
+   */
+  void Close();
+
+  //! Get the name of the file.
+  const std::string& Filename() const { return filename; }
+  //! Get the character between the values of a point.
+  char Delimiter() const { return delimiter; }
+
+ private:
+  // Copying a writer is not allowed.
+  ChunkWriter(const ChunkWriter& other);
+  ChunkWriter& operator=(const ChunkWriter& other);
+
+  //! Throw if anything could not be written.
+  void CheckStream() const;
+
+  //! The name of the file.
+  std::string filename;
+  //! The stream to write to.
+  std::ofstream stream;
+  //! The character between the values of a point.
+  char delimiter;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "chunk_writer_impl.hpp"
+
+#endif
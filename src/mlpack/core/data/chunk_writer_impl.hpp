@@ -0,0 +1,102 @@
+/**
+ * @file core/data/chunk_writer_impl.hpp
+ *
+ * Implementation of the ChunkWriter class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CHUNK_WRITER_IMPL_HPP
+#define MLPACK_CORE_DATA_CHUNK_WRITER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "chunk_writer.hpp"
+
+namespace mlpack {
+namespace data {
+
+inline ChunkWriter::ChunkWriter(const std::string& filename) :
+    filename(filename),
+    stream(filename)
+{
+  if (!stream.is_open())
+  {
+    throw std::runtime_error("data::ChunkWriter(): cannot open file '" +
+        filename + "' for writing");
+  }
+  stream.precision(std::numeric_limits<double>::max_digits10);
+
+  const std::string extension = Extension(filename);
+  delimiter = (extension == "csv") ? ',' : ((extension == "tsv") ? '\t' : ' ');
+}
+
+template<typename eT>
+void ChunkWriter::Write(const arma::Mat<eT>& chunk)
+{
+  for (size_t col = 0; col < chunk.n_cols; ++col)
+  {
+    for (size_t row = 0; row < chunk.n_rows; ++row)
+    {
+      if (row > 0)
+        stream << delimiter;
+      stream << chunk(row, col);
+    }
+
+    stream << '\n';
+  }
+
+  CheckStream();
+}
+
+template<typename eT>
+void ChunkWriter::Write(const arma::SpMat<eT>& chunk)
+{
+  for (size_t col = 0; col < chunk.n_cols; ++col)
+  {
+    typename arma::SpMat<eT>::const_iterator it = chunk.begin_col(col);
+    for (size_t row = 0; row < chunk.n_rows; ++row)
+    {
+      if (row > 0)
+        stream << delimiter;
+
+      if (it != chunk.end_col(col) && it.row() == row)
+      {
+        stream << *it;
+        ++it;
+      }
+      else
+      {
+        stream << '0';
+      }
+    }
+
+    stream << '\n';
+  }
+
+  CheckStream();
+}
+
+inline void ChunkWriter::Close()
+{
+  if (!stream.is_open())
+    return;
+
+  stream.close();
+  CheckStream();
+}
+
+inline void ChunkWriter::CheckStream() const
+{
+  if (!stream.good())
+  {
+    throw std::runtime_error("data::ChunkWriter: error writing to '" +
+        filename + "'");
+  }
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
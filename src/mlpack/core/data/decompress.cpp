@@ -0,0 +1,552 @@
+/**
+ * @file core/data/decompress.cpp
+ *
+ * Implementation of decompression of gzip- and zstd-compressed files, and of
+ * compression of blocks of memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "decompress.hpp"
+
+#include <fstream>
+
+#ifdef HAS_ZLIB
+  #include <zlib.h>
+#endif
+#ifdef HAS_ZSTD
+  #include <zstd.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+namespace {
+
+//! Size of the blocks of compressed data read from the file.
+const size_t inputBlockSize = 1 << 18;
+//! Size of the blocks of decompressed data given to the reader of a stream.
+const size_t outputBlockSize = 1 << 20;
+//! Number of decompressed blocks a stream may hold before they are read.
+const size_t maxQueuedBlocks = 4;
+
+//! Throw if mlpack was compiled without support for the given compression.
+void CheckSupport(const std::string& filename, const Compression compression)
+{
+#ifndef HAS_ZLIB
+  if (compression == Compression::gzip)
+  {
+    throw std::runtime_error("'" + filename + "' is gzip-compressed, but "
+        "mlpack was compiled without zlib support.");
+  }
+#endif
+#ifndef HAS_ZSTD
+  if (compression == Compression::zstd)
+  {
+    throw std::runtime_error("'" + filename + "' is zstd-compressed, but "
+        "mlpack was compiled without zstd support.");
+  }
+#endif
+  (void) filename;
+  (void) compression;
+}
+
+/**
+ * Decompress the given file front to back, calling emit(data, size) for each
+ * block of decompressed data, which is at most blockSize bytes.  If emit()
+ * returns false, decompression stops early.  An error message is returned if
+ * the file is corrupt, and an empty string otherwise.
+ */
+template<typename EmitFunction>
+std::string DecompressBlocks(const std::string& filename,
+                             const Compression compression,
+                             const size_t blockSize,
+                             EmitFunction&& emit)
+{
+  std::ifstream stream(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!stream.is_open())
+    return "Cannot open file '" + filename + "'.";
+
+  std::vector<char> in(inputBlockSize);
+  std::vector<char> out(blockSize);
+  std::string error;
+
+#ifdef HAS_ZLIB
+  if (compression == Compression::gzip)
+  {
+    z_stream zs;
+    std::memset(&zs, 0, sizeof(z_stream));
+    // 15 + 32: use the largest window, and expect a gzip (or zlib) header.
+    if (inflateInit2(&zs, 15 + 32) != Z_OK)
+      return "Cannot initialize zlib.";
+
+    zs.next_out = reinterpret_cast<Bytef*>(out.data());
+    zs.avail_out = (uInt) out.size();
+    bool ended = false;
+    bool stopped = false;
+    bool endOfFile = false;
+    while (error.empty() && !stopped)
+    {
+      if (zs.avail_in == 0 && !endOfFile)
+      {
+        stream.read(in.data(), in.size());
+        zs.next_in = reinterpret_cast<Bytef*>(in.data());
+        zs.avail_in = (uInt) stream.gcount();
+        endOfFile = (zs.avail_in == 0);
+      }
+
+      // Once all of the input is read, zlib may still hold output that didn't
+      // fit in the last block; keep inflating until nothing more comes out.
+      const uInt availOut = zs.avail_out;
+      const int ret = inflate(&zs, Z_NO_FLUSH);
+      if (endOfFile && ret == Z_BUF_ERROR && zs.avail_out == availOut)
+        break;
+
+      if (ret == Z_STREAM_END)
+      {
+        // Another gzip member may follow this one, as with `cat a.gz b.gz`.
+        ended = true;
+        inflateReset(&zs);
+      }
+      else if (ret == Z_OK)
+      {
+        ended = false;
+      }
+      else if (ret != Z_BUF_ERROR)
+      {
+        error = "'" + filename + "' holds invalid gzip data.";
+      }
+
+      if (zs.avail_out == 0)
+      {
+        stopped = !emit(out.data(), out.size());
+        zs.next_out = reinterpret_cast<Bytef*>(out.data());
+        zs.avail_out = (uInt) out.size();
+      }
+    }
+
+    if (error.empty() && !stopped)
+    {
+      if (zs.avail_out < out.size())
+        emit(out.data(), out.size() - zs.avail_out);
+      if (!ended)
+        error = "'" + filename + "' is truncated.";
+    }
+
+    inflateEnd(&zs);
+  }
+#endif
+
+#ifdef HAS_ZSTD
+  if (compression == Compression::zstd)
+  {
+    ZSTD_DCtx* context = ZSTD_createDCtx();
+    if (context == NULL)
+      return "Cannot initialize zstd.";
+
+    ZSTD_outBuffer output = { out.data(), out.size(), 0 };
+    size_t ret = 0;
+    bool stopped = false;
+    while (error.empty() && !stopped)
+    {
+      stream.read(in.data(), in.size());
+      ZSTD_inBuffer input = { in.data(), (size_t) stream.gcount(), 0 };
+      if (input.size == 0)
+        break;
+
+      // Keep going until all of the input is used and the output is flushed.
+      while (true)
+      {
+        ret = ZSTD_decompressStream(context, &output, &input);
+        if (ZSTD_isError(ret))
+        {
+          error = "'" + filename + "' holds invalid zstd data: " +
+              ZSTD_getErrorName(ret);
+          break;
+        }
+
+        if (output.pos == output.size)
+        {
+          if (!emit(out.data(), output.pos))
+          {
+            stopped = true;
+            break;
+          }
+
+          output.pos = 0;
+        }
+        else if (input.pos == input.size)
+        {
+          break;
+        }
+      }
+    }
+
+    if (error.empty() && !stopped)
+    {
+      if (output.pos > 0)
+        emit(out.data(), output.pos);
+      // A nonzero return means that the last frame is incomplete.
+      if (ret != 0)
+        error = "'" + filename + "' is truncated.";
+    }
+
+    ZSTD_freeDCtx(context);
+  }
+#endif
+
+  (void) compression;
+  (void) emit;
+  return error;
+}
+
+#ifdef HAS_ZSTD
+/**
+ * Decompress all of the frames of a zstd file in parallel, if they all record
+ * their decompressed size.  Returns false, without doing anything, if they
+ * don't.
+ */
+bool DecompressZstdFrames(const std::string& filename,
+                          char*& data,
+                          size_t& size)
+{
+  std::ifstream stream(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!stream.is_open())
+    throw std::runtime_error("Cannot open file '" + filename + "'.");
+
+  stream.seekg(0, std::ios::end);
+  std::vector<char> compressed((size_t) stream.tellg());
+  stream.seekg(0, std::ios::beg);
+  stream.read(compressed.data(), compressed.size());
+  if (!stream.good())
+    throw std::runtime_error("Cannot read file '" + filename + "'.");
+
+  // Find where each frame starts, and where its contents go.
+  std::vector<size_t> frameOffsets, frameSizes, contentOffsets, contentSizes;
+  size_t totalSize = 0;
+  for (size_t pos = 0; pos < compressed.size(); )
+  {
+    const size_t frameSize = ZSTD_findFrameCompressedSize(
+        compressed.data() + pos, compressed.size() - pos);
+    if (ZSTD_isError(frameSize))
+      return false;
+
+    // Skippable frames (such as seek tables) have no contents.
+    const unsigned long long contentSize = ZSTD_getFrameContentSize(
+        compressed.data() + pos, frameSize);
+    if (contentSize == ZSTD_CONTENTSIZE_UNKNOWN ||
+        contentSize == ZSTD_CONTENTSIZE_ERROR)
+      return false;
+
+    frameOffsets.push_back(pos);
+    frameSizes.push_back(frameSize);
+    contentOffsets.push_back(totalSize);
+    contentSizes.push_back((size_t) contentSize);
+    totalSize += (size_t) contentSize;
+    pos += frameSize;
+  }
+
+  // Don't bother for a single frame; streaming uses less memory.
+  if (frameOffsets.size() < 2)
+    return false;
+
+  char* result = new char[std::max(totalSize, (size_t) 1)];
+  std::vector<char> failed(frameOffsets.size(), 0);
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t f = 0; f < (omp_size_t) frameOffsets.size(); ++f)
+  {
+    const size_t ret = ZSTD_decompress(result + contentOffsets[f],
+        contentSizes[f], compressed.data() + frameOffsets[f], frameSizes[f]);
+    if (ZSTD_isError(ret) || ret != contentSizes[f])
+      failed[f] = 1;
+  }
+
+  if (std::find(failed.begin(), failed.end(), 1) != failed.end())
+  {
+    delete[] result;
+    throw std::runtime_error("'" + filename + "' holds invalid zstd data.");
+  }
+
+  data = result;
+  size = totalSize;
+  return true;
+}
+#endif
+
+} // namespace
+
+void DecompressFile(const std::string& filename,
+                    const Compression compression,
+                    char*& data,
+                    size_t& size)
+{
+  CheckSupport(filename, compression);
+
+#ifdef HAS_ZSTD
+  if (compression == Compression::zstd &&
+      DecompressZstdFrames(filename, data, size))
+    return;
+#endif
+
+  // Otherwise, decompress front to back into a growing buffer.
+  size_t capacity = outputBlockSize;
+  char* result = new char[capacity];
+  size_t resultSize = 0;
+  const std::string error = DecompressBlocks(filename, compression,
+      outputBlockSize, [&](const char* block, const size_t blockSize)
+      {
+        if (resultSize + blockSize > capacity)
+        {
+          capacity = std::max(2 * capacity, resultSize + blockSize);
+          char* grown = new char[capacity];
+          std::memcpy(grown, result, resultSize);
+          delete[] result;
+          result = grown;
+        }
+
+        std::memcpy(result + resultSize, block, blockSize);
+        resultSize += blockSize;
+        return true;
+      });
+
+  if (!error.empty())
+  {
+    delete[] result;
+    throw std::runtime_error(error);
+  }
+
+  data = result;
+  size = resultSize;
+}
+
+Compression BlockCompression()
+{
+#if defined(HAS_ZSTD)
+  return Compression::zstd;
+#elif defined(HAS_ZLIB)
+  return Compression::gzip;
+#else
+  return Compression::none;
+#endif
+}
+
+bool CompressBlock(const char* data,
+                   const size_t size,
+                   const Compression compression,
+                   std::string& out)
+{
+#ifdef HAS_ZSTD
+  if (compression == Compression::zstd)
+  {
+    out.resize(ZSTD_compressBound(size));
+    const size_t ret = ZSTD_compress(&out[0], out.size(), data, size, 3);
+    if (ZSTD_isError(ret))
+      return false;
+
+    out.resize(ret);
+    return true;
+  }
+#endif
+
+#ifdef HAS_ZLIB
+  if (compression == Compression::gzip)
+  {
+    uLongf outSize = compressBound((uLong) size);
+    out.resize(outSize);
+    if (compress2(reinterpret_cast<Bytef*>(&out[0]), &outSize,
+        reinterpret_cast<const Bytef*>(data), (uLong) size,
+        Z_DEFAULT_COMPRESSION) != Z_OK)
+      return false;
+
+    out.resize(outSize);
+    return true;
+  }
+#endif
+
+  (void) data;
+  (void) size;
+  (void) compression;
+  (void) out;
+  return false;
+}
+
+void DecompressBlock(const char* data,
+                     const size_t size,
+                     const Compression compression,
+                     char* out,
+                     const size_t outSize)
+{
+#ifdef HAS_ZSTD
+  if (compression == Compression::zstd)
+  {
+    const size_t ret = ZSTD_decompress(out, outSize, data, size);
+    if (ZSTD_isError(ret) || ret != outSize)
+      throw std::runtime_error("DecompressBlock(): invalid zstd data.");
+
+    return;
+  }
+#endif
+
+#ifdef HAS_ZLIB
+  if (compression == Compression::gzip)
+  {
+    uLongf decompressedSize = (uLongf) outSize;
+    if (uncompress(reinterpret_cast<Bytef*>(out), &decompressedSize,
+        reinterpret_cast<const Bytef*>(data), (uLong) size) != Z_OK ||
+        decompressedSize != outSize)
+      throw std::runtime_error("DecompressBlock(): invalid zlib data.");
+
+    return;
+  }
+#endif
+
+  (void) data;
+  (void) size;
+  (void) out;
+  (void) outSize;
+  if (compression == Compression::none)
+    throw std::runtime_error("DecompressBlock(): the block is not compressed.");
+  else
+    throw std::runtime_error("DecompressBlock(): mlpack was compiled without "
+        "support for the compression of the block.");
+}
+
+DecompressStreamBuf::DecompressStreamBuf(const std::string& filename,
+                                         const Compression compression) :
+    filename(filename),
+    compression(compression),
+    finished(false),
+    stopping(false),
+    blockStart(0)
+{
+  CheckSupport(filename, compression);
+  Start();
+}
+
+DecompressStreamBuf::~DecompressStreamBuf()
+{
+  Stop();
+}
+
+DecompressStreamBuf::int_type DecompressStreamBuf::underflow()
+{
+  if (gptr() == egptr() && !NextBlock())
+    return traits_type::eof();
+
+  return traits_type::to_int_type(*gptr());
+}
+
+DecompressStreamBuf::pos_type DecompressStreamBuf::seekoff(
+    off_type off,
+    std::ios_base::seekdir dir,
+    std::ios_base::openmode which)
+{
+  if (dir == std::ios_base::beg)
+    return seekpos(pos_type(off), which);
+  else if (dir == std::ios_base::cur)
+    return seekpos(pos_type(blockStart + (gptr() - eback()) + off), which);
+
+  // We don't know where the end is.
+  return pos_type(off_type(-1));
+}
+
+DecompressStreamBuf::pos_type DecompressStreamBuf::seekpos(
+    pos_type pos,
+    std::ios_base::openmode which)
+{
+  const std::streamoff target = pos;
+  if (target < 0 || !(which & std::ios_base::in))
+    return pos_type(off_type(-1));
+
+  // To go backwards, we have to start over.
+  if (target < blockStart)
+  {
+    Stop();
+    Start();
+  }
+
+  while (target > blockStart + (std::streamoff) current.size())
+  {
+    if (!NextBlock())
+      return pos_type(off_type(-1));
+  }
+
+  setg(current.data(), current.data() + (target - blockStart),
+      current.data() + current.size());
+  return pos;
+}
+
+void DecompressStreamBuf::Start()
+{
+  blocks.clear();
+  current.clear();
+  blockStart = 0;
+  finished = false;
+  stopping = false;
+  error.clear();
+  setg(NULL, NULL, NULL);
+
+  worker = std::thread(&DecompressStreamBuf::Run, this);
+}
+
+void DecompressStreamBuf::Stop()
+{
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    stopping = true;
+  }
+  changed.notify_all();
+
+  if (worker.joinable())
+    worker.join();
+}
+
+void DecompressStreamBuf::Run()
+{
+  const std::string result = DecompressBlocks(filename, compression,
+      outputBlockSize, [this](const char* block, const size_t blockSize)
+      {
+        // Wait until the reader has caught up.
+        std::unique_lock<std::mutex> guard(lock);
+        changed.wait(guard, [this]()
+            { return stopping || blocks.size() < maxQueuedBlocks; });
+        if (stopping)
+          return false;
+
+        blocks.push_back(std::vector<char>(block, block + blockSize));
+        changed.notify_all();
+        return true;
+      });
+
+  std::lock_guard<std::mutex> guard(lock);
+  error = result;
+  finished = true;
+  changed.notify_all();
+}
+
+bool DecompressStreamBuf::NextBlock()
+{
+  std::unique_lock<std::mutex> guard(lock);
+  changed.wait(guard, [this]() { return !blocks.empty() || finished; });
+  if (blocks.empty())
+  {
+    // Don't let the reader mistake a corrupt file for a shorter one.
+    if (!error.empty())
+      throw std::runtime_error(error);
+
+    return false;
+  }
+
+  blockStart += current.size();
+  current.swap(blocks.front());
+  blocks.pop_front();
+  changed.notify_all();
+
+  setg(current.data(), current.data(), current.data() + current.size());
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
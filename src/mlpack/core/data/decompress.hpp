@@ -0,0 +1,172 @@
+/**
+ * @file core/data/decompress.hpp
+ *
+ * Decompression of gzip- and zstd-compressed files, either all at once into
+ * memory or as a stream, and compression of blocks of memory.  These are only
+ * available if mlpack was compiled with zlib and zstd, respectively.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_DECOMPRESS_HPP
+#define MLPACK_CORE_DATA_DECOMPRESS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+
+#include "detect_file_type.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Decompress the whole of the given file into memory.  On success, `data`
+ * points to a buffer holding the decompressed contents, allocated with new[];
+ * the caller owns it.  A zstd file made of several frames that all record
+ * their decompressed size (as parallel and seekable zstd compressors write
+ * them) has its frames decoded in parallel.
+ *
+ * A std::runtime_error is thrown if the file cannot be read, if it is corrupt,
+ * or if mlpack was compiled without support for its compression.
+ *
+ * @param filename Name of the file to decompress.
+ * @param compression Compression format of the file.
+ * @param data Set to the decompressed data.
+ * @param size Set to the size of the decompressed data in bytes.
+ */
+void DecompressFile(const std::string& filename,
+                    const Compression compression,
+                    char*& data,
+                    size_t& size);
+
+/**
+ * Return the compression that CompressBlock() should use: zstd if mlpack was
+ * compiled with it, otherwise gzip (zlib) if mlpack was compiled with that, and
+ * otherwise Compression::none.
+ */
+Compression BlockCompression();
+
+/**
+ * Compress a block of memory on its own.  For Compression::gzip, the block is
+ * compressed in the zlib format, without a gzip header.  Returns false, leaving
+ * `out` unspecified, if mlpack was compiled without support for the given
+ * compression or if the block could not be compressed.
+ *
+ * @param data Data to compress.
+ * @param size Size of the data in bytes.
+ * @param compression Compression to use.
+ * @param out Set to the compressed block.
+ */
+bool CompressBlock(const char* data,
+                   const size_t size,
+                   const Compression compression,
+                   std::string& out);
+
+/**
+ * Decompress a block compressed by CompressBlock() into the given memory, which
+ * must be exactly as large as the decompressed block.  A std::runtime_error is
+ * thrown if the block is corrupt, if it does not have the given size, or if
+ * mlpack was compiled without support for its compression.
+ *
+ * @param data Compressed block.
+ * @param size Size of the compressed block in bytes.
+ * @param compression Compression of the block.
+ * @param out Memory to decompress into.
+ * @param outSize Size of the decompressed block in bytes.
+ */
+void DecompressBlock(const char* data,
+                     const size_t size,
+                     const Compression compression,
+                     char* out,
+                     const size_t outSize);
+
+/**
+ * A read-only stream buffer that gives the decompressed contents of a file.  A
+ * background thread decompresses the file one block at a time, a few blocks
+ * ahead of the reader, so that decompression and parsing overlap.  Only a few
+ * blocks are ever held in memory.
+ *
+ * The stream may be seeked relative to its beginning or to the current
+ * position.  Seeking forwards skips data; seeking backwards starts
+ * decompressing the file over again.  The end of the stream is not known in
+ * advance, so it cannot be seeked relative to.  If the file turns out to be
+ * corrupt or truncated, a std::runtime_error is thrown when the reader gets to
+ * the end of the data that could be decompressed; a std::istream catches it
+ * and sets its badbit, and rethrows it if badbit is in its exception mask.
+ */
+class DecompressStreamBuf : public std::streambuf
+{
+ public:
+  /**
+   * Start decompressing the given file.  A std::runtime_error is thrown if
+   * mlpack was compiled without support for the compression of the file.
+   *
+   * @param filename Name of the file to decompress.
+   * @param compression Compression format of the file.
+   */
+  DecompressStreamBuf(const std::string& filename,
+                      const Compression compression);
+
+  //! Stop decompressing and clean up.
+  ~DecompressStreamBuf();
+
+ protected:
+  //! Get the next block of decompressed data, waiting for it if necessary.
+  int_type underflow();
+
+  //! Seek relative to the beginning or the current position.
+  pos_type seekoff(off_type off,
+                   std::ios_base::seekdir dir,
+                   std::ios_base::openmode which);
+
+  //! Seek to the given position.
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which);
+
+ private:
+  //! Start the background thread at the beginning of the file.
+  void Start();
+  //! Stop the background thread.
+  void Stop();
+  //! Decompress the file, adding blocks to the queue; run by the thread.
+  void Run();
+  //! Move to the next decompressed block; return false at the end, and throw
+  //! a std::runtime_error if the file is corrupt.
+  bool NextBlock();
+
+  //! Name of the file.
+  std::string filename;
+  //! Compression format of the file.
+  Compression compression;
+
+  //! The thread that decompresses the file.
+  std::thread worker;
+  //! Protects the members below that are shared with the thread.
+  std::mutex lock;
+  //! Signals a change of the shared members.
+  std::condition_variable changed;
+  //! Decompressed blocks that have not been read yet.
+  std::deque<std::vector<char>> blocks;
+  //! Whether the thread has decompressed all of the file.
+  bool finished;
+  //! Whether the thread has been asked to stop.
+  bool stopping;
+  //! The error that stopped the thread, if any.
+  std::string error;
+
+  //! The block being read.
+  std::vector<char> current;
+  //! Position of the start of the current block in the decompressed data.
+  std::streamoff blockStart;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
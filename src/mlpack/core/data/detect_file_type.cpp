@@ -189,10 +189,10 @@ arma::file_type GuessFileType(std::istream& f)
  * @param filename Name of the file.
  * @return The detected file type.
  */
-arma::file_type AutoDetect(std::fstream& stream, const std::string& filename)
+arma::file_type AutoDetect(std::istream& stream, const std::string& filename)
 {
-  // Get the extension.
-  std::string extension = Extension(filename);
+  // Get the extension, ignoring any compression.
+  std::string extension = UncompressedExtension(filename);
   arma::file_type detectedLoadType = arma::file_type_unknown;
 
   if (extension == "csv" || extension == "tsv")
@@ -301,6 +301,72 @@ arma::file_type AutoDetect(std::fstream& stream, const std::string& filename)
   return detectedLoadType;
 }
 
+/**
+ * Return whether the given file holds libsvm (svmlight) data.  Files with the
+ * extension .svm, .libsvm or .svmlight always do; for .txt files, the first
+ * line that holds data is inspected.
+ *
+ * @param stream Opened file stream to look into for autodetection.
+ * @param filename Name of the file.
+ */
+bool DetectLibSVM(std::istream& stream, const std::string& filename)
+{
+  const std::string extension = UncompressedExtension(filename);
+  if (extension == "svm" || extension == "libsvm" || extension == "svmlight")
+    return true;
+  else if (extension != "txt")
+    return false;
+
+  stream.clear();
+  const std::streampos pos = stream.tellg();
+
+  bool isLibSVM = false;
+  std::string line;
+  while (std::getline(stream, line))
+  {
+    // Skip comments and blank lines.
+    const size_t comment = line.find('#');
+    if (comment != std::string::npos)
+      line.erase(comment);
+    boost::trim(line);
+    if (line.empty())
+      continue;
+
+    // We need at least one index:value pair to tell a libsvm file apart from
+    // a single column of numbers.
+    std::vector<std::string> tokens;
+    boost::split(tokens, line, boost::is_any_of(" \t"),
+        boost::token_compress_on);
+    if (tokens.size() < 2)
+      break;
+
+    isLibSVM = (tokens[0].find(':') == std::string::npos);
+    for (size_t i = 1; i < tokens.size() && isLibSVM; ++i)
+    {
+      const size_t colon = tokens[i].find(':');
+      if (colon == std::string::npos || colon == 0 ||
+          colon == tokens[i].size() - 1)
+      {
+        isLibSVM = false;
+        break;
+      }
+
+      const std::string index = tokens[i].substr(0, colon);
+      if (index != "qid" &&
+          index.find_first_not_of("0123456789") != std::string::npos)
+        isLibSVM = false;
+    }
+
+    break;
+  }
+
+  // Reset stream position.
+  stream.clear();
+  stream.seekg(pos);
+
+  return isLibSVM;
+}
+
 /**
  * Return the type based only on the extension.
  *
@@ -338,5 +404,30 @@ arma::file_type DetectFromExtension(const std::string& filename)
   }
 }
 
+/**
+ * Detect whether the given file is compressed, by inspecting its first bytes.
+ *
+ * @param filename Name of the file.
+ */
+Compression DetectCompression(const std::string& filename)
+{
+  // Raw binary data could start with anything at all.
+  if (Extension(filename) == "bin")
+    return Compression::none;
+
+  std::ifstream stream(filename.c_str(), std::ios::in | std::ios::binary);
+  unsigned char magic[4] = { 0, 0, 0, 0 };
+  stream.read(reinterpret_cast<char*>(magic), 4);
+  const std::streamsize bytes = stream.gcount();
+
+  if (bytes >= 2 && magic[0] == 0x1f && magic[1] == 0x8b)
+    return Compression::gzip;
+  else if (bytes == 4 && magic[0] == 0x28 && magic[1] == 0xb5 &&
+      magic[2] == 0x2f && magic[3] == 0xfd)
+    return Compression::zstd;
+
+  return Compression::none;
+}
+
 } // namespace data
 } // namespace mlpack
@@ -47,13 +47,27 @@ arma::file_type GuessFileType(std::istream& f);
  * If the file is detected as a CSV, and the CSV is detected to have a header
  * row, `stream` will be fast-forwarded to point at the second line of the file.
  *
+ * The extension of a compressed file is the extension before .gz or .zst.
+ *
  * @param stream Opened file stream to look into for autodetection.
  * @param filename Name of the file.
  * @return The detected file type.  arma::file_type_unknown if unknown.
  */
-arma::file_type AutoDetect(std::fstream& stream,
+arma::file_type AutoDetect(std::istream& stream,
                            const std::string& filename);
 
+/**
+ * Return whether the given file holds libsvm (svmlight) data.  Files with the
+ * extension .svm, .libsvm or .svmlight always do; for .txt files, the first
+ * line that holds data is inspected, and must look like
+ * "label index:value ...".  The position of `stream` is not changed.
+ *
+ * @param stream Opened file stream to look into for autodetection.
+ * @param filename Name of the file.
+ * @return Whether the file is a libsvm file.
+ */
+bool DetectLibSVM(std::istream& stream, const std::string& filename);
+
 /**
  * Return the type based only on the extension.
  *
@@ -62,6 +76,29 @@ arma::file_type AutoDetect(std::fstream& stream,
  */
 arma::file_type DetectFromExtension(const std::string& filename);
 
+/**
+ * Compression formats that data::Load() can read transparently.
+ */
+enum class Compression
+{
+  none,
+  gzip,
+  zstd
+};
+
+/**
+ * Detect whether the given file is compressed, by inspecting its first bytes.
+ * Compressed files usually have the extension .gz or .zst after the extension
+ * of the format they hold (e.g. data.csv.gz), but the extension is not needed
+ * to detect them.  Raw binary (.bin) files have no header, and so are never
+ * considered compressed.  Compression::none is returned if the file cannot be
+ * opened.
+ *
+ * @param filename Name of the file.
+ * @return The compression format of the file.
+ */
+Compression DetectCompression(const std::string& filename);
+
 } // namespace data
 } // namespace mlpack
 
@@ -32,6 +32,20 @@ inline std::string Extension(const std::string& filename)
   return extension;
 }
 
+/**
+ * Extract the extension of a file that may be compressed: for data.csv.gz or
+ * data.csv.zst, this is "csv".  For files that don't end in .gz or .zst, this
+ * is the same as Extension().
+ */
+inline std::string UncompressedExtension(const std::string& filename)
+{
+  const std::string extension = Extension(filename);
+  if (extension == "gz" || extension == "zst")
+    return Extension(filename.substr(0, filename.rfind('.')));
+
+  return extension;
+}
+
 } // namespace data
 } // namespace mlpack
 
@@ -16,13 +16,17 @@
 namespace mlpack {
 namespace data {
 
-//! Define the formats we can read through cereal.
+//! Define the formats we can read through cereal.  The bulk formats are
+//! mlpack's own (see bulk_model.hpp); bulk_compressed also compresses large
+//! matrices.
 enum format
 {
   autodetect,
   json,
   xml,
-  binary
+  binary,
+  bulk,
+  bulk_compressed
 };
 
 } // namespace data
@@ -71,6 +71,28 @@ class CustomImputation
     }
   }
 
+  /**
+   * Fit function sets the value of each of the given dimensions to the custom
+   * value, so that all the dimensions can be imputed at once (see
+   * Imputer::Fit()).
+   *
+   * @param input Matrix that contains the mapped values.
+   * @param mappedValues Value that the user wants to get rid of, for each of
+   *     the given dimensions.
+   * @param dimensions Indices of the dimensions to impute.
+   * @param values Vector to store the value of each given dimension in.
+   * @param columnMajor State of whether the input matrix is columnMajor or not.
+   */
+  void Fit(const arma::Mat<T>& /* input */,
+           const arma::Col<T>& /* mappedValues */,
+           const arma::uvec& dimensions,
+           arma::Col<T>& values,
+           const bool /* columnMajor */ = true) const
+  {
+    values.set_size(dimensions.n_elem);
+    values.fill(customValue);
+  }
+
  private:
   //! A user-defined value that the user wants to replace missing values with.
   T customValue;
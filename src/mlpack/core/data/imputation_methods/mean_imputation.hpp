@@ -96,6 +96,74 @@ class MeanImputation
       input(target.first, target.second) = mean;
     }
   }
+
+  /**
+   * Fit function computes the mean of each of the given dimensions, excluding
+   * its mapped value and NaN, in one pass over the input.  The points are
+   * split into blocks whose sums are computed in parallel.  The means can then
+   * be used to impute all the dimensions at once (see Imputer::Fit()).
+   *
+   * @param input Matrix that contains the mapped values.
+   * @param mappedValues Value that the user wants to get rid of, for each of
+   *     the given dimensions.
+   * @param dimensions Indices of the dimensions to compute the means of.
+   * @param values Vector to store the mean of each given dimension in.
+   * @param columnMajor State of whether the input matrix is columnMajor or not.
+   */
+  void Fit(const arma::Mat<T>& input,
+           const arma::Col<T>& mappedValues,
+           const arma::uvec& dimensions,
+           arma::Col<T>& values,
+           const bool columnMajor = true) const
+  {
+    // Blocks of a fixed number of points, added up in order, give the same
+    // sums with any number of threads.
+    const size_t blockSize = 4096;
+    const size_t numPoints = columnMajor ? input.n_cols : input.n_rows;
+    const size_t numBlocks = std::max((size_t) 1,
+        (numPoints + blockSize - 1) / blockSize);
+
+    std::vector<arma::vec> sums(numBlocks,
+        arma::vec(dimensions.n_elem, arma::fill::zeros));
+    std::vector<arma::Col<size_t>> counts(numBlocks,
+        arma::Col<size_t>(dimensions.n_elem, arma::fill::zeros));
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+    {
+      const size_t begin = b * blockSize;
+      const size_t end = std::min(begin + blockSize, numPoints);
+      for (size_t i = begin; i < end; ++i)
+      {
+        for (size_t d = 0; d < dimensions.n_elem; ++d)
+        {
+          const T value = columnMajor ? input(dimensions[d], i) :
+              input(i, dimensions[d]);
+          if (value == mappedValues[d] || std::isnan(value))
+            continue;
+
+          sums[b][d] += value;
+          ++counts[b][d];
+        }
+      }
+    }
+
+    for (size_t b = 1; b < numBlocks; ++b)
+    {
+      sums[0] += sums[b];
+      counts[0] += counts[b];
+    }
+
+    values.set_size(dimensions.n_elem);
+    for (size_t d = 0; d < dimensions.n_elem; ++d)
+    {
+      if (counts[0][d] == 0)
+        Log::Fatal << "it is impossible to calculate mean; no valid elements "
+            << "in dimension " << dimensions[d] << std::endl;
+
+      values[d] = (T) (sums[0][d] / counts[0][d]);
+    }
+  }
 }; // class MeanImputation
 
 } // namespace data
@@ -78,13 +78,118 @@ class MedianImputation
     }
 
     // calculate median
-    const double median = arma::median(arma::vec(elemsToKeep));
+    const double median = Median(elemsToKeep);
 
     for (const PairType& target : targets)
     {
        input(target.first, target.second) = median;
     }
   }
+
+  /**
+   * Fit function computes the median of each of the given dimensions,
+   * excluding its mapped value and NaN.  The valid values of each dimension
+   * are gathered in one parallel pass over blocks of points, and then the
+   * medians of all dimensions are selected in parallel.  The medians can then
+   * be used to impute all the dimensions at once (see Imputer::Fit()).
+   *
+   * @param input Matrix that contains the mapped values.
+   * @param mappedValues Value that the user wants to get rid of, for each of
+   *     the given dimensions.
+   * @param dimensions Indices of the dimensions to compute the medians of.
+   * @param values Vector to store the median of each given dimension in.
+   * @param columnMajor State of whether the input matrix is columnMajor or not.
+   */
+  void Fit(const arma::Mat<T>& input,
+           const arma::Col<T>& mappedValues,
+           const arma::uvec& dimensions,
+           arma::Col<T>& values,
+           const bool columnMajor = true) const
+  {
+    const size_t numPoints = columnMajor ? input.n_cols : input.n_rows;
+    size_t numBlocks = 1;
+    #ifdef HAS_OPENMP
+      numBlocks = (size_t) omp_get_max_threads();
+    #endif
+    numBlocks = std::max((size_t) 1, std::min(numBlocks, numPoints / 1024));
+
+    // The valid values of each dimension, for each block.
+    std::vector<std::vector<std::vector<T>>> blockValues(numBlocks,
+        std::vector<std::vector<T>>(dimensions.n_elem));
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+    {
+      const size_t begin = (b * numPoints) / numBlocks;
+      const size_t end = ((b + 1) * numPoints) / numBlocks;
+      for (size_t i = begin; i < end; ++i)
+      {
+        for (size_t d = 0; d < dimensions.n_elem; ++d)
+        {
+          const T value = columnMajor ? input(dimensions[d], i) :
+              input(i, dimensions[d]);
+          if (value == mappedValues[d] || std::isnan(value))
+            continue;
+
+          blockValues[b][d].push_back(value);
+        }
+      }
+    }
+
+    // Check for empty dimensions here, since an exception can't leave the
+    // parallel loop below.
+    for (size_t d = 0; d < dimensions.n_elem; ++d)
+    {
+      size_t count = 0;
+      for (size_t b = 0; b < numBlocks; ++b)
+        count += blockValues[b][d].size();
+
+      if (count == 0)
+        Log::Fatal << "it is impossible to calculate median; no valid "
+            << "elements in dimension " << dimensions[d] << std::endl;
+    }
+
+    values.set_size(dimensions.n_elem);
+    #pragma omp parallel for
+    for (omp_size_t d = 0; d < (omp_size_t) dimensions.n_elem; ++d)
+    {
+      // Join the values of the blocks, freeing them as we go.
+      std::vector<T> dimensionValues;
+      std::swap(dimensionValues, blockValues[0][d]);
+      for (size_t b = 1; b < numBlocks; ++b)
+      {
+        dimensionValues.insert(dimensionValues.end(),
+            blockValues[b][d].begin(), blockValues[b][d].end());
+        std::vector<T>().swap(blockValues[b][d]);
+      }
+
+      values[d] = (T) Median(dimensionValues);
+    }
+  }
+
+ private:
+  /**
+   * Compute the median of the given values with a selection algorithm instead
+   * of a full sort.  The values are reordered.
+   */
+  template<typename ElemType>
+  static double Median(std::vector<ElemType>& values)
+  {
+    if (values.empty())
+      Log::Fatal << "it is impossible to calculate median; no valid elements "
+          << "in the dimension" << std::endl;
+
+    const size_t middle = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + middle, values.end());
+    if (values.size() % 2 == 1)
+      return values[middle];
+
+    // For an even number of values, average the two middle values; the lower
+    // one is the largest value before the middle.
+    const ElemType lower = *std::max_element(values.begin(),
+        values.begin() + middle);
+    return (lower + (double) values[middle]) / 2.0;
+  }
 }; // class MedianImputation
 
 } // namespace data
@@ -65,6 +65,80 @@ class Imputer
     strategy.Impute(input, mappedValue, dimension, columnMajor);
   }
 
+  /**
+   * Compute the values that the missing values of the given dimensions will be
+   * replaced with, using the imputation strategy.  The strategy computes the
+   * statistics of all the dimensions in one parallel pass over the input (for
+   * instance, MeanImputation and MedianImputation), instead of one pass for
+   * each dimension.  Once fitted, Impute(input) replaces the missing values of
+   * all the fitted dimensions of the input, or of any other dataset mapped in
+   * the same way, such as the other chunks of a file read with a ChunkReader.
+   * The fitted values are serialized with the imputer.
+   *
+   * The strategy must have a Fit() method; ListwiseDeletion, which removes
+   * points instead of replacing values, does not.
+   *
+   * @param input Input dataset to compute the statistics on.
+   * @param missingValue User defined missing value; it must be mapped in each
+   *     of the given dimensions.
+   * @param dimensions Dimensions to impute.
+   */
+  void Fit(const arma::Mat<T>& input,
+           const std::string& missingValue,
+           const std::vector<size_t>& dimensions)
+  {
+    const size_t numDimensions = columnMajor ? input.n_rows : input.n_cols;
+    fittedDimensions.set_size(dimensions.size());
+    mappedValues.set_size(dimensions.size());
+    for (size_t i = 0; i < dimensions.size(); ++i)
+    {
+      if (dimensions[i] >= numDimensions)
+      {
+        std::ostringstream oss;
+        oss << "Imputer::Fit(): dimension " << dimensions[i] << " is not "
+            << "less than the number of dimensions (" << numDimensions << ")!";
+        throw std::invalid_argument(oss.str());
+      }
+
+      fittedDimensions[i] = dimensions[i];
+      mappedValues[i] = static_cast<T>(mapper.UnmapValue(missingValue,
+          dimensions[i]));
+    }
+
+    strategy.Fit(input, mappedValues, fittedDimensions, values, columnMajor);
+  }
+
+  /**
+   * Replace the missing values of all the dimensions given to Fit() with the
+   * fitted values.  The input is overwritten in place, and all the dimensions
+   * are imputed in one parallel pass over the points.
+   *
+   * @param input Input dataset to apply imputation.
+   */
+  void Impute(arma::Mat<T>& input) const
+  {
+    const size_t numDimensions = columnMajor ? input.n_rows : input.n_cols;
+    if (fittedDimensions.n_elem > 0 &&
+        arma::max(fittedDimensions) >= numDimensions)
+    {
+      throw std::invalid_argument("Imputer::Impute(): the input has fewer "
+          "dimensions than the imputer was fitted with!");
+    }
+
+    const size_t numPoints = columnMajor ? input.n_cols : input.n_rows;
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) numPoints; ++i)
+    {
+      for (size_t d = 0; d < fittedDimensions.n_elem; ++d)
+      {
+        T& value = columnMajor ? input(fittedDimensions[d], i) :
+            input(i, fittedDimensions[d]);
+        if (value == mappedValues[d] || std::isnan(value))
+          value = values[d];
+      }
+    }
+  }
+
   //! Get the strategy.
   const StrategyType& Strategy() const { return strategy; }
 
@@ -77,6 +151,23 @@ class Imputer
   //! Modify the given mapper.
   MapperType& Mapper() { return mapper; }
 
+  //! Get the dimensions the imputer was fitted on.
+  const arma::uvec& FittedDimensions() const { return fittedDimensions; }
+
+  //! Get the value that replaces missing values of each fitted dimension.
+  const arma::Col<T>& FittedValues() const { return values; }
+
+  //! Serialize the imputer.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(mapper));
+    ar(CEREAL_NVP(columnMajor));
+    ar(CEREAL_NVP(fittedDimensions));
+    ar(CEREAL_NVP(mappedValues));
+    ar(CEREAL_NVP(values));
+  }
+
  private:
   // StrategyType
   StrategyType strategy;
@@ -86,6 +177,15 @@ class Imputer
 
   // save columnMajor as a member variable since it is rarely changed.
   bool columnMajor;
+
+  // Dimensions the imputer was fitted on.
+  arma::uvec fittedDimensions;
+
+  // Mapped missing value of each fitted dimension.
+  arma::Col<T> mappedValues;
+
+  // Value that replaces missing values of each fitted dimension.
+  arma::Col<T> values;
 }; // class Imputer
 
 } // namespace data
@@ -0,0 +1,62 @@
+/**
+ * @file core/data/input_file.cpp
+ *
+ * Implementation of the InputFile class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "input_file.hpp"
+#include "decompress.hpp"
+
+#include <fstream>
+
+namespace mlpack {
+namespace data {
+
+InputFile::InputFile(const std::string& filename, const bool seekable) :
+    std::istream(NULL),
+    buffer(NULL),
+    file(NULL),
+    isOpen(false)
+{
+  const Compression compression = DetectCompression(filename);
+  if (compression == Compression::none)
+  {
+    std::filebuf* fileBuffer = new std::filebuf();
+    isOpen = (fileBuffer->open(filename.c_str(),
+        std::ios::in | std::ios::binary) != NULL);
+    buffer = fileBuffer;
+  }
+  else if (seekable)
+  {
+    // MappedFile decompresses the whole file into memory.
+    file = new MappedFile(filename);
+    buffer = new MemoryStreamBuf(file->Data(), file->Size());
+    isOpen = true;
+  }
+  else
+  {
+    buffer = new DecompressStreamBuf(filename, compression);
+    isOpen = true;
+  }
+
+  rdbuf(buffer);
+  if (!isOpen)
+    setstate(std::ios::failbit);
+
+  // Rethrow errors from the buffer, such as a corrupt compressed file.
+  exceptions(std::ios::badbit);
+}
+
+InputFile::~InputFile()
+{
+  // The buffer may point into the file.
+  delete buffer;
+  delete file;
+}
+
+} // namespace data
+} // namespace mlpack
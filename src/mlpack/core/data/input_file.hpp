@@ -0,0 +1,120 @@
+/**
+ * @file core/data/input_file.hpp
+ *
+ * An input stream over a file that may be compressed.  This is what the
+ * loaders read text files through, so that compressed files can be loaded
+ * without any special handling.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_INPUT_FILE_HPP
+#define MLPACK_CORE_DATA_INPUT_FILE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <istream>
+#include <streambuf>
+
+#include "mapped_file.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A read-only stream buffer over a block of memory, which may be seeked
+ * anywhere.  The memory is not copied, and must outlive the buffer.
+ */
+class MemoryStreamBuf : public std::streambuf
+{
+ public:
+  //! Read from the given block of memory.
+  MemoryStreamBuf(const char* data, const size_t size)
+  {
+    char* begin = const_cast<char*>(data);
+    setg(begin, begin, begin + size);
+  }
+
+ protected:
+  //! Seek relative to the beginning, the current position, or the end.
+  pos_type seekoff(off_type off,
+                   std::ios_base::seekdir dir,
+                   std::ios_base::openmode which)
+  {
+    std::streamoff target = off;
+    if (dir == std::ios_base::cur)
+      target += gptr() - eback();
+    else if (dir == std::ios_base::end)
+      target += egptr() - eback();
+
+    return seekpos(pos_type(target), which);
+  }
+
+  //! Seek to the given position.
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which)
+  {
+    const std::streamoff target = pos;
+    if (target < 0 || target > egptr() - eback() ||
+        !(which & std::ios_base::in))
+      return pos_type(off_type(-1));
+
+    setg(eback(), eback() + target, egptr());
+    return pos;
+  }
+};
+
+/**
+ * InputFile is a std::istream that reads a file in binary mode, decompressing
+ * it on the fly if it is compressed with gzip or zstd (see
+ * DetectCompression()).  Uncompressed files are read directly, as with a
+ * std::ifstream.
+ *
+ * A compressed file is normally decompressed on a background thread while it
+ * is being read (see DecompressStreamBuf); such a stream can be rewound, but
+ * not seeked relative to its end.  If `seekable` is true, a compressed file is
+ * instead decompressed into memory when it is opened, so that it can be seeked
+ * anywhere.
+ *
+ * If the file cannot be opened, is_open() returns false and the stream is
+ * failed.  A std::runtime_error is thrown if the file is compressed and mlpack
+ * was compiled without support for its compression, or if it is corrupt or
+ * truncated (when it is read, unless `seekable` is true).  The stream has
+ * badbit in its exception mask, so that such an error reaches the caller
+ * instead of looking like the end of the file.
+ */
+class InputFile : public std::istream
+{
+ public:
+  /**
+   * Open the given file for reading.
+   *
+   * @param filename Name of the file to open.
+   * @param seekable Whether a compressed file must support arbitrary seeks.
+   */
+  InputFile(const std::string& filename, const bool seekable = false);
+
+  //! Close the file.
+  ~InputFile();
+
+  //! Return whether the file was opened successfully.
+  bool is_open() const { return isOpen; }
+
+ private:
+  // Copying a stream is not allowed.
+  InputFile(const InputFile& other);
+  InputFile& operator=(const InputFile& other);
+
+  //! The buffer that the stream reads from.
+  std::streambuf* buffer;
+  //! The decompressed file, for seekable compressed files.
+  MappedFile* file;
+  //! Whether the file was opened successfully.
+  bool isOpen;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,77 @@
+/**
+ * @file core/data/libsvm.hpp
+ *
+ * Loading and saving of sparse datasets in the libsvm (or svmlight) format,
+ * where each line holds one labeled point:
+ *
+ *   <label> [qid:<n>] <index>:<value> <index>:<value> ... [# comment]
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LIBSVM_HPP
+#define MLPACK_CORE_DATA_LIBSVM_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "mapped_file.hpp"
+#include "parse_number.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Load a libsvm file into a sparse matrix, one point per column, and a row of
+ * labels.  The file is memory-mapped and parsed in parallel straight into the
+ * compressed sparse column structure of the matrix: a first pass counts the
+ * nonzeros of every point, and a second pass writes the indices and values to
+ * their final positions.
+ *
+ * Indices are 1-based as in the libsvm tools, unless the index 0 appears in the
+ * file, in which case they are taken to be 0-based.  The file does not record
+ * the dimensionality, so by default the number of rows of the matrix is the
+ * largest index seen, and trailing dimensions that are zero in every point are
+ * lost; give the dimensionality to keep them.  Blank lines, comments and qid
+ * fields are ignored.  Labels are parsed as LabelType; note that, as with
+ * stream extraction, a label like -1 wraps around if LabelType is unsigned.
+ *
+ * A std::runtime_error is thrown on failure.
+ *
+ * @param filename Name of file to load.
+ * @param matrix Sparse matrix to load the points into.
+ * @param labels Row vector to load the labels into.
+ * @param dimensionality Number of rows of the matrix, or 0 to use the largest
+ *     index in the file; a larger index is an error.
+ */
+template<typename eT, typename LabelType>
+void LoadLibSVM(const std::string& filename,
+                arma::SpMat<eT>& matrix,
+                arma::Row<LabelType>& labels,
+                const size_t dimensionality = 0);
+
+/**
+ * Save a sparse matrix (one point per column) and its labels as a libsvm file,
+ * with 1-based indices.  Only the nonzero elements are written, so the number
+ * of rows must be given to LoadLibSVM() to get it back if the last rows are all
+ * zero.  A std::invalid_argument is thrown if the number of
+ * labels is not the number of points, and a std::runtime_error if the file
+ * cannot be written.
+ *
+ * @param filename Name of file to save to.
+ * @param matrix Sparse matrix to save.
+ * @param labels Labels of the points.
+ */
+template<typename eT, typename LabelType>
+void SaveLibSVM(const std::string& filename,
+                const arma::SpMat<eT>& matrix,
+                const arma::Row<LabelType>& labels);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "libsvm_impl.hpp"
+
+#endif
@@ -0,0 +1,373 @@
+/**
+ * @file core/data/libsvm_impl.hpp
+ *
+ * Implementation of loading and saving of libsvm files.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LIBSVM_IMPL_HPP
+#define MLPACK_CORE_DATA_LIBSVM_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "libsvm.hpp"
+
+#include <fstream>
+
+namespace mlpack {
+namespace data {
+
+namespace details {
+
+/**
+ * Split one line of a libsvm file into its label and its index:value pairs,
+ * calling f(indexBegin, indexEnd, valueBegin, valueEnd) for each pair.
+ * Comments and qid fields are skipped.  Returns false if the line holds no
+ * point (it is blank or only a comment); throws a std::runtime_error if the
+ * line is malformed.
+ */
+template<typename PairFunction>
+bool TokenizeLibSVMLine(const char* begin,
+                        const char* end,
+                        const char*& labelBegin,
+                        const char*& labelEnd,
+                        PairFunction&& f)
+{
+  const char* comment = static_cast<const char*>(
+      std::memchr(begin, '#', end - begin));
+  if (comment != NULL)
+    end = comment;
+
+  const char* p = begin;
+  bool first = true;
+  while (true)
+  {
+    while (p != end && (*p == ' ' || *p == '\t' || *p == '\r'))
+      ++p;
+    if (p == end)
+      break;
+
+    const char* tokenBegin = p;
+    while (p != end && *p != ' ' && *p != '\t' && *p != '\r')
+      ++p;
+
+    if (first)
+    {
+      labelBegin = tokenBegin;
+      labelEnd = p;
+      first = false;
+      continue;
+    }
+
+    const char* colon = static_cast<const char*>(
+        std::memchr(tokenBegin, ':', p - tokenBegin));
+    if (colon == NULL)
+    {
+      throw std::runtime_error("expected index:value, but found '" +
+          std::string(tokenBegin, p) + "'");
+    }
+
+    if (colon - tokenBegin == 3 && std::memcmp(tokenBegin, "qid", 3) == 0)
+      continue;
+
+    f(tokenBegin, colon, colon + 1, p);
+  }
+
+  return !first;
+}
+
+/**
+ * Parse the index of an index:value pair of a libsvm file, and throw a
+ * std::runtime_error if it is not a nonnegative integer.
+ */
+inline arma::uword ParseLibSVMIndex(const char* indexBegin,
+                                    const char* indexEnd)
+{
+  arma::uword index;
+  if (indexBegin == indexEnd || *indexBegin < '0' || *indexBegin > '9' ||
+      !ParseNumber(indexBegin, indexEnd, index))
+  {
+    throw std::runtime_error("invalid index '" +
+        std::string(indexBegin, indexEnd) + "'");
+  }
+
+  return index;
+}
+
+} // namespace details
+
+template<typename eT, typename LabelType>
+void LoadLibSVM(const std::string& filename,
+                arma::SpMat<eT>& matrix,
+                arma::Row<LabelType>& labels,
+                const size_t dimensionality)
+{
+  MappedFile file(filename);
+  const char* data = file.Data();
+  const char* dataEnd = data + file.Size();
+
+  std::vector<const char*> chunks;
+  SplitChunks(data, dataEnd, chunks);
+  const size_t numChunks = chunks.size() - 1;
+
+  // Errors can't leave the parallel regions, so we keep the first one of each
+  // chunk, along with the line it happened on.
+  std::vector<std::string> errors(numChunks);
+  std::vector<size_t> errorLines(numChunks, 0);
+
+  // First pass: count the lines and the nonzeros of every point in each chunk.
+  std::vector<std::vector<size_t>> pointNonzeros(numChunks);
+  std::vector<size_t> lineOffsets(numChunks + 1, 0);
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    size_t line = 0;
+    const char* p = chunks[c];
+    try
+    {
+      const char* labelBegin;
+      const char* labelEnd;
+      while (p != chunks[c + 1])
+      {
+        const char* lineEnd = FindLineEnd(p, chunks[c + 1]);
+        size_t nonzeros = 0;
+        if (details::TokenizeLibSVMLine(p, lineEnd, labelBegin, labelEnd,
+            [&](const char*, const char*, const char*, const char*)
+            {
+              ++nonzeros;
+            }))
+        {
+          pointNonzeros[c].push_back(nonzeros);
+        }
+
+        ++line;
+        p = (lineEnd == chunks[c + 1]) ? lineEnd : lineEnd + 1;
+      }
+    }
+    catch (std::exception& e)
+    {
+      errors[c] = e.what();
+      errorLines[c] = line;
+      line += CountLines(p, chunks[c + 1]);
+    }
+
+    lineOffsets[c + 1] = line;
+  }
+
+  for (size_t c = 0; c < numChunks; ++c)
+    lineOffsets[c + 1] += lineOffsets[c];
+
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    if (!errors[c].empty())
+    {
+      std::ostringstream oss;
+      oss << "LoadLibSVM(): " << errors[c] << " on line "
+          << (lineOffsets[c] + errorLines[c]) << " of '" << filename << "'.";
+      throw std::runtime_error(oss.str());
+    }
+  }
+
+  // Now we know where every point goes, and where its nonzeros go.
+  std::vector<size_t> pointOffsets(numChunks + 1, 0);
+  for (size_t c = 0; c < numChunks; ++c)
+    pointOffsets[c + 1] = pointOffsets[c] + pointNonzeros[c].size();
+  const size_t numPoints = pointOffsets[numChunks];
+
+  arma::uvec colPtrs(numPoints + 1);
+  colPtrs[0] = 0;
+  size_t nonzeros = 0;
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    for (size_t i = 0; i < pointNonzeros[c].size(); ++i)
+    {
+      nonzeros += pointNonzeros[c][i];
+      colPtrs[pointOffsets[c] + i + 1] = nonzeros;
+    }
+  }
+
+  arma::uvec rowIndices(nonzeros);
+  arma::Col<eT> values(nonzeros);
+  labels.set_size(numPoints);
+
+  // Second pass: parse every point straight into its place.
+  std::vector<size_t> maxIndices(numChunks, 0);
+  std::vector<char> sawZero(numChunks, 0);
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    size_t line = 0;
+    size_t point = pointOffsets[c];
+    const char* p = chunks[c];
+    try
+    {
+      while (p != chunks[c + 1])
+      {
+        const char* lineEnd = FindLineEnd(p, chunks[c + 1]);
+        const char* labelBegin;
+        const char* labelEnd;
+        size_t pos = colPtrs[point];
+        bool sorted = true;
+        const bool isPoint = details::TokenizeLibSVMLine(p, lineEnd,
+            labelBegin, labelEnd, [&](const char* indexBegin,
+                                      const char* indexEnd,
+                                      const char* valueBegin,
+                                      const char* valueEnd)
+            {
+              const arma::uword index = details::ParseLibSVMIndex(indexBegin,
+                  indexEnd);
+              if (!ParseNumber(valueBegin, valueEnd, values[pos]))
+              {
+                throw std::runtime_error("invalid value '" +
+                    std::string(valueBegin, valueEnd) + "'");
+              }
+
+              if (pos > colPtrs[point] && index <= rowIndices[pos - 1])
+                sorted = false;
+              rowIndices[pos++] = index;
+              maxIndices[c] = std::max(maxIndices[c], (size_t) index);
+              if (index == 0)
+                sawZero[c] = 1;
+            });
+
+        if (isPoint)
+        {
+          if (!ParseNumber(labelBegin, labelEnd, labels[point]))
+          {
+            throw std::runtime_error("invalid label '" +
+                std::string(labelBegin, labelEnd) + "'");
+          }
+
+          // The libsvm format asks for increasing indices, but not every
+          // writer follows it.
+          if (!sorted)
+          {
+            const size_t first = colPtrs[point];
+            std::vector<std::pair<arma::uword, eT>> pairs;
+            for (size_t i = first; i < pos; ++i)
+              pairs.push_back(std::make_pair(rowIndices[i], values[i]));
+            std::sort(pairs.begin(), pairs.end(),
+                [](const std::pair<arma::uword, eT>& a,
+                   const std::pair<arma::uword, eT>& b)
+                {
+                  return a.first < b.first;
+                });
+
+            for (size_t i = 0; i < pairs.size(); ++i)
+            {
+              if (i > 0 && pairs[i].first == pairs[i - 1].first)
+              {
+                std::ostringstream oss;
+                oss << "duplicate index " << pairs[i].first;
+                throw std::runtime_error(oss.str());
+              }
+
+              rowIndices[first + i] = pairs[i].first;
+              values[first + i] = pairs[i].second;
+            }
+          }
+
+          ++point;
+        }
+
+        ++line;
+        p = (lineEnd == chunks[c + 1]) ? lineEnd : lineEnd + 1;
+      }
+    }
+    catch (std::exception& e)
+    {
+      errors[c] = e.what();
+      errorLines[c] = line;
+    }
+  }
+
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    if (!errors[c].empty())
+    {
+      std::ostringstream oss;
+      oss << "LoadLibSVM(): " << errors[c] << " on line "
+          << (lineOffsets[c] + errorLines[c]) << " of '" << filename << "'.";
+      throw std::runtime_error(oss.str());
+    }
+  }
+
+  size_t maxIndex = 0;
+  bool zeroBased = false;
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    maxIndex = std::max(maxIndex, maxIndices[c]);
+    zeroBased |= (sawZero[c] == 1);
+  }
+
+  // Convert 1-based indices to row indices.
+  if (!zeroBased)
+  {
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) nonzeros; ++i)
+      --rowIndices[i];
+  }
+
+  const size_t fileRows = (nonzeros == 0) ? 0 :
+      (zeroBased ? maxIndex + 1 : maxIndex);
+  if (dimensionality != 0 && fileRows > dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "LoadLibSVM(): '" << filename << "' has dimensionality " << fileRows
+        << ", but the given dimensionality is " << dimensionality << ".";
+    throw std::runtime_error(oss.str());
+  }
+
+  const size_t numRows = (dimensionality == 0) ? fileRows : dimensionality;
+  matrix = arma::SpMat<eT>(rowIndices, colPtrs, values, numRows, numPoints);
+}
+
+template<typename eT, typename LabelType>
+void SaveLibSVM(const std::string& filename,
+                const arma::SpMat<eT>& matrix,
+                const arma::Row<LabelType>& labels)
+{
+  if (labels.n_elem != matrix.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "SaveLibSVM(): number of labels (" << labels.n_elem << ") does not "
+        << "match number of points (" << matrix.n_cols
+        << ")! ";
+    throw std::invalid_argument(oss.str());
+  }
+
+  std::ofstream stream(filename.c_str());
+  if (!stream.is_open())
+  {
+    std::ostringstream oss;
+    oss << "Cannot open file '" << filename << "' for writing. ";
+    throw std::runtime_error(oss.str());
+  }
+
+  // Make sure that floating-point values survive the round trip.
+  if (std::is_floating_point<eT>::value)
+    stream.precision(std::numeric_limits<eT>::max_digits10);
+
+  for (size_t i = 0; i < matrix.n_cols; ++i)
+  {
+    stream << labels[i];
+    typename arma::SpMat<eT>::const_iterator it = matrix.begin_col(i);
+    for (; it != matrix.end_col(i); ++it)
+      stream << ' ' << (it.row() + 1) << ':' << (*it);
+    stream << '\n';
+  }
+
+  if (!stream.good())
+  {
+    std::ostringstream oss;
+    oss << "Error writing to '" << filename << "'. ";
+    throw std::runtime_error(oss.str());
+  }
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -41,6 +41,13 @@ namespace data /** Functions to load and save matrices and models. */ {
  *  - Raw binary (arma::raw_binary), denoted by .bin
  *  - Armadillo binary (arma::arma_binary), denoted by .bin
  *  - HDF5 (arma::hdf5_binary), denoted by .hdf, .hdf5, .h5, or .he5
+ *  - mlpack binary, denoted by .mlbin (see LoadBinaryMatrix())
+ *
+ * Any of these files except HDF5 files may be compressed with gzip or zstd,
+ * in which case the extension of the format comes before .gz or .zst (e.g.
+ * data.csv.gz).  Compressed files are detected by their contents, and
+ * decompressed in memory; this needs mlpack to have been compiled with zlib or
+ * zstd.
  *
  * By default, this function will try to automatically determine the type of
  * file to load based on its extension and by inspecting the file.  If you know
@@ -84,6 +91,10 @@ bool Load(const std::string& filename,
  *  - TXT (coord_ascii), denoted by .txt
  *  - Raw binary (raw_binary), denoted by .bin
  *  - Armadillo binary (arma_binary), denoted by .bin
+ *  - libsvm, denoted by .svm, .libsvm, .svmlight, or .txt (the labels are
+ *    ignored; use the overload below to get them)
+ *
+ * As with dense matrices, these files may be compressed with gzip or zstd.
  *
  * If the file extension is not one of those types, an error will be given.
  * This is preferable to Armadillo's default behavior of loading an unknown
@@ -108,6 +119,35 @@ bool Load(const std::string& filename,
           const bool fatal = false,
           const bool transpose = true);
 
+/**
+ * Loads a sparse matrix and its labels from a libsvm (svmlight) file, where
+ * each line holds a label followed by index:value pairs.  Each line becomes a
+ * column of the matrix.  The file is parsed in parallel; see LoadLibSVM() for
+ * the details of the format.
+ *
+ * The file does not record the dimensionality, so unless it is given, the
+ * matrix has as many rows as the largest index in the file; dimensions that are
+ * zero in every point at the end are then lost when a matrix saved with
+ * data::Save() is loaded again.
+ *
+ * If the parameter 'fatal' is set to true, a std::runtime_error exception will
+ * be thrown if the matrix does not load successfully.
+ *
+ * @param filename Name of file to load.
+ * @param matrix Sparse matrix to load the points into.
+ * @param labels Row vector to load the labels into.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param dimensionality Number of rows of the matrix, or 0 (the default) to
+ *     use the largest index in the file.
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT, typename LabelType>
+bool Load(const std::string& filename,
+          arma::SpMat<eT>& matrix,
+          arma::Row<LabelType>& labels,
+          const bool fatal = false,
+          const size_t dimensionality = 0);
+
 /**
  * Don't document these with doxygen; these declarations aren't helpful to
  * users.
@@ -261,6 +301,8 @@ bool Load(const std::string& filename,
  * - CSV (csv_ascii), denoted by .csv, or optionally .txt
  * - TSV (raw_ascii), denoted by .tsv, .csv, or .txt
  * - ASCII (raw_ascii), denoted by .txt
+ * - mlpack binary, denoted by .mlbin; if a DatasetInfo was saved with the
+ *   matrix, it replaces the contents of `info`
  *
  * If the file extension is not one of those types, an error will be given.
  * This is preferable to Armadillo's default behavior of loading an unknown
@@ -352,8 +394,14 @@ extern template bool Load<double, IncrementPolicy>(
  *  - xml, denoted by .xml
  *  - binary, denoted by .bin
  *
+ * mlpack's bulk model format is also supported (see bulk_model.hpp):
+ *
+ *  - bulk, denoted by .mlpk
+ *  - bulk with compressed matrices, denoted by .mlpkz
+ *
  * The format parameter can take any of the values in the 'format' enum:
- * 'format::autodetect', 'format::json', 'format::xml', and 'format::binary'.
+ * 'format::autodetect', 'format::json', 'format::xml', 'format::binary',
+ * 'format::bulk', and 'format::bulk_compressed'.
  * The autodetect functionality operates on the file extension (so, "file.txt"
  * would be autodetected as text).
  *
@@ -17,31 +17,29 @@
 
 #include <boost/algorithm/string/trim.hpp>
 #include "is_naninf.hpp"
+#include "input_file.hpp"
 
 namespace mlpack {
 namespace data {
 
-template<typename eT, typename PolicyType>
-void LoadARFF(const std::string& filename,
-              arma::Mat<eT>& matrix,
-              DatasetMapper<PolicyType>& info)
-{
-  // First, open the file.
-  std::ifstream ifs;
-  ifs.open(filename, std::ios::in | std::ios::binary);
-
-  // if file is not open throw an error (file not found).
-  if (!ifs.is_open())
-  {
-    Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
-  }
+namespace details {
 
+/**
+ * Read the header of an ARFF file from the given stream, up to and including
+ * the @data line.  The number of dimensions is stored in dimensionality, the
+ * type of each dimension (true if categorical) in types, and the categories
+ * that the header lists for a dimension in categoryStrings.  Returns the
+ * number of lines read; a std::runtime_error is thrown if the header is
+ * malformed.
+ */
+inline size_t ReadARFFHeader(
+    std::istream& ifs,
+    size_t& dimensionality,
+    std::vector<bool>& types,
+    std::map<size_t, std::vector<std::string>>& categoryStrings)
+{
   std::string line;
-  size_t dimensionality = 0;
-  // We'll store a vector of strings representing categories to be mapped, if
-  // needed.
-  std::map<size_t, std::vector<std::string>> categoryStrings;
-  std::vector<bool> types;
+  dimensionality = 0;
   size_t headerLines = 0;
   while (ifs.good())
   {
@@ -142,19 +140,25 @@ void LoadARFF(const std::string& filename,
   if (ifs.eof())
     throw std::runtime_error("no @data section found");
 
+  return headerLines;
+}
+
+/**
+ * Set the types of the dimensions of the given DatasetMapper to those read from
+ * an ARFF header, and map the categories that the header lists.  An empty
+ * DatasetMapper is first set to the right dimensionality; otherwise, it must
+ * already have it.
+ */
+template<typename eT, typename PolicyType>
+void InitARFFInfo(
+    const size_t dimensionality,
+    const std::vector<bool>& types,
+    const std::map<size_t, std::vector<std::string>>& categoryStrings,
+    DatasetMapper<PolicyType>& info)
+{
   // Reset the DatasetInfo object, if needed.
   if (info.Dimensionality() == 0)
-  {
     info = DatasetMapper<PolicyType>(dimensionality);
-  }
-  else if (info.Dimensionality() != dimensionality)
-  {
-    std::ostringstream oss;
-    oss << "data::LoadARFF(): given DatasetInfo has dimensionality "
-        << info.Dimensionality() << ", but data has dimensionality "
-        << dimensionality;
-    throw std::invalid_argument(oss.str());
-  }
 
   for (size_t i = 0; i < types.size(); ++i)
   {
@@ -175,6 +179,154 @@ void LoadARFF(const std::string& filename,
       info.template MapString<eT>(str, (*it).first);
     }
   }
+}
+
+/**
+ * Parse one line of the @data section of an ARFF file into the given column of
+ * the matrix, mapping categorical values with the given DatasetMapper.  The
+ * line number is only used in error messages.  Returns the number of values on
+ * the line; a std::runtime_error is thrown if there are too many, or if a value
+ * does not fit the type of its dimension.
+ */
+template<typename eT, typename PolicyType>
+size_t ParseARFFLine(
+    std::string line,
+    const size_t lineNumber,
+    const std::map<size_t, std::vector<std::string>>& categoryStrings,
+    DatasetMapper<PolicyType>& info,
+    arma::Mat<eT>& matrix,
+    const size_t row)
+{
+  boost::trim(line);
+  // Each line of the @data section must be a CSV (except sparse data, which
+  // we will handle later).  So now we can tokenize the
+  // CSV and parse it.  The '?' representing a missing value is not allowed,
+  // so if that occurs we throw an exception.  We also throw an exception if
+  // any piece of data does not match its type (categorical or numeric).
+
+  // If the first character is {, it is sparse data, and we can just say this
+  // is not handled for now...
+  if (line[0] == '{')
+    throw std::runtime_error("cannot yet parse sparse ARFF data");
+
+  // Tokenize the line.
+  typedef boost::tokenizer<boost::escaped_list_separator<char>> Tokenizer;
+  boost::escaped_list_separator<char> sep("\\", ",", "\"");
+  Tokenizer tok(line, sep);
+
+  size_t col = 0;
+  std::stringstream token;
+  for (Tokenizer::iterator it = tok.begin(); it != tok.end(); ++it)
+  {
+    // Check that we are not too many columns in.
+    if (col >= matrix.n_rows)
+    {
+      std::stringstream error;
+      error << "Too many columns in line " << lineNumber << ".";
+      throw std::runtime_error(error.str());
+    }
+
+    // What should this token be?
+    if (info.Type(col) == Datatype::categorical)
+    {
+      // Strip spaces before mapping.
+      std::string token = *it;
+      boost::trim(token);
+      const size_t currentNumMappings = info.NumMappings(col);
+      const eT result = info.template MapString<eT>(token, col);
+
+      // If the set of categories was pre-specified, then we must crash if
+      // this was not one of those categories.
+      if (categoryStrings.count(col) > 0 &&
+          currentNumMappings < info.NumMappings(col))
+      {
+        std::stringstream error;
+        error << "Parse error at line " << lineNumber << " token "
+            << col << ": category \"" << token << "\" not in the set of known"
+            << " categories for this dimension (";
+        for (size_t i = 0; i < categoryStrings.at(col).size() - 1; ++i)
+          error << "\"" << categoryStrings.at(col)[i] << "\", ";
+        error << "\"" << categoryStrings.at(col).back() << "\").";
+        throw std::runtime_error(error.str());
+      }
+
+      // We load transposed.
+      matrix(col, row) = result;
+    }
+    else if (info.Type(col) == Datatype::numeric)
+    {
+      // Attempt to read as numeric.
+      token.clear();
+      token.str(*it);
+
+      eT val = eT(0);
+      token >> val;
+
+      if (token.fail())
+      {
+        // Check for NaN or inf.
+        if (!IsNaNInf(val, token.str()))
+        {
+          // Okay, it's not NaN or inf.  If it's '?', we issue a specific
+          // error, otherwise we issue a general error.
+          std::stringstream error;
+          std::string tokenStr = token.str();
+          boost::trim(tokenStr);
+          if (tokenStr == "?")
+            error << "Missing values ('?') not supported, ";
+          else
+            error << "Parse error ";
+          error << "at line " << lineNumber << " token " << col
+              << ": \"" << tokenStr << "\".";
+          throw std::runtime_error(error.str());
+        }
+      }
+
+      // If we made it to here, we have a value.
+      matrix(col, row) = val; // We load transposed.
+    }
+
+    ++col;
+  }
+
+  return col;
+}
+
+} // namespace details
+
+template<typename eT, typename PolicyType>
+void LoadARFF(const std::string& filename,
+              arma::Mat<eT>& matrix,
+              DatasetMapper<PolicyType>& info)
+{
+  // First, open the file.  A compressed file is decompressed as it is read.
+  InputFile ifs(filename);
+
+  // if file is not open throw an error (file not found).
+  if (!ifs.is_open())
+  {
+    Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
+  }
+
+  std::string line;
+  size_t dimensionality = 0;
+  // We'll store a vector of strings representing categories to be mapped, if
+  // needed.
+  std::map<size_t, std::vector<std::string>> categoryStrings;
+  std::vector<bool> types;
+  const size_t headerLines = details::ReadARFFHeader(ifs, dimensionality,
+      types, categoryStrings);
+
+  if (info.Dimensionality() != 0 && info.Dimensionality() != dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "data::LoadARFF(): given DatasetInfo has dimensionality "
+        << info.Dimensionality() << ", but data has dimensionality "
+        << dimensionality;
+    throw std::invalid_argument(oss.str());
+  }
+
+  details::InitARFFInfo<eT>(dimensionality, types, categoryStrings, info);
 
   // We need to find out how many lines of data are in the file.
   std::streampos pos = ifs.tellg();
@@ -199,97 +351,8 @@ void LoadARFF(const std::string& filename,
   while (ifs.good())
   {
     std::getline(ifs, line, '\n');
-    boost::trim(line);
-    // Each line of the @data section must be a CSV (except sparse data, which
-    // we will handle later).  So now we can tokenize the
-    // CSV and parse it.  The '?' representing a missing value is not allowed,
-    // so if that occurs we throw an exception.  We also throw an exception if
-    // any piece of data does not match its type (categorical or numeric).
-
-    // If the first character is {, it is sparse data, and we can just say this
-    // is not handled for now...
-    if (line[0] == '{')
-      throw std::runtime_error("cannot yet parse sparse ARFF data");
-
-    // Tokenize the line.
-    typedef boost::tokenizer<boost::escaped_list_separator<char>> Tokenizer;
-    boost::escaped_list_separator<char> sep("\\", ",", "\"");
-    Tokenizer tok(line, sep);
-
-    size_t col = 0;
-    std::stringstream token;
-    for (Tokenizer::iterator it = tok.begin(); it != tok.end(); ++it)
-    {
-      // Check that we are not too many columns in.
-      if (col >= matrix.n_rows)
-      {
-        std::stringstream error;
-        error << "Too many columns in line " << (headerLines + row) << ".";
-        throw std::runtime_error(error.str());
-      }
-
-      // What should this token be?
-      if (info.Type(col) == Datatype::categorical)
-      {
-        // Strip spaces before mapping.
-        std::string token = *it;
-        boost::trim(token);
-        const size_t currentNumMappings = info.NumMappings(col);
-        const eT result = info.template MapString<eT>(token, col);
-
-        // If the set of categories was pre-specified, then we must crash if
-        // this was not one of those categories.
-        if (categoryStrings.count(col) > 0 &&
-            currentNumMappings < info.NumMappings(col))
-        {
-          std::stringstream error;
-          error << "Parse error at line " << (headerLines + row) << " token "
-              << col << ": category \"" << token << "\" not in the set of known"
-              << " categories for this dimension (";
-          for (size_t i = 0; i < categoryStrings.at(col).size() - 1; ++i)
-            error << "\"" << categoryStrings.at(col)[i] << "\", ";
-          error << "\"" << categoryStrings.at(col).back() << "\").";
-          throw std::runtime_error(error.str());
-        }
-
-        // We load transposed.
-        matrix(col, row) = result;
-      }
-      else if (info.Type(col) == Datatype::numeric)
-      {
-        // Attempt to read as numeric.
-        token.clear();
-        token.str(*it);
-
-        eT val = eT(0);
-        token >> val;
-
-        if (token.fail())
-        {
-          // Check for NaN or inf.
-          if (!IsNaNInf(val, token.str()))
-          {
-            // Okay, it's not NaN or inf.  If it's '?', we issue a specific
-            // error, otherwise we issue a general error.
-            std::stringstream error;
-            std::string tokenStr = token.str();
-            boost::trim(tokenStr);
-            if (tokenStr == "?")
-              error << "Missing values ('?') not supported, ";
-            else
-              error << "Parse error ";
-            error << "at line " << (headerLines + row) << " token " << col
-                << ": \"" << tokenStr << "\".";
-            throw std::runtime_error(error.str());
-          }
-        }
-
-        // If we made it to here, we have a value.
-        matrix(col, row) = val; // We load transposed.
-      }
-
-      ++col;
-    }
+    details::ParseARFFLine(line, headerLines + row, categoryStrings, info,
+        matrix, row);
     ++row;
   }
 }
@@ -18,7 +18,8 @@ namespace mlpack {
 namespace data {
 
 LoadCSV::LoadCSV(const std::string& file) :
-  extension(Extension(file)),
+  extension(UncompressedExtension(file)),
+  delimiter((extension == "csv") ? ',' : (extension == "txt") ? ' ' : '\t'),
   filename(file),
   inFile(file)
 {
@@ -23,7 +23,9 @@
 
 #include "extension.hpp"
 #include "format.hpp"
+#include "input_file.hpp"
 #include "dataset_mapper.hpp"
+#include "map_policies/map_policy_traits.hpp"
 
 namespace mlpack {
 namespace data {
@@ -58,7 +60,12 @@ class LoadCSV
   {
     CheckOpen();
 
-    if (transpose)
+    // If the policy leaves numbers alone, we can parse the numbers in parallel
+    // straight from a memory mapping of the file, and only hand the remaining
+    // tokens to the DatasetMapper.
+    if (MapPolicyTraits<PolicyType>::PassesNumbersThrough)
+      ParallelParse(inout, infoSet, transpose);
+    else if (transpose)
       TransposeParse(inout, infoSet);
     else
       NonTransposeParse(inout, infoSet);
@@ -228,6 +235,21 @@ class LoadCSV
     }
   }
 
+  /**
+   * Split the given line into tokens with the same rules as the spirit parser,
+   * calling f(index, begin, end) for each (trimmed) token.  Parsing stops at
+   * the first character that can't be parsed, as with qi::parse().
+   *
+   * @param begin Start of the line.
+   * @param end End of the line (pointing at the newline or the end of file).
+   * @param f Function to call for each token.
+   * @return Number of tokens in the line.
+   */
+  template<typename TokenFunction>
+  size_t TokenizeLine(const char* begin,
+                      const char* end,
+                      TokenFunction&& f) const;
+
  private:
   using iter_type = boost::iterator_range<std::string::iterator>;
 
@@ -381,6 +403,70 @@ class LoadCSV
     }
   }
 
+  /**
+   * Parse the file in parallel.  The file is memory-mapped and split into
+   * chunks of whole lines; each thread counts the lines of a chunk, and then
+   * parses the numbers of a chunk directly into the right columns (or rows) of
+   * the matrix.  Tokens that are not numbers are only handed to the
+   * DatasetMapper afterwards (see MapCategorical()), so the mappings are the
+   * same as for a serial parse.  This requires
+   * MapPolicyTraits<PolicyType>::PassesNumbersThrough to be true.
+   *
+   * @param inout Matrix to load into.
+   * @param infoSet DatasetMapper to load with.
+   * @param transpose If true, each line of the file is a column of the matrix.
+   */
+  template<typename T, typename PolicyType>
+  void ParallelParse(arma::Mat<T>& inout,
+                     DatasetMapper<PolicyType>& infoSet,
+                     const bool transpose);
+
+  /**
+   * Map every token of the categorical dimensions of the given chunks into
+   * the matrix, one at a time and in file order.
+   *
+   * @param chunks Boundaries of the chunks of lines of the file.
+   * @param chunkOffsets Index of the first line of each chunk.
+   * @param categorical For each dimension, whether it is categorical.
+   * @param inout Matrix to map into.
+   * @param infoSet DatasetMapper to map with.
+   * @param transpose If true, each line of the file is a column of the matrix.
+   */
+  template<typename T, typename PolicyType>
+  void MapCategorical(const std::vector<const char*>& chunks,
+                      const std::vector<size_t>& chunkOffsets,
+                      const std::vector<char>& categorical,
+                      arma::Mat<T>& inout,
+                      DatasetMapper<PolicyType>& infoSet,
+                      const bool transpose,
+                      const typename std::enable_if<
+                          !MapPolicyTraits<PolicyType>::MapsConcurrently>::type*
+                          = 0);
+
+  /**
+   * Map every token of the categorical dimensions of the given chunks into
+   * the matrix, with all chunks mapped in parallel by the policy (see
+   * ConcurrentIncrementPolicy).  The mappings are the same as those of a
+   * serial parse.
+   *
+   * @param chunks Boundaries of the chunks of lines of the file.
+   * @param chunkOffsets Index of the first line of each chunk.
+   * @param categorical For each dimension, whether it is categorical.
+   * @param inout Matrix to map into.
+   * @param infoSet DatasetMapper to map with.
+   * @param transpose If true, each line of the file is a column of the matrix.
+   */
+  template<typename T, typename PolicyType>
+  void MapCategorical(const std::vector<const char*>& chunks,
+                      const std::vector<size_t>& chunkOffsets,
+                      const std::vector<char>& categorical,
+                      arma::Mat<T>& inout,
+                      DatasetMapper<PolicyType>& infoSet,
+                      const bool transpose,
+                      const typename std::enable_if<
+                          MapPolicyTraits<PolicyType>::MapsConcurrently>::type*
+                          = 0);
+
   //! Spirit rule for parsing.
   boost::spirit::qi::rule<std::string::iterator, iter_type()> stringRule;
   //! Spirit rule for delimiters (i.e. ',' for CSVs).
@@ -388,13 +474,19 @@ class LoadCSV
 
   //! Extension (type) of file.
   std::string extension;
+  //! Character separating tokens (',' for CSVs, '\t' for TSVs, ' ' for text).
+  char delimiter;
   //! Name of file.
   std::string filename;
-  //! Opened stream for reading.
-  std::ifstream inFile;
+  //! Opened stream for reading; compressed files are decompressed as they are
+  //! read.
+  InputFile inFile;
 };
 
 } // namespace data
 } // namespace mlpack
 
+// Include implementation of the parallel parser.
+#include "load_csv_impl.hpp"
+
 #endif
@@ -0,0 +1,380 @@
+/**
+ * @file core/data/load_csv_impl.hpp
+ *
+ * Implementation of the parallel parser of the LoadCSV class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_CSV_IMPL_HPP
+#define MLPACK_CORE_DATA_LOAD_CSV_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "load_csv.hpp"
+#include "mapped_file.hpp"
+#include "parse_number.hpp"
+
+namespace mlpack {
+namespace data {
+
+namespace details {
+
+//! Return whether the character is whitespace, as boost::trim() sees it.
+inline bool IsSpace(const char c)
+{
+  return (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' ||
+      c == '\f');
+}
+
+//! Remove whitespace from either side of [begin, end).
+inline void TrimRange(const char*& begin, const char*& end)
+{
+  while (begin != end && IsSpace(*begin))
+    ++begin;
+  while (end != begin && IsSpace(*(end - 1)))
+    --end;
+}
+
+} // namespace details
+
+template<typename TokenFunction>
+size_t LoadCSV::TokenizeLine(const char* begin,
+                             const char* end,
+                             TokenFunction&& f) const
+{
+  // Remove whitespace from either side.
+  details::TrimRange(begin, end);
+
+  size_t numTokens = 0;
+  const char* p = begin;
+  while (true)
+  {
+    const char* tokenBegin = p;
+
+    // Quoted strings may contain delimiters; a doubled quote is an escaped
+    // quote.  The quotes are part of the token.
+    if (p != end && (*p == '"' || *p == '\''))
+    {
+      const char quote = *p;
+      const char* q = p + 1;
+      while (q != end)
+      {
+        if (*q != quote)
+        {
+          ++q;
+        }
+        else if (q + 1 != end && *(q + 1) == quote)
+        {
+          q += 2;
+        }
+        else
+        {
+          // Found the closing quote.
+          p = q + 1;
+          break;
+        }
+      }
+    }
+
+    // Consume everything up to the next delimiter.  Text files are split on
+    // spaces, but cannot contain commas.
+    while (p != end && *p != delimiter && *p != '\r' && *p != '\n' &&
+        !(delimiter == ' ' && *p == ','))
+    {
+      ++p;
+    }
+
+    const char* tokenEnd = p;
+    details::TrimRange(tokenBegin, tokenEnd);
+    f(numTokens, tokenBegin, tokenEnd);
+    ++numTokens;
+
+    // Now consume the delimiter, and any spaces around it.
+    if (p == end || *p != delimiter)
+      break;
+
+    ++p;
+    while (p != end && *p == ' ')
+      ++p;
+  }
+
+  return numTokens;
+}
+
+template<typename T, typename PolicyType>
+void LoadCSV::ParallelParse(arma::Mat<T>& inout,
+                            DatasetMapper<PolicyType>& infoSet,
+                            const bool transpose)
+{
+  MappedFile file(filename);
+  const char* data = file.Data();
+  const char* dataEnd = data + file.Size();
+
+  // Split the file into chunks of lines, and count the lines in each chunk so
+  // that we know which column (or row) of the matrix each chunk starts at.
+  std::vector<const char*> chunks;
+  SplitChunks(data, dataEnd, chunks);
+  const size_t numChunks = chunks.size() - 1;
+
+  std::vector<size_t> chunkOffsets(numChunks + 1, 0);
+  #pragma omp parallel for
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+    chunkOffsets[c + 1] = CountLines(chunks[c], chunks[c + 1]);
+
+  for (size_t c = 0; c < numChunks; ++c)
+    chunkOffsets[c + 1] += chunkOffsets[c];
+  const size_t numLines = chunkOffsets[numChunks];
+
+  // The first line gives the number of tokens that every line must have.  We
+  // also hold on to the first token of each dimension for the first pass of
+  // the DatasetMapper.
+  std::vector<std::string> firstTokens(transpose ? 0 : numLines);
+  size_t numTokens = 0;
+  if (numLines > 0)
+  {
+    numTokens = TokenizeLine(data, FindLineEnd(data, dataEnd),
+        [&](const size_t, const char* begin, const char* end)
+        {
+          if (transpose)
+            firstTokens.push_back(std::string(begin, end));
+        });
+  }
+
+  // Reset the DatasetInfo object, if needed.
+  if (numLines > 0 || !transpose)
+  {
+    if (infoSet.Dimensionality() == 0)
+    {
+      infoSet.SetDimensionality(firstTokens.size());
+    }
+    else if (infoSet.Dimensionality() != firstTokens.size())
+    {
+      std::ostringstream oss;
+      oss << "data::LoadCSV(): given DatasetInfo has dimensionality "
+          << infoSet.Dimensionality() << ", but data has dimensionality "
+          << firstTokens.size();
+      throw std::invalid_argument(oss.str());
+    }
+  }
+
+  if (transpose)
+    inout.set_size(numTokens, numLines);
+  else
+    inout.set_size(numLines, numTokens);
+
+  // Now parse every chunk.  The dimension of a token is always its row in the
+  // matrix.  Numbers go straight into the matrix; for everything else, we
+  // only remember the first such token of each dimension in each chunk, which
+  // is all that the first pass of the DatasetMapper needs.
+  std::vector<std::vector<std::pair<size_t, std::string>>> rejected(numChunks);
+  std::vector<size_t> badLines(numChunks, numLines);
+  std::vector<size_t> badLineTokens(numChunks, 0);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    std::vector<char> seen(transpose ? numTokens : 1, 0);
+    size_t line = chunkOffsets[c];
+    const char* p = chunks[c];
+    while (p != chunks[c + 1])
+    {
+      const char* lineEnd = FindLineEnd(p, chunks[c + 1]);
+      if (!transpose)
+        seen[0] = 0;
+
+      const size_t lineTokens = TokenizeLine(p, lineEnd,
+          [&](const size_t token, const char* begin, const char* end)
+          {
+            if (token >= numTokens)
+              return;
+
+            const size_t row = transpose ? token : line;
+            const size_t col = transpose ? line : token;
+            if (!transpose && token == 0)
+              firstTokens[line] = std::string(begin, end);
+
+            T value;
+            if (ParseNumber(begin, end, value))
+            {
+              inout.at(row, col) = value;
+            }
+            else
+            {
+              // This will be filled in by the DatasetMapper.
+              inout.at(row, col) = T(0);
+              char& seenRow = seen[transpose ? row : 0];
+              if (!seenRow)
+              {
+                seenRow = 1;
+                rejected[c].push_back(std::make_pair(row,
+                    std::string(begin, end)));
+              }
+            }
+          });
+
+      if (lineTokens != numTokens)
+      {
+        badLines[c] = line;
+        badLineTokens[c] = lineTokens;
+        break;
+      }
+
+      ++line;
+      p = (lineEnd == chunks[c + 1]) ? lineEnd : lineEnd + 1;
+    }
+  }
+
+  // Exceptions can't leave the parallel region, so report the first bad line
+  // now.
+  for (size_t c = 0; c < numChunks; ++c)
+  {
+    if (badLines[c] != numLines)
+    {
+      std::ostringstream oss;
+      oss << "LoadCSV::ParallelParse(): wrong number of dimensions ("
+          << badLineTokens[c] << ") on line " << badLines[c] << "; should be "
+          << numTokens << " dimensions.";
+      throw std::runtime_error(oss.str());
+    }
+  }
+
+  // Give the DatasetMapper its first pass.  Because the policy passes numbers
+  // through, the first token of each dimension and the non-numeric tokens are
+  // enough to determine the type of each dimension.
+  for (size_t d = 0; d < firstTokens.size(); ++d)
+    infoSet.template MapFirstPass<T>(firstTokens[d], d);
+  for (size_t c = 0; c < numChunks; ++c)
+    for (size_t i = 0; i < rejected[c].size(); ++i)
+      infoSet.template MapFirstPass<T>(rejected[c][i].second,
+          rejected[c][i].first);
+
+  std::vector<char> categorical(infoSet.Dimensionality(), 0);
+  bool anyCategorical = false;
+  for (size_t d = 0; d < categorical.size(); ++d)
+  {
+    if (infoSet.Type(d) == Datatype::categorical)
+    {
+      categorical[d] = 1;
+      anyCategorical = true;
+    }
+  }
+
+  if (anyCategorical)
+  {
+    MapCategorical(chunks, chunkOffsets, categorical, inout, infoSet,
+        transpose);
+  }
+}
+
+template<typename T, typename PolicyType>
+void LoadCSV::MapCategorical(
+    const std::vector<const char*>& chunks,
+    const std::vector<size_t>& /* chunkOffsets */,
+    const std::vector<char>& categorical,
+    arma::Mat<T>& inout,
+    DatasetMapper<PolicyType>& infoSet,
+    const bool transpose,
+    const typename std::enable_if<
+        !MapPolicyTraits<PolicyType>::MapsConcurrently>::type*)
+{
+  // Map every token of the categorical dimensions, in file order, so that the
+  // mappings are the same as a serial parse would give.
+  const char* dataEnd = chunks.back();
+  size_t line = 0;
+  const char* p = chunks.front();
+  while (p != dataEnd)
+  {
+    const char* lineEnd = FindLineEnd(p, dataEnd);
+    if (transpose || categorical[line])
+    {
+      TokenizeLine(p, lineEnd,
+          [&](const size_t token, const char* begin, const char* end)
+          {
+            const size_t row = transpose ? token : line;
+            if (categorical[row])
+            {
+              inout.at(row, transpose ? line : token) =
+                  infoSet.template MapString<T>(std::string(begin, end), row);
+            }
+          });
+    }
+
+    ++line;
+    p = (lineEnd == dataEnd) ? lineEnd : lineEnd + 1;
+  }
+}
+
+template<typename T, typename PolicyType>
+void LoadCSV::MapCategorical(
+    const std::vector<const char*>& chunks,
+    const std::vector<size_t>& chunkOffsets,
+    const std::vector<char>& categorical,
+    arma::Mat<T>& inout,
+    DatasetMapper<PolicyType>& infoSet,
+    const bool transpose,
+    const typename std::enable_if<
+        MapPolicyTraits<PolicyType>::MapsConcurrently>::type*)
+{
+  // The provisional mappings are held in the matrix until they are replaced;
+  // like the final mappings, they are exact as long as T can represent the
+  // number of distinct strings of a dimension.
+  const size_t numChunks = chunks.size() - 1;
+  PolicyType& policy = infoSet.Policy();
+  policy.StartConcurrentMapping(infoSet, categorical);
+
+  // The position of a token in its dimension is its line (or, without
+  // transposing, its index on the line), so positions follow file order.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    size_t line = chunkOffsets[c];
+    const char* p = chunks[c];
+    while (p != chunks[c + 1])
+    {
+      const char* lineEnd = FindLineEnd(p, chunks[c + 1]);
+      if (transpose || categorical[line])
+      {
+        TokenizeLine(p, lineEnd,
+            [&](const size_t token, const char* begin, const char* end)
+            {
+              const size_t row = transpose ? token : line;
+              const size_t col = transpose ? line : token;
+              if (categorical[row])
+              {
+                inout.at(row, col) = T(policy.MapConcurrently(begin, end, row,
+                    col));
+              }
+            });
+      }
+
+      ++line;
+      p = (lineEnd == chunks[c + 1]) ? lineEnd : lineEnd + 1;
+    }
+  }
+
+  // Now replace the provisional mappings with the final ones.
+  std::vector<std::vector<size_t>> ids;
+  policy.FinishConcurrentMapping(infoSet, ids);
+
+  std::vector<size_t> rows;
+  for (size_t d = 0; d < categorical.size(); ++d)
+    if (categorical[d])
+      rows.push_back(d);
+
+  #pragma omp parallel for
+  for (omp_size_t col = 0; col < (omp_size_t) inout.n_cols; ++col)
+  {
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+      T& value = inout.at(rows[i], col);
+      value = T(ids[rows[i]][(size_t) value]);
+    }
+  }
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
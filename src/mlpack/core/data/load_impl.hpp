@@ -16,18 +16,22 @@
 
 #include <exception>
 #include <algorithm>
+#include <memory>
 #include <mlpack/core/util/timers.hpp>
 
 #include "load_csv.hpp"
 #include "load.hpp"
 #include "extension.hpp"
 #include "detect_file_type.hpp"
+#include "input_file.hpp"
 
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/tokenizer.hpp>
 #include <boost/algorithm/string.hpp>
 
 #include "load_arff.hpp"
+#include "binary_matrix.hpp"
+#include "libsvm.hpp"
 
 namespace mlpack {
 namespace data {
@@ -62,6 +66,28 @@ void TransposeTokens(std::vector<std::vector<std::string>> const &input,
   }
 }
 
+//! Load a .mlbin file along with the DatasetInfo stored in it.
+template<typename eT>
+void LoadBinaryMatrixWithInfo(const std::string& filename,
+                              arma::Mat<eT>& matrix,
+                              DatasetInfo& info,
+                              const bool transpose)
+{
+  LoadBinaryMatrix(filename, matrix, &info, transpose);
+}
+
+//! Other kinds of DatasetMapper are not stored in .mlbin files, so only the
+//! dimensionality can be set.
+template<typename eT, typename PolicyType>
+void LoadBinaryMatrixWithInfo(const std::string& filename,
+                              arma::Mat<eT>& matrix,
+                              DatasetMapper<PolicyType>& info,
+                              const bool transpose)
+{
+  LoadBinaryMatrix(filename, matrix, (DatasetInfo*) NULL, transpose);
+  info.SetDimensionality(matrix.n_rows);
+}
+
 } // namespace details
 
 template <typename MatType>
@@ -94,14 +120,54 @@ bool Load(const std::string& filename,
 {
   Timer::Start("loading_data");
 
-  // Catch nonexistent files by opening the stream ourselves.
-  std::fstream stream;
-#ifdef  _WIN32 // Always open in binary mode on Windows.
-  stream.open(filename.c_str(), std::fstream::in | std::fstream::binary);
-#else
-  stream.open(filename.c_str(), std::fstream::in);
-#endif
-  if (!stream.is_open())
+  // mlpack's own binary format is handled separately, since it is copied from a
+  // mapping of the file.
+  if (inputLoadType == arma::auto_detect &&
+      UncompressedExtension(filename) == "mlbin")
+  {
+    Log::Info << "Loading '" << filename << "' as mlpack binary data.  "
+        << std::flush;
+    try
+    {
+      LoadBinaryMatrix(filename, matrix, (DatasetInfo*) NULL, transpose);
+    }
+    catch (std::exception& e)
+    {
+      Log::Info << std::endl;
+      Timer::Stop("loading_data");
+      if (fatal)
+        Log::Fatal << e.what() << std::endl;
+      else
+        Log::Warn << e.what() << std::endl;
+
+      return false;
+    }
+
+    Log::Info << "Size is " << (transpose ? matrix.n_cols : matrix.n_rows)
+        << " x " << (transpose ? matrix.n_rows : matrix.n_cols) << ".\n";
+    Timer::Stop("loading_data");
+    return true;
+  }
+
+  // Catch nonexistent files by opening the stream ourselves.  A compressed file
+  // is decompressed into memory here, since detecting its type needs seeks.
+  std::unique_ptr<InputFile> stream;
+  try
+  {
+    stream.reset(new InputFile(filename, true));
+  }
+  catch (std::exception& e)
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << e.what() << std::endl;
+    else
+      Log::Warn << e.what() << std::endl;
+
+    return false;
+  }
+
+  if (!stream->is_open())
   {
     Timer::Stop("loading_data");
     if (fatal)
@@ -118,7 +184,7 @@ bool Load(const std::string& filename,
   if (inputLoadType == arma::auto_detect)
   {
     // Attempt to auto-detect the type from the given file.
-    loadType = AutoDetect(stream, filename);
+    loadType = AutoDetect(*stream, filename);
     // Provide error if we don't know the type.
     if (loadType == arma::file_type_unknown)
     {
@@ -165,7 +231,7 @@ bool Load(const std::string& filename,
   // We can't use the stream if the type is HDF5.
   bool success;
   if (loadType != arma::hdf5_binary)
-    success = matrix.load(stream, loadType);
+    success = matrix.load(*stream, loadType);
   else
     success = matrix.load(filename, loadType);
 
@@ -207,8 +273,8 @@ bool Load(const std::string& filename,
   // Get the extension and load as necessary.
   Timer::Start("loading_data");
 
-  // Get the extension.
-  std::string extension = Extension(filename);
+  // Get the extension, ignoring any compression.
+  std::string extension = UncompressedExtension(filename);
 
   // Catch nonexistent files by opening the stream ourselves.
   std::fstream stream;
@@ -270,6 +336,25 @@ bool Load(const std::string& filename,
       return false;
     }
   }
+  else if (extension == "mlbin")
+  {
+    Log::Info << "Loading '" << filename << "' as mlpack binary data.  "
+        << std::flush;
+    try
+    {
+      details::LoadBinaryMatrixWithInfo(filename, matrix, info, transpose);
+    }
+    catch (std::exception& e)
+    {
+      Timer::Stop("loading_data");
+      if (fatal)
+        Log::Fatal << e.what() << std::endl;
+      else
+        Log::Warn << e.what() << std::endl;
+
+      return false;
+    }
+  }
   else
   {
     // The type is unknown.
@@ -301,17 +386,28 @@ bool Load(const std::string& filename,
 {
   Timer::Start("loading_data");
 
-  // Get the extension.
-  std::string extension = Extension(filename);
+  // Get the extension, ignoring any compression.
+  std::string extension = UncompressedExtension(filename);
 
-  // Catch nonexistent files by opening the stream ourselves.
-  std::fstream stream;
-#ifdef  _WIN32 // Always open in binary mode on Windows.
-  stream.open(filename.c_str(), std::fstream::in | std::fstream::binary);
-#else
-  stream.open(filename.c_str(), std::fstream::in);
-#endif
-  if (!stream.is_open())
+  // Catch nonexistent files by opening the stream ourselves.  A compressed file
+  // is decompressed on a background thread as it is read.
+  std::unique_ptr<InputFile> stream;
+  try
+  {
+    stream.reset(new InputFile(filename));
+  }
+  catch (std::exception& e)
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << e.what() << std::endl;
+    else
+      Log::Warn << e.what() << std::endl;
+
+    return false;
+  }
+
+  if (!stream->is_open())
   {
     Timer::Stop("loading_data");
     if (fatal)
@@ -323,6 +419,35 @@ bool Load(const std::string& filename,
     return false;
   }
 
+  if (DetectLibSVM(*stream, filename))
+  {
+    Log::Info << "Loading '" << filename << "' as libsvm data (ignoring "
+        << "labels).  " << std::flush;
+    try
+    {
+      arma::Row<eT> labels;
+      LoadLibSVM(filename, matrix, labels);
+      if (!transpose)
+        matrix = matrix.t();
+    }
+    catch (std::exception& e)
+    {
+      Log::Info << std::endl;
+      Timer::Stop("loading_data");
+      if (fatal)
+        Log::Fatal << e.what() << std::endl;
+      else
+        Log::Warn << e.what() << std::endl;
+
+      return false;
+    }
+
+    Log::Info << "Size is " << (transpose ? matrix.n_cols : matrix.n_rows)
+        << " x " << (transpose ? matrix.n_rows : matrix.n_cols) << ".\n";
+    Timer::Stop("loading_data");
+    return true;
+  }
+
   bool unknownType = false;
   arma::file_type loadType;
   std::string stringType;
@@ -339,11 +464,11 @@ bool Load(const std::string& filename,
     const std::string ARMA_SPM_BIN = "ARMA_SPM_BIN";
     std::string rawHeader(ARMA_SPM_BIN.length(), '\0');
 
-    std::streampos pos = stream.tellg();
+    std::streampos pos = stream->tellg();
 
-    stream.read(&rawHeader[0], std::streamsize(ARMA_SPM_BIN.length()));
-    stream.clear();
-    stream.seekg(pos); // Reset stream position after peeking.
+    stream->read(&rawHeader[0], std::streamsize(ARMA_SPM_BIN.length()));
+    stream->clear();
+    stream->seekg(pos); // Reset stream position after peeking.
 
     if (rawHeader == ARMA_SPM_BIN)
     {
@@ -387,7 +512,7 @@ bool Load(const std::string& filename,
 
   bool success;
 
-  success = matrix.load(stream, loadType);
+  success = matrix.load(*stream, loadType);
 
   if (!success)
   {
@@ -416,6 +541,39 @@ bool Load(const std::string& filename,
   return success;
 }
 
+// For loading a sparse matrix with labels from a libsvm file.
+template<typename eT, typename LabelType>
+bool Load(const std::string& filename,
+          arma::SpMat<eT>& matrix,
+          arma::Row<LabelType>& labels,
+          const bool fatal,
+          const size_t dimensionality)
+{
+  Timer::Start("loading_data");
+
+  Log::Info << "Loading '" << filename << "' as libsvm data.  " << std::flush;
+  try
+  {
+    LoadLibSVM(filename, matrix, labels, dimensionality);
+  }
+  catch (std::exception& e)
+  {
+    Log::Info << std::endl;
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << e.what() << std::endl;
+    else
+      Log::Warn << e.what() << std::endl;
+
+    return false;
+  }
+
+  Log::Info << "Size is " << matrix.n_cols << " x " << matrix.n_rows << ".\n";
+  Timer::Stop("loading_data");
+
+  return true;
+}
+
 } // namespace data
 } // namespace mlpack
 
@@ -16,6 +16,7 @@
 #include "load.hpp"
 
 #include "extension.hpp"
+#include "bulk_model.hpp"
 
 #include <cereal/archives/xml.hpp>
 #include <cereal/archives/binary.hpp>
@@ -42,6 +43,8 @@ bool Load(const std::string& filename,
       f = format::binary;
     else if (extension == "json")
       f = format::json;
+    else if (extension == "mlpk" || extension == "mlpkz")
+      f = format::bulk;
     else
     {
       if (fatal)
@@ -55,6 +58,26 @@ bool Load(const std::string& filename,
     }
   }
 
+  // Bulk model files are read by their own archive; compressed and
+  // uncompressed files are loaded the same way.
+  if (f == format::bulk || f == format::bulk_compressed)
+  {
+    try
+    {
+      LoadBulkModel(filename, name, t);
+      return true;
+    }
+    catch (std::exception& e)
+    {
+      if (fatal)
+        Log::Fatal << e.what() << std::endl;
+      else
+        Log::Warn << e.what() << std::endl;
+
+      return false;
+    }
+  }
+
   // Now load the given format.
   std::ifstream ifs;
 #ifdef _WIN32 // Open non-text in binary mode on Windows.
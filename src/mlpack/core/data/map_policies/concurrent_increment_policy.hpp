@@ -0,0 +1,181 @@
+/**
+ * @file core/data/map_policies/concurrent_increment_policy.hpp
+ *
+ * A variant of IncrementPolicy whose mappings can be built by many threads at
+ * once.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MAP_POLICIES_CONCURRENT_INCREMENT_POLICY_HPP
+#define MLPACK_CORE_DATA_MAP_POLICIES_CONCURRENT_INCREMENT_POLICY_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/map_policies/increment_policy.hpp>
+#include <mlpack/core/data/string_table.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * ConcurrentIncrementPolicy maps strings exactly as IncrementPolicy does: the
+ * distinct strings of a categorical dimension are mapped to 0, 1, 2, ... in
+ * the order they first appear.  The difference is in how loaders can build the
+ * mappings.  Instead of handing each token to MapString() one at a time, in
+ * file order, a parallel loader can map the tokens of a file from all of its
+ * threads at once with MapConcurrently().  Tokens are hashed where they lie,
+ * and only the first occurrence of each distinct string is copied (see
+ * StringTable); this makes loading much faster for datasets with many distinct
+ * categories, such as user ids.  The final mappings do not depend on the
+ * number of threads, and are the same as IncrementPolicy gives.
+ *
+ * Only the parsing gets faster: the DatasetMapper still keeps its own copies
+ * of every distinct string, just as with IncrementPolicy, so the memory it
+ * holds after loading is the same.  While the mappings are finished, the
+ * string table of each dimension is freed as soon as its strings are copied,
+ * so at most one table is held next to the copies.
+ *
+ * Use it by loading into a DatasetMapper<ConcurrentIncrementPolicy>:
+ *
+ * @code
+ * data::DatasetMapper<data::ConcurrentIncrementPolicy> info;
+ * arma::mat dataset;
+ * data::Load("users.csv", dataset, info);
+ * @endcode
+ *
+ * A concurrent mapping goes in three steps:
+ *
+ *  - StartConcurrentMapping() prepares a StringTable for each categorical
+ *    dimension, holding the strings the DatasetMapper has already mapped.
+ *  - MapConcurrently() is called from any number of threads with each token
+ *    and its position in the dimension, and returns a provisional id.
+ *  - FinishConcurrentMapping() adds the new strings to the DatasetMapper in the
+ *    order of their first positions, and gives the final id of every
+ *    provisional id.
+ */
+class ConcurrentIncrementPolicy : public IncrementPolicy
+{
+ public:
+  ConcurrentIncrementPolicy(const bool forceAllMappings = false) :
+      IncrementPolicy(forceAllMappings) { }
+
+  //! Copy the policy; a concurrent mapping in progress is not copied.
+  ConcurrentIncrementPolicy(const ConcurrentIncrementPolicy& other) :
+      IncrementPolicy(other) { }
+
+  //! Copy the policy; a concurrent mapping in progress is not copied.
+  ConcurrentIncrementPolicy& operator=(const ConcurrentIncrementPolicy& other)
+  {
+    IncrementPolicy::operator=(other);
+    tables.clear();
+    offsets.clear();
+    return *this;
+  }
+
+  /**
+   * Prepare to map the tokens of the given dimensions concurrently.  The
+   * strings that the mapper already has for those dimensions keep their
+   * mappings.
+   *
+   * @param mapper The DatasetMapper that holds this policy.
+   * @param dimensions For each dimension, whether its tokens will be mapped.
+   */
+  template<typename MapperType>
+  void StartConcurrentMapping(const MapperType& mapper,
+                              const std::vector<char>& dimensions)
+  {
+    tables.clear();
+    tables.resize(dimensions.size());
+    offsets.assign(dimensions.size(), 0);
+    for (size_t d = 0; d < dimensions.size(); ++d)
+    {
+      if (!dimensions[d])
+        continue;
+
+      tables[d].reset(new StringTable());
+      offsets[d] = mapper.NumMappings(d);
+      for (size_t i = 0; i < offsets[d]; ++i)
+      {
+        const std::string& str = mapper.UnmapString(i, d);
+        tables[d]->Insert(str.data(), str.size(), i);
+      }
+    }
+  }
+
+  /**
+   * Map the given token of the given dimension, and return its provisional
+   * id.  This may be called from many threads at once.  The position orders
+   * the tokens of a dimension; with positions in file order, the final
+   * mappings are those that a serial pass would give.
+   *
+   * @param begin Start of the token.
+   * @param end End of the token.
+   * @param dimension Dimension of the token.
+   * @param position Position of the token in its dimension.
+   */
+  size_t MapConcurrently(const char* begin,
+                         const char* end,
+                         const size_t dimension,
+                         const size_t position)
+  {
+    return tables[dimension]->Insert(begin, end - begin,
+        offsets[dimension] + position);
+  }
+
+  /**
+   * Add the strings that were mapped concurrently to the mapper, and store in
+   * ids[d][provisionalId] the final mapping of each provisional id of
+   * dimension d.  The types of the mapped dimensions must already be
+   * categorical.  The string table of each dimension is freed once its strings
+   * are copied into the mapper.
+   *
+   * @param mapper The DatasetMapper that holds this policy.
+   * @param ids Vector to store the final mappings in.
+   */
+  template<typename MapperType>
+  void FinishConcurrentMapping(MapperType& mapper,
+                               std::vector<std::vector<size_t>>& ids)
+  {
+    ids.clear();
+    ids.resize(tables.size());
+    for (size_t d = 0; d < tables.size(); ++d)
+    {
+      if (!tables[d])
+        continue;
+
+      // The strings come out in the order MapString() gives them mappings.
+      tables[d]->Finalize(ids[d]);
+      for (size_t i = offsets[d]; i < tables[d]->Size(); ++i)
+        mapper.template MapString<size_t>(tables[d]->String(i), d);
+
+      // The mapper has its own copies now, so the arena can go.
+      tables[d].reset();
+    }
+
+    tables.clear();
+    offsets.clear();
+  }
+
+ private:
+  //! The string table of each dimension being mapped (NULL for the others).
+  std::vector<std::unique_ptr<StringTable>> tables;
+  //! The number of mappings each dimension had before mapping started.
+  std::vector<size_t> offsets;
+}; // class ConcurrentIncrementPolicy
+
+//! ConcurrentIncrementPolicy only maps tokens that aren't numbers (unless
+//! forced), and can map them concurrently.
+template<>
+class MapPolicyTraits<ConcurrentIncrementPolicy>
+{
+ public:
+  static const bool PassesNumbersThrough = true;
+  static const bool MapsConcurrently = true;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
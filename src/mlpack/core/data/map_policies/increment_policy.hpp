@@ -15,6 +15,7 @@
 #include <mlpack/prereqs.hpp>
 #include <unordered_map>
 #include <mlpack/core/data/map_policies/datatype.hpp>
+#include <mlpack/core/data/map_policies/map_policy_traits.hpp>
 
 namespace mlpack {
 namespace data {
@@ -147,6 +148,15 @@ class IncrementPolicy
   bool forceAllMappings;
 }; // class IncrementPolicy
 
+//! IncrementPolicy only maps tokens that aren't numbers (unless forced).
+template<>
+class MapPolicyTraits<IncrementPolicy>
+{
+ public:
+  static const bool PassesNumbersThrough = true;
+  static const bool MapsConcurrently = false;
+};
+
 } // namespace data
 } // namespace mlpack
 
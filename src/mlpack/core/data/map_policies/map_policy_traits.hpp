@@ -0,0 +1,54 @@
+/**
+ * @file core/data/map_policies/map_policy_traits.hpp
+ *
+ * This provides the MapPolicyTraits class, a template class to get information
+ * about various mapping policies used by DatasetMapper.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MAP_POLICIES_MAP_POLICY_TRAITS_HPP
+#define MLPACK_CORE_DATA_MAP_POLICIES_MAP_POLICY_TRAITS_HPP
+
+namespace mlpack {
+namespace data {
+
+/**
+ * This is a template class that can provide information about various mapping
+ * policies.  By default, this class will provide the weakest possible
+ * assumptions on policies, and each policy should override values as
+ * necessary.  If a policy doesn't need to override a value, then there's no
+ * need to write a MapPolicyTraits specialization for that class.
+ */
+template<typename PolicyType>
+class MapPolicyTraits
+{
+ public:
+  /**
+   * If true, then the policy passes numbers through unchanged: in a numeric
+   * dimension, MapString() returns any token that can be read as a number as
+   * that number, without touching the mappings.  In addition, MapFirstPass()
+   * only makes a dimension categorical when it sees a token that cannot be
+   * read as a number, or else it does so for any token of that dimension (as
+   * IncrementPolicy does when all mappings are forced).
+   *
+   * This allows loaders to parse numeric tokens in parallel, and only hand the
+   * remaining tokens to the DatasetMapper.
+   */
+  static const bool PassesNumbersThrough = false;
+
+  /**
+   * If true, then the policy can map tokens from many threads at once, with
+   * StartConcurrentMapping(), MapConcurrently() and FinishConcurrentMapping()
+   * (see ConcurrentIncrementPolicy).  Loaders that parse in parallel then do
+   * not have to map the tokens one at a time, in file order.
+   */
+  static const bool MapsConcurrently = false;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
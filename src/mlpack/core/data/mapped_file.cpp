@@ -0,0 +1,218 @@
+/**
+ * @file core/data/mapped_file.cpp
+ *
+ * Implementation of the MappedFile class and the line splitting helpers.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "mapped_file.hpp"
+#include "decompress.hpp"
+
+#include <fstream>
+#include <sstream>
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+MappedFile::MappedFile(const std::string& filename) :
+    filename(filename),
+    data(NULL),
+    size(0),
+    mapped(false)
+{
+  // A compressed file is no use to anyone as it is, so we decompress it instead
+  // of mapping it.
+  const Compression compression = DetectCompression(filename);
+  if (compression != Compression::none)
+  {
+    DecompressFile(filename, compression, data, size);
+    return;
+  }
+
+#ifndef _WIN32
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    std::ostringstream oss;
+    oss << "Cannot open file '" << filename << "'. " << std::endl;
+    throw std::runtime_error(oss.str());
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0)
+  {
+    close(fd);
+    std::ostringstream oss;
+    oss << "Cannot determine size of file '" << filename << "'. " << std::endl;
+    throw std::runtime_error(oss.str());
+  }
+
+  size = (size_t) st.st_size;
+
+  // mmap() cannot map an empty file; there is nothing to map anyway.
+  if (size > 0)
+  {
+    void* region = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd,
+        0);
+    if (region == MAP_FAILED)
+    {
+      close(fd);
+      std::ostringstream oss;
+      oss << "Cannot map file '" << filename << "' into memory. " << std::endl;
+      throw std::runtime_error(oss.str());
+    }
+
+    // We will read the file front to back, so let the kernel read ahead.
+    madvise(region, size, MADV_SEQUENTIAL);
+
+    data = static_cast<char*>(region);
+    mapped = true;
+  }
+
+  // The mapping stays valid after the descriptor is closed.
+  close(fd);
+#else
+  std::ifstream stream(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!stream.is_open())
+  {
+    std::ostringstream oss;
+    oss << "Cannot open file '" << filename << "'. " << std::endl;
+    throw std::runtime_error(oss.str());
+  }
+
+  stream.seekg(0, std::ios::end);
+  size = (size_t) stream.tellg();
+  stream.seekg(0, std::ios::beg);
+
+  if (size > 0)
+  {
+    data = new char[size];
+    stream.read(data, size);
+    if (!stream.good())
+    {
+      Reset();
+      std::ostringstream oss;
+      oss << "Cannot read file '" << filename << "'. " << std::endl;
+      throw std::runtime_error(oss.str());
+    }
+  }
+#endif
+}
+
+MappedFile::MappedFile(MappedFile&& other) :
+    filename(std::move(other.filename)),
+    data(other.data),
+    size(other.size),
+    mapped(other.mapped)
+{
+  other.data = NULL;
+  other.size = 0;
+  other.mapped = false;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other)
+{
+  if (this != &other)
+  {
+    Reset();
+
+    filename = std::move(other.filename);
+    data = other.data;
+    size = other.size;
+    mapped = other.mapped;
+
+    other.data = NULL;
+    other.size = 0;
+    other.mapped = false;
+  }
+
+  return *this;
+}
+
+MappedFile::~MappedFile()
+{
+  Reset();
+}
+
+void MappedFile::Reset()
+{
+#ifndef _WIN32
+  if (mapped && data != NULL)
+    munmap(data, size);
+  else
+    delete[] data;
+#else
+  delete[] data;
+#endif
+
+  data = NULL;
+  size = 0;
+  mapped = false;
+}
+
+void SplitChunks(const char* begin,
+                 const char* end,
+                 std::vector<const char*>& chunks)
+{
+  size_t threads = 1;
+  #ifdef HAS_OPENMP
+    threads = omp_get_max_threads();
+  #endif
+
+  // Use a few chunks per thread so that the work stays balanced when some
+  // lines are more expensive than others, but don't split small files at all.
+  const size_t size = end - begin;
+  const size_t minChunkSize = 1 << 20;
+  const size_t numChunks = std::max((size_t) 1,
+      std::min(4 * threads, size / minChunkSize));
+
+  chunks.clear();
+  chunks.push_back(begin);
+  for (size_t i = 1; i < numChunks; ++i)
+  {
+    // Move each boundary forward to the start of the next line.
+    const char* p = std::max(begin + i * (size / numChunks), chunks.back());
+    const char* newline = static_cast<const char*>(
+        std::memchr(p, '\n', end - p));
+    chunks.push_back((newline == NULL) ? end : newline + 1);
+  }
+  chunks.push_back(end);
+}
+
+size_t CountLines(const char* begin, const char* end)
+{
+  size_t lines = 0;
+  const char* p = begin;
+  while (p != end)
+  {
+    const char* newline = static_cast<const char*>(
+        std::memchr(p, '\n', end - p));
+    ++lines;
+    if (newline == NULL)
+      break;
+
+    p = newline + 1;
+  }
+
+  return lines;
+}
+
+const char* FindLineEnd(const char* begin, const char* end)
+{
+  const char* newline = static_cast<const char*>(
+      std::memchr(begin, '\n', end - begin));
+  return (newline == NULL) ? end : newline;
+}
+
+} // namespace data
+} // namespace mlpack
@@ -0,0 +1,105 @@
+/**
+ * @file core/data/mapped_file.hpp
+ *
+ * A simple RAII wrapper around a private, copy-on-write memory mapping of a
+ * file: the mapping may be written to, but writes never reach the file.  On
+ * systems without mmap(), the file is instead read into memory.  Also contains
+ * helpers to split mapped text into lines for parallel parsing.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MAPPED_FILE_HPP
+#define MLPACK_CORE_DATA_MAPPED_FILE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * MappedFile gives access to the contents of a file as a contiguous block of
+ * memory.  Where mmap() is available, the file is mapped privately: the pages
+ * are only read from disk when they are touched, and writes to the mapping are
+ * copy-on-write and never reach the file.  Otherwise (e.g. on Windows), the
+ * whole file is read into a heap buffer.  Files compressed with gzip or zstd
+ * cannot be mapped, so they are decompressed into a heap buffer, and Data()
+ * gives the decompressed contents.
+ *
+ * The mapping lives as long as the MappedFile object; any pointer obtained via
+ * Data() is invalid once the object is destroyed.  MappedFile objects may be
+ * moved but not copied.
+ */
+class MappedFile
+{
+ public:
+  /**
+   * Map the given file into memory.  A std::runtime_error is thrown if the
+   * file cannot be opened or mapped.
+   *
+   * @param filename Name of file to map.
+   */
+  MappedFile(const std::string& filename);
+
+  //! Take ownership of the mapping held by another MappedFile.
+  MappedFile(MappedFile&& other);
+
+  //! Take ownership of the mapping held by another MappedFile.
+  MappedFile& operator=(MappedFile&& other);
+
+  //! Unmap the file.
+  ~MappedFile();
+
+  //! Get a pointer to the start of the file contents.
+  const char* Data() const { return data; }
+  //! Modify the contents of the mapping (this never modifies the file).
+  char* Data() { return data; }
+
+  //! Get the size of the file in bytes.
+  size_t Size() const { return size; }
+
+  //! Return whether the file is mapped (as opposed to read into memory).
+  bool IsMapped() const { return mapped; }
+
+  //! Get the name of the mapped file.
+  const std::string& Filename() const { return filename; }
+
+ private:
+  // Copying a mapping is not allowed.
+  MappedFile(const MappedFile& other);
+  MappedFile& operator=(const MappedFile& other);
+
+  //! Release the mapping or buffer, if any.
+  void Reset();
+
+  //! Name of the mapped file.
+  std::string filename;
+  //! Start of the file contents.
+  char* data;
+  //! Size of the file contents in bytes.
+  size_t size;
+  //! Whether data points to an mmap() region or a heap buffer.
+  bool mapped;
+};
+
+/**
+ * Split [begin, end) into chunks of whole lines, for threads to parse in
+ * parallel.  A few chunks are made per thread, but small inputs are not split.
+ * On return, chunk i is [chunks[i], chunks[i + 1]).
+ */
+void SplitChunks(const char* begin,
+                 const char* end,
+                 std::vector<const char*>& chunks);
+
+//! Count the number of lines in [begin, end), as std::getline() would.
+size_t CountLines(const char* begin, const char* end);
+
+//! Find the end of the line starting at begin (the newline, or end).
+const char* FindLineEnd(const char* begin, const char* end);
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -15,6 +15,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core.hpp>
+#include <mlpack/core/data/chunk_reader.hpp>
 
 namespace mlpack {
 namespace data {
@@ -36,7 +37,9 @@ void OneHotEncoding(const RowType& labelsIn,
 /**
  * Overloaded function for the above function, which takes a matrix as input
  * and also a vector of indices to encode and outputs a matrix.
- * Indices represent the IDs of the dimensions to be one-hot encoded.
+ * Indices represent the IDs of the dimensions to be one-hot encoded.  NaN
+ * values can't be one-hot encoded, so a std::invalid_argument is thrown if a
+ * dimension to encode has one.
  *
  * @param input Input dataset to be encoded.
  * @param indices Index of rows to be encoded.
@@ -62,6 +65,76 @@ void OneHotEncoding(const arma::Mat<eT>& input,
                     arma::Mat<eT>& output,
                     const data::DatasetInfo& datasetInfo);
 
+/**
+ * Overloaded function for the above function, which takes a matrix as input
+ * and also a vector of indices to encode and outputs a sparse matrix.  The
+ * sparse matrix is built directly in the compressed sparse column format, so
+ * the memory used only grows with the number of encoded dimensions and
+ * nonzero values, not with the number of distinct values; dimensions that are
+ * not encoded are copied, and their zeros are not stored.  The result is the
+ * same as that of the dense version, and NaN values are rejected the same way.
+ *
+ * @param input Input dataset to be encoded.
+ * @param indices Index of rows to be encoded.
+ * @param output Encoded sparse matrix.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    arma::SpMat<eT>& output);
+
+/**
+ * Overloaded function for the above function, which takes a matrix as input
+ * and also a DatasetInfo object and outputs a sparse matrix.
+ * This function encodes all the dimensions marked `Datatype::categorical`
+ * in the data::DatasetInfo, and copies the numeric dimensions.
+ *
+ * @param input Input dataset to be encoded.
+ * @param output Encoded sparse matrix.
+ * @param datasetInfo DatasetInfo object that has information about data.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    arma::SpMat<eT>& output,
+                    const data::DatasetInfo& datasetInfo);
+
+/**
+ * One-hot encode a dataset that is read in chunks by the given ChunkReader, so
+ * that datasets larger than memory can be encoded.  This takes two passes over
+ * the data: the first finds the distinct values of the dimensions to encode,
+ * and the second encodes each chunk into a sparse matrix and passes it to
+ * `handleChunk`, which has to be callable as
+ *
+ * @code
+ * void handleChunk(const arma::SpMat<eT>& encodedChunk);
+ * @endcode
+ *
+ * The encoded chunks all have the same number of rows, and put together, are
+ * the same as the in-memory encoding of the whole dataset.  A
+ * std::invalid_argument is thrown if an index is not a dimension of the data,
+ * if a dimension to encode has a NaN value, or if the second pass finds a value
+ * that the first did not (that is, if the data changed in between).
+ *
+ * @param reader ChunkReader to read the dataset with.
+ * @param indices Index of rows to be encoded.
+ * @param handleChunk Function to call with each encoded chunk.
+ */
+template<typename eT, typename PolicyType, typename ChunkHandlerType>
+void OneHotEncoding(ChunkReader<eT, PolicyType>& reader,
+                    const arma::Col<size_t>& indices,
+                    ChunkHandlerType handleChunk);
+
+/**
+ * Overloaded function for the above function, which encodes all the dimensions
+ * that the DatasetMapper of the reader marks `Datatype::categorical`.
+ *
+ * @param reader ChunkReader to read the dataset with.
+ * @param handleChunk Function to call with each encoded chunk.
+ */
+template<typename eT, typename PolicyType, typename ChunkHandlerType>
+void OneHotEncoding(ChunkReader<eT, PolicyType>& reader,
+                    ChunkHandlerType handleChunk);
+
 } // namespace data
 } // namespace mlpack
 
@@ -65,6 +65,183 @@ void OneHotEncoding(const RowType& labelsIn,
   labelMap.clear();
 }
 
+namespace details {
+
+/**
+ * Mark the dimensions to encode, and make an empty mapping for each of them.
+ * A std::invalid_argument is thrown if an index is not a dimension.
+ */
+template<typename eT>
+void OneHotPrepare(const size_t dimensionality,
+                   const arma::Col<size_t>& indices,
+                   std::vector<char>& encoded,
+                   std::vector<std::unordered_map<eT, size_t>>& mappings)
+{
+  encoded.assign(dimensionality, 0);
+  mappings.clear();
+  mappings.resize(dimensionality);
+  for (size_t i = 0; i < indices.n_elem; ++i)
+  {
+    if (indices[i] >= dimensionality)
+    {
+      std::ostringstream oss;
+      oss << "OneHotEncoding(): dimension " << indices[i] << " is out of "
+          << "range; the data only has " << dimensionality << " dimensions!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    encoded[indices[i]] = 1;
+  }
+}
+
+/**
+ * Add the values of the given points that haven't been seen yet to the
+ * mappings of the encoded dimensions.  Each new value of a dimension is mapped
+ * to the next free index of that dimension, in the order of the points.  The
+ * dimensions are independent, so they are mapped in parallel.  NaN is not equal
+ * to itself and so can't be mapped; a std::invalid_argument is thrown if an
+ * encoded dimension has a NaN value.
+ */
+template<typename eT>
+void OneHotMapValues(const arma::Mat<eT>& input,
+                     const std::vector<char>& encoded,
+                     std::vector<std::unordered_map<eT, size_t>>& mappings)
+{
+  size_t numNaN = 0;
+  #pragma omp parallel for schedule(dynamic) reduction(+: numNaN)
+  for (omp_size_t row = 0; row < (omp_size_t) input.n_rows; ++row)
+  {
+    if (!encoded[row])
+      continue;
+
+    std::unordered_map<eT, size_t>& mapping = mappings[row];
+    for (size_t col = 0; col < input.n_cols; ++col)
+    {
+      if (std::isnan(input(row, col)))
+        ++numNaN;
+      else
+        mapping.emplace(input(row, col), mapping.size());
+    }
+  }
+
+  if (numNaN > 0)
+  {
+    std::ostringstream oss;
+    oss << "OneHotEncoding(): " << numNaN << " NaN values found in the "
+        << "dimensions to encode; NaN cannot be one-hot encoded!";
+    throw std::invalid_argument(oss.str());
+  }
+}
+
+/**
+ * Throw a std::invalid_argument if the given number of values were not found in
+ * the mappings when encoding.  This can only happen when the data changes
+ * between the passes over a ChunkReader.
+ */
+inline void OneHotCheckUnknown(const size_t numUnknown)
+{
+  if (numUnknown > 0)
+  {
+    std::ostringstream oss;
+    oss << "OneHotEncoding(): " << numUnknown << " values to encode were not "
+        << "seen when the mappings were built!";
+    throw std::invalid_argument(oss.str());
+  }
+}
+
+/**
+ * Compute the first output dimension of each input dimension.  The last
+ * element of offsets is the total number of output dimensions.
+ */
+template<typename eT>
+void OneHotOffsets(const std::vector<char>& encoded,
+                   const std::vector<std::unordered_map<eT, size_t>>& mappings,
+                   std::vector<size_t>& offsets)
+{
+  offsets.resize(encoded.size() + 1);
+  offsets[0] = 0;
+  for (size_t i = 0; i < encoded.size(); ++i)
+    offsets[i + 1] = offsets[i] + (encoded[i] ? mappings[i].size() : 1);
+}
+
+/**
+ * One-hot encode the given points into a sparse matrix with the given
+ * mappings, building the compressed sparse column format directly: the first
+ * pass counts the nonzeros of each point, and the second writes them.
+ */
+template<typename eT>
+void OneHotEncodeSparse(
+    const arma::Mat<eT>& input,
+    const std::vector<char>& encoded,
+    const std::vector<std::unordered_map<eT, size_t>>& mappings,
+    const std::vector<size_t>& offsets,
+    arma::SpMat<eT>& output)
+{
+  size_t numEncoded = 0;
+  for (size_t row = 0; row < input.n_rows; ++row)
+    numEncoded += encoded[row];
+
+  arma::uvec colPtrs(input.n_cols + 1);
+  colPtrs[0] = 0;
+  #pragma omp parallel for
+  for (omp_size_t col = 0; col < (omp_size_t) input.n_cols; ++col)
+  {
+    size_t nonzeros = numEncoded;
+    for (size_t row = 0; row < input.n_rows; ++row)
+    {
+      if (!encoded[row] && input(row, col) != eT(0))
+        ++nonzeros;
+    }
+
+    colPtrs[col + 1] = nonzeros;
+  }
+
+  for (size_t col = 0; col < input.n_cols; ++col)
+    colPtrs[col + 1] += colPtrs[col];
+
+  // The output dimensions of each input dimension come after those of the
+  // previous one, so the row indices of each column are already sorted.
+  arma::uvec rowIndices(colPtrs[input.n_cols]);
+  arma::Col<eT> values(colPtrs[input.n_cols]);
+  size_t numUnknown = 0;
+  #pragma omp parallel for reduction(+: numUnknown)
+  for (omp_size_t col = 0; col < (omp_size_t) input.n_cols; ++col)
+  {
+    size_t j = colPtrs[col];
+    for (size_t row = 0; row < input.n_rows; ++row)
+    {
+      const eT value = input(row, col);
+      if (encoded[row])
+      {
+        typename std::unordered_map<eT, size_t>::const_iterator it =
+            mappings[row].find(value);
+        if (it == mappings[row].end())
+        {
+          // Keep the structure of the column valid until we throw.
+          ++numUnknown;
+          rowIndices[j] = offsets[row];
+        }
+        else
+        {
+          rowIndices[j] = offsets[row] + it->second;
+        }
+        values[j++] = eT(1);
+      }
+      else if (value != eT(0))
+      {
+        rowIndices[j] = offsets[row];
+        values[j++] = value;
+      }
+    }
+  }
+
+  OneHotCheckUnknown(numUnknown);
+  output = arma::SpMat<eT>(rowIndices, colPtrs, values, offsets.back(),
+      input.n_cols);
+}
+
+} // namespace details
+
 /**
  * Overloaded function for the above function, which takes a matrix as input
  * and also a vector of indices to encode and outputs a matrix.
@@ -86,61 +263,44 @@ void OneHotEncoding(const arma::Mat<eT>& input,
     return;
   }
 
-  // First, we need to compute the size of the output matrix.
-
-  // This vector will eventually hold the offsets for each dimension in the
-  // one-hot encoded matrix, but first it will just hold the counts of
-  // dimensions for each dimension.
-  arma::Col<size_t> dimensionOffsets(input.n_rows, arma::fill::ones);
-  // This will hold the mappings from a value that should be one-hot encoded to
-  // the index of the dimension it should take.
-  std::unordered_map<size_t, std::unordered_map<eT, size_t>> mappings;
-  for (size_t i = 0; i < indices.n_elem; ++i)
-  {
-    dimensionOffsets[indices[i]] = 0;
-    mappings.insert(
-        std::make_pair(indices[i], std::unordered_map<eT, size_t>()));
-  }
-
-  for (size_t col = 0; col < input.n_cols; ++col)
-  {
-    for (size_t row = 0; row < input.n_rows; ++row)
-    {
-      if (mappings.count(row) != 0)
-      {
-        // We have to one-hot encode this point.
-        if (mappings[row].count(input(row, col)) == 0)
-          mappings[row][input(row, col)] = dimensionOffsets[row]++;
-      }
-    }
-  }
-
-  // Turn the dimension counts into offsets.  Note that the last element is the
-  // total number of dimensions, and the first element is the offset for
-  // dimension *2* (not 1).
-  for (size_t i = 1; i < dimensionOffsets.n_elem; ++i)
-    dimensionOffsets[i] += dimensionOffsets[i - 1];
+  // First, map the values of each dimension that should be one-hot encoded to
+  // the index of the output dimension it should take, and compute the size of
+  // the output matrix.
+  std::vector<char> encoded;
+  std::vector<std::unordered_map<eT, size_t>> mappings;
+  std::vector<size_t> offsets;
+  details::OneHotPrepare(input.n_rows, indices, encoded, mappings);
+  details::OneHotMapValues(input, encoded, mappings);
+  details::OneHotOffsets(encoded, mappings, offsets);
 
   // Now, initialize the output matrix to the right size.
-  output.zeros(dimensionOffsets[dimensionOffsets.n_elem - 1], input.n_cols);
+  output.zeros(offsets.back(), input.n_cols);
 
   // Finally, one-hot encode the matrix.
-  for (size_t col = 0; col < input.n_cols; ++col)
+  size_t numUnknown = 0;
+  #pragma omp parallel for reduction(+: numUnknown)
+  for (omp_size_t col = 0; col < (omp_size_t) input.n_cols; ++col)
   {
     for (size_t row = 0; row < input.n_rows; ++row)
     {
-      const size_t dimOffset = (row == 0) ? 0 : dimensionOffsets[row - 1];
-      if (mappings.count(row) != 0)
+      if (encoded[row])
       {
-        output(dimOffset + mappings[row][input(row, col)], col) = eT(1);
+        typename std::unordered_map<eT, size_t>::const_iterator it =
+            mappings[row].find(input(row, col));
+        if (it == mappings[row].end())
+          ++numUnknown;
+        else
+          output(offsets[row] + it->second, col) = eT(1);
       }
       else
       {
         // No need for one-hot encoding.
-        output(dimOffset, col) = input(row, col);
+        output(offsets[row], col) = input(row, col);
       }
     }
   }
+
+  details::OneHotCheckUnknown(numUnknown);
 }
 
 /**
@@ -169,6 +329,77 @@ void OneHotEncoding(const arma::Mat<eT>& input,
   OneHotEncoding(input, arma::Col<size_t>(indices), output);
 }
 
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    arma::SpMat<eT>& output)
+{
+  std::vector<char> encoded;
+  std::vector<std::unordered_map<eT, size_t>> mappings;
+  std::vector<size_t> offsets;
+  details::OneHotPrepare(input.n_rows, indices, encoded, mappings);
+  details::OneHotMapValues(input, encoded, mappings);
+  details::OneHotOffsets(encoded, mappings, offsets);
+  details::OneHotEncodeSparse(input, encoded, mappings, offsets, output);
+}
+
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    arma::SpMat<eT>& output,
+                    const data::DatasetInfo& datasetInfo)
+{
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < datasetInfo.Dimensionality(); ++i)
+  {
+    if (datasetInfo.Type(i) == data::Datatype::categorical)
+      indices.push_back(i);
+  }
+
+  OneHotEncoding(input, arma::Col<size_t>(indices), output);
+}
+
+template<typename eT, typename PolicyType, typename ChunkHandlerType>
+void OneHotEncoding(ChunkReader<eT, PolicyType>& reader,
+                    const arma::Col<size_t>& indices,
+                    ChunkHandlerType handleChunk)
+{
+  std::vector<char> encoded;
+  std::vector<std::unordered_map<eT, size_t>> mappings;
+  std::vector<size_t> offsets;
+  details::OneHotPrepare(reader.Dimensionality(), indices, encoded, mappings);
+
+  // The first pass finds the distinct values of each encoded dimension.
+  arma::Mat<eT> chunk;
+  reader.Reset();
+  while (reader.Next(chunk))
+    details::OneHotMapValues(chunk, encoded, mappings);
+  details::OneHotOffsets(encoded, mappings, offsets);
+
+  // The second pass encodes the chunks.
+  arma::SpMat<eT> encodedChunk;
+  reader.Reset();
+  while (reader.Next(chunk))
+  {
+    details::OneHotEncodeSparse(chunk, encoded, mappings, offsets,
+        encodedChunk);
+    handleChunk(encodedChunk);
+  }
+}
+
+template<typename eT, typename PolicyType, typename ChunkHandlerType>
+void OneHotEncoding(ChunkReader<eT, PolicyType>& reader,
+                    ChunkHandlerType handleChunk)
+{
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < reader.Dimensionality(); ++i)
+  {
+    if (reader.Info().Type(i) == data::Datatype::categorical)
+      indices.push_back(i);
+  }
+
+  OneHotEncoding(reader, arma::Col<size_t>(indices), handleChunk);
+}
+
 } // namespace data
 } // namespace mlpack
 
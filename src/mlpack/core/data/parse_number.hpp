@@ -0,0 +1,237 @@
+/**
+ * @file core/data/parse_number.hpp
+ *
+ * Fast conversion of character ranges to numbers, used by the text loaders.
+ * Unlike a std::stringstream extraction, these functions need neither a
+ * std::string copy of the token nor a null-terminated buffer, so they can be
+ * applied directly to memory-mapped input.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_PARSE_NUMBER_HPP
+#define MLPACK_CORE_DATA_PARSE_NUMBER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Convert the characters in [begin, end) to a floating-point number.  The whole
+ * range must be a decimal number of the form [+-]digits[.digits][(e|E)[+-]
+ * digits]; otherwise false is returned and `value` is not modified.  As with
+ * stream extraction, "nan", "inf" and values that overflow the type are
+ * rejected.  The result is correctly rounded: short inputs are converted
+ * exactly in floating point, and anything else is handed to std::strtod() or
+ * std::strtof().
+ *
+ * @param begin Start of the token.
+ * @param end One past the end of the token.
+ * @param value Variable to store the number in.
+ * @return Whether the token was a number.
+ */
+template<typename T>
+inline bool ParseNumber(
+    const char* begin,
+    const char* end,
+    T& value,
+    const typename std::enable_if<std::is_floating_point<T>::value>::type* = 0)
+{
+  const char* p = begin;
+  bool negative = false;
+  if (p != end && (*p == '+' || *p == '-'))
+  {
+    negative = (*p == '-');
+    ++p;
+  }
+
+  // Accumulate up to 19 significant digits; that always fits in 64 bits.
+  uint64_t mantissa = 0;
+  int significantDigits = 0;
+  int exponent = 0;
+  bool truncated = false;
+  bool anyDigits = false;
+
+  for (; p != end && *p >= '0' && *p <= '9'; ++p)
+  {
+    anyDigits = true;
+    if (significantDigits < 19)
+    {
+      mantissa = 10 * mantissa + (*p - '0');
+      if (mantissa != 0)
+        ++significantDigits;
+    }
+    else
+    {
+      ++exponent;
+      truncated = true;
+    }
+  }
+
+  if (p != end && *p == '.')
+  {
+    for (++p; p != end && *p >= '0' && *p <= '9'; ++p)
+    {
+      anyDigits = true;
+      if (significantDigits < 19)
+      {
+        mantissa = 10 * mantissa + (*p - '0');
+        if (mantissa != 0)
+          ++significantDigits;
+        --exponent;
+      }
+      else
+      {
+        truncated = true;
+      }
+    }
+  }
+
+  if (!anyDigits)
+    return false;
+
+  if (p != end && (*p == 'e' || *p == 'E'))
+  {
+    ++p;
+    bool negativeExponent = false;
+    if (p != end && (*p == '+' || *p == '-'))
+    {
+      negativeExponent = (*p == '-');
+      ++p;
+    }
+
+    if (p == end || *p < '0' || *p > '9')
+      return false;
+
+    int explicitExponent = 0;
+    for (; p != end && *p >= '0' && *p <= '9'; ++p)
+    {
+      // Anything this large overflows or underflows anyway.
+      if (explicitExponent < 100000)
+        explicitExponent = 10 * explicitExponent + (*p - '0');
+    }
+
+    exponent += negativeExponent ? -explicitExponent : explicitExponent;
+  }
+
+  // There must be nothing left over.
+  if (p != end)
+    return false;
+
+  if (mantissa == 0)
+  {
+    value = negative ? -T(0) : T(0);
+    return true;
+  }
+
+  // If the mantissa and the power of ten are both exactly representable, a
+  // single multiplication or division gives the correctly rounded result.
+  static const T powersOfTen[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8,
+      1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+      1e21, 1e22 };
+  const uint64_t maxExactMantissa = uint64_t(1) <<
+      ((std::numeric_limits<T>::digits < 63) ? std::numeric_limits<T>::digits :
+      63);
+  const int maxExactExponent = (std::numeric_limits<T>::digits >= 53) ? 22 :
+      (std::numeric_limits<T>::digits >= 24) ? 10 : 0;
+
+  if (!truncated && mantissa <= maxExactMantissa &&
+      exponent >= -maxExactExponent && exponent <= maxExactExponent)
+  {
+    T result = T(mantissa);
+    if (exponent < 0)
+      result /= powersOfTen[-exponent];
+    else
+      result *= powersOfTen[exponent];
+
+    value = negative ? -result : result;
+    return true;
+  }
+
+  // Otherwise, fall back to the C library.  The token is already known to be
+  // well-formed, so all that can go wrong is overflow.
+  const std::string token(begin, end);
+  const T result = std::is_same<T, float>::value ?
+      T(std::strtof(token.c_str(), NULL)) :
+      std::is_same<T, double>::value ?
+      T(std::strtod(token.c_str(), NULL)) :
+      T(std::strtold(token.c_str(), NULL));
+  if (std::isinf(result))
+    return false;
+
+  value = result;
+  return true;
+}
+
+/**
+ * Convert the characters in [begin, end) to an integer.  The whole range must
+ * be of the form [+-]digits, and the value must fit in the type; otherwise
+ * false is returned and `value` is not modified.  As with stream extraction, a
+ * negative value given for an unsigned type wraps around.
+ *
+ * @param begin Start of the token.
+ * @param end One past the end of the token.
+ * @param value Variable to store the number in.
+ * @return Whether the token was a number.
+ */
+template<typename T>
+inline bool ParseNumber(
+    const char* begin,
+    const char* end,
+    T& value,
+    const typename std::enable_if<std::is_integral<T>::value>::type* = 0)
+{
+  const char* p = begin;
+  bool negative = false;
+  if (p != end && (*p == '+' || *p == '-'))
+  {
+    negative = (*p == '-');
+    ++p;
+  }
+
+  if (p == end)
+    return false;
+
+  const unsigned long long limit =
+      std::numeric_limits<unsigned long long>::max();
+  unsigned long long magnitude = 0;
+  for (; p != end; ++p)
+  {
+    if (*p < '0' || *p > '9')
+      return false;
+
+    const unsigned long long digit = (unsigned long long) (*p - '0');
+    if (magnitude > (limit - digit) / 10)
+      return false;
+
+    magnitude = 10 * magnitude + digit;
+  }
+
+  if (std::is_signed<T>::value)
+  {
+    const unsigned long long maxMagnitude = negative ?
+        (unsigned long long) std::numeric_limits<T>::max() + 1 :
+        (unsigned long long) std::numeric_limits<T>::max();
+    if (magnitude > maxMagnitude)
+      return false;
+
+    value = negative ? T(-(long long) (magnitude - 1) - 1) : T(magnitude);
+  }
+  else
+  {
+    if (magnitude > (unsigned long long) std::numeric_limits<T>::max())
+      return false;
+
+    value = negative ? T(0 - magnitude) : T(magnitude);
+  }
+
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
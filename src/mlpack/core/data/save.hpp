@@ -20,6 +20,7 @@
 
 #include "format.hpp"
 #include "image_info.hpp"
+#include "dataset_mapper.hpp"
 
 namespace mlpack {
 namespace data /** Functions to load and save matrices. */ {
@@ -39,6 +40,7 @@ namespace data /** Functions to load and save matrices. */ {
  *  - Raw binary (arma::raw_binary), denoted by .bin
  *  - Armadillo binary (arma::arma_binary), denoted by .bin
  *  - HDF5 (arma::hdf5_binary), denoted by .hdf5, .hdf, .h5, or .he5
+ *  - mlpack binary, denoted by .mlbin (see SaveBinaryMatrix())
  *
  * By default, this function will try to automatically determine the format to
  * save with based only on the filename's extension.  If you would prefer to
@@ -66,6 +68,27 @@ bool Save(const std::string& filename,
           bool transpose = true,
           arma::file_type inputSaveType = arma::auto_detect);
 
+/**
+ * Saves a matrix and the DatasetInfo that describes it to file, guessing the
+ * filetype from the extension.  Only the mlpack binary format (.mlbin) can
+ * store the DatasetInfo; for any other type, only the matrix is saved, exactly
+ * as Save() without a DatasetInfo would do.  A .mlbin file saved in this way
+ * can be loaded with data::Load() and a DatasetInfo to recover both.
+ *
+ * @param filename Name of file to save to.
+ * @param matrix Matrix to save into file.
+ * @param info DatasetInfo describing the dimensions of the matrix.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param transpose If true, transpose the matrix before saving (default true).
+ * @return Boolean value indicating success or failure of save.
+ */
+template<typename eT>
+bool Save(const std::string& filename,
+          const arma::Mat<eT>& matrix,
+          const DatasetInfo& info,
+          const bool fatal = false,
+          bool transpose = true);
+
 /**
  * Saves a sparse matrix to file, guessing the filetype from the
  * extension.  This will transpose the matrix at save time.  If the
@@ -97,6 +120,28 @@ bool Save(const std::string& filename,
           const bool fatal = false,
           bool transpose = true);
 
+/**
+ * Saves a sparse matrix and its labels as a libsvm (svmlight) file, where each
+ * column of the matrix becomes a line holding its label followed by 1-based
+ * index:value pairs for the nonzero elements.  The file can be loaded again
+ * with the corresponding data::Load() overload; since the number of rows is not
+ * saved, give it to data::Load() if the last rows may be all zero.
+ *
+ * If the parameter 'fatal' is set to true, a std::runtime_error exception will
+ * be thrown upon failure.
+ *
+ * @param filename Name of file to save to.
+ * @param matrix Sparse matrix to save into file.
+ * @param labels Labels of the points in the matrix.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of save.
+ */
+template<typename eT, typename LabelType>
+bool Save(const std::string& filename,
+          const arma::SpMat<eT>& matrix,
+          const arma::Row<LabelType>& labels,
+          const bool fatal = false);
+
 /**
  * Saves a model to file, guessing the filetype from the extension, or,
  * optionally, saving the specified format.  If automatic extension detection is
@@ -109,8 +154,14 @@ bool Save(const std::string& filename,
  *  - xml, denoted by .xml
  *  - binary, denoted by .bin
  *
+ * mlpack's bulk model format is also supported (see bulk_model.hpp):
+ *
+ *  - bulk, denoted by .mlpk
+ *  - bulk with compressed matrices, denoted by .mlpkz
+ *
  * The format parameter can take any of the values in the 'format' enum:
- * 'format::autodetect', 'format::json', 'format::xml', and 'format::binary'.
+ * 'format::autodetect', 'format::json', 'format::xml', 'format::binary',
+ * 'format::bulk', and 'format::bulk_compressed'.
  * The autodetect functionality operates on the file extension (so, "file.txt"
  * would be autodetected as text).
  *
@@ -16,6 +16,9 @@
 #include "save.hpp"
 #include "extension.hpp"
 #include "detect_file_type.hpp"
+#include "binary_matrix.hpp"
+#include "bulk_model.hpp"
+#include "libsvm.hpp"
 
 #include <cereal/archives/xml.hpp>
 #include <cereal/archives/json.hpp>
@@ -24,6 +27,39 @@
 namespace mlpack {
 namespace data {
 
+namespace details {
+
+//! Save a matrix (and possibly a DatasetInfo) as a .mlbin file.
+template<typename eT>
+bool SaveBinary(const std::string& filename,
+                const arma::Mat<eT>& matrix,
+                const DatasetInfo* info,
+                const bool fatal,
+                const bool transpose)
+{
+  Log::Info << "Saving mlpack binary data to '" << filename << "'."
+      << std::endl;
+  try
+  {
+    SaveBinaryMatrix(filename, matrix, info, transpose);
+  }
+  catch (std::exception& e)
+  {
+    Timer::Stop("saving_data");
+    if (fatal)
+      Log::Fatal << e.what() << "Save failed." << std::endl;
+    else
+      Log::Warn << e.what() << "Save failed." << std::endl;
+
+    return false;
+  }
+
+  Timer::Stop("saving_data");
+  return true;
+}
+
+} // namespace details
+
 template<typename eT>
 bool Save(const std::string& filename,
           const arma::Col<eT>& vec,
@@ -52,6 +88,9 @@ bool Save(const std::string& filename,
 {
   Timer::Start("saving_data");
 
+  if (inputSaveType == arma::auto_detect && Extension(filename) == "mlbin")
+    return details::SaveBinary(filename, matrix, NULL, fatal, transpose);
+
   arma::file_type saveType = inputSaveType;
   std::string stringType = "";
 
@@ -150,6 +189,20 @@ bool Save(const std::string& filename,
   return true;
 }
 
+template<typename eT>
+bool Save(const std::string& filename,
+          const arma::Mat<eT>& matrix,
+          const DatasetInfo& info,
+          const bool fatal,
+          bool transpose)
+{
+  if (Extension(filename) != "mlbin")
+    return Save(filename, matrix, fatal, transpose);
+
+  Timer::Start("saving_data");
+  return details::SaveBinary(filename, matrix, &info, fatal, transpose);
+}
+
 // Save a Sparse Matrix
 template<typename eT>
 bool Save(const std::string& filename,
@@ -259,6 +312,36 @@ bool Save(const std::string& filename,
   return true;
 }
 
+//! Save a sparse matrix with labels as a libsvm file.
+template<typename eT, typename LabelType>
+bool Save(const std::string& filename,
+          const arma::SpMat<eT>& matrix,
+          const arma::Row<LabelType>& labels,
+          const bool fatal)
+{
+  Timer::Start("saving_data");
+
+  Log::Info << "Saving libsvm data to '" << filename << "'." << std::endl;
+  try
+  {
+    SaveLibSVM(filename, matrix, labels);
+  }
+  catch (std::exception& e)
+  {
+    Timer::Stop("saving_data");
+    if (fatal)
+      Log::Fatal << e.what() << "Save failed." << std::endl;
+    else
+      Log::Warn << e.what() << "Save failed." << std::endl;
+
+    return false;
+  }
+
+  Timer::Stop("saving_data");
+
+  return true;
+}
+
 //! Save a model to file.
 template<typename T>
 bool Save(const std::string& filename,
@@ -277,15 +360,38 @@ bool Save(const std::string& filename,
       f = format::binary;
     else if (extension == "json")
       f = format::json;
+    else if (extension == "mlpk")
+      f = format::bulk;
+    else if (extension == "mlpkz")
+      f = format::bulk_compressed;
     else
     {
       if (fatal)
         Log::Fatal << "Unable to detect type of '" << filename << "'; incorrect"
-            << " extension? (allowed: xml/bin/json)" << std::endl;
+            << " extension? (allowed: xml/bin/json/mlpk/mlpkz)" << std::endl;
       else
         Log::Warn << "Unable to detect type of '" << filename << "'; save "
-            << "failed.  Incorrect extension? (allowed: xml/bin/json)"
-            << std::endl;
+            << "failed.  Incorrect extension? (allowed: xml/bin/json/mlpk/"
+            << "mlpkz)" << std::endl;
+
+      return false;
+    }
+  }
+
+  // Bulk model files are written by their own archive.
+  if (f == format::bulk || f == format::bulk_compressed)
+  {
+    try
+    {
+      SaveBulkModel(filename, name, t, f == format::bulk_compressed);
+      return true;
+    }
+    catch (std::exception& e)
+    {
+      if (fatal)
+        Log::Fatal << e.what() << std::endl;
+      else
+        Log::Warn << e.what() << std::endl;
 
       return false;
     }
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_MAX_ABS_SCALE_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "scaler_statistics.hpp"
 
 namespace mlpack {
 namespace data {
@@ -54,8 +55,23 @@ class MaxAbsScaler
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMin = arma::min(input, 1);
-    itemMax = arma::max(input, 1);
+    statistics.Reset();
+    PartialFit(input);
+  }
+
+  /**
+   * Function to fit features incrementally: the given points are added to the
+   * points that the scaler has been fitted with so far, and the minimum and
+   * the maximum are updated in one parallel pass over the points.
+   *
+   * @param input Dataset to add to the fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    statistics.Update(input);
+    itemMin = statistics.Min();
+    itemMax = statistics.Max();
     scale = arma::max(arma::abs(itemMin), arma::abs(itemMax));
     // Handling zeros in scale vector.
     scale.for_each([](arma::vec::elem_type& val) { val =
@@ -80,6 +96,25 @@ class MaxAbsScaler
     output = input.each_col() / scale;
   }
 
+  /**
+   * Function to scale features in place, without a copy of the dataset.
+   *
+   * @param input Dataset to scale features of.
+   */
+  template<typename MatType>
+  void Transform(MatType& input)
+  {
+    if (scale.is_empty())
+    {
+      throw std::runtime_error("Call Fit() before Transform(), please"
+        " refer to the documentation.");
+    }
+
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) input.n_cols; ++i)
+      input.col(i) /= scale;
+  }
+
   /**
    * Function to retrieve original dataset.
    *
@@ -100,12 +135,18 @@ class MaxAbsScaler
   //! Get the Scale row vector.
   const arma::vec& Scale() const { return scale; }
 
+  //! Get the statistics the scaler has been fitted with.
+  const ScalerStatistics& Statistics() const { return statistics; }
+
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */)
+  void serialize(Archive& ar, const uint32_t version)
   {
     ar(CEREAL_NVP(itemMin));
     ar(CEREAL_NVP(itemMax));
     ar(CEREAL_NVP(scale));
+    // Older models have no statistics, so PartialFit() starts over on them.
+    if (version > 0)
+      ar(CEREAL_NVP(statistics));
   }
  private:
   // Vector which holds minimum of each feature.
@@ -114,9 +155,13 @@ class MaxAbsScaler
   arma::vec itemMax;
   // Vector which is used to scale up each feature.
   arma::vec scale;
+  // Statistics of the points seen so far.
+  ScalerStatistics statistics;
 }; // class MaxAbsScaler
 
 } // namespace data
 } // namespace mlpack
 
+CEREAL_CLASS_VERSION(mlpack::data::MaxAbsScaler, (1));
+
 #endif
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_SCALE_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "scaler_statistics.hpp"
 
 namespace mlpack {
 namespace data {
@@ -73,8 +74,23 @@ class MinMaxScaler
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMin = arma::min(input, 1);
-    itemMax = arma::max(input, 1);
+    statistics.Reset();
+    PartialFit(input);
+  }
+
+  /**
+   * Function to fit features incrementally: the given points are added to the
+   * points that the scaler has been fitted with so far, and the minimum and
+   * the maximum are updated in one parallel pass over the points.
+   *
+   * @param input Dataset to add to the fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    statistics.Update(input);
+    itemMin = statistics.Min();
+    itemMax = statistics.Max();
     scale = itemMax - itemMin;
     // Handle zeros in scale vector.
     scale.for_each([](arma::vec::elem_type& val) { val =
@@ -103,6 +119,25 @@ class MinMaxScaler
     output = (input.each_col() % scale).each_col() + scalerowmin;
   }
 
+  /**
+   * Function to scale features in place, without a copy of the dataset.
+   *
+   * @param input Dataset to scale features of.
+   */
+  template<typename MatType>
+  void Transform(MatType& input)
+  {
+    if (scalerowmin.is_empty() || scale.is_empty())
+    {
+      throw std::runtime_error("Call Fit() before Transform(), please"
+          " refer to the documentation.");
+    }
+
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) input.n_cols; ++i)
+      input.col(i) = input.col(i) % scale + scalerowmin;
+  }
+
   /**
    * Function to retrieve original dataset.
    *
@@ -127,8 +162,11 @@ class MinMaxScaler
   //! Get the lower range parameter.
   double ScaleMin() const { return scaleMin; }
 
+  //! Get the statistics the scaler has been fitted with.
+  const ScalerStatistics& Statistics() const { return statistics; }
+
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */)
+  void serialize(Archive& ar, const uint32_t version)
   {
     ar(CEREAL_NVP(itemMin));
     ar(CEREAL_NVP(itemMax));
@@ -136,6 +174,9 @@ class MinMaxScaler
     ar(CEREAL_NVP(scaleMin));
     ar(CEREAL_NVP(scaleMax));
     ar(CEREAL_NVP(scalerowmin));
+    // Older models have no statistics, so PartialFit() starts over on them.
+    if (version > 0)
+      ar(CEREAL_NVP(statistics));
   }
 
  private:
@@ -151,9 +192,13 @@ class MinMaxScaler
   double scaleMax;
   // Column vector of scalemin
   arma::vec scalerowmin;
+  // Statistics of the points seen so far.
+  ScalerStatistics statistics;
 }; // class MinMaxScaler
 
 } // namespace data
 } // namespace mlpack
 
+CEREAL_CLASS_VERSION(mlpack::data::MinMaxScaler, (1));
+
 #endif
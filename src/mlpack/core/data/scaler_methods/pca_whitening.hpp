@@ -15,9 +15,42 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/math/lin_alg.hpp>
 #include <mlpack/core/math/ccov.hpp>
+#include "scaler_statistics.hpp"
+
+#include <mutex>
 
 namespace mlpack {
 namespace data {
+namespace details {
+
+/**
+ * Center the given points and multiply them by the given whitening matrix, in
+ * place.  The points are whitened in parallel blocks, so only one block of
+ * points at a time is copied.
+ *
+ * @param input Points to whiten.
+ * @param mean Mean to center the points with.
+ * @param whitening Whitening matrix.
+ */
+template<typename MatType>
+void WhitenInPlace(MatType& input,
+                   const arma::vec& mean,
+                   const arma::mat& whitening)
+{
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (input.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    const size_t begin = b * blockSize;
+    const size_t end = std::min((size_t) input.n_cols, begin + blockSize);
+    input.cols(begin, end - 1) = whitening *
+        (input.cols(begin, end - 1).each_col() - mean);
+  }
+}
+
+} // namespace details
 
 /**
  * A simple PCAWhitening class.
@@ -52,7 +85,7 @@ class PCAWhitening
    *
    * @param eps Regularization parameter.
    */
-  PCAWhitening(double eps = 0.00005)
+  PCAWhitening(double eps = 0.00005) : statistics(true), stale(false)
   {
     epsilon = eps;
     // Ensure scaleMin is smaller than scaleMax.
@@ -62,6 +95,26 @@ class PCAWhitening
     }
   }
 
+  //! Copy the given scaler.
+  PCAWhitening(const PCAWhitening& other) { *this = other; }
+
+  //! Copy the given scaler.
+  PCAWhitening& operator=(const PCAWhitening& other)
+  {
+    if (this == &other)
+      return *this;
+
+    // The other scaler may be decomposing its covariance in another thread.
+    std::lock_guard<std::mutex> lock(other.decomposeLock);
+    itemMean = other.itemMean;
+    eigenVectors = other.eigenVectors;
+    epsilon = other.epsilon;
+    eigenValues = other.eigenValues;
+    statistics = other.statistics;
+    stale = other.stale;
+    return *this;
+  }
+
   /**
    * Function to fit features, to find out the min max and scale.
    *
@@ -70,11 +123,27 @@ class PCAWhitening
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMean = arma::mean(input, 1);
-    // Get eigenvectors and eigenvalues of covariance of input matrix.
-    eig_sym(eigenValues, eigenVectors, mlpack::math::ColumnCovariance(
-        input.each_col() - itemMean));
-    eigenValues += epsilon;
+    statistics.Reset();
+    PartialFit(input);
+  }
+
+  /**
+   * Function to fit features incrementally: the given points are added to the
+   * points that the scaler has been fitted with so far, and the mean and the
+   * covariance are updated in one parallel pass over the points.  The
+   * eigendecomposition of the covariance matrix is only recomputed when it is
+   * next needed, so any number of chunks may be added before that.  That
+   * recomputation is guarded by a lock, so a fitted scaler may be used from
+   * several threads at once.
+   *
+   * @param input Dataset to add to the fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    statistics.Update(input);
+    itemMean = statistics.Mean();
+    stale = true;
   }
 
   /**
@@ -86,6 +155,7 @@ class PCAWhitening
   template<typename MatType>
   void Transform(const MatType& input, MatType& output)
   {
+    Decompose();
     if (eigenValues.is_empty() || eigenVectors.is_empty())
     {
       throw std::runtime_error("Call Fit() before Transform(), please"
@@ -97,6 +167,25 @@ class PCAWhitening
         * output;
   }
 
+  /**
+   * Function for PCA whitening in place, without a copy of the dataset.
+   *
+   * @param input Dataset to whiten.
+   */
+  template<typename MatType>
+  void Transform(MatType& input)
+  {
+    Decompose();
+    if (eigenValues.is_empty() || eigenVectors.is_empty())
+    {
+      throw std::runtime_error("Call Fit() before Transform(), please"
+          " refer to the documentation.");
+    }
+
+    details::WhitenInPlace(input, itemMean,
+        arma::diagmat(1.0 / arma::sqrt(eigenValues)) * eigenVectors.t());
+  }
+
   /**
    * Function to retrieve original dataset.
    *
@@ -106,6 +195,7 @@ class PCAWhitening
   template<typename MatType>
   void InverseTransform(const MatType& input, MatType& output)
   {
+    Decompose();
     output = arma::diagmat(arma::sqrt(eigenValues)) * inv(eigenVectors.t())
         * input;
     output = (output.each_col() + itemMean);
@@ -114,33 +204,67 @@ class PCAWhitening
   //! Get the mean row vector.
   const arma::vec& ItemMean() const { return itemMean; }
   //! Get the eigenvalues vector.
-  const arma::vec& EigenValues() const { return eigenValues; }
+  const arma::vec& EigenValues() const { Decompose(); return eigenValues; }
   //! Get the eigenvector.
-  const arma::mat& EigenVectors() const { return eigenVectors; }
+  const arma::mat& EigenVectors() const { Decompose(); return eigenVectors; }
   //! Get the regularization parameter.
   const double& Epsilon() const { return epsilon; }
 
+  //! Get the statistics the scaler has been fitted with.
+  const ScalerStatistics& Statistics() const { return statistics; }
+
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */)
+  void serialize(Archive& ar, const uint32_t version)
   {
+    if (!cereal::is_loading<Archive>())
+      Decompose();
+
     ar(CEREAL_NVP(eigenValues));
     ar(CEREAL_NVP(eigenVectors));
     ar(CEREAL_NVP(itemMean));
     ar(CEREAL_NVP(epsilon));
+    // Older models have no statistics, so PartialFit() starts over on them.
+    if (version > 0)
+      ar(CEREAL_NVP(statistics));
+
+    if (cereal::is_loading<Archive>())
+      stale = false;
   }
 
  private:
   // Vector which holds mean of each feature.
   arma::vec itemMean;
-  // Mat which hold the eigenvectors.
-  arma::mat eigenVectors;
+  // Mat which hold the eigenvectors; it is computed lazily.
+  mutable arma::mat eigenVectors;
   // Regularization Paramter.
   double epsilon;
-  // Vector which hold the eigenvalues.
-  arma::vec eigenValues;
+  // Vector which hold the eigenvalues; it is computed lazily.
+  mutable arma::vec eigenValues;
+  // Statistics of the points seen so far.
+  ScalerStatistics statistics;
+  // Whether the eigendecomposition is out of date with the statistics.
+  mutable bool stale;
+  // Protects the lazily computed members above.
+  mutable std::mutex decomposeLock;
+
+  // Recompute the eigendecomposition of the covariance matrix, if it is out of
+  // date.  The const methods that call this may run in several threads.
+  void Decompose() const
+  {
+    std::lock_guard<std::mutex> lock(decomposeLock);
+    if (!stale)
+      return;
+
+    // Get eigenvectors and eigenvalues of covariance of input matrix.
+    eig_sym(eigenValues, eigenVectors, statistics.Covariance());
+    eigenValues += epsilon;
+    stale = false;
+  }
 }; // class PCAWhitening
 
 } // namespace data
 } // namespace mlpack
 
+CEREAL_CLASS_VERSION(mlpack::data::PCAWhitening, (1));
+
 #endif
@@ -0,0 +1,250 @@
+/**
+ * @file core/data/scaler_methods/scaler_statistics.hpp
+ *
+ * Mergeable statistics of a dataset, which the scalers are fitted with.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SCALER_STATISTICS_HPP
+#define MLPACK_CORE_DATA_SCALER_STATISTICS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * ScalerStatistics holds the number of points seen so far and the mean, the
+ * sum of squared deviations from the mean, the minimum and the maximum of each
+ * dimension; optionally, it also holds the sum of the outer products of the
+ * deviations, from which the covariance matrix is found.  These statistics can
+ * be merged exactly (Chan et al., "Updating Formulae and a Pairwise Algorithm
+ * for Computing Sample Variances", 1979), so a dataset can be fitted one chunk
+ * at a time, and each chunk is split into blocks of points whose statistics
+ * are computed in parallel.  Only one pass is taken over each chunk.
+ *
+ * Each block holds BlockSize points (except maybe the last), and the blocks
+ * are always merged in the same order, so the result does not depend on the
+ * number of threads.  Only a few blocks per thread are held at once.
+ */
+class ScalerStatistics
+{
+ public:
+  //! Number of points in each block whose statistics are computed in parallel.
+  //! This is big enough that merging is cheap next to the work on the points.
+  static const size_t BlockSize = 1024;
+
+  /**
+   * Create empty statistics.
+   *
+   * @param covariance Whether to keep the statistics of the covariance matrix.
+   */
+  ScalerStatistics(const bool covariance = false) :
+      count(0),
+      covariance(covariance)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Add the points of the given matrix (one point per column) to the
+   * statistics.  The dimensionality must match that of any points added
+   * before.
+   *
+   * @param input Points to add.
+   */
+  template<typename MatType>
+  void Update(const MatType& input)
+  {
+    if (input.n_cols == 0)
+      return;
+
+    if (count > 0 && input.n_rows != mean.n_elem)
+    {
+      std::ostringstream oss;
+      oss << "ScalerStatistics::Update(): dimensionality of the points ("
+          << input.n_rows << ") does not match the dimensionality of the "
+          << "points seen before (" << mean.n_elem << ")!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    // Each block may hold a d x d comoment, so only a round of a few blocks per
+    // thread is kept at a time.  The blocks are still merged one by one in
+    // order, so the size of a round does not change the result.
+    const size_t numBlocks = (input.n_cols + BlockSize - 1) / BlockSize;
+    size_t roundSize = 1;
+    #ifdef HAS_OPENMP
+      roundSize = 2 * (size_t) omp_get_max_threads();
+    #endif
+    roundSize = std::min(roundSize, numBlocks);
+
+    std::vector<ScalerStatistics> blocks(roundSize,
+        ScalerStatistics(covariance));
+    for (size_t first = 0; first < numBlocks; first += roundSize)
+    {
+      const size_t last = std::min(first + roundSize, numBlocks);
+      #pragma omp parallel for schedule(static)
+      for (omp_size_t b = first; b < (omp_size_t) last; ++b)
+      {
+        const size_t begin = b * BlockSize;
+        const size_t end = std::min(begin + BlockSize, (size_t) input.n_cols);
+        blocks[b - first].Compute(input.cols(begin, end - 1));
+      }
+
+      for (size_t b = first; b < last; ++b)
+        Merge(blocks[b - first]);
+    }
+  }
+
+  /**
+   * Merge the given statistics into these, as if the points they were computed
+   * from had been added here.
+   *
+   * @param other Statistics to merge.
+   */
+  void Merge(const ScalerStatistics& other)
+  {
+    if (other.count == 0)
+      return;
+
+    if (count == 0)
+    {
+      count = other.count;
+      mean = other.mean;
+      m2 = other.m2;
+      min = other.min;
+      max = other.max;
+      if (covariance)
+        comoment = other.comoment;
+      return;
+    }
+
+    if (other.mean.n_elem != mean.n_elem)
+    {
+      throw std::invalid_argument("ScalerStatistics::Merge(): statistics have "
+          "different dimensionalities!");
+    }
+
+    const double n = (double) (count + other.count);
+    const double weight = (double) count * (double) other.count / n;
+    const arma::vec delta = other.mean - mean;
+
+    mean += delta * ((double) other.count / n);
+    m2 += other.m2 + arma::square(delta) * weight;
+    min = arma::min(min, other.min);
+    max = arma::max(max, other.max);
+    if (covariance)
+      comoment += other.comoment + (delta * delta.t()) * weight;
+    count += other.count;
+  }
+
+  //! Forget all the points that have been added.
+  void Reset()
+  {
+    count = 0;
+    mean.clear();
+    m2.clear();
+    min.clear();
+    max.clear();
+    comoment.clear();
+  }
+
+  /**
+   * Get the variance of each dimension.
+   *
+   * @param normType If 0, normalize by N - 1; if 1, normalize by N.
+   */
+  arma::vec Variance(const size_t normType = 0) const
+  {
+    return m2 / Normalizer(normType);
+  }
+
+  /**
+   * Get the covariance matrix of the points; the statistics must have been
+   * created with covariance set to true.
+   *
+   * @param normType If 0, normalize by N - 1; if 1, normalize by N.
+   */
+  arma::mat Covariance(const size_t normType = 0) const
+  {
+    if (!covariance)
+    {
+      throw std::logic_error("ScalerStatistics::Covariance(): the statistics "
+          "of the covariance matrix are not kept!");
+    }
+
+    return comoment / Normalizer(normType);
+  }
+
+  //! Get the number of points added.
+  size_t Count() const { return count; }
+  //! Get the mean of each dimension.
+  const arma::vec& Mean() const { return mean; }
+  //! Get the sum of squared deviations from the mean of each dimension.
+  const arma::vec& M2() const { return m2; }
+  //! Get the minimum of each dimension.
+  const arma::vec& Min() const { return min; }
+  //! Get the maximum of each dimension.
+  const arma::vec& Max() const { return max; }
+  //! Get whether the statistics of the covariance matrix are kept.
+  bool KeepsCovariance() const { return covariance; }
+
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(count));
+    ar(CEREAL_NVP(covariance));
+    ar(CEREAL_NVP(mean));
+    ar(CEREAL_NVP(m2));
+    ar(CEREAL_NVP(min));
+    ar(CEREAL_NVP(max));
+    ar(CEREAL_NVP(comoment));
+  }
+
+ private:
+  //! Compute the statistics of the given points from scratch.
+  template<typename MatType>
+  void Compute(const MatType& input)
+  {
+    count = input.n_cols;
+    mean = arma::mean(input, 1);
+    min = arma::min(input, 1);
+    max = arma::max(input, 1);
+
+    const arma::mat centered = input.each_col() - mean;
+    m2 = arma::sum(arma::square(centered), 1);
+    if (covariance)
+      comoment = centered * centered.t();
+  }
+
+  //! Get the normalizer of the variance, as ColumnCovariance() computes it.
+  double Normalizer(const size_t normType) const
+  {
+    if (normType == 0)
+      return (count > 1) ? (double) (count - 1) : 1.0;
+    return (count > 0) ? (double) count : 1.0;
+  }
+
+  //! Number of points added.
+  size_t count;
+  //! Whether the statistics of the covariance matrix are kept.
+  bool covariance;
+  //! Mean of each dimension.
+  arma::vec mean;
+  //! Sum of squared deviations from the mean of each dimension.
+  arma::vec m2;
+  //! Minimum of each dimension.
+  arma::vec min;
+  //! Maximum of each dimension.
+  arma::vec max;
+  //! Sum of the outer products of the deviations from the mean.
+  arma::mat comoment;
+}; // class ScalerStatistics
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_STANDARD_SCALE_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "scaler_statistics.hpp"
 
 namespace mlpack {
 namespace data {
@@ -43,6 +44,23 @@ namespace data {
  * // Retransform the input.
  * scale.InverseTransform(output, input);
  * @endcode
+ *
+ * A dataset that does not fit in memory can be fitted one chunk at a time with
+ * PartialFit(), and then scaled in place one chunk at a time:
+ *
+ * @code
+ * data::DatasetInfo info;
+ * data::ChunkReader<> reader("train.csv", 10000, info);
+ * arma::mat chunk;
+ *
+ * StandardScaler scale;
+ * while (reader.Next(chunk))
+ *   scale.PartialFit(chunk);
+ *
+ * reader.Reset();
+ * while (reader.Next(chunk))
+ *   scale.Transform(chunk);
+ * @endcode
  */
 class StandardScaler
 {
@@ -55,8 +73,23 @@ class StandardScaler
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMean = arma::mean(input, 1);
-    itemStdDev = arma::stddev(input, 1, 1);
+    statistics.Reset();
+    PartialFit(input);
+  }
+
+  /**
+   * Function to fit features incrementally: the given points are added to the
+   * points that the scaler has been fitted with so far, and the mean and the
+   * standard deviation are updated in one parallel pass over the points.
+   *
+   * @param input Dataset to add to the fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    statistics.Update(input);
+    itemMean = statistics.Mean();
+    itemStdDev = arma::sqrt(statistics.Variance(1));
     // Handle zeros in scale vector.
     itemStdDev.for_each([](arma::vec::elem_type& val) { val =
         (val == 0) ? 1 : val; });
@@ -80,6 +113,25 @@ class StandardScaler
     output = (input.each_col() - itemMean).each_col() / itemStdDev;
   }
 
+  /**
+   * Function to scale features in place, without a copy of the dataset.
+   *
+   * @param input Dataset to scale features of.
+   */
+  template<typename MatType>
+  void Transform(MatType& input)
+  {
+    if (itemMean.is_empty() || itemStdDev.is_empty())
+    {
+      throw std::runtime_error("Call Fit() before Transform(), please"
+        " refer to the documentation.");
+    }
+
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) input.n_cols; ++i)
+      input.col(i) = (input.col(i) - itemMean) / itemStdDev;
+  }
+
   /**
    * Function to retrieve original dataset.
    *
@@ -98,11 +150,17 @@ class StandardScaler
   //! Get the standard deviation row vector.
   const arma::vec& ItemStdDev() const { return itemStdDev; }
 
+  //! Get the statistics the scaler has been fitted with.
+  const ScalerStatistics& Statistics() const { return statistics; }
+
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */)
+  void serialize(Archive& ar, const uint32_t version)
   {
     ar(CEREAL_NVP(itemMean));
     ar(CEREAL_NVP(itemStdDev));
+    // Older models have no statistics, so PartialFit() starts over on them.
+    if (version > 0)
+      ar(CEREAL_NVP(statistics));
   }
 
  private:
@@ -110,9 +168,13 @@ class StandardScaler
   arma::vec itemMean;
   // Vector which holds standard devation of each feature.
   arma::vec itemStdDev;
+  // Statistics of the points seen so far.
+  ScalerStatistics statistics;
 }; // class StandardScaler
 
 } // namespace data
 } // namespace mlpack
 
+CEREAL_CLASS_VERSION(mlpack::data::StandardScaler, (1));
+
 #endif
@@ -65,6 +65,19 @@ class ZCAWhitening
     pca.Fit(input);
   }
 
+  /**
+   * Function to fit features incrementally: the given points are added to the
+   * points that the scaler has been fitted with so far.  See
+   * PCAWhitening::PartialFit().
+   *
+   * @param input Dataset to add to the fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    pca.PartialFit(input);
+  }
+
   /**
    * Function for ZCA whitening.
    *
@@ -78,6 +91,25 @@ class ZCAWhitening
     output = pca.EigenVectors() * output;
   }
 
+  /**
+   * Function for ZCA whitening in place, without a copy of the dataset.
+   *
+   * @param input Dataset to whiten.
+   */
+  template<typename MatType>
+  void Transform(MatType& input)
+  {
+    if (pca.EigenValues().is_empty() || pca.EigenVectors().is_empty())
+    {
+      throw std::runtime_error("Call Fit() before Transform(), please"
+          " refer to the documentation.");
+    }
+
+    details::WhitenInPlace(input, pca.ItemMean(), pca.EigenVectors() *
+        arma::diagmat(1.0 / arma::sqrt(pca.EigenValues())) *
+        pca.EigenVectors().t());
+  }
+
   /**
    * Function to retrieve original dataset.
    *
@@ -100,6 +132,8 @@ class ZCAWhitening
   const arma::mat& EigenVectors() const { return pca.EigenVectors(); }
   //! Get the regularization parameter.
   double Epsilon() const { return pca.Epsilon(); }
+  //! Get the statistics the scaler has been fitted with.
+  const ScalerStatistics& Statistics() const { return pca.Statistics(); }
 
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */)
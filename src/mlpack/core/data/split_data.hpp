@@ -62,6 +62,116 @@ void SplitHelper(const InputType& input,
   }
 }
 
+/**
+ * Compute the indices of the points of a training set and a test set, without
+ * copying any data.  The points are split exactly as Split() would split them
+ * (with the same random seed), so that input.cols(trainIndices) is the
+ * training set Split() would give.  The indices can be used to select the
+ * points of the sets only when they are needed, or to partition the dataset in
+ * place with SplitInPlace().
+ *
+ * @code
+ * arma::mat input = loadData();
+ * arma::uvec trainIndices, testIndices;
+ * SplitIndices(input.n_cols, trainIndices, testIndices, 0.3);
+ * @endcode
+ *
+ * @param numPoints Number of points in the dataset.
+ * @param trainIndices Vector to store the indices of the training points into.
+ * @param testIndices Vector to store the indices of the test points into.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *     sample is visited in linear order. (Default true.)
+ */
+inline void SplitIndices(const size_t numPoints,
+                         arma::uvec& trainIndices,
+                         arma::uvec& testIndices,
+                         const double testRatio,
+                         const bool shuffleData = true)
+{
+  const size_t testSize = static_cast<size_t>(numPoints * testRatio);
+  const size_t trainSize = numPoints - testSize;
+
+  arma::uvec order = arma::linspace<arma::uvec>(0, numPoints - 1, numPoints);
+  if (shuffleData)
+    order = arma::shuffle(order);
+
+  trainIndices = order.head(trainSize);
+  testIndices = order.tail(testSize);
+}
+
+/**
+ * Compute the indices of the points of a stratified training set and test set,
+ * without copying any data; the ratio of each class in the training and test
+ * sets is the same as in the original dataset.  The points are split exactly
+ * as StratifiedSplit() would split them (with the same random seed).
+ * Expects labels to be of type arma::Row<> or arma::Col<>, with values in the
+ * range [0, n) where n is the number of different labels.
+ *
+ * @param inputLabel Input labels to stratify.
+ * @param trainIndices Vector to store the indices of the training points into.
+ * @param testIndices Vector to store the indices of the test points into.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *     sample is visited in linear order. (Default true.)
+ */
+template<typename LabelsType,
+         typename = std::enable_if_t<arma::is_arma_type<LabelsType>::value> >
+void StratifiedSplitIndices(const LabelsType& inputLabel,
+                            arma::uvec& trainIndices,
+                            arma::uvec& testIndices,
+                            const double testRatio,
+                            const bool shuffleData = true)
+{
+  // See StratifiedSplit() for the idea of the algorithm.
+  const bool typeCheck = (arma::is_Row<LabelsType>::value)
+      || (arma::is_Col<LabelsType>::value);
+  if (!typeCheck)
+    throw std::runtime_error("data::Split(): when stratified sampling is done, "
+        "labels must have type `arma::Row<>`!");
+  size_t trainIdx = 0;
+  size_t testIdx = 0;
+  size_t trainSize = 0;
+  size_t testSize = 0;
+  arma::uvec labelCounts;
+  arma::uvec testLabelCounts;
+  typename LabelsType::elem_type maxLabel = inputLabel.max();
+
+  labelCounts.zeros(maxLabel+1);
+  testLabelCounts.zeros(maxLabel+1);
+
+  for (typename LabelsType::elem_type label : inputLabel)
+    ++labelCounts[label];
+
+  for (arma::uword labelCount : labelCounts)
+  {
+    testSize += floor(labelCount * testRatio);
+    trainSize += labelCount - floor(labelCount * testRatio);
+  }
+
+  trainIndices.set_size(trainSize);
+  testIndices.set_size(testSize);
+
+  arma::uvec order = arma::linspace<arma::uvec>(0, inputLabel.n_elem - 1,
+      inputLabel.n_elem);
+  if (shuffleData)
+    order = arma::shuffle(order);
+
+  for (arma::uword i : order)
+  {
+    typename LabelsType::elem_type label = inputLabel[i];
+    if (testLabelCounts[label] < floor(labelCounts[label] * testRatio))
+    {
+      testLabelCounts[label] += 1;
+      testIndices[testIdx++] = i;
+    }
+    else
+    {
+      trainIndices[trainIdx++] = i;
+    }
+  }
+}
+
 /**
  * Given an input dataset and labels, stratify into a training set and test set.
  * It is recommended to have the input labels between the range [0, n) where n
@@ -142,79 +252,18 @@ void StratifiedSplit(const arma::Mat<T>& input,
    * 0
    * 1 1
    */
-  const bool typeCheck = (arma::is_Row<LabelsType>::value)
-      || (arma::is_Col<LabelsType>::value);
-  if (!typeCheck)
-    throw std::runtime_error("data::Split(): when stratified sampling is done, "
-        "labels must have type `arma::Row<>`!");
-  size_t trainIdx = 0;
-  size_t testIdx = 0;
-  size_t trainSize = 0;
-  size_t testSize = 0;
-  arma::uvec labelCounts;
-  arma::uvec testLabelCounts;
-  typename LabelsType::elem_type maxLabel = inputLabel.max();
-
-  labelCounts.zeros(maxLabel+1);
-  testLabelCounts.zeros(maxLabel+1);
-
-  for (typename LabelsType::elem_type label : inputLabel)
-    ++labelCounts[label];
+  arma::uvec trainIndices, testIndices;
+  StratifiedSplitIndices(inputLabel, trainIndices, testIndices, testRatio,
+      shuffleData);
 
-  for (arma::uword labelCount : labelCounts)
-  {
-    testSize += floor(labelCount * testRatio);
-    trainSize += labelCount - floor(labelCount * testRatio);
-  }
-
-  trainData.set_size(input.n_rows, trainSize);
-  testData.set_size(input.n_rows, testSize);
-  trainLabel.set_size(inputLabel.n_rows, trainSize);
-  testLabel.set_size(inputLabel.n_rows, testSize);
-
-  if (shuffleData)
-  {
-    arma::uvec order = arma::shuffle(
-        arma::linspace<arma::uvec>(0, input.n_cols - 1, input.n_cols));
-
-    for (arma::uword i : order)
-    {
-      typename LabelsType::elem_type label = inputLabel[i];
-      if (testLabelCounts[label] < floor(labelCounts[label] * testRatio))
-      {
-        testLabelCounts[label] += 1;
-        testData.col(testIdx) = input.col(i);
-        testLabel[testIdx] = inputLabel[i];
-        testIdx += 1;
-      }
-      else
-      {
-        trainData.col(trainIdx) = input.col(i);
-        trainLabel[trainIdx] = inputLabel[i];
-        trainIdx += 1;
-      }
-    }
-  }
-  else
-  {
-    for (arma::uword i = 0; i < input.n_cols; i++)
-    {
-      typename LabelsType::elem_type label = inputLabel[i];
-      if (testLabelCounts[label] < floor(labelCounts[label] * testRatio))
-      {
-        testLabelCounts[label] += 1;
-        testData.col(testIdx) = input.col(i);
-        testLabel[testIdx] = inputLabel[i];
-        testIdx += 1;
-      }
-      else
-      {
-        trainData.col(trainIdx) = input.col(i);
-        trainLabel[trainIdx] = inputLabel[i];
-        trainIdx += 1;
-      }
-    }
-  }
+  trainData = input.cols(trainIndices);
+  testData = input.cols(testIndices);
+  trainLabel.set_size(inputLabel.n_rows, trainIndices.n_elem);
+  testLabel.set_size(inputLabel.n_rows, testIndices.n_elem);
+  for (size_t i = 0; i < trainIndices.n_elem; ++i)
+    trainLabel[i] = inputLabel[trainIndices[i]];
+  for (size_t i = 0; i < testIndices.n_elem; ++i)
+    testLabel[i] = inputLabel[testIndices[i]];
 }
 
 /**
@@ -408,6 +457,127 @@ Split(const arma::Mat<T>& input,
                          std::move(testData));
 }
 
+namespace details {
+
+/**
+ * Reorder the columns of the given matrix in place, so that column i becomes
+ * the column that was at order[i].  Each cycle of the permutation is followed
+ * with a copy of only one column.
+ */
+template<typename MatType>
+void PermuteColumns(MatType& input, const arma::uvec& order)
+{
+  std::vector<bool> visited(order.n_elem, false);
+  arma::Col<typename MatType::elem_type> first;
+  for (size_t start = 0; start < order.n_elem; ++start)
+  {
+    if (visited[start] || order[start] == start)
+      continue;
+
+    first = input.col(start);
+    size_t i = start;
+    while (order[i] != start)
+    {
+      input.col(i) = input.col(order[i]);
+      visited[i] = true;
+      i = order[i];
+    }
+
+    input.col(i) = first;
+    visited[i] = true;
+  }
+}
+
+} // namespace details
+
+/**
+ * Given an input dataset, shuffle and partition it in place into a training set
+ * and a test set, without copying it.  After the call, the first columns of the
+ * input are the training set and the rest are the test set; the number of
+ * training points is returned.  The sets hold the same points, in the same
+ * order, as the sets Split() would give with the same random seed.
+ *
+ * The sets can then be used through aliases of the input, which take no extra
+ * memory, and passed to Train() methods like any other matrix:
+ *
+ * @code
+ * arma::mat input = loadData();
+ * const size_t trainSize = SplitInPlace(input, 0.3);
+ *
+ * arma::mat trainData(input.colptr(0), input.n_rows, trainSize, false, true);
+ * arma::mat testData(input.colptr(trainSize), input.n_rows,
+ *     input.n_cols - trainSize, false, true);
+ * @endcode
+ *
+ * @param input Input dataset to split in place.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *     sample is visited in linear order, and the input is not changed.
+ *     (Default true.)
+ * @return The number of points in the training set.
+ */
+template<typename T>
+size_t SplitInPlace(arma::Mat<T>& input,
+                    const double testRatio,
+                    const bool shuffleData = true)
+{
+  arma::uvec trainIndices, testIndices;
+  SplitIndices(input.n_cols, trainIndices, testIndices, testRatio,
+      shuffleData);
+  details::PermuteColumns(input, arma::join_cols(trainIndices, testIndices));
+
+  return trainIndices.n_elem;
+}
+
+/**
+ * Given an input dataset and labels, shuffle and partition both in place into a
+ * training set and a test set, without copying them.  After the call, the
+ * first columns of the input and the first labels are the training set, and
+ * the rest are the test set; the number of training points is returned.  The
+ * sets hold the same points, in the same order, as the sets Split() (or
+ * StratifiedSplit(), if stratifyData is true) would give with the same random
+ * seed.  See the other overload of SplitInPlace() for how to use the sets
+ * without copying them.
+ *
+ * @param input Input dataset to split in place.
+ * @param inputLabel Input labels to split in place; they must have one column
+ *     for each point, as arma::Row<> and arma::Mat<> labels do.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *     sample is visited in linear order. (Default true.)
+ * @param stratifyData If true, the train and test splits are stratified
+ *     so that the ratio of each class in the training and test sets is the same
+ *     as in the original dataset. Expects labels to be of type arma::Row<> or
+ *     arma::Col<>.
+ * @return The number of points in the training set.
+ */
+template<typename T, typename LabelsType,
+         typename = std::enable_if_t<arma::is_arma_type<LabelsType>::value> >
+size_t SplitInPlace(arma::Mat<T>& input,
+                    LabelsType& inputLabel,
+                    const double testRatio,
+                    const bool shuffleData = true,
+                    const bool stratifyData = false)
+{
+  arma::uvec trainIndices, testIndices;
+  if (stratifyData)
+  {
+    StratifiedSplitIndices(inputLabel, trainIndices, testIndices, testRatio,
+        shuffleData);
+  }
+  else
+  {
+    SplitIndices(input.n_cols, trainIndices, testIndices, testRatio,
+        shuffleData);
+  }
+
+  const arma::uvec order = arma::join_cols(trainIndices, testIndices);
+  details::PermuteColumns(input, order);
+  details::PermuteColumns(inputLabel, order);
+
+  return trainIndices.n_elem;
+}
+
 /**
  * Given an input dataset and labels, split into a training set and test set.
  * Example usage below.  This overload places the split dataset into the four
@@ -99,6 +99,13 @@ class StringEncoding
    * writes it in the column-major order. If the output type is 2D std::vector
    * then the function writes it in the row major order.
    *
+   * If the output type is arma::sp_mat and the policy encodes tokens from
+   * their counts (as BagOfWordsEncodingPolicy and TfIdfEncodingPolicy do),
+   * the strings are tokenized in parallel and the output is built directly in
+   * the sparse format; the tokenizer then has to be safe to call from many
+   * threads at once. This is the way to encode large corpora, whose dense
+   * encoding would not fit in memory.
+   *
    * @tparam OutputType Type of the output container. The function supports
    *                    the following types: arma::mat, arma::sp_mat,
    *                    std::vector<std::vector<>>.
@@ -202,6 +209,94 @@ class StringEncoding
                     typename std::enable_if<StringEncodingPolicyTraits<
                         PolicyType>::onePassEncoding>::type* = 0);
 
+  /**
+   * A helper function to encode the given text and write the result to
+   * the given sparse matrix in the column-major order. This is an overload for
+   * policies that encode the tokens of a string from their counts alone (see
+   * StringEncodingPolicyTraits::sparseEncoding). The strings are tokenized in
+   * parallel, and the output is built directly in the compressed sparse
+   * column format, so that it never takes more memory than its nonzero
+   * values. The labels the dictionary gives to new tokens do not depend on
+   * the number of threads, and are the same as the other overloads give.
+   *
+   * @tparam TokenizerType Type of the tokenizer.
+   * @tparam PolicyType The type of the encoding policy. It has to be
+   *                    equal to EncodingPolicyType.
+   * @tparam ElemType Type of the output values.
+   *
+   * @param input Corpus of text to encode.
+   * @param output Output sparse matrix to store the result.
+   * @param tokenizer The tokenizer object. It has to be safe to call from
+   *                  many threads at once.
+   * @param policy The policy object.
+   */
+  template<typename TokenizerType, typename PolicyType, typename ElemType>
+  void EncodeHelper(const std::vector<std::string>& input,
+                    arma::SpMat<ElemType>& output,
+                    const TokenizerType& tokenizer,
+                    PolicyType& policy,
+                    typename std::enable_if<StringEncodingPolicyTraits<
+                        PolicyType>::sparseEncoding>::type* = 0);
+
+  /**
+   * Tokenize the given strings in parallel, and count the tokens of each
+   * string. Each thread labels the strings of a contiguous block with its own
+   * dictionary, and the new tokens of the blocks are then added to the
+   * dictionary in order, so that tokens are labeled in the order in which
+   * they first appear in the input.
+   *
+   * For each string i, the labels of its distinct tokens (in increasing order)
+   * and their numbers of occurrences are stored in the vectors of its block,
+   * nonzeros[i] is set to the number of its distinct tokens and numTokens[i]
+   * to its total number of tokens.
+   *
+   * @tparam TokenizerType Type of the tokenizer.
+   * @tparam DictType Type of the dictionary; equal to DictionaryType.
+   *
+   * @param input Corpus of text to encode.
+   * @param tokenizer The tokenizer object.
+   * @param dict The dictionary.
+   * @param blockStarts Index of the first string of each block, followed by
+   *                    the number of strings.
+   * @param labels Labels of the tokens of each block.
+   * @param counts Numbers of occurrences of the tokens of each block.
+   * @param nonzeros Number of distinct tokens of each string.
+   * @param numTokens Number of tokens of each string.
+   */
+  template<typename TokenizerType, typename DictType>
+  void CountTokens(const std::vector<std::string>& input,
+                   const TokenizerType& tokenizer,
+                   DictType& dict,
+                   const std::vector<size_t>& blockStarts,
+                   std::vector<std::vector<size_t>>& labels,
+                   std::vector<std::vector<size_t>>& counts,
+                   std::vector<size_t>& nonzeros,
+                   std::vector<size_t>& numTokens);
+
+  /**
+   * Tokenize the given strings in parallel, and count the tokens of each
+   * string. This overload is for a HashingDictionary, whose labels can be
+   * looked up by all threads at once, so no merging is needed.
+   */
+  template<typename TokenizerType, typename Token>
+  void CountTokens(const std::vector<std::string>& input,
+                   const TokenizerType& tokenizer,
+                   HashingDictionary<Token>& dict,
+                   const std::vector<size_t>& blockStarts,
+                   std::vector<std::vector<size_t>>& labels,
+                   std::vector<std::vector<size_t>>& counts,
+                   std::vector<size_t>& nonzeros,
+                   std::vector<size_t>& numTokens);
+
+  /**
+   * Sort the given labels of the tokens of a string, and append each distinct
+   * label and its number of occurrences to the given vectors. Return the
+   * number of distinct labels.
+   */
+  static size_t AppendCounts(std::vector<size_t>& stringLabels,
+                             std::vector<size_t>& labels,
+                             std::vector<size_t>& counts);
+
  private:
   //! The encoding policy object.
   EncodingPolicyType encodingPolicy;
@@ -342,6 +342,110 @@ class StringEncodingDictionary<int>
   size_t size;
 };
 
+/**
+ * HashingDictionary implements the hashing trick: instead of storing the
+ * tokens, it labels each token by its hash modulo a fixed number of buckets.
+ * It takes no memory however many distinct tokens the input has, and any
+ * number of threads can look tokens up at once; the price is that tokens whose
+ * hashes collide share a label.  Labels start from one, like those of
+ * StringEncodingDictionary, and the same token always gets the same label.
+ *
+ * @tparam Token Type of the token (boost::string_view, std::string or int).
+ */
+template<typename Token>
+class HashingDictionary
+{
+ public:
+  //! The type of the token that the dictionary labels.
+  using TokenType = Token;
+
+  /**
+   * Construct the dictionary with the given number of buckets.
+   *
+   * @param numBuckets The number of distinct labels.
+   */
+  HashingDictionary(const size_t numBuckets = (1 << 20)) :
+      numBuckets(numBuckets)
+  {
+    if (numBuckets == 0)
+    {
+      throw std::invalid_argument("HashingDictionary: the number of buckets "
+          "must be positive!");
+    }
+  }
+
+  /**
+   * The function returns true, since every token has a label.
+   *
+   * @param * (token) The given token.
+   */
+  static bool HasToken(const Token& /* token */) { return true; }
+
+  /**
+   * The function returns the label of the given token; nothing is stored.
+   *
+   * @param token The given token.
+   */
+  size_t AddToken(const Token& token) const { return Value(token); }
+
+  /**
+   * The function returns the label of the given token.
+   *
+   * @param token The given token.
+   */
+  size_t Value(const Token& token) const
+  {
+    return Hash(token) % numBuckets + 1;
+  }
+
+  //! Get the number of labels.
+  size_t Size() const { return numBuckets; }
+
+  //! Clear the dictionary (there is nothing to clear).
+  void Clear() { }
+
+  //! Get the number of buckets.
+  size_t NumBuckets() const { return numBuckets; }
+  //! Modify the number of buckets.
+  size_t& NumBuckets() { return numBuckets; }
+
+  /**
+   * Serialize the class to the given archive.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(numBuckets));
+  }
+
+ private:
+  /**
+   * Hash the given token with 64-bit FNV-1a, so that labels do not depend on
+   * the platform or the standard library.
+   */
+  static uint64_t Hash(const boost::string_view token)
+  {
+    uint64_t hash = 14695981039346656037ULL;
+    for (const char symbol : token)
+    {
+      hash ^= static_cast<unsigned char>(symbol);
+      hash *= 1099511628211ULL;
+    }
+
+    return hash;
+  }
+
+  //! Hash the given character.
+  static uint64_t Hash(const int token)
+  {
+    const char symbol = static_cast<char>(token);
+    return Hash(boost::string_view(&symbol, 1));
+  }
+
+  //! The number of buckets.
+  size_t numBuckets;
+};
+
 } // namespace data
 } // namespace mlpack
 
@@ -196,6 +196,265 @@ EncodeHelper(const std::vector<std::string>& input,
   }
 }
 
+template<typename EncodingPolicyType, typename DictionaryType>
+template<typename TokenizerType, typename PolicyType, typename ElemType>
+void StringEncoding<EncodingPolicyType, DictionaryType>::
+EncodeHelper(const std::vector<std::string>& input,
+             arma::SpMat<ElemType>& output,
+             const TokenizerType& tokenizer,
+             PolicyType& policy,
+             typename std::enable_if<StringEncodingPolicyTraits<
+                 PolicyType>::sparseEncoding>::type*)
+{
+  policy.Reset();
+
+  // Split the strings into a contiguous block for each thread.
+  size_t numBlocks = 1;
+  #ifdef HAS_OPENMP
+    numBlocks = omp_get_max_threads();
+  #endif
+  numBlocks = std::max((size_t) 1, std::min(numBlocks, input.size()));
+
+  std::vector<size_t> blockStarts(numBlocks + 1);
+  for (size_t b = 0; b <= numBlocks; ++b)
+    blockStarts[b] = b * input.size() / numBlocks;
+
+  std::vector<std::vector<size_t>> labels(numBlocks);
+  std::vector<std::vector<size_t>> counts(numBlocks);
+  std::vector<size_t> nonzeros(input.size());
+  std::vector<size_t> numTokens(input.size());
+  CountTokens(input, tokenizer, dictionary, blockStarts, labels, counts,
+      nonzeros, numTokens);
+
+  // Each string is a column, with a nonzero value for each distinct token.
+  arma::uvec colPtrs(input.size() + 1);
+  colPtrs[0] = 0;
+  for (size_t i = 0; i < input.size(); ++i)
+    colPtrs[i + 1] = colPtrs[i] + nonzeros[i];
+
+  // The labels are assigned sequentially starting from one.
+  arma::uvec rowIndices(colPtrs[input.size()]);
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    const size_t offset = colPtrs[blockStarts[b]];
+    for (size_t j = 0; j < labels[b].size(); ++j)
+      rowIndices[offset + j] = labels[b][j] - 1;
+
+    std::vector<size_t>().swap(labels[b]);
+  }
+
+  std::vector<size_t> numContainingStrings(dictionary.Size(), 0);
+  for (size_t j = 0; j < rowIndices.n_elem; ++j)
+    numContainingStrings[rowIndices[j]]++;
+
+  arma::Col<ElemType> values(rowIndices.n_elem);
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    const size_t offset = colPtrs[blockStarts[b]];
+    for (size_t i = blockStarts[b]; i < blockStarts[b + 1]; ++i)
+    {
+      for (size_t j = colPtrs[i]; j < colPtrs[i + 1]; ++j)
+      {
+        values[j] = policy.template EncodedValue<ElemType>(
+            counts[b][j - offset], numTokens[i], input.size(),
+            numContainingStrings[rowIndices[j]]);
+      }
+    }
+  }
+
+  output = arma::SpMat<ElemType>(rowIndices, colPtrs, values,
+      dictionary.Size(), input.size());
+}
+
+template<typename EncodingPolicyType, typename DictionaryType>
+template<typename TokenizerType, typename DictType>
+void StringEncoding<EncodingPolicyType, DictionaryType>::CountTokens(
+    const std::vector<std::string>& input,
+    const TokenizerType& tokenizer,
+    DictType& dict,
+    const std::vector<size_t>& blockStarts,
+    std::vector<std::vector<size_t>>& labels,
+    std::vector<std::vector<size_t>>& counts,
+    std::vector<size_t>& nonzeros,
+    std::vector<size_t>& numTokens)
+{
+  using TokenType = typename DictType::TokenType;
+  const size_t numBlocks = blockStarts.size() - 1;
+
+  // The new tokens of each block, in the order the block labels them.
+  std::vector<std::vector<TokenType>> blockTokens(numBlocks);
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    // Each block labels its tokens with a dictionary of its own, which only
+    // holds the tokens that the main dictionary doesn't have yet.
+    DictType blockDict;
+    std::vector<size_t> stringLabels;
+    for (size_t i = blockStarts[b]; i < blockStarts[b + 1]; ++i)
+    {
+      boost::string_view strView(input[i]);
+      auto token = tokenizer(strView);
+
+      static_assert(
+          std::is_same<typename std::remove_reference<decltype(token)>::type,
+                       typename std::remove_reference<TokenType>::type>::value,
+          "The dictionary token type doesn't match the return value type "
+          "of the tokenizer.");
+
+      stringLabels.clear();
+      while (!tokenizer.IsTokenEmpty(token))
+      {
+        // Known tokens get their labels right away; the labels of the
+        // block dictionary are stored shifted by the size of the main one.
+        if (dict.HasToken(token))
+        {
+          stringLabels.push_back(dict.Value(token));
+        }
+        else if (blockDict.HasToken(token))
+        {
+          stringLabels.push_back(dict.Size() + blockDict.Value(token));
+        }
+        else
+        {
+          blockTokens[b].push_back(token);
+          stringLabels.push_back(dict.Size() +
+              blockDict.AddToken(std::move(token)));
+        }
+
+        token = tokenizer(strView);
+      }
+
+      numTokens[i] = stringLabels.size();
+      nonzeros[i] = AppendCounts(stringLabels, labels[b], counts[b]);
+    }
+  }
+
+  // Add the new tokens to the dictionary block by block, so that they are
+  // labeled in the order in which they first appear in the input.
+  const size_t dictSize = dict.Size();
+  std::vector<std::vector<size_t>> newLabels(numBlocks);
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    newLabels[b].resize(blockTokens[b].size());
+    for (size_t k = 0; k < blockTokens[b].size(); ++k)
+    {
+      const TokenType& token = blockTokens[b][k];
+      newLabels[b][k] = dict.HasToken(token) ? dict.Value(token) :
+          dict.AddToken(token);
+    }
+
+    std::vector<TokenType>().swap(blockTokens[b]);
+  }
+
+  // Translate the labels of the new tokens, and sort the labels of each
+  // string again.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    std::vector<std::pair<size_t, size_t>> stringCounts;
+    size_t offset = 0;
+    for (size_t i = blockStarts[b]; i < blockStarts[b + 1]; ++i)
+    {
+      stringCounts.clear();
+      bool hasNewTokens = false;
+      for (size_t j = offset; j < offset + nonzeros[i]; ++j)
+      {
+        size_t label = labels[b][j];
+        if (label > dictSize)
+        {
+          label = newLabels[b][label - dictSize - 1];
+          hasNewTokens = true;
+        }
+
+        stringCounts.emplace_back(label, counts[b][j]);
+      }
+
+      if (hasNewTokens)
+      {
+        std::sort(stringCounts.begin(), stringCounts.end());
+        for (size_t j = 0; j < stringCounts.size(); ++j)
+        {
+          labels[b][offset + j] = stringCounts[j].first;
+          counts[b][offset + j] = stringCounts[j].second;
+        }
+      }
+
+      offset += nonzeros[i];
+    }
+  }
+}
+
+template<typename EncodingPolicyType, typename DictionaryType>
+template<typename TokenizerType, typename Token>
+void StringEncoding<EncodingPolicyType, DictionaryType>::CountTokens(
+    const std::vector<std::string>& input,
+    const TokenizerType& tokenizer,
+    HashingDictionary<Token>& dict,
+    const std::vector<size_t>& blockStarts,
+    std::vector<std::vector<size_t>>& labels,
+    std::vector<std::vector<size_t>>& counts,
+    std::vector<size_t>& nonzeros,
+    std::vector<size_t>& numTokens)
+{
+  const size_t numBlocks = blockStarts.size() - 1;
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    std::vector<size_t> stringLabels;
+    for (size_t i = blockStarts[b]; i < blockStarts[b + 1]; ++i)
+    {
+      boost::string_view strView(input[i]);
+      auto token = tokenizer(strView);
+
+      static_assert(
+          std::is_same<typename std::remove_reference<decltype(token)>::type,
+                       typename std::remove_reference<Token>::type>::value,
+          "The dictionary token type doesn't match the return value type "
+          "of the tokenizer.");
+
+      stringLabels.clear();
+      while (!tokenizer.IsTokenEmpty(token))
+      {
+        stringLabels.push_back(dict.Value(token));
+        token = tokenizer(strView);
+      }
+
+      numTokens[i] = stringLabels.size();
+      nonzeros[i] = AppendCounts(stringLabels, labels[b], counts[b]);
+    }
+  }
+}
+
+template<typename EncodingPolicyType, typename DictionaryType>
+size_t StringEncoding<EncodingPolicyType, DictionaryType>::AppendCounts(
+    std::vector<size_t>& stringLabels,
+    std::vector<size_t>& labels,
+    std::vector<size_t>& counts)
+{
+  std::sort(stringLabels.begin(), stringLabels.end());
+
+  size_t numDistinct = 0;
+  for (size_t j = 0; j < stringLabels.size(); ++j)
+  {
+    if (j > 0 && stringLabels[j] == stringLabels[j - 1])
+    {
+      counts.back()++;
+    }
+    else
+    {
+      labels.push_back(stringLabels[j]);
+      counts.push_back(1);
+      numDistinct++;
+    }
+  }
+
+  return numDistinct;
+}
+
 template<typename EncodingPolicyType, typename DictionaryType>
 template<typename Archive>
 void StringEncoding<EncodingPolicyType, DictionaryType>::serialize(
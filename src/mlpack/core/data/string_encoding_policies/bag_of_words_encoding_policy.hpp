@@ -146,6 +146,28 @@ class BagOfWordsEncodingPolicy
                               size_t /* value */)
   { }
 
+  /**
+   * The function returns the encoded value of a token from its number of
+   * occurrences in the string. It is used to encode into a sparse matrix.
+   *
+   * @tparam ElemType Type of the output values.
+   *
+   * @param numOccurrences The number of times the token occurs in the string.
+   * @param * (numTokens) The total number of tokens in the string (not used).
+   * @param * (numStrings) The number of strings in the input dataset (not
+   *     used).
+   * @param * (numContainingStrings) The number of strings in the input dataset
+   *     which contain the token (not used).
+   */
+  template<typename ElemType>
+  static ElemType EncodedValue(const size_t numOccurrences,
+                               const size_t /* numTokens */,
+                               const size_t /* numStrings */,
+                               const size_t /* numContainingStrings */)
+  {
+    return numOccurrences;
+  }
+
   /**
    * Serialize the class to the given archive.
    */
@@ -156,6 +178,22 @@ class BagOfWordsEncodingPolicy
   }
 };
 
+template<>
+struct StringEncodingPolicyTraits<BagOfWordsEncodingPolicy>
+{
+  /**
+   * Indicates if the policy is able to encode the token at once without
+   * any information about other tokens as well as the total tokens count.
+   */
+  static const bool onePassEncoding = false;
+
+  /**
+   * Indicates if the policy is able to encode the tokens of a string from
+   * their counts alone.
+   */
+  static const bool sparseEncoding = true;
+};
+
 /**
  * A convenient alias for the StringEncoding class with BagOfWordsEncodingPolicy
  * and the default dictionary for the given token type.
@@ -165,6 +203,16 @@ class BagOfWordsEncodingPolicy
 template<typename TokenType>
 using BagOfWordsEncoding = StringEncoding<BagOfWordsEncodingPolicy,
                                           StringEncodingDictionary<TokenType>>;
+
+/**
+ * A convenient alias for the StringEncoding class with BagOfWordsEncodingPolicy
+ * and a HashingDictionary, i.e. bag of words with the hashing trick.
+ *
+ * @tparam TokenType Type of the tokens.
+ */
+template<typename TokenType>
+using HashingBagOfWordsEncoding = StringEncoding<BagOfWordsEncodingPolicy,
+                                                 HashingDictionary<TokenType>>;
 } // namespace data
 } // namespace mlpack
 
@@ -133,6 +133,12 @@ struct StringEncodingPolicyTraits<DictionaryEncodingPolicy>
    * any information about other tokens as well as the total tokens count.
    */
   static const bool onePassEncoding = true;
+
+  /**
+   * Indicates if the policy is able to encode the tokens of a string from
+   * their counts alone.
+   */
+  static const bool sparseEncoding = false;
 };
 
 /**
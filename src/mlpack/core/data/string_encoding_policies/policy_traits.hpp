@@ -31,6 +31,16 @@ struct StringEncodingPolicyTraits
    * any information about other tokens as well as the total tokens count.
    */
   static const bool onePassEncoding = false;
+
+  /**
+   * Indicates if the value that the policy writes for a token only depends on
+   * the number of times the token occurs in the string, the number of tokens
+   * in the string, the number of strings and the number of strings that
+   * contain the token.  Such a policy provides the EncodedValue() function,
+   * and StringEncoding encodes with it directly into a sparse matrix, using
+   * all available threads.
+   */
+  static const bool sparseEncoding = false;
 };
 
 } // namespace data
@@ -217,7 +217,29 @@ class TfIdfEncodingPolicy
     linesSizes[line]++;
   }
 
-  //! Return token frequencies.
+  /**
+   * The function returns the tf-idf value of a token from its number of
+   * occurrences in the string. It is used to encode into a sparse matrix.
+   *
+   * @tparam ElemType Type of the output values.
+   *
+   * @param numOccurrences The number of times the token occurs in the string.
+   * @param numTokens The total number of tokens in the string.
+   * @param numStrings The number of strings in the input dataset.
+   * @param numContainingStrings The number of strings in the input dataset
+   *     which contain the token.
+   */
+  template<typename ElemType>
+  ElemType EncodedValue(const size_t numOccurrences,
+                        const size_t numTokens,
+                        const size_t numStrings,
+                        const size_t numContainingStrings) const
+  {
+    return TermFrequency<ElemType>(numOccurrences, numTokens) *
+        InverseDocumentFrequency<ElemType>(numStrings, numContainingStrings);
+  }
+
+  //! Return token frequencies (not collected when encoding into sp_mat).
   const std::vector<std::unordered_map<size_t, size_t>>&
       TokensFrequences() const { return tokensFrequences; }
   //! Modify token frequencies.
@@ -275,7 +297,7 @@ class TfIdfEncodingPolicy
    */
   template<typename ValueType>
   ValueType TermFrequency(const size_t numOccurrences,
-                          const size_t numTokens)
+                          const size_t numTokens) const
   {
     switch (tfType)
     {
@@ -304,7 +326,7 @@ class TfIdfEncodingPolicy
    */
   template<typename ValueType>
   ValueType InverseDocumentFrequency(const size_t totalNumLines,
-                                     const size_t numOccurrences)
+                                     const size_t numOccurrences) const
   {
     if (smoothIdf)
     {
@@ -334,6 +356,22 @@ class TfIdfEncodingPolicy
   bool smoothIdf;
 };
 
+template<>
+struct StringEncodingPolicyTraits<TfIdfEncodingPolicy>
+{
+  /**
+   * Indicates if the policy is able to encode the token at once without
+   * any information about other tokens as well as the total tokens count.
+   */
+  static const bool onePassEncoding = false;
+
+  /**
+   * Indicates if the policy is able to encode the tokens of a string from
+   * their counts alone.
+   */
+  static const bool sparseEncoding = true;
+};
+
 /**
  * A convenient alias for the StringEncoding class with TfIdfEncodingPolicy
  * and the default dictionary for the given token type.
@@ -343,6 +381,16 @@ class TfIdfEncodingPolicy
 template<typename TokenType>
 using TfIdfEncoding = StringEncoding<TfIdfEncodingPolicy,
                                      StringEncodingDictionary<TokenType>>;
+
+/**
+ * A convenient alias for the StringEncoding class with TfIdfEncodingPolicy
+ * and a HashingDictionary, i.e. tf-idf with the hashing trick.
+ *
+ * @tparam TokenType Type of the tokens.
+ */
+template<typename TokenType>
+using HashingTfIdfEncoding = StringEncoding<TfIdfEncodingPolicy,
+                                            HashingDictionary<TokenType>>;
 } // namespace data
 } // namespace mlpack
 
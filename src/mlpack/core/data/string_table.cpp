@@ -0,0 +1,181 @@
+/**
+ * @file core/data/string_table.cpp
+ *
+ * Implementation of the StringTable class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "string_table.hpp"
+
+namespace mlpack {
+namespace data {
+
+// Definition of the static member, for when it is odr-used.
+const size_t StringTable::numShards;
+
+StringTable::StringTable()
+{
+  for (size_t i = 0; i < numShards; ++i)
+  {
+    shards.push_back(std::unique_ptr<Shard>(new Shard()));
+    shards.back()->slots.resize(16, 0);
+    shards.back()->blockUsed = 0;
+    shards.back()->blockSize = 0;
+  }
+}
+
+size_t StringTable::Insert(const char* str,
+                           const size_t length,
+                           const size_t position)
+{
+  const uint64_t hash = Hash(str, length);
+  // The low bits pick the shard, so the slot is chosen with the others.
+  const size_t shardIndex = hash & (numShards - 1);
+  Shard& shard = *shards[shardIndex];
+
+  std::lock_guard<std::mutex> guard(shard.lock);
+  const size_t mask = shard.slots.size() - 1;
+  size_t slot = (hash / numShards) & mask;
+  while (shard.slots[slot] != 0)
+  {
+    Entry& entry = shard.entries[shard.slots[slot] - 1];
+    if (entry.hash == hash && entry.length == length &&
+        std::memcmp(entry.str, str, length) == 0)
+    {
+      entry.position = std::min(entry.position, position);
+      return entry.id;
+    }
+
+    slot = (slot + 1) & mask;
+  }
+
+  // This is a new string.
+  Entry entry;
+  entry.str = Store(shard, str, length);
+  entry.length = length;
+  entry.hash = hash;
+  entry.position = position;
+  entry.id = shard.entries.size() * numShards + shardIndex;
+  shard.entries.push_back(entry);
+  shard.slots[slot] = shard.entries.size();
+
+  // Keep the load factor at most one half.
+  if (2 * shard.entries.size() > shard.slots.size())
+    Grow(shard);
+
+  return entry.id;
+}
+
+void StringTable::Finalize(std::vector<size_t>& ids)
+{
+  size_t maxEntries = 0;
+  sorted.clear();
+  for (size_t s = 0; s < numShards; ++s)
+  {
+    maxEntries = std::max(maxEntries, shards[s]->entries.size());
+    for (size_t i = 0; i < shards[s]->entries.size(); ++i)
+      sorted.push_back(&shards[s]->entries[i]);
+  }
+
+  // Positions are unique unless a string was inserted twice with the same
+  // position; break ties by the string so the order is still deterministic.
+  std::sort(sorted.begin(), sorted.end(),
+      [](const Entry* a, const Entry* b)
+      {
+        if (a->position != b->position)
+          return a->position < b->position;
+        const int c = std::memcmp(a->str, b->str, std::min(a->length,
+            b->length));
+        return (c != 0) ? (c < 0) : (a->length < b->length);
+      });
+
+  ids.assign(maxEntries * numShards, 0);
+  for (size_t i = 0; i < sorted.size(); ++i)
+    ids[sorted[i]->id] = i;
+}
+
+size_t StringTable::Size() const
+{
+  size_t size = 0;
+  for (size_t s = 0; s < numShards; ++s)
+    size += shards[s]->entries.size();
+  return size;
+}
+
+std::string StringTable::String(const size_t id) const
+{
+  return std::string(sorted[id]->str, sorted[id]->length);
+}
+
+uint64_t StringTable::Hash(const char* str, const size_t length)
+{
+  // Mix eight bytes at a time with the finalizer of MurmurHash3.
+  const auto mix = [](uint64_t h)
+  {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+  };
+
+  uint64_t hash = 0x9e3779b97f4a7c15ULL ^ length;
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8)
+  {
+    uint64_t word;
+    std::memcpy(&word, str + i, 8);
+    hash = mix(hash ^ word) + 0x9e3779b97f4a7c15ULL;
+  }
+
+  if (i < length)
+  {
+    uint64_t word = 0;
+    std::memcpy(&word, str + i, length - i);
+    hash = mix(hash ^ word);
+  }
+
+  return mix(hash);
+}
+
+const char* StringTable::Store(Shard& shard,
+                               const char* str,
+                               const size_t length)
+{
+  if (shard.blocks.empty() || shard.blockUsed + length > shard.blockSize)
+  {
+    // Blocks grow with the shard, but long strings get a block of their own
+    // size.
+    shard.blockSize = std::max(length, std::max((size_t) 4096,
+        std::min(2 * shard.blockSize, (size_t) (1 << 20))));
+    shard.blocks.push_back(std::unique_ptr<char[]>(new char[shard.blockSize]));
+    shard.blockUsed = 0;
+  }
+
+  char* copy = shard.blocks.back().get() + shard.blockUsed;
+  std::memcpy(copy, str, length);
+  shard.blockUsed += length;
+  return copy;
+}
+
+void StringTable::Grow(Shard& shard)
+{
+  std::vector<size_t> slots(2 * shard.slots.size(), 0);
+  const size_t mask = slots.size() - 1;
+  for (size_t i = 0; i < shard.entries.size(); ++i)
+  {
+    size_t slot = (shard.entries[i].hash / numShards) & mask;
+    while (slots[slot] != 0)
+      slot = (slot + 1) & mask;
+    slots[slot] = i + 1;
+  }
+
+  shard.slots.swap(slots);
+}
+
+} // namespace data
+} // namespace mlpack
@@ -0,0 +1,131 @@
+/**
+ * @file core/data/string_table.hpp
+ *
+ * A hash table of strings that many threads can insert into at once, used to
+ * map categorical tokens while a file is parsed in parallel.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_STRING_TABLE_HPP
+#define MLPACK_CORE_DATA_STRING_TABLE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <memory>
+#include <mutex>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * StringTable assigns an id to each distinct string inserted into it.  It is
+ * meant for mapping many tokens that point into a larger buffer (such as a
+ * memory-mapped file): a token is only copied the first time it is seen, into
+ * an arena owned by the table, and lookups never allocate.
+ *
+ * The table is split into shards by the hash of the string.  Each shard is an
+ * open-addressing hash table with linear probing and its own lock, so threads
+ * inserting at once rarely wait on each other.
+ *
+ * Because threads insert in no particular order, Insert() returns a
+ * provisional id.  Each insertion also gives the position of the token (for
+ * instance, its line in a file), and the table remembers the smallest position
+ * of each string.  Once all insertions are done, Finalize() numbers the strings
+ * by their first position, which does not depend on the order of insertions;
+ * with positions taken in file order, these are the ids that a serial pass
+ * over the file would give.
+ */
+class StringTable
+{
+ public:
+  //! Create an empty table.
+  StringTable();
+
+  /**
+   * Insert the given string, if it is not in the table yet, and return its
+   * provisional id.  This may be called from many threads at once, but not at
+   * the same time as any other method.
+   *
+   * @param str Pointer to the string (it does not need to be null-terminated).
+   * @param length Length of the string.
+   * @param position Position of this occurrence of the string.
+   */
+  size_t Insert(const char* str, const size_t length, const size_t position);
+
+  /**
+   * Number the strings in the table by their first position.  After this,
+   * ids[provisionalId] is the final id of each string, and String() can be
+   * used to get the strings by their final ids.
+   *
+   * @param ids Vector to store the final id of each provisional id in.
+   */
+  void Finalize(std::vector<size_t>& ids);
+
+  //! Get the number of distinct strings in the table.
+  size_t Size() const;
+
+  //! Get the string with the given final id (only valid after Finalize()).
+  std::string String(const size_t id) const;
+
+ private:
+  // Copying a table is not allowed.
+  StringTable(const StringTable& other);
+  StringTable& operator=(const StringTable& other);
+
+  //! A distinct string in the table.
+  struct Entry
+  {
+    //! The copy of the string in the arena.
+    const char* str;
+    //! Length of the string.
+    size_t length;
+    //! Hash of the string.
+    uint64_t hash;
+    //! Smallest position the string was inserted with.
+    size_t position;
+    //! Provisional id of the string.
+    size_t id;
+  };
+
+  //! One part of the table, holding the strings with some hashes.
+  struct Shard
+  {
+    //! Guards everything in the shard.
+    std::mutex lock;
+    //! Open-addressing slots; each holds an entry index plus one, or 0.
+    std::vector<size_t> slots;
+    //! The strings in this shard, by local index.
+    std::vector<Entry> entries;
+    //! Blocks of memory that the strings are copied into.
+    std::vector<std::unique_ptr<char[]>> blocks;
+    //! Number of bytes used in the last block.
+    size_t blockUsed;
+    //! Size of the last block.
+    size_t blockSize;
+  };
+
+  //! Number of shards; a power of two.
+  static const size_t numShards = 64;
+
+  //! Hash the given string.
+  static uint64_t Hash(const char* str, const size_t length);
+
+  //! Copy the given string into the arena of the given shard.
+  static const char* Store(Shard& shard, const char* str, const size_t length);
+
+  //! Double the number of slots of the given shard.
+  static void Grow(Shard& shard);
+
+  //! The shards.
+  std::vector<std::unique_ptr<Shard>> shards;
+  //! Entries by final id, set by Finalize().
+  std::vector<const Entry*> sorted;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,106 @@
+/**
+ * @file core/hpt/candidates.hpp
+ *
+ * Tools to build the sets of hyper-parameters that the search strategies of
+ * HyperParameterTuner evaluate.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_CANDIDATES_HPP
+#define MLPACK_CORE_HPT_CANDIDATES_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+
+namespace mlpack {
+namespace hpt {
+namespace details {
+
+/**
+ * Make sure that every dimension is categorical, since the search strategies
+ * only choose from sets of values, and return the number of points in the
+ * grid.
+ *
+ * @param name Name of the calling strategy, for error messages.
+ * @param categoricalDimensions Whether each dimension is categorical.
+ * @param numCategories Number of values of each dimension.
+ */
+inline double GridSize(const std::string& name,
+                       const std::vector<bool>& categoricalDimensions,
+                       const arma::Row<size_t>& numCategories)
+{
+  double size = 1.0;
+  for (size_t i = 0; i < categoricalDimensions.size(); ++i)
+  {
+    if (!categoricalDimensions[i])
+    {
+      std::ostringstream oss;
+      oss << name << "::Optimize(): the dimension " << i << " is not "
+          << "categorical" << std::endl;
+      throw std::invalid_argument(oss.str());
+    }
+
+    size *= numCategories[i];
+  }
+
+  return size;
+}
+
+/**
+ * Get every point of the grid, one in each column.  The points are in the
+ * order in which GridSearch visits them: the last dimension changes fastest.
+ *
+ * @param numCategories Number of values of each dimension.
+ */
+inline arma::mat GridCandidates(const arma::Row<size_t>& numCategories)
+{
+  size_t numPoints = 1;
+  for (size_t i = 0; i < numCategories.n_elem; ++i)
+    numPoints *= numCategories[i];
+
+  arma::mat candidates(numCategories.n_elem, numPoints);
+  for (size_t j = 0; j < numPoints; ++j)
+  {
+    size_t index = j;
+    for (size_t i = numCategories.n_elem; i > 0; --i)
+    {
+      candidates(i - 1, j) = index % numCategories[i - 1];
+      index /= numCategories[i - 1];
+    }
+  }
+
+  return candidates;
+}
+
+/**
+ * Get the given number of points of the grid drawn uniformly at random, one in
+ * each column.  If there are at least as many as there are points in the grid,
+ * the whole grid is given instead.
+ *
+ * @param numCategories Number of values of each dimension.
+ * @param gridSize Number of points in the grid.
+ * @param numCandidates Number of points to draw.
+ */
+inline arma::mat RandomCandidates(const arma::Row<size_t>& numCategories,
+                                  const double gridSize,
+                                  const size_t numCandidates)
+{
+  if ((double) numCandidates >= gridSize)
+    return GridCandidates(numCategories);
+
+  arma::mat candidates(numCategories.n_elem, numCandidates);
+  for (size_t j = 0; j < numCandidates; ++j)
+    for (size_t i = 0; i < numCategories.n_elem; ++i)
+      candidates(i, j) = math::RandInt(numCategories[i]);
+
+  return candidates;
+}
+
+} // namespace details
+} // namespace hpt
+} // namespace mlpack
+
+#endif
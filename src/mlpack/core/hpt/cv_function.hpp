@@ -83,6 +83,24 @@ class CVFunction
    */
   void Gradient(const arma::mat& parameters, arma::mat& gradient);
 
+  /**
+   * Run cross-validation with each of the given sets of parameters
+   * concurrently, with the given budget (see the EvaluateWithBudget() method
+   * of the CVType class).  Each thread trains its own models, so the training
+   * of MLAlgorithm has to be safe to run concurrently; each set of parameters
+   * draws random numbers from its own math::RandomStream.  Only models trained
+   * with the full budget can become the best model; ties are broken in favor
+   * of the first set of parameters, so the result does not depend on the
+   * number of threads.
+   *
+   * @param candidates Sets of parameters to evaluate, one in each column.
+   * @param objectives Row to store the objective of each set of parameters in.
+   * @param budget The budget of each evaluation (more than 0 and at most 1).
+   */
+  void Evaluate(const arma::mat& candidates,
+                arma::rowvec& objectives,
+                const double budget = 1.0);
+
   //! Access and modify the best model so far.
   MLAlgorithm& BestModel() { return bestModel; }
 
@@ -125,36 +143,71 @@ class CVFunction
   //! Minimum absolute increase of arguments for calculation of gradient.
   double minDelta;
 
+  /**
+   * Run cross-validation with the collected arguments, and keep the trained
+   * model if it is the best so far.
+   */
+  struct FullEvaluator
+  {
+    CVFunction& function;
+
+    template<typename... Args>
+    double operator()(const Args&... args);
+  };
+
+  /**
+   * Run cross-validation with the collected arguments and the given budget,
+   * and store the trained model in the given model.
+   */
+  struct BudgetEvaluator
+  {
+    CVType& cv;
+    double budget;
+    MLAlgorithm& model;
+
+    template<typename... Args>
+    double operator()(const Args&... args);
+  };
+
   /**
    * Collect all arguments and run cross-validation.
    */
   template<size_t BoundArgIndex,
            size_t ParamIndex,
+           typename EvaluatorType,
            typename... Args,
            typename = typename
                std::enable_if<(BoundArgIndex + ParamIndex < TotalArgs)>::type>
-  inline double Evaluate(const arma::mat& parameters, const Args&... args);
+  inline double Evaluate(EvaluatorType& evaluator,
+                         const arma::mat& parameters,
+                         const Args&... args);
 
   /**
    * Run cross-validation with the collected arguments.
    */
   template<size_t BoundArgIndex,
            size_t ParamIndex,
+           typename EvaluatorType,
            typename... Args,
            typename = typename
                std::enable_if<BoundArgIndex + ParamIndex == TotalArgs>::type,
            typename = void>
-  inline double Evaluate(const arma::mat& parameters, const Args&... args);
+  inline double Evaluate(EvaluatorType& evaluator,
+                         const arma::mat& parameters,
+                         const Args&... args);
 
   /**
    * Put the bound argument (at the BoundArgIndex position) as the next one.
    */
   template<size_t BoundArgIndex,
            size_t ParamIndex,
+           typename EvaluatorType,
            typename... Args,
            typename = typename std::enable_if<
                UseBoundArg<BoundArgIndex, ParamIndex>::value>::type>
-  inline double PutNextArg(const arma::mat& parameters, const Args&... args);
+  inline double PutNextArg(EvaluatorType& evaluator,
+                           const arma::mat& parameters,
+                           const Args&... args);
 
   /**
    * Put the element (at the ParamIndex position) of the parameters as the next
@@ -162,11 +215,14 @@ class CVFunction
    */
   template<size_t BoundArgIndex,
            size_t ParamIndex,
+           typename EvaluatorType,
            typename... Args,
            typename = typename std::enable_if<
                !UseBoundArg<BoundArgIndex, ParamIndex>::value>::type,
            typename = void>
-  inline double PutNextArg(const arma::mat& parameters, const Args&... args);
+  inline double PutNextArg(EvaluatorType& evaluator,
+                           const arma::mat& parameters,
+                           const Args&... args);
 };
 
 
@@ -65,7 +65,8 @@ template<typename CVType,
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
     const arma::mat& parameters)
 {
-  return Evaluate<0, 0>(parameters);
+  FullEvaluator evaluator{*this};
+  return Evaluate<0, 0>(evaluator, parameters);
 }
 
 template<typename CVType,
@@ -89,19 +90,147 @@ void CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Gradient(
   }
 }
 
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+void CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
+    const arma::mat& candidates,
+    arma::rowvec& objectives,
+    const double budget)
+{
+  const size_t numCandidates = candidates.n_cols;
+  objectives.set_size(numCandidates);
+
+  // The best candidate of this batch and its model.
+  size_t batchBestIndex = numCandidates;
+  double batchBestObjective = 0.0;
+  MLAlgorithm batchBestModel;
+
+  // Each candidate draws from its own random stream, so the objectives don't
+  // depend on the number of threads.
+  const size_t seed = math::RandomStreamSeed();
+
+  // An exception can't leave the parallel region, so the first one is kept
+  // and thrown afterwards.
+  std::exception_ptr exception;
+
+  #pragma omp parallel
+  {
+    size_t threadBestIndex = numCandidates;
+    double threadBestObjective = 0.0;
+    MLAlgorithm threadBestModel;
+    MLAlgorithm model;
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) numCandidates; ++i)
+    {
+      try
+      {
+        math::RandomStream stream(seed, i);
+        math::RandomStreamScope scope(stream);
+        const arma::mat parameters = candidates.col(i);
+        BudgetEvaluator evaluator{cv, budget, model};
+        objectives[i] = Evaluate<0, 0>(evaluator, parameters);
+
+        // Candidates are visited in increasing order by each thread, so a tie
+        // keeps the first one.  An invalid objective is never the best.
+        if (!std::isnan(objectives[i]) &&
+            (threadBestIndex == numCandidates ||
+             objectives[i] < threadBestObjective))
+        {
+          threadBestIndex = i;
+          threadBestObjective = objectives[i];
+          threadBestModel = std::move(model);
+        }
+      }
+      catch (...)
+      {
+        #pragma omp critical
+        {
+          if (!exception)
+            exception = std::current_exception();
+        }
+      }
+    }
+
+    #pragma omp critical
+    {
+      if (threadBestIndex < numCandidates &&
+          (batchBestIndex == numCandidates ||
+           threadBestObjective < batchBestObjective ||
+           (threadBestObjective == batchBestObjective &&
+            threadBestIndex < batchBestIndex)))
+      {
+        batchBestIndex = threadBestIndex;
+        batchBestObjective = threadBestObjective;
+        batchBestModel = std::move(threadBestModel);
+      }
+    }
+  }
+
+  if (exception)
+    std::rethrow_exception(exception);
+
+  // Change the best model as Evaluate() would, but only with models that were
+  // trained with the full budget.
+  if (budget >= 1.0 && batchBestIndex < numCandidates &&
+      (bestObjective > batchBestObjective ||
+       bestObjective == std::numeric_limits<double>::max()))
+  {
+    bestObjective = batchBestObjective;
+    bestModel = std::move(batchBestModel);
+  }
+}
+
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+template<typename... Args>
+double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::
+    FullEvaluator::operator()(const Args&... args)
+{
+  double objective = function.cv.Evaluate(args...);
+
+  // Change the best model if we have got a better score, or if we probably
+  // have not assigned any valid (trained) model yet.
+  if (function.bestObjective > objective ||
+      function.bestObjective == std::numeric_limits<double>::max())
+  {
+    function.bestObjective = objective;
+    function.bestModel = std::move(function.cv.Model());
+  }
+
+  return objective;
+}
+
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+template<typename... Args>
+double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::
+    BudgetEvaluator::operator()(const Args&... args)
+{
+  return cv.EvaluateWithBudget(budget, model, args...);
+}
+
 template<typename CVType,
          typename MLAlgorithm,
          size_t TotalArgs,
          typename... BoundArgs>
 template<size_t BoundArgIndex,
          size_t ParamIndex,
+         typename EvaluatorType,
          typename... Args,
          typename>
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
+    EvaluatorType& evaluator,
     const arma::mat& parameters,
     const Args&... args)
 {
-  return PutNextArg<BoundArgIndex, ParamIndex>(parameters, args...);
+  return PutNextArg<BoundArgIndex, ParamIndex>(evaluator, parameters, args...);
 }
 
 template<typename CVType,
@@ -110,25 +239,16 @@ template<typename CVType,
          typename... BoundArgs>
 template<size_t BoundArgIndex,
          size_t ParamIndex,
+         typename EvaluatorType,
          typename... Args,
          typename,
          typename>
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
+    EvaluatorType& evaluator,
     const arma::mat& /* parameters */,
     const Args&... args)
 {
-  double objective = cv.Evaluate(args...);
-
-  // Change the best model if we have got a better score, or if we probably
-  // have not assigned any valid (trained) model yet.
-  if (bestObjective > objective ||
-      bestObjective == std::numeric_limits<double>::max())
-  {
-    bestObjective = objective;
-    bestModel = std::move(cv.Model());
-  }
-
-  return objective;
+  return evaluator(args...);
 }
 
 template<typename CVType,
@@ -137,14 +257,16 @@ template<typename CVType,
          typename... BoundArgs>
 template<size_t BoundArgIndex,
          size_t ParamIndex,
+         typename EvaluatorType,
          typename... Args,
          typename>
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::PutNextArg(
+    EvaluatorType& evaluator,
     const arma::mat& parameters,
     const Args&... args)
 {
-  return Evaluate<BoundArgIndex + 1, ParamIndex>(
-      parameters, args..., std::get<BoundArgIndex>(boundArgs).value);
+  return Evaluate<BoundArgIndex + 1, ParamIndex>(evaluator, parameters,
+      args..., std::get<BoundArgIndex>(boundArgs).value);
 }
 
 template<typename CVType,
@@ -153,22 +275,25 @@ template<typename CVType,
          typename... BoundArgs>
 template<size_t BoundArgIndex,
          size_t ParamIndex,
+         typename EvaluatorType,
          typename... Args,
          typename,
          typename>
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::PutNextArg(
+    EvaluatorType& evaluator,
     const arma::mat& parameters,
     const Args&... args)
 {
   if (datasetInfo.Type(ParamIndex) == data::Datatype::categorical)
   {
-    return Evaluate<BoundArgIndex, ParamIndex + 1>(parameters, args...,
-        datasetInfo.UnmapString(size_t(parameters(ParamIndex, 0)), ParamIndex));
+    return Evaluate<BoundArgIndex, ParamIndex + 1>(evaluator, parameters,
+        args..., datasetInfo.UnmapString(size_t(parameters(ParamIndex, 0)),
+        ParamIndex));
   }
   else
   {
-    return Evaluate<BoundArgIndex, ParamIndex + 1>(parameters, args...,
-        parameters(ParamIndex, 0));
+    return Evaluate<BoundArgIndex, ParamIndex + 1>(evaluator, parameters,
+        args..., parameters(ParamIndex, 0));
   }
 }
 
@@ -14,6 +14,9 @@
 
 #include <mlpack/core/cv/meta_info_extractor.hpp>
 #include <mlpack/core/hpt/deduce_hp_types.hpp>
+#include <mlpack/core/hpt/hyperband.hpp>
+#include <mlpack/core/hpt/parallel_grid_search.hpp>
+#include <mlpack/core/hpt/successive_halving.hpp>
 #include <ensmallen.hpp>
 
 namespace mlpack {
@@ -67,12 +70,22 @@ namespace hpt {
  *     Fixed(useCholesky), lambda1Set, lambda2Set);
  * @endcode
  *
+ * GridSearch evaluates the sets of hyper-parameters one after another.
+ * ParallelGridSearch finds the same ones, but evaluates the sets concurrently.
+ * SuccessiveHalving and Hyperband first evaluate many sets with a fraction of
+ * the cross-validation budget (some of the folds of KFoldCV, or some of the
+ * training points of SimpleCV), and only evaluate the most promising ones in
+ * full; this is much faster for big grids, but the best set may be missed if
+ * its quality can't be told with a small budget.  These three strategies
+ * train models from many threads at once.
+ *
  * @tparam MLAlgorithm A machine learning algorithm.
  * @tparam Metric A metric to assess the quality of a trained model.
  * @tparam CV A cross-validation strategy used to assess a set of
  *     hyper-parameters.
- * @tparam OptimizerType An optimization strategy (GridSearch and
- *     GradientDescent are supported).
+ * @tparam OptimizerType An optimization strategy (GridSearch,
+ *     ParallelGridSearch, SuccessiveHalving, Hyperband and GradientDescent are
+ *     supported).
  * @tparam MatType The type of data.
  * @tparam PredictionsType The type of predictions (should be passed when the
  *     predictions type is a template parameter in Train methods of the given
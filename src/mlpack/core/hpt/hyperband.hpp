@@ -0,0 +1,146 @@
+/**
+ * @file core/hpt/hyperband.hpp
+ *
+ * A hyper-parameter search that runs successive halving with several
+ * trade-offs between the number of candidates and their first budget.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_HYPERBAND_HPP
+#define MLPACK_CORE_HPT_HYPERBAND_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/hpt/candidates.hpp>
+#include <mlpack/core/hpt/successive_halving.hpp>
+
+namespace mlpack {
+namespace hpt {
+
+/**
+ * Hyperband (Li et al., "Hyperband: A Novel Bandit-Based Approach to
+ * Hyperparameter Optimization", 2018) runs SuccessiveHalving in several
+ * brackets on points of the grid drawn at random.  The first bracket starts
+ * many candidates with the minimum budget, and each following bracket starts
+ * fewer candidates with a budget eta times bigger; the last one evaluates a
+ * few candidates with the full budget only.  This hedges against
+ * hyper-parameters whose quality can't be told with a small budget.  The best
+ * point of all the brackets is kept.
+ *
+ * As with SuccessiveHalving, the cross-validation strategy has to provide
+ * EvaluateWithBudget(), and the training of the machine learning algorithm has
+ * to be safe to run from many threads at once.
+ *
+ * @code
+ * HyperParameterTuner<LARS, MSE, KFoldCV, Hyperband> hpt(10, data, responses);
+ * double bestLambda1, bestLambda2;
+ * std::tie(bestLambda1, bestLambda2) = hpt.Optimize(lambda1Set, lambda2Set);
+ * @endcode
+ */
+class Hyperband
+{
+ public:
+  /**
+   * Create the Hyperband object.
+   *
+   * @param eta Factor by which the number of candidates is divided and the
+   *     budget is multiplied in each round of successive halving (at least 2).
+   * @param minBudget Smallest budget any candidate is evaluated with (more
+   *     than 0 and at most 1).
+   */
+  Hyperband(const size_t eta = 3, const double minBudget = 1.0 / 9.0) :
+      eta(eta),
+      minBudget(minBudget)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Find the best point of the grid, and store it.
+   *
+   * @param function CVFunction to minimize.
+   * @param bestParameters Matrix to store the best point in.
+   * @param categoricalDimensions Whether each dimension is categorical; all of
+   *     them have to be.
+   * @param numCategories Number of values of each dimension.
+   * @return The objective of the best point with the full budget.
+   */
+  template<typename FunctionType>
+  double Optimize(FunctionType& function,
+                  arma::mat& bestParameters,
+                  const std::vector<bool>& categoricalDimensions,
+                  const arma::Row<size_t>& numCategories)
+  {
+    const double gridSize = details::GridSize("Hyperband",
+        categoricalDimensions, numCategories);
+
+    if (eta < 2)
+    {
+      throw std::invalid_argument("Hyperband::Optimize(): eta should be at "
+          "least 2");
+    }
+    if (minBudget <= 0.0 || minBudget > 1.0)
+    {
+      throw std::invalid_argument("Hyperband::Optimize(): the minimum budget "
+          "should be more than 0 and at most 1");
+    }
+
+    // The number of times the minimum budget can be multiplied by eta; the
+    // small tolerance keeps a budget like 1 / 9 from losing a bracket to
+    // rounding.
+    const size_t maxBracket = (size_t) std::floor(
+        std::log(1.0 / minBudget) / std::log((double) eta) + 1e-9);
+
+    bool found = false;
+    double bestObjective = std::numeric_limits<double>::infinity();
+    for (size_t s = maxBracket + 1; s > 0; --s)
+    {
+      const size_t bracket = s - 1;
+      const size_t numCandidates = (size_t) std::ceil(
+          (double) (maxBracket + 1) / (bracket + 1) *
+          std::pow((double) eta, (double) bracket));
+      const double budget = std::pow((double) eta, -(double) bracket);
+
+      arma::mat candidates = details::RandomCandidates(numCategories,
+          gridSize, numCandidates);
+      arma::mat bracketParameters;
+      SuccessiveHalving halving(eta, budget);
+      const double objective = halving.Optimize(function, candidates,
+          bracketParameters);
+
+      // A tie keeps the earlier bracket, as the best model of the function
+      // does.
+      if (objective < bestObjective || !found)
+      {
+        found = true;
+        bestObjective = objective;
+        bestParameters = bracketParameters;
+      }
+    }
+
+    return bestObjective;
+  }
+
+  //! Get the factor by which the candidates are reduced in each round.
+  size_t Eta() const { return eta; }
+  //! Modify the factor by which the candidates are reduced in each round.
+  size_t& Eta() { return eta; }
+
+  //! Get the smallest budget any candidate is evaluated with.
+  double MinBudget() const { return minBudget; }
+  //! Modify the smallest budget any candidate is evaluated with.
+  double& MinBudget() { return minBudget; }
+
+ private:
+  //! The factor by which the candidates are reduced in each round.
+  size_t eta;
+  //! The smallest budget any candidate is evaluated with.
+  double minBudget;
+};
+
+} // namespace hpt
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,77 @@
+/**
+ * @file core/hpt/parallel_grid_search.hpp
+ *
+ * A grid search that evaluates the points of the grid concurrently.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_PARALLEL_GRID_SEARCH_HPP
+#define MLPACK_CORE_HPT_PARALLEL_GRID_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/hpt/candidates.hpp>
+
+namespace mlpack {
+namespace hpt {
+
+/**
+ * ParallelGridSearch finds the same hyper-parameters as ens::GridSearch, but
+ * the points of the grid are cross-validated concurrently, each thread with
+ * its own models.  It can be used as the optimizer of HyperParameterTuner:
+ *
+ * @code
+ * HyperParameterTuner<LARS, MSE, KFoldCV, ParallelGridSearch> hpt(k, data,
+ *     responses);
+ * double bestLambda1, bestLambda2;
+ * std::tie(bestLambda1, bestLambda2) = hpt.Optimize(lambda1Set, lambda2Set);
+ * @endcode
+ *
+ * The cross-validation strategy has to provide EvaluateWithBudget() (as
+ * SimpleCV and KFoldCV do), and the training of the machine learning algorithm
+ * has to be safe to run from many threads at once.  The whole grid is held in
+ * memory.
+ */
+class ParallelGridSearch
+{
+ public:
+  /**
+   * Evaluate every point of the grid and store the best one.
+   *
+   * @param function CVFunction to minimize.
+   * @param bestParameters Matrix to store the best point in.
+   * @param categoricalDimensions Whether each dimension is categorical; all of
+   *     them have to be.
+   * @param numCategories Number of values of each dimension.
+   * @return The objective of the best point.
+   */
+  template<typename FunctionType>
+  double Optimize(FunctionType& function,
+                  arma::mat& bestParameters,
+                  const std::vector<bool>& categoricalDimensions,
+                  const arma::Row<size_t>& numCategories)
+  {
+    details::GridSize("ParallelGridSearch", categoricalDimensions,
+        numCategories);
+
+    const arma::mat candidates = details::GridCandidates(numCategories);
+    arma::rowvec objectives;
+    function.Evaluate(candidates, objectives);
+
+    // Keep the first of the best points, as GridSearch does.
+    size_t best = 0;
+    for (size_t i = 1; i < objectives.n_elem; ++i)
+      if (objectives[i] < objectives[best] || std::isnan(objectives[best]))
+        best = i;
+
+    bestParameters = candidates.col(best);
+    return objectives[best];
+  }
+};
+
+} // namespace hpt
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,171 @@
+/**
+ * @file core/hpt/successive_halving.hpp
+ *
+ * A hyper-parameter search that evaluates many candidates cheaply and only
+ * gives the full budget to the best of them.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_SUCCESSIVE_HALVING_HPP
+#define MLPACK_CORE_HPT_SUCCESSIVE_HALVING_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/hpt/candidates.hpp>
+
+namespace mlpack {
+namespace hpt {
+
+/**
+ * SuccessiveHalving (Jamieson and Talwalkar, "Non-stochastic Best Arm
+ * Identification and Hyperparameter Optimization", 2016) chooses from the
+ * points of a grid of hyper-parameters.  All the candidates are first
+ * cross-validated with a small budget; then only the best 1 / eta of them are
+ * kept, and the budget is multiplied by eta, until the remaining candidates
+ * are cross-validated with the full budget.  The candidates of each round are
+ * evaluated concurrently, each thread with its own models.
+ *
+ * The budget is the proportion of the work of a full cross-validation: for
+ * KFoldCV, the proportion of the folds that are run; for SimpleCV, the
+ * proportion of the training set that is trained on.  The cross-validation
+ * strategy has to provide EvaluateWithBudget(), and the training of the
+ * machine learning algorithm has to be safe to run from many threads at once.
+ *
+ * @code
+ * HyperParameterTuner<LARS, MSE, KFoldCV, SuccessiveHalving> hpt(10, data,
+ *     responses);
+ * hpt.Optimizer().NumCandidates() = 100;
+ * double bestLambda1, bestLambda2;
+ * std::tie(bestLambda1, bestLambda2) = hpt.Optimize(lambda1Set, lambda2Set);
+ * @endcode
+ */
+class SuccessiveHalving
+{
+ public:
+  /**
+   * Create the SuccessiveHalving object.
+   *
+   * @param eta Factor by which the number of candidates is divided and the
+   *     budget is multiplied in each round (at least 2).
+   * @param minBudget Budget of the first round (more than 0 and at most 1).
+   * @param numCandidates Number of points of the grid to draw at random as the
+   *     first candidates; if 0, the whole grid is used.
+   */
+  SuccessiveHalving(const size_t eta = 3,
+                    const double minBudget = 1.0 / 9.0,
+                    const size_t numCandidates = 0) :
+      eta(eta),
+      minBudget(minBudget),
+      numCandidates(numCandidates)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Find the best point of the grid, and store it.
+   *
+   * @param function CVFunction to minimize.
+   * @param bestParameters Matrix to store the best point in.
+   * @param categoricalDimensions Whether each dimension is categorical; all of
+   *     them have to be.
+   * @param numCategories Number of values of each dimension.
+   * @return The objective of the best point with the full budget.
+   */
+  template<typename FunctionType>
+  double Optimize(FunctionType& function,
+                  arma::mat& bestParameters,
+                  const std::vector<bool>& categoricalDimensions,
+                  const arma::Row<size_t>& numCategories)
+  {
+    const double gridSize = details::GridSize("SuccessiveHalving",
+        categoricalDimensions, numCategories);
+
+    const arma::mat candidates = (numCandidates == 0) ?
+        details::GridCandidates(numCategories) :
+        details::RandomCandidates(numCategories, gridSize, numCandidates);
+
+    return Optimize(function, candidates, bestParameters);
+  }
+
+  /**
+   * Run successive halving on the given candidates, starting with the budget
+   * MinBudget(), and store the best of them.
+   *
+   * @param function CVFunction to minimize.
+   * @param candidates Points to choose from, one in each column.
+   * @param bestParameters Matrix to store the best point in.
+   * @return The objective of the best point with the full budget.
+   */
+  template<typename FunctionType>
+  double Optimize(FunctionType& function,
+                  arma::mat candidates,
+                  arma::mat& bestParameters)
+  {
+    if (eta < 2)
+    {
+      throw std::invalid_argument("SuccessiveHalving::Optimize(): eta should "
+          "be at least 2");
+    }
+    if (minBudget <= 0.0 || minBudget > 1.0)
+    {
+      throw std::invalid_argument("SuccessiveHalving::Optimize(): the minimum "
+          "budget should be more than 0 and at most 1");
+    }
+
+    double budget = minBudget;
+    arma::rowvec objectives;
+    while (true)
+    {
+      function.Evaluate(candidates, objectives, budget);
+
+      // An invalid objective is worse than any other.
+      for (size_t i = 0; i < objectives.n_elem; ++i)
+        if (std::isnan(objectives[i]))
+          objectives[i] = std::numeric_limits<double>::infinity();
+      if (budget >= 1.0)
+        break;
+
+      // Keep the best candidates; a tie keeps the first ones.
+      const size_t numKept = std::max((size_t) 1, candidates.n_cols / eta);
+      const arma::uvec order = arma::stable_sort_index(objectives);
+      candidates = candidates.cols(order.head(numKept));
+
+      // A single candidate doesn't need any more rounds.
+      budget = (numKept == 1) ? 1.0 : std::min(1.0, budget * eta);
+    }
+
+    const size_t best = objectives.index_min();
+    bestParameters = candidates.col(best);
+    return objectives[best];
+  }
+
+  //! Get the factor by which the candidates are reduced in each round.
+  size_t Eta() const { return eta; }
+  //! Modify the factor by which the candidates are reduced in each round.
+  size_t& Eta() { return eta; }
+
+  //! Get the budget of the first round.
+  double MinBudget() const { return minBudget; }
+  //! Modify the budget of the first round.
+  double& MinBudget() { return minBudget; }
+
+  //! Get the number of random candidates (0 means the whole grid).
+  size_t NumCandidates() const { return numCandidates; }
+  //! Modify the number of random candidates (0 means the whole grid).
+  size_t& NumCandidates() { return numCandidates; }
+
+ private:
+  //! The factor by which the candidates are reduced in each round.
+  size_t eta;
+  //! The budget of the first round.
+  double minBudget;
+  //! The number of random candidates (0 means the whole grid).
+  size_t numCandidates;
+};
+
+} // namespace hpt
+} // namespace mlpack
+
+#endif
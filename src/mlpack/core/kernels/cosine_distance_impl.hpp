@@ -32,6 +32,22 @@ double CosineDistance::Evaluate(const VecTypeA& a, const VecTypeB& b)
     return dot(a, b) / denominator;
 }
 
+template<typename MatTypeA, typename MatTypeB>
+void CosineDistance::Evaluate(const MatTypeA& a,
+                              const MatTypeB& b,
+                              arma::mat& k)
+{
+  // Scale by the inverse norms, leaving the products with zero vectors at 0.
+  arma::rowvec aScale = arma::sqrt(SquaredColumnNorms(a));
+  arma::rowvec bScale = arma::sqrt(SquaredColumnNorms(b));
+  aScale.transform([](const double x) { return (x == 0.0) ? 0.0 : 1.0 / x; });
+  bScale.transform([](const double x) { return (x == 0.0) ? 0.0 : 1.0 / x; });
+
+  k = a.t() * b;
+  k.each_col() %= aScale.t();
+  k.each_row() %= bScale;
+}
+
 } // namespace kernel
 } // namespace mlpack
 
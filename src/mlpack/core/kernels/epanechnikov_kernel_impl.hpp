@@ -29,6 +29,15 @@ inline double EpanechnikovKernel::Evaluate(const VecTypeA& a, const VecTypeB& b)
       * inverseBandwidthSquared);
 }
 
+template<typename MatTypeA, typename MatTypeB>
+inline void EpanechnikovKernel::Evaluate(const MatTypeA& a,
+                                         const MatTypeB& b,
+                                         arma::mat& k) const
+{
+  SquaredDistanceMatrix(a, b, k);
+  k = arma::clamp(1.0 - k * inverseBandwidthSquared, 0.0, 1.0);
+}
+
 /**
  * Obtains the convolution integral [integral of K(||x-a||) K(||b-x||) dx]
  * for the two vectors.
@@ -72,6 +72,21 @@ namespace kernel {
  * generalization, mlpack methods expect all kernels to require state and hence
  * must store instantiated kernel functions; this is why a default constructor
  * is necessary.
+ *
+ * @note
+ * A kernel may also evaluate itself between every column of one matrix and
+ * every column of another at once, with a function like
+ *
+ * @code
+ * template<typename MatTypeA, typename MatTypeB>
+ * void Evaluate(const MatTypeA& a, const MatTypeB& b, arma::mat& k) const;
+ * @endcode
+ *
+ * that sets k(i, j) = K(a.col(i), b.col(j)).  This is usually much faster than
+ * evaluating the pairs one at a time, since it can be done with a matrix
+ * product.  A kernel that has this function should set HasBatchEvaluate to
+ * true in its KernelTraits; methods that need many kernel values at once call
+ * KernelMatrix() (in kernel_matrix.hpp), which then uses it.
  */
 class ExampleKernel
 {
@@ -0,0 +1,252 @@
+/**
+ * @file core/kernels/kernel_matrix.hpp
+ *
+ * Compute the kernel values between all pairs of points of two sets at once.
+ * Kernels that have a batch Evaluate() (as shown by KernelTraits) compute the
+ * whole block with a matrix product and elementwise operations; for any other
+ * kernel, the values are computed one pair at a time.  Large kernel matrices
+ * can be computed in tiles in parallel, and products with a kernel matrix can
+ * be computed without ever holding the whole kernel matrix.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
+#define MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_traits.hpp>
+
+namespace mlpack {
+namespace kernel {
+
+/**
+ * Return the squared L2 norm of each column of the given (dense or sparse)
+ * matrix.
+ */
+template<typename MatType>
+arma::rowvec SquaredColumnNorms(const MatType& a)
+{
+  return arma::rowvec(arma::mat(arma::sum(arma::square(a), 0)));
+}
+
+/**
+ * Compute the squared Euclidean distance between each column of a and each
+ * column of b, so that d(i, j) = || a_i - b_j ||^2.  This uses the expansion
+ * ||a_i||^2 + ||b_j||^2 - 2 a_i^T b_j, so the bulk of the work is one matrix
+ * product.  The distances can be off by a little more rounding error than if
+ * they were computed one at a time; the ones that round below zero are set to
+ * zero.
+ *
+ * @param a First set of points (one per column).
+ * @param b Second set of points (one per column).
+ * @param d Matrix to store the a.n_cols x b.n_cols distances in.
+ */
+template<typename MatTypeA, typename MatTypeB>
+void SquaredDistanceMatrix(const MatTypeA& a, const MatTypeB& b, arma::mat& d)
+{
+  d = a.t() * b;
+  d *= -2.0;
+  d.each_col() += SquaredColumnNorms(a).t();
+  d.each_row() += SquaredColumnNorms(b);
+  d.transform([](const double x) { return (x < 0.0) ? 0.0 : x; });
+}
+
+/**
+ * Whether the kernel has a batch Evaluate(), as given by
+ * KernelTraits::HasBatchEvaluate.  A KernelTraits specialization written
+ * before HasBatchEvaluate existed may not define it; then this is false.
+ */
+template<typename KernelType, typename = void>
+struct KernelHasBatchEvaluate : std::false_type { };
+
+template<typename KernelType>
+struct KernelHasBatchEvaluate<KernelType, typename std::enable_if<
+    KernelTraits<KernelType>::HasBatchEvaluate>::type> : std::true_type { };
+
+/**
+ * Compute the kernel value between each column of a and each column of b with
+ * the batch Evaluate() of the kernel, so that k(i, j) = K(a_i, b_j).
+ *
+ * @param kernel Kernel to evaluate.
+ * @param a First set of points (one per column).
+ * @param b Second set of points (one per column).
+ * @param k Matrix to store the a.n_cols x b.n_cols kernel values in.
+ */
+template<typename KernelType, typename MatTypeA, typename MatTypeB>
+void KernelMatrix(
+    KernelType& kernel,
+    const MatTypeA& a,
+    const MatTypeB& b,
+    arma::mat& k,
+    const typename std::enable_if<KernelHasBatchEvaluate<typename
+        std::remove_const<KernelType>::type>::value>::type* = 0)
+{
+  kernel.Evaluate(a, b, k);
+}
+
+/**
+ * Compute the kernel value between each column of a and each column of b one
+ * pair at a time, for kernels without a batch Evaluate(), so that
+ * k(i, j) = K(a_i, b_j).
+ *
+ * @param kernel Kernel to evaluate.
+ * @param a First set of points (one per column).
+ * @param b Second set of points (one per column).
+ * @param k Matrix to store the a.n_cols x b.n_cols kernel values in.
+ */
+template<typename KernelType, typename MatTypeA, typename MatTypeB>
+void KernelMatrix(
+    KernelType& kernel,
+    const MatTypeA& a,
+    const MatTypeB& b,
+    arma::mat& k,
+    const typename std::enable_if<!KernelHasBatchEvaluate<typename
+        std::remove_const<KernelType>::type>::value>::type* = 0)
+{
+  k.set_size(a.n_cols, b.n_cols);
+  for (size_t j = 0; j < b.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      k(i, j) = kernel.Evaluate(a.col(i), b.col(j));
+}
+
+//! Default number of points along each side of a tile in TiledKernelMatrix(),
+//! SymmetricKernelMatrix(), and KernelMatrixProduct().
+static const size_t KernelMatrixTileSize = 256;
+
+/**
+ * Compute the kernel value between each column of a and each column of b, so
+ * that k(i, j) = K(a_i, b_j).  The matrix is computed in tiles of tileSize x
+ * tileSize values, in parallel with OpenMP; each tile is computed with
+ * KernelMatrix().  The Evaluate() functions of the kernel must be safe to call
+ * from several threads at once (as they are for all of mlpack's kernels).
+ *
+ * @param kernel Kernel to evaluate.
+ * @param a First set of points (one per column).
+ * @param b Second set of points (one per column).
+ * @param k Matrix to store the a.n_cols x b.n_cols kernel values in.
+ * @param tileSize Number of points along each side of a tile.
+ */
+template<typename KernelType, typename MatTypeA, typename MatTypeB>
+void TiledKernelMatrix(KernelType& kernel,
+                       const MatTypeA& a,
+                       const MatTypeB& b,
+                       arma::mat& k,
+                       const size_t tileSize = KernelMatrixTileSize)
+{
+  k.set_size(a.n_cols, b.n_cols);
+  const size_t rowTiles = (a.n_cols + tileSize - 1) / tileSize;
+  const size_t colTiles = (b.n_cols + tileSize - 1) / tileSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t t = 0; t < (omp_size_t) (rowTiles * colTiles); ++t)
+  {
+    const size_t rowBegin = (t % rowTiles) * tileSize;
+    const size_t colBegin = (t / rowTiles) * tileSize;
+    const size_t rowEnd = std::min(rowBegin + tileSize, (size_t) a.n_cols) - 1;
+    const size_t colEnd = std::min(colBegin + tileSize, (size_t) b.n_cols) - 1;
+
+    arma::mat tile;
+    KernelMatrix(kernel, a.cols(rowBegin, rowEnd), b.cols(colBegin, colEnd),
+        tile);
+    k.submat(rowBegin, colBegin, rowEnd, colEnd) = tile;
+  }
+}
+
+/**
+ * Compute the kernel value between each pair of columns of a, so that
+ * k(i, j) = K(a_i, a_j).  Since the kernel matrix is symmetric, only the tiles
+ * on and above the diagonal are computed (in parallel, as in
+ * TiledKernelMatrix()), and each is copied to its mirror image.  The result is
+ * exactly symmetric.
+ *
+ * @param kernel Kernel to evaluate.
+ * @param a Set of points (one per column).
+ * @param k Matrix to store the a.n_cols x a.n_cols kernel values in.
+ * @param tileSize Number of points along each side of a tile.
+ */
+template<typename KernelType, typename MatType>
+void SymmetricKernelMatrix(KernelType& kernel,
+                           const MatType& a,
+                           arma::mat& k,
+                           const size_t tileSize = KernelMatrixTileSize)
+{
+  k.set_size(a.n_cols, a.n_cols);
+  const size_t tiles = (a.n_cols + tileSize - 1) / tileSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t t = 0; t < (omp_size_t) (tiles * tiles); ++t)
+  {
+    const size_t i = t % tiles;
+    const size_t j = t / tiles;
+    if (i > j)
+      continue; // This is the mirror image of another tile.
+
+    const size_t rowBegin = i * tileSize;
+    const size_t colBegin = j * tileSize;
+    const size_t rowEnd = std::min(rowBegin + tileSize, (size_t) a.n_cols) - 1;
+    const size_t colEnd = std::min(colBegin + tileSize, (size_t) a.n_cols) - 1;
+
+    arma::mat tile;
+    KernelMatrix(kernel, a.cols(rowBegin, rowEnd), a.cols(colBegin, colEnd),
+        tile);
+    if (i == j)
+    {
+      k.submat(rowBegin, colBegin, rowEnd, colEnd) = arma::symmatu(tile);
+    }
+    else
+    {
+      k.submat(rowBegin, colBegin, rowEnd, colEnd) = tile;
+      k.submat(colBegin, rowBegin, colEnd, rowEnd) = tile.t();
+    }
+  }
+}
+
+/**
+ * Compute y = K x, where K is the kernel matrix of the columns of a (so that
+ * K(i, j) = K(a_i, a_j)), without holding all of K at once.  Each thread
+ * computes a block of rows of y from one tile of K at a time, so only one
+ * tile per thread is ever held.  Every product evaluates the kernel between
+ * all pairs of points again, so this is only worth it when K is too large to
+ * hold.
+ *
+ * @param kernel Kernel to evaluate.
+ * @param a Set of points (one per column).
+ * @param x Matrix to multiply by; it must have a.n_cols rows.
+ * @param y Matrix to store the a.n_cols x x.n_cols product in.
+ * @param tileSize Number of points along each side of a tile.
+ */
+template<typename KernelType, typename MatType>
+void KernelMatrixProduct(KernelType& kernel,
+                         const MatType& a,
+                         const arma::mat& x,
+                         arma::mat& y,
+                         const size_t tileSize = KernelMatrixTileSize)
+{
+  y.zeros(a.n_cols, x.n_cols);
+  const size_t tiles = (a.n_cols + tileSize - 1) / tileSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) tiles; ++i)
+  {
+    const size_t rowBegin = i * tileSize;
+    const size_t rowEnd = std::min(rowBegin + tileSize, (size_t) a.n_cols) - 1;
+
+    arma::mat tile;
+    for (size_t colBegin = 0; colBegin < a.n_cols; colBegin += tileSize)
+    {
+      const size_t colEnd = std::min(colBegin + tileSize,
+          (size_t) a.n_cols) - 1;
+      KernelMatrix(kernel, a.cols(rowBegin, rowEnd), a.cols(colBegin, colEnd),
+          tile);
+      y.rows(rowBegin, rowEnd) += tile * x.rows(colBegin, colEnd);
+    }
+  }
+}
+
+} // namespace kernel
+} // namespace mlpack
+
+#endif
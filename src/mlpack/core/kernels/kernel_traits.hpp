@@ -36,6 +36,14 @@ class KernelTraits
    * If true, then the kernel include a squared distance, ||x - y||^2 .
    */
   static const bool UsesSquaredDistance = false;
+
+  /**
+   * If true, then the kernel has a batch Evaluate(a, b, k) that fills k with
+   * the kernel values between each column of the matrix a and each column of
+   * the matrix b.  KernelMatrix() (in kernel_matrix.hpp) uses it when it is
+   * available.
+   */
+  static const bool HasBatchEvaluate = false;
 };
 
 } // namespace kernel
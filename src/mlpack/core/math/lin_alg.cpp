@@ -189,6 +189,58 @@ void mlpack::math::RemoveRows(const arma::mat& input,
   }
 }
 
+void mlpack::math::BlockedOuterProduct(const arma::mat& a,
+                                       const arma::mat& b,
+                                       arma::mat& output,
+                                       const size_t blockSize)
+{
+  output.zeros(a.n_rows, b.n_rows);
+  const size_t blocks = (a.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel
+  {
+    // Each thread sums the products of its blocks separately.
+    arma::mat localOutput(a.n_rows, b.n_rows, arma::fill::zeros);
+
+    #pragma omp for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) blocks; ++i)
+    {
+      const size_t begin = i * blockSize;
+      const size_t end = std::min(begin + blockSize, (size_t) a.n_cols) - 1;
+      localOutput += a.cols(begin, end) * b.cols(begin, end).t();
+    }
+
+    #pragma omp critical
+    output += localOutput;
+  }
+}
+
+void mlpack::math::ColumnsToSparse(const std::vector<arma::uvec>& rowIndices,
+                                   const std::vector<arma::vec>& values,
+                                   const size_t nRows,
+                                   arma::sp_mat& output)
+{
+  // Find where each column starts.
+  arma::uvec colPtrs(rowIndices.size() + 1);
+  colPtrs[0] = 0;
+  for (size_t i = 0; i < rowIndices.size(); ++i)
+    colPtrs[i + 1] = colPtrs[i] + rowIndices[i].n_elem;
+
+  arma::uvec allRowIndices(colPtrs[rowIndices.size()]);
+  arma::vec allValues(colPtrs[rowIndices.size()]);
+  for (size_t i = 0; i < rowIndices.size(); ++i)
+  {
+    if (rowIndices[i].n_elem > 0)
+    {
+      allRowIndices.subvec(colPtrs[i], colPtrs[i + 1] - 1) = rowIndices[i];
+      allValues.subvec(colPtrs[i], colPtrs[i + 1] - 1) = values[i];
+    }
+  }
+
+  output = arma::sp_mat(allRowIndices, colPtrs, allValues, nRows,
+      rowIndices.size());
+}
+
 void mlpack::math::Svec(const arma::mat& input, arma::vec& output)
 {
   const size_t n = input.n_rows;
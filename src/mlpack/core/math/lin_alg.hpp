@@ -74,6 +74,39 @@ void RemoveRows(const arma::mat& input,
                 const std::vector<size_t>& rowsToRemove,
                 arma::mat& output);
 
+/**
+ * Compute output = a * b^T, where a and b have the same number of columns.  The
+ * columns are split into blocks of blockSize columns; the products of the
+ * blocks are computed in parallel with OpenMP, and summed.  This is useful when
+ * a and b have many more columns than rows, so that the product is small.
+ *
+ * @param a First matrix.
+ * @param b Second matrix.
+ * @param output Matrix to store a * b^T in.
+ * @param blockSize Number of columns in each block.
+ */
+void BlockedOuterProduct(const arma::mat& a,
+                         const arma::mat& b,
+                         arma::mat& output,
+                         const size_t blockSize = 1024);
+
+/**
+ * Assemble a sparse matrix from the nonzero elements of each of its columns.
+ * The row indices of each column must be sorted.  The elements are copied
+ * straight into the storage of the sparse matrix, so this is faster than
+ * inserting them.
+ *
+ * @param rowIndices Row indices of the nonzero elements of each column.
+ * @param values Values of the nonzero elements of each column.
+ * @param nRows Number of rows of the matrix.
+ * @param output Matrix to store the result in; it has rowIndices.size()
+ *     columns.
+ */
+void ColumnsToSparse(const std::vector<arma::uvec>& rowIndices,
+                     const std::vector<arma::vec>& values,
+                     const size_t nRows,
+                     arma::sp_mat& output);
+
 /**
  * Upper triangular representation of a symmetric matrix, scaled such that,
  * dot(Svec(A), Svec(B)) == dot(A, B) for symmetric A, B. Specifically,
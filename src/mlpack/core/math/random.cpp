@@ -1,7 +1,8 @@
 /**
  * @file core/math/random.cpp
  *
- * Declarations of global random number generators.
+ * Declarations of global random number generators, and of the active random
+ * stream of each thread.
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
@@ -21,5 +22,14 @@ MLPACK_EXPORT std::uniform_real_distribution<> randUniformDist(0.0, 1.0);
 // Global normal distribution.
 MLPACK_EXPORT std::normal_distribution<> randNormalDist(0.0, 1.0);
 
+class RandomStream;
+
+// The stream that is active on each thread.
+MLPACK_EXPORT RandomStream*& ActiveRandomStream()
+{
+  static thread_local RandomStream* stream = NULL;
+  return stream;
+}
+
 } // namespace math
 } // namespace mlpack
@@ -31,7 +31,128 @@ extern MLPACK_EXPORT std::uniform_real_distribution<> randUniformDist;
 extern MLPACK_EXPORT std::normal_distribution<> randNormalDist;
 
 /**
- * Set the random seed used by the random functions (Random() and RandInt()).
+ * A RandomStream is a random number generator of its own, seeded from a seed
+ * and a stream number.  Streams with different numbers give independent
+ * sequences, so a parallel loop can give each of its tasks (a tree of a forest,
+ * a fold, a worker) its own stream, and draw the same numbers for a given seed
+ * whatever the number of threads and the order the tasks run in.
+ *
+ * A stream is used by the random functions of this file (Random(), RandInt(),
+ * RandNormal(), ...) on the threads where it is made active with a
+ * RandomStreamScope; elsewhere they use the global generator.  Code that runs
+ * inside a stream, such as the training of a model, needs no change:
+ *
+ * @code
+ * const size_t seed = math::RandomStreamSeed();
+ * #pragma omp parallel for
+ * for (omp_size_t i = 0; i < (omp_size_t) n; ++i)
+ * {
+ *   math::RandomStream stream(seed, i);
+ *   math::RandomStreamScope scope(stream);
+ *   // Any call to math::Random() here draws from the stream.
+ * }
+ * @endcode
+ */
+class RandomStream
+{
+ public:
+  /**
+   * Create the stream with the given number, for the given seed.
+   *
+   * @param seed Seed shared by all the streams, usually from
+   *     RandomStreamSeed().
+   * @param stream Number of the stream.
+   */
+  RandomStream(const size_t seed, const size_t stream) :
+      uniformDist(0.0, 1.0),
+      normalDist(0.0, 1.0)
+  {
+    std::seed_seq sequence{ (uint32_t) seed, (uint32_t) ((uint64_t) seed >> 32),
+        (uint32_t) stream, (uint32_t) ((uint64_t) stream >> 32) };
+    generator.seed(sequence);
+  }
+
+  //! Generate a uniform random number between 0 and 1.
+  double Random() { return uniformDist(generator); }
+  //! Generate a normally distributed random number with mean 0 and variance
+  //! 1.
+  double RandNormal() { return normalDist(generator); }
+
+  //! Modify the generator of the stream.
+  std::mt19937& Generator() { return generator; }
+
+ private:
+  //! The generator of the stream.
+  std::mt19937 generator;
+  //! The uniform distribution of the stream.
+  std::uniform_real_distribution<> uniformDist;
+  //! The normal distribution of the stream; it keeps state between draws.
+  std::normal_distribution<> normalDist;
+};
+
+/**
+ * Get the stream that is active on the calling thread, or NULL if the global
+ * generator is used.
+ */
+MLPACK_EXPORT RandomStream*& ActiveRandomStream();
+
+/**
+ * A RandomStreamScope makes the given stream active on the calling thread
+ * while it exists; the stream that was active before is restored when it is
+ * destroyed.
+ */
+class RandomStreamScope
+{
+ public:
+  /**
+   * Make the given stream active on the calling thread.
+   *
+   * @param stream Stream to draw random numbers from.
+   */
+  RandomStreamScope(RandomStream& stream) : previous(ActiveRandomStream())
+  {
+    ActiveRandomStream() = &stream;
+  }
+
+  //! Restore the stream that was active before.
+  ~RandomStreamScope() { ActiveRandomStream() = previous; }
+
+  //! A scope can't be copied.
+  RandomStreamScope(const RandomStreamScope& other) = delete;
+  //! A scope can't be copied.
+  RandomStreamScope& operator=(const RandomStreamScope& other) = delete;
+
+ private:
+  //! The stream that was active before.
+  RandomStream* previous;
+};
+
+/**
+ * Get the generator that the random functions use on the calling thread: the
+ * generator of the active stream, or the global generator.
+ */
+inline std::mt19937& RandGen()
+{
+  RandomStream* stream = ActiveRandomStream();
+  return (stream == NULL) ? randGen : stream->Generator();
+}
+
+/**
+ * Draw a seed for a set of random streams.  Call it outside of the parallel
+ * region that uses the streams; the seed is deterministic given the random
+ * seed (see RandomSeed()).
+ */
+inline size_t RandomStreamSeed()
+{
+  std::mt19937& generator = RandGen();
+  const uint64_t high = generator();
+  const uint64_t low = generator();
+  return (size_t) ((high << 32) | low);
+}
+
+/**
+ * Set the random seed used by the random functions (Random() and RandInt()),
+ * and so of the seeds drawn for random streams.
  * The seed is casted to a 32-bit integer before being given to the random
  * number generator, but a size_t is taken as a parameter for API consistency.
  *
@@ -82,7 +203,8 @@ inline void CustomRandomSeed(const size_t seed)
  */
 inline double Random()
 {
-  return randUniformDist(randGen);
+  RandomStream* stream = ActiveRandomStream();
+  return (stream == NULL) ? randUniformDist(randGen) : stream->Random();
 }
 
 /**
@@ -90,7 +212,7 @@ inline double Random()
  */
 inline double Random(const double lo, const double hi)
 {
-  return lo + (hi - lo) * randUniformDist(randGen);
+  return lo + (hi - lo) * Random();
 }
 
 /**
@@ -109,7 +231,7 @@ inline double RandBernoulli(const double input)
  */
 inline int RandInt(const int hiExclusive)
 {
-  return (int) std::floor((double) hiExclusive * randUniformDist(randGen));
+  return (int) std::floor((double) hiExclusive * Random());
 }
 
 /**
@@ -117,8 +239,7 @@ inline int RandInt(const int hiExclusive)
  */
 inline int RandInt(const int lo, const int hiExclusive)
 {
-  return lo + (int) std::floor((double) (hiExclusive - lo)
-                               * randUniformDist(randGen));
+  return lo + (int) std::floor((double) (hiExclusive - lo) * Random());
 }
 
 /**
@@ -126,7 +247,8 @@ inline int RandInt(const int lo, const int hiExclusive)
  */
 inline double RandNormal()
 {
-  return randNormalDist(randGen);
+  RandomStream* stream = ActiveRandomStream();
+  return (stream == NULL) ? randNormalDist(randGen) : stream->RandNormal();
 }
 
 /**
@@ -138,7 +260,7 @@ inline double RandNormal()
  */
 inline double RandNormal(const double mean, const double variance)
 {
-  return variance * randNormalDist(randGen) + mean;
+  return variance * RandNormal() + mean;
 }
 
 /**
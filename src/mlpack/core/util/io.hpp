@@ -23,6 +23,7 @@
 #include <mlpack/prereqs.hpp>
 
 #include "timers.hpp"
+#include "trace.hpp"
 #include "binding_details.hpp"
 #include "program_doc.hpp"
 #include "version.hpp"
@@ -328,6 +329,9 @@ class IO
   //! Holds the timer objects.
   Timers timer;
 
+  //! Holds the spans of the tracing profiler.
+  Tracer tracer;
+
   //! So that Timer::Start() and Timer::Stop() can access the timer variable.
   friend class Timer;
 
@@ -91,6 +91,7 @@ static const std::string testName = "";
 #include <mlpack/core/util/param.hpp>
 #include <mlpack/bindings/cli/parse_command_line.hpp>
 #include <mlpack/bindings/cli/end_program.hpp>
+#include <mlpack/bindings/cli/serve.hpp>
 
 static void mlpackMain(); // This is typically defined after this include.
 
@@ -104,7 +105,11 @@ int main(int argc, char** argv)
   // A "total_time" timer is run by default for each mlpack program.
   mlpack::Timer::Start("total_time");
 
-  mlpackMain();
+  // With --serve, the program is run for each request it receives.
+  if (mlpack::IO::HasParam("serve"))
+    mlpack::bindings::cli::Serve(&mlpackMain);
+  else
+    mlpackMain();
 
   // Print output options, print verbose information, save model parameters,
   // clean up, and so forth.
@@ -481,6 +486,10 @@ PARAM_FLAG("verbose", "Display informational messages and the full list of "
 PARAM_FLAG("help", "Default help info.", "h");
 PARAM_STRING_IN("info", "Print help on a specific option.", "", "");
 PARAM_FLAG("version", "Display the version of mlpack.", "V");
+PARAM_STRING_IN("serve", "Instead of running once, load the input models and "
+    "run for each request read from standard input (if '-' is given) or from "
+    "connections to the Unix domain socket with the given path, sending back "
+    "the outputs.", "", "");
 
 // Python-specific parameters.
 PARAM_FLAG("copy_all_inputs", "If specified, all input parameters will be deep"
@@ -23,18 +23,20 @@ using namespace std;
 using namespace chrono;
 
 /**
- * Start the given timer.
+ * Start the given timer, and begin a span with its name if tracing is enabled.
  */
 void Timer::Start(const string& name)
 {
   IO::GetSingleton().timer.StartTimer(name, this_thread::get_id());
+  IO::GetSingleton().tracer.Begin(name);
 }
 
 /**
- * Stop the given timer.
+ * Stop the given timer, and end the span with its name.
  */
 void Timer::Stop(const string& name)
 {
+  IO::GetSingleton().tracer.End(name);
   IO::GetSingleton().timer.StopTimer(name, this_thread::get_id());
 }
 
@@ -172,6 +174,20 @@ void Timers::StopAllTimers()
   timerStartTime.clear();
 }
 
+void Timers::StopThreadTimers(const thread::id& threadId)
+{
+  lock_guard<mutex> lock(timersMutex);
+
+  if (timerStartTime.count(threadId) == 0)
+    return;
+
+  high_resolution_clock::time_point currTime = high_resolution_clock::now();
+  for (auto it : timerStartTime[threadId])
+    timers[it.first] += duration_cast<microseconds>(currTime - it.second);
+
+  timerStartTime.erase(threadId);
+}
+
 void Timers::StartTimer(const string& timerName,
                         const thread::id& threadId)
 {
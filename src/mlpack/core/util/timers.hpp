@@ -42,6 +42,9 @@ namespace mlpack {
  * stopped, and its value to be obtained.  A named timer is specific to the
  * thread it is running on, so if you start a timer in one thread, it cannot be
  * stopped from a different thread.
+ *
+ * If the Tracer of mlpack is enabled, each run of a timer is also recorded as
+ * a span, nested in the spans that were open when it started (see Tracer).
  */
 class Timer
 {
@@ -163,6 +166,14 @@ class Timers
    */
   void StopAllTimers();
 
+  /**
+   * Stop all timers that were started by the given thread, for instance after
+   * an exception interrupted the code that would have stopped them.
+   *
+   * @param threadId Id of the thread whose timers are stopped.
+   */
+  void StopThreadTimers(const std::thread::id& threadId);
+
   //! Modify whether or not timing is enabled.
   std::atomic<bool>& Enabled() { return enabled; }
   //! Get whether or not timing is enabled.
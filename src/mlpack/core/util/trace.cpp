@@ -0,0 +1,419 @@
+/**
+ * @file core/util/trace.cpp
+ *
+ * Implementation of the tracing profiler.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "trace.hpp"
+#include "io.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+using namespace mlpack;
+using namespace std;
+using namespace chrono;
+
+const size_t Tracer::NoSpan;
+
+namespace {
+
+// Write the given string as a JSON string.
+void WriteJSONString(ostream& stream, const string& str)
+{
+  stream << '"';
+  for (const char c : str)
+  {
+    if (c == '"' || c == '\\')
+    {
+      stream << '\\' << c;
+    }
+    else if ((unsigned char) c < 0x20)
+    {
+      stream << "\\u" << hex << setw(4) << setfill('0') << (int) c << dec
+          << setfill(' ');
+    }
+    else
+    {
+      stream << c;
+    }
+  }
+  stream << '"';
+}
+
+// Get the duration at the given percentile of the given sorted durations.
+nanoseconds Percentile(const vector<int64_t>& durations, const double p)
+{
+  const size_t rank = (size_t) std::ceil(p * durations.size());
+  return nanoseconds(durations[std::max(rank, (size_t) 1) - 1]);
+}
+
+} // namespace
+
+Tracer::Tracer() :
+    enabled(false),
+    origin(steady_clock::now())
+{
+  // Ids start at 1, so that no tracer has the id threads start with.
+  static atomic<size_t> nextId(1);
+  id = nextId++;
+}
+
+size_t Tracer::Begin(const string& name)
+{
+  if (!enabled)
+    return NoSpan;
+
+  ThreadBuffer& buffer = Buffer();
+  unordered_map<string, size_t>::const_iterator it =
+      buffer.nameIds.find(name);
+  size_t nameId;
+  if (it == buffer.nameIds.end())
+  {
+    nameId = buffer.names.size();
+    buffer.names.push_back(name);
+    buffer.nameIds[name] = nameId;
+  }
+  else
+  {
+    nameId = it->second;
+  }
+
+  Event event;
+  event.name = nameId;
+  event.parent = buffer.open.empty() ? NoSpan : buffer.open.back();
+  event.end = -1;
+
+  const size_t span = buffer.events.size();
+  buffer.events.push_back(event);
+  buffer.open.push_back(span);
+
+  // Take the time last, so that the bookkeeping isn't counted in the span.
+  buffer.events.back().start = Now();
+  return span;
+}
+
+void Tracer::End(const size_t span)
+{
+  if (span == NoSpan)
+    return;
+
+  const int64_t time = Now();
+  ThreadBuffer& buffer = Buffer();
+  // The span may have been removed by Reset().
+  if (span < buffer.events.size() && buffer.events[span].end < 0)
+    EndEvent(buffer, span, time);
+}
+
+void Tracer::End(const string& name)
+{
+  if (!enabled)
+    return;
+
+  const int64_t time = Now();
+  ThreadBuffer& buffer = Buffer();
+  unordered_map<string, size_t>::const_iterator it =
+      buffer.nameIds.find(name);
+  if (it == buffer.nameIds.end())
+    return;
+
+  for (size_t i = buffer.open.size(); i > 0; --i)
+  {
+    if (buffer.events[buffer.open[i - 1]].name == it->second)
+    {
+      EndEvent(buffer, buffer.open[i - 1], time);
+      return;
+    }
+  }
+}
+
+void Tracer::EndAll()
+{
+  const int64_t time = Now();
+  lock_guard<mutex> lock(buffersMutex);
+  for (size_t b = 0; b < buffers.size(); ++b)
+  {
+    for (const size_t span : buffers[b]->open)
+      buffers[b]->events[span].end = time;
+    buffers[b]->open.clear();
+  }
+}
+
+void Tracer::Reset()
+{
+  // The buffers are kept, since threads remember them.
+  lock_guard<mutex> lock(buffersMutex);
+  for (size_t b = 0; b < buffers.size(); ++b)
+  {
+    buffers[b]->events.clear();
+    buffers[b]->open.clear();
+  }
+  origin = steady_clock::now();
+}
+
+map<string, SpanStatistics> Tracer::Statistics() const
+{
+  vector<string> stacks;
+  vector<vector<size_t>> eventStacks;
+  Stacks(stacks, eventStacks);
+  vector<vector<int64_t>> selfTimes;
+  SelfTimes(selfTimes);
+
+  vector<vector<int64_t>> durations(stacks.size());
+  vector<int64_t> self(stacks.size(), 0);
+  for (size_t b = 0; b < buffers.size(); ++b)
+  {
+    const vector<Event>& events = buffers[b]->events;
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+      if (events[i].end < 0)
+        continue;
+
+      durations[eventStacks[b][i]].push_back(events[i].end - events[i].start);
+      self[eventStacks[b][i]] += selfTimes[b][i];
+    }
+  }
+
+  map<string, SpanStatistics> statistics;
+  for (size_t s = 0; s < stacks.size(); ++s)
+  {
+    if (durations[s].empty())
+      continue;
+
+    std::sort(durations[s].begin(), durations[s].end());
+    int64_t total = 0;
+    for (const int64_t duration : durations[s])
+      total += duration;
+
+    SpanStatistics& stats = statistics[stacks[s]];
+    stats.count = durations[s].size();
+    stats.total = nanoseconds(total);
+    stats.self = nanoseconds(self[s]);
+    stats.min = nanoseconds(durations[s].front());
+    stats.median = Percentile(durations[s], 0.5);
+    stats.p90 = Percentile(durations[s], 0.9);
+    stats.p99 = Percentile(durations[s], 0.99);
+    stats.max = nanoseconds(durations[s].back());
+  }
+
+  return statistics;
+}
+
+void Tracer::ExportChromeTrace(ostream& stream) const
+{
+  const ios::fmtflags flags = stream.flags();
+  stream << fixed << setprecision(3);
+  stream << "{\"traceEvents\":[";
+  bool first = true;
+  for (size_t b = 0; b < buffers.size(); ++b)
+  {
+    const ThreadBuffer& buffer = *buffers[b];
+    for (const Event& event : buffer.events)
+    {
+      if (event.end < 0)
+        continue;
+
+      stream << (first ? "\n" : ",\n") << "{\"name\":";
+      WriteJSONString(stream, buffer.names[event.name]);
+      stream << ",\"cat\":\"mlpack\",\"ph\":\"X\",\"ts\":"
+          << event.start / 1000.0 << ",\"dur\":"
+          << (event.end - event.start) / 1000.0 << ",\"pid\":0,\"tid\":"
+          << buffer.thread << "}";
+      first = false;
+    }
+  }
+  stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  stream.flags(flags);
+}
+
+void Tracer::ExportFoldedStacks(ostream& stream) const
+{
+  vector<string> stacks;
+  vector<vector<size_t>> eventStacks;
+  Stacks(stacks, eventStacks);
+  vector<vector<int64_t>> selfTimes;
+  SelfTimes(selfTimes);
+
+  vector<int64_t> self(stacks.size(), 0);
+  vector<char> closed(stacks.size(), 0);
+  for (size_t b = 0; b < buffers.size(); ++b)
+  {
+    const vector<Event>& events = buffers[b]->events;
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+      if (events[i].end < 0)
+        continue;
+
+      self[eventStacks[b][i]] += selfTimes[b][i];
+      closed[eventStacks[b][i]] = 1;
+    }
+  }
+
+  // Flame graph tools merge equal stacks anyway, but sorted output is easier to
+  // compare.
+  map<string, int64_t> folded;
+  for (size_t s = 0; s < stacks.size(); ++s)
+    if (closed[s])
+      folded[stacks[s]] = self[s];
+
+  for (auto& it : folded)
+    stream << it.first << " " << (it.second + 500) / 1000 << "\n";
+}
+
+void Tracer::Save(const string& filename) const
+{
+  ofstream stream(filename);
+  if (!stream.is_open())
+  {
+    ostringstream error;
+    error << "Tracer::Save(): cannot open file '" << filename
+        << "' for writing";
+    throw runtime_error(error.str());
+  }
+
+  const string extension = ".json";
+  if (filename.size() >= extension.size() &&
+      filename.compare(filename.size() - extension.size(), extension.size(),
+      extension) == 0)
+    ExportChromeTrace(stream);
+  else
+    ExportFoldedStacks(stream);
+}
+
+Tracer::ThreadBuffer& Tracer::Buffer()
+{
+  // Each thread remembers the buffer it used last, so that it only has to take
+  // the lock when it switches tracers.
+  thread_local size_t cachedId = 0;
+  thread_local ThreadBuffer* cachedBuffer = NULL;
+  if (cachedId == id)
+    return *cachedBuffer;
+
+  lock_guard<mutex> lock(buffersMutex);
+  ThreadBuffer*& buffer = threadBuffers[this_thread::get_id()];
+  if (buffer == NULL)
+  {
+    buffers.emplace_back(new ThreadBuffer());
+    buffer = buffers.back().get();
+    buffer->thread = buffers.size() - 1;
+  }
+
+  cachedId = id;
+  cachedBuffer = buffer;
+  return *buffer;
+}
+
+int64_t Tracer::Now() const
+{
+  return duration_cast<nanoseconds>(steady_clock::now() - origin).count();
+}
+
+void Tracer::EndEvent(ThreadBuffer& buffer,
+                      const size_t span,
+                      const int64_t time)
+{
+  buffer.events[span].end = time;
+  // The span is usually the innermost one.
+  for (size_t i = buffer.open.size(); i > 0; --i)
+  {
+    if (buffer.open[i - 1] == span)
+    {
+      buffer.open.erase(buffer.open.begin() + (i - 1));
+      return;
+    }
+  }
+}
+
+void Tracer::Stacks(vector<string>& stacks,
+                    vector<vector<size_t>>& eventStacks) const
+{
+  // Each stack is identified by its parent stack (plus one, or zero for a
+  // root) and its innermost name.
+  map<pair<size_t, string>, size_t> ids;
+
+  stacks.clear();
+  eventStacks.clear();
+  eventStacks.resize(buffers.size());
+  for (size_t b = 0; b < buffers.size(); ++b)
+  {
+    const ThreadBuffer& buffer = *buffers[b];
+    eventStacks[b].resize(buffer.events.size());
+    // A parent always begins before its children, so its stack is known.
+    for (size_t i = 0; i < buffer.events.size(); ++i)
+    {
+      const Event& event = buffer.events[i];
+      const size_t parentStack = (event.parent == NoSpan) ? 0 :
+          eventStacks[b][event.parent] + 1;
+      string name = buffer.names[event.name];
+      std::replace(name.begin(), name.end(), ';', ',');
+
+      map<pair<size_t, string>, size_t>::const_iterator it =
+          ids.find(make_pair(parentStack, name));
+      if (it != ids.end())
+      {
+        eventStacks[b][i] = it->second;
+        continue;
+      }
+
+      eventStacks[b][i] = stacks.size();
+      ids[make_pair(parentStack, name)] = stacks.size();
+      stacks.push_back((parentStack == 0) ? name :
+          stacks[parentStack - 1] + ";" + name);
+    }
+  }
+}
+
+void Tracer::SelfTimes(vector<vector<int64_t>>& selfTimes) const
+{
+  selfTimes.clear();
+  selfTimes.resize(buffers.size());
+  for (size_t b = 0; b < buffers.size(); ++b)
+  {
+    const vector<Event>& events = buffers[b]->events;
+    selfTimes[b].assign(events.size(), 0);
+    for (size_t i = 0; i < events.size(); ++i)
+      if (events[i].end >= 0)
+        selfTimes[b][i] += events[i].end - events[i].start;
+
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+      const Event& event = events[i];
+      if (event.end >= 0 && event.parent != NoSpan &&
+          events[event.parent].end >= 0)
+      {
+        selfTimes[b][event.parent] -= event.end - event.start;
+      }
+    }
+
+    // Spans that don't end in order may overlap their parents' ends.
+    for (size_t i = 0; i < events.size(); ++i)
+      selfTimes[b][i] = std::max(selfTimes[b][i], (int64_t) 0);
+  }
+}
+
+TraceSpan::TraceSpan(const string& name) :
+    tracer(IO::GetSingleton().tracer),
+    span(tracer.Begin(name))
+{
+  // Nothing to do.
+}
+
+TraceSpan::TraceSpan(Tracer& tracer, const string& name) :
+    tracer(tracer),
+    span(tracer.Begin(name))
+{
+  // Nothing to do.
+}
+
+TraceSpan::~TraceSpan()
+{
+  tracer.End(span);
+}
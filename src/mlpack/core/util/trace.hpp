@@ -0,0 +1,271 @@
+/**
+ * @file core/util/trace.hpp
+ *
+ * A tracing profiler for mlpack, which records nested spans of time on each
+ * thread.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTILITIES_TRACE_HPP
+#define MLPACK_CORE_UTILITIES_TRACE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace mlpack {
+
+/**
+ * The statistics of all the closed spans with the same stack of names.
+ */
+struct SpanStatistics
+{
+  //! Number of spans.
+  size_t count;
+  //! Sum of the durations of the spans.
+  std::chrono::nanoseconds total;
+  //! Sum of the durations of the spans, minus the time spent in their
+  //! children.
+  std::chrono::nanoseconds self;
+  //! Shortest duration.
+  std::chrono::nanoseconds min;
+  //! Median duration.
+  std::chrono::nanoseconds median;
+  //! 90th percentile of the durations.
+  std::chrono::nanoseconds p90;
+  //! 99th percentile of the durations.
+  std::chrono::nanoseconds p99;
+  //! Longest duration.
+  std::chrono::nanoseconds max;
+};
+
+/**
+ * The Tracer records spans of time: each span has a name, a start and an end,
+ * and is the child of the span that was innermost on its thread when it
+ * began.  Unlike the Timers, which only keep the sum of the durations of each
+ * name, the Tracer keeps every span, so it can give the distribution of the
+ * durations of each stack of names (see Statistics()), and export the whole
+ * trace as Chrome trace-event JSON (for chrome://tracing or Perfetto) or as
+ * folded stacks (for flame graphs).
+ *
+ * Each thread records its spans in its own buffer, so beginning and ending
+ * spans takes no lock; only the first span of each thread takes one, to create
+ * its buffer.  Spans of different threads are not related, so the spans of an
+ * OpenMP worker thread are roots on that thread.
+ *
+ * The Tracer of mlpack is held by the IO singleton; the mlpack::Timer
+ * functions also begin and end spans in it, and TraceSpan gives scoped spans:
+ *
+ * @code
+ * {
+ *   TraceSpan span("tree_building");
+ *   // Build the tree...
+ * }
+ * @endcode
+ *
+ * Nothing is recorded unless the tracer is enabled.  Reset(), EndAll(),
+ * Statistics() and the exports read the buffers of all threads, so no other
+ * thread may begin or end spans while they run.
+ */
+class Tracer
+{
+ public:
+  //! Create an empty tracer; it is disabled.
+  Tracer();
+
+  /**
+   * Begin a span with the given name on the calling thread, and return its
+   * handle, to end it with.  If the tracer is disabled, nothing is recorded.
+   *
+   * @param name Name of the span.
+   */
+  size_t Begin(const std::string& name);
+
+  /**
+   * End the span with the given handle.  This must be called on the thread
+   * that began the span.  Spans don't have to end in the order they began.
+   *
+   * @param span Handle of the span, as returned by Begin().
+   */
+  void End(const size_t span);
+
+  /**
+   * End the innermost open span with the given name on the calling thread.
+   * If there is no such span (for instance, if it began before the tracer was
+   * enabled), nothing happens.
+   *
+   * @param name Name of the span.
+   */
+  void End(const std::string& name);
+
+  /**
+   * End all open spans, on all threads.
+   */
+  void EndAll();
+
+  /**
+   * Remove all spans.  Whether or not tracing is enabled will not be changed.
+   * Spans that are open must not be ended afterwards.
+   */
+  void Reset();
+
+  /**
+   * Get the statistics of the closed spans of each stack of names.  A stack is
+   * the names of a span and its ancestors, outermost first, separated by ';'
+   * (a ';' in a name is replaced by ',').
+   */
+  std::map<std::string, SpanStatistics> Statistics() const;
+
+  /**
+   * Write the closed spans in the Chrome trace-event format.  Times are in
+   * microseconds since the tracer was created or reset.
+   *
+   * @param stream Stream to write to.
+   */
+  void ExportChromeTrace(std::ostream& stream) const;
+
+  /**
+   * Write the self time of each stack of names, in microseconds, in the folded
+   * format used by flame graph tools: one line per stack, with the names
+   * separated by ';', a space, and the time.
+   *
+   * @param stream Stream to write to.
+   */
+  void ExportFoldedStacks(std::ostream& stream) const;
+
+  /**
+   * Save the closed spans to the given file: in the Chrome trace-event format
+   * if its extension is '.json', and as folded stacks otherwise.  A
+   * std::runtime_error is thrown if the file cannot be written.
+   *
+   * @param filename Name of the file.
+   */
+  void Save(const std::string& filename) const;
+
+  //! Modify whether or not tracing is enabled.
+  std::atomic<bool>& Enabled() { return enabled; }
+  //! Get whether or not tracing is enabled.
+  bool Enabled() const { return enabled; }
+
+ private:
+  //! A recorded span.
+  struct Event
+  {
+    //! Index of the name in the names of the thread.
+    size_t name;
+    //! Index of the parent event, or NoSpan for a root.
+    size_t parent;
+    //! Start, in nanoseconds since the origin.
+    int64_t start;
+    //! End, in nanoseconds since the origin; -1 while the span is open.
+    int64_t end;
+  };
+
+  //! The spans of one thread.  Only that thread writes to it.
+  struct ThreadBuffer
+  {
+    //! Index of the buffer, which identifies the thread in exports.
+    size_t thread;
+    //! All spans, in the order they began.
+    std::vector<Event> events;
+    //! Indices of the open spans, in the order they began.
+    std::vector<size_t> open;
+    //! Distinct names of the spans.
+    std::vector<std::string> names;
+    //! Index of each name in names.
+    std::unordered_map<std::string, size_t> nameIds;
+  };
+
+  //! Handle returned when nothing was recorded.
+  static const size_t NoSpan = size_t(-1);
+
+  //! Get the buffer of the calling thread, creating it if needed.
+  ThreadBuffer& Buffer();
+
+  //! Get the current time, in nanoseconds since the origin.
+  int64_t Now() const;
+
+  //! End the given open span of the given buffer at the given time.
+  static void EndEvent(ThreadBuffer& buffer,
+                       const size_t span,
+                       const int64_t time);
+
+  /**
+   * Find the stack of names of every event.  stacks holds the distinct
+   * stacks, and eventStacks[b][i] is the index in stacks of event i of buffer
+   * b.
+   */
+  void Stacks(std::vector<std::string>& stacks,
+              std::vector<std::vector<size_t>>& eventStacks) const;
+
+  /**
+   * Find the time each closed event spent outside its closed children, in
+   * nanoseconds, for every buffer.
+   */
+  void SelfTimes(std::vector<std::vector<int64_t>>& selfTimes) const;
+
+  //! Whether or not tracing is enabled.
+  std::atomic<bool> enabled;
+  //! Unique id of the tracer, used by threads to find their buffers.
+  size_t id;
+  //! Time that span times are relative to.
+  std::chrono::steady_clock::time_point origin;
+  //! A mutex for creating buffers.
+  mutable std::mutex buffersMutex;
+  //! The buffers of all threads.
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+  //! The buffer of each thread.
+  std::map<std::thread::id, ThreadBuffer*> threadBuffers;
+};
+
+/**
+ * A TraceSpan begins a span when it is created and ends it when it is
+ * destroyed.  By default, the span is recorded in the Tracer of mlpack.
+ */
+class TraceSpan
+{
+ public:
+  /**
+   * Begin a span with the given name in the Tracer of mlpack.
+   *
+   * @param name Name of the span.
+   */
+  TraceSpan(const std::string& name);
+
+  /**
+   * Begin a span with the given name in the given tracer.
+   *
+   * @param tracer Tracer to record the span in.
+   * @param name Name of the span.
+   */
+  TraceSpan(Tracer& tracer, const std::string& name);
+
+  //! End the span.
+  ~TraceSpan();
+
+  //! A span can't be copied.
+  TraceSpan(const TraceSpan& other) = delete;
+  //! A span can't be copied.
+  TraceSpan& operator=(const TraceSpan& other) = delete;
+
+ private:
+  //! The tracer the span is recorded in.
+  Tracer& tracer;
+  //! Handle of the span.
+  size_t span;
+};
+
+} // namespace mlpack
+
+#endif // MLPACK_CORE_UTILITIES_TRACE_HPP
@@ -15,6 +15,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/metrics/ip_metric.hpp>
+#include <mlpack/core/kernels/kernel_matrix.hpp>
 #include "fastmks_stat.hpp"
 #include <mlpack/core/tree/cover_tree.hpp>
 #include <queue>
@@ -339,6 +340,14 @@ class FastMKS
   //! Use a priority queue to represent the list of candidate points.
   typedef std::priority_queue<Candidate, std::vector<Candidate>,
       CandidateCmp> CandidateList;
+
+  //! Get the number of queries whose kernel values are computed at once in
+  //! naive mode, so that each block of kernel values takes about 8MB.
+  size_t NaiveBlockSize() const
+  {
+    return std::max((size_t) 1, ((size_t) 1 << 20) /
+        std::max((size_t) 1, (size_t) referenceSet->n_cols));
+  }
 };
 
 } // namespace fastmks
@@ -455,31 +455,41 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
-    for (size_t q = 0; q < querySet.n_cols; ++q)
+    // Simple double loop.  Stupid, slow, but a good benchmark.  The kernel
+    // values are computed for a block of queries at a time, so that kernels
+    // with a batch Evaluate() can use a matrix product.
+    const size_t blockSize = NaiveBlockSize();
+    arma::mat block;
+    for (size_t begin = 0; begin < querySet.n_cols; begin += blockSize)
     {
-      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
-      std::vector<Candidate> cList(k, def);
-      CandidateList pqueue(CandidateCmp(), std::move(cList));
+      const size_t end = std::min(begin + blockSize, (size_t) querySet.n_cols);
+      kernel::KernelMatrix(metric.Kernel(), *referenceSet,
+          querySet.cols(begin, end - 1), block);
 
-      for (size_t r = 0; r < referenceSet->n_cols; ++r)
+      for (size_t q = begin; q < end; ++q)
       {
-        const double eval = metric.Kernel().Evaluate(querySet.col(q),
-                                                     referenceSet->col(r));
+        const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
+        std::vector<Candidate> cList(k, def);
+        CandidateList pqueue(CandidateCmp(), std::move(cList));
 
-        if (eval > pqueue.top().first)
+        for (size_t r = 0; r < referenceSet->n_cols; ++r)
         {
-          Candidate c = std::make_pair(eval, r);
-          pqueue.pop();
-          pqueue.push(c);
+          const double eval = block(r, q - begin);
+
+          if (eval > pqueue.top().first)
+          {
+            Candidate c = std::make_pair(eval, r);
+            pqueue.pop();
+            pqueue.push(c);
+          }
         }
-      }
 
-      for (size_t j = 1; j <= k; ++j)
-      {
-        indices(k - j, q) = pqueue.top().second;
-        kernels(k - j, q) = pqueue.top().first;
-        pqueue.pop();
+        for (size_t j = 1; j <= k; ++j)
+        {
+          indices(k - j, q) = pqueue.top().second;
+          kernels(k - j, q) = pqueue.top().first;
+          pqueue.pop();
+        }
       }
     }
 
@@ -592,35 +602,45 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
-    for (size_t q = 0; q < referenceSet->n_cols; ++q)
+    // Simple double loop.  Stupid, slow, but a good benchmark.  As above, the
+    // kernel values are computed for a block of queries at a time.
+    const size_t blockSize = NaiveBlockSize();
+    arma::mat block;
+    for (size_t begin = 0; begin < referenceSet->n_cols; begin += blockSize)
     {
-      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
-      std::vector<Candidate> cList(k, def);
-      CandidateList pqueue(CandidateCmp(), std::move(cList));
+      const size_t end = std::min(begin + blockSize,
+          (size_t) referenceSet->n_cols);
+      kernel::KernelMatrix(metric.Kernel(), *referenceSet,
+          referenceSet->cols(begin, end - 1), block);
 
-      for (size_t r = 0; r < referenceSet->n_cols; ++r)
+      for (size_t q = begin; q < end; ++q)
       {
-        if (q == r)
-          continue; // Don't return the point as its own candidate.
+        const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
+        std::vector<Candidate> cList(k, def);
+        CandidateList pqueue(CandidateCmp(), std::move(cList));
 
-        const double eval = metric.Kernel().Evaluate(referenceSet->col(q),
-                                                     referenceSet->col(r));
+        for (size_t r = 0; r < referenceSet->n_cols; ++r)
+        {
+          if (q == r)
+            continue; // Don't return the point as its own candidate.
 
-        if (eval > pqueue.top().first)
+          const double eval = block(r, q - begin);
+
+          if (eval > pqueue.top().first)
+          {
+            Candidate c = std::make_pair(eval, r);
+            pqueue.pop();
+            pqueue.push(c);
+          }
+        }
+
+        for (size_t j = 1; j <= k; ++j)
         {
-          Candidate c = std::make_pair(eval, r);
+          indices(k - j, q) = pqueue.top().second;
+          kernels(k - j, q) = pqueue.top().first;
           pqueue.pop();
-          pqueue.push(c);
         }
       }
-
-      for (size_t j = 1; j <= k; ++j)
-      {
-        indices(k - j, q) = pqueue.top().second;
-        kernels(k - j, q) = pqueue.top().first;
-        pqueue.pop();
-      }
     }
 
     Timer::Stop("computing_products");
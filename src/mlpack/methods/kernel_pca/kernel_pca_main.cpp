@@ -30,6 +30,7 @@
 #include <mlpack/methods/nystroem_method/kmeans_selection.hpp>
 #include <mlpack/methods/nystroem_method/nystroem_method.hpp>
 #include <mlpack/methods/kernel_pca/kernel_rules/nystroem_method.hpp>
+#include <mlpack/methods/kernel_pca/kernel_rules/randomized_method.hpp>
 
 #include "kernel_pca.hpp"
 
@@ -96,7 +97,14 @@ BINDING_LONG_DESC(
     "the kernel matrix; to specify the sampling scheme, the " +
     PRINT_PARAM_STRING("sampling") + " parameter is used.  The "
     "sampling scheme for the Nystroem method can be chosen from the "
-    "following list: 'kmeans', 'random', 'ordered'.");
+    "following list: 'kmeans', 'random', 'ordered'."
+    "\n\n"
+    "For large datasets, the full kernel matrix may take too much memory.  If "
+    "the " + PRINT_PARAM_STRING("randomized_method") + " parameter is "
+    "specified, the leading eigenvectors are instead found with a randomized "
+    "eigensolver that only computes small parts of the kernel matrix at a "
+    "time.  Only one of " + PRINT_PARAM_STRING("nystroem_method") + " and " +
+    PRINT_PARAM_STRING("randomized_method") + " may be specified.");
 
 // Example.
 BINDING_EXAMPLE(
@@ -128,6 +136,8 @@ PARAM_FLAG("center", "If set, the transformed data will be centered about the "
     "origin.", "c");
 
 PARAM_FLAG("nystroem_method", "If set, the Nystroem method will be used.", "n");
+PARAM_FLAG("randomized_method", "If set, a randomized eigensolver that never "
+    "holds the full kernel matrix will be used.", "r");
 
 PARAM_STRING_IN("sampling", "Sampling scheme to use for the Nystroem method: "
     "'kmeans', 'random', 'ordered'", "s", "kmeans");
@@ -145,6 +155,7 @@ template<typename KernelType>
 void RunKPCA(arma::mat& dataset,
              const bool centerTransformedData,
              const bool nystroem,
+             const bool randomized,
              const size_t newDim,
              const string& sampling,
              KernelType& kernel)
@@ -177,6 +188,12 @@ void RunKPCA(arma::mat& dataset,
         << "choices are 'kmeans', 'random' and 'ordered'" << endl;
     }
   }
+  else if (randomized)
+  {
+    KernelPCA<KernelType, RandomizedKernelRule<KernelType> > kpca(kernel,
+        centerTransformedData);
+    kpca.Apply(dataset, newDim);
+  }
   else
   {
     KernelPCA<KernelType> kpca(kernel, centerTransformedData);
@@ -212,22 +229,25 @@ static void mlpackMain()
   const string kernelType = IO::GetParam<string>("kernel");
 
   const bool centerTransformedData = IO::HasParam("center");
+  RequireOnlyOnePassed({ "nystroem_method", "randomized_method" }, true,
+      "only one method may be used", true);
   const bool nystroem = IO::HasParam("nystroem_method");
+  const bool randomized = IO::HasParam("randomized_method");
   const string sampling = IO::GetParam<string>("sampling");
 
   if (kernelType == "linear")
   {
     LinearKernel kernel;
-    RunKPCA<LinearKernel>(dataset, centerTransformedData, nystroem, newDim,
-        sampling, kernel);
+    RunKPCA<LinearKernel>(dataset, centerTransformedData, nystroem,
+        randomized, newDim, sampling, kernel);
   }
   else if (kernelType == "gaussian")
   {
     const double bandwidth = IO::GetParam<double>("bandwidth");
 
     GaussianKernel kernel(bandwidth);
-    RunKPCA<GaussianKernel>(dataset, centerTransformedData, nystroem, newDim,
-        sampling, kernel);
+    RunKPCA<GaussianKernel>(dataset, centerTransformedData, nystroem,
+        randomized, newDim, sampling, kernel);
   }
   else if (kernelType == "polynomial")
   {
@@ -236,7 +256,7 @@ static void mlpackMain()
 
     PolynomialKernel kernel(degree, offset);
     RunKPCA<PolynomialKernel>(dataset, centerTransformedData, nystroem,
-        newDim, sampling, kernel);
+        randomized, newDim, sampling, kernel);
   }
   else if (kernelType == "hyptan")
   {
@@ -245,15 +265,15 @@ static void mlpackMain()
 
     HyperbolicTangentKernel kernel(scale, offset);
     RunKPCA<HyperbolicTangentKernel>(dataset, centerTransformedData, nystroem,
-        newDim, sampling, kernel);
+        randomized, newDim, sampling, kernel);
   }
   else if (kernelType == "laplacian")
   {
     const double bandwidth = IO::GetParam<double>("bandwidth");
 
     LaplacianKernel kernel(bandwidth);
-    RunKPCA<LaplacianKernel>(dataset, centerTransformedData, nystroem, newDim,
-        sampling, kernel);
+    RunKPCA<LaplacianKernel>(dataset, centerTransformedData, nystroem,
+        randomized, newDim, sampling, kernel);
   }
   else if (kernelType == "epanechnikov")
   {
@@ -261,13 +281,13 @@ static void mlpackMain()
 
     EpanechnikovKernel kernel(bandwidth);
     RunKPCA<EpanechnikovKernel>(dataset, centerTransformedData, nystroem,
-        newDim, sampling, kernel);
+        randomized, newDim, sampling, kernel);
   }
   else if (kernelType == "cosine")
   {
     CosineDistance kernel;
-    RunKPCA<CosineDistance>(dataset, centerTransformedData, nystroem, newDim,
-        sampling, kernel);
+    RunKPCA<CosineDistance>(dataset, centerTransformedData, nystroem,
+        randomized, newDim, sampling, kernel);
   }
 
   // Save the output dataset.
@@ -0,0 +1,138 @@
+/**
+ * @file methods/kernel_pca/kernel_rules/randomized_method.hpp
+ *
+ * Use a randomized eigensolver on the implicitly defined kernel matrix, so
+ * that the full kernel matrix never has to be held in memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_KERNEL_PCA_RANDOMIZED_METHOD_HPP
+#define MLPACK_METHODS_KERNEL_PCA_RANDOMIZED_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_matrix.hpp>
+
+namespace mlpack {
+namespace kpca {
+
+/**
+ * Find the leading eigenvectors of the centered kernel matrix with randomized
+ * subspace iteration ("Finding structure with randomness: Probabilistic
+ * algorithms for constructing approximate matrix decompositions", Halko,
+ * Martinsson and Tropp, 2011).  The kernel matrix is only ever used through
+ * products with a few vectors, which are computed tile by tile in parallel
+ * with kernel::KernelMatrixProduct(), so memory use is linear in the number of
+ * points instead of quadratic.  Each product evaluates the kernel on all pairs
+ * of points, so for small datasets NaiveKernelRule is faster.
+ *
+ * Unlike NaiveKernelRule, only the given number of eigenvalues and
+ * eigenvectors are computed.
+ */
+template<typename KernelType>
+class RandomizedKernelRule
+{
+ public:
+  /**
+   * Find the leading eigenvectors of the implicitly defined kernel matrix.
+   *
+   * @param data Input data points.
+   * @param transformedData Matrix to output results into.
+   * @param eigval KPCA eigenvalues will be written to this vector.
+   * @param eigvec KPCA eigenvectors will be written to this matrix.
+   * @param rank Number of eigenvectors to compute.
+   * @param kernel Kernel to be used for computation.
+   */
+  static void ApplyKernelMatrix(const arma::mat& data,
+                                arma::mat& transformedData,
+                                arma::vec& eigval,
+                                arma::mat& eigvec,
+                                const size_t rank,
+                                KernelType kernel = KernelType())
+  {
+    // Sample a few more directions than we need, and do a couple of power
+    // iterations; this is usually enough to get the leading eigenvectors
+    // accurately.
+    const size_t oversampling = 10;
+    const size_t powerIterations = 2;
+
+    const size_t n = data.n_cols;
+    const size_t dim = std::min(std::max(rank, (size_t) 1), n);
+    const size_t samples = std::min(dim + oversampling, n);
+
+    // For PCA the data has to be centered, so we work with the centered kernel
+    // matrix K - 1 m^T - m 1^T + mu 1 1^T, where m holds the mean of each row
+    // of K and mu is the mean of m.  We find m with the first product.
+    arma::mat x(n, samples + 1);
+    x.cols(0, samples - 1).randn();
+    x.col(samples).ones();
+
+    arma::mat y;
+    kernel::KernelMatrixProduct(kernel, data, x, y);
+    const arma::vec rowMean = y.col(samples) / n;
+    const double mean = arma::mean(rowMean);
+    x.shed_col(samples);
+    y.shed_col(samples);
+    CenterProduct(x, rowMean, mean, y);
+
+    // Now y holds the product of the centered kernel matrix with a random
+    // matrix.  Orthonormalize it and apply the kernel matrix again, a few
+    // times; the last q is the basis we use.
+    arma::mat q, r;
+    for (size_t i = 0; i <= powerIterations; ++i)
+    {
+      arma::qr_econ(q, r, y);
+      kernel::KernelMatrixProduct(kernel, data, q, y);
+      CenterProduct(q, rowMean, mean, y);
+    }
+
+    // Eigendecompose the centered kernel matrix projected onto q.
+    arma::mat b = q.t() * y;
+    b = 0.5 * (b + b.t());
+    arma::vec s;
+    arma::mat v;
+    if (!arma::eig_sym(s, v, b))
+    {
+      Log::Fatal << "Failed to eigendecompose the kernel matrix." << std::endl;
+    }
+
+    // The eigenvalues are ordered backwards (we need largest to smallest).
+    s = arma::flipud(s);
+    v = arma::fliplr(v);
+
+    eigval = s.head(dim);
+    eigvec = q * v.head_cols(dim);
+
+    // Since y holds the centered kernel matrix times q, y * v holds the
+    // centered kernel matrix times the eigenvectors.
+    transformedData = (y * v.head_cols(dim)).t();
+    transformedData.each_col() /= arma::sqrt(eigval);
+  }
+
+ private:
+  /**
+   * Turn y = K x into the product of the centered kernel matrix with x.
+   *
+   * @param x Matrix that K was multiplied by.
+   * @param rowMean Mean of each row of K.
+   * @param mean Mean of all of K.
+   * @param y Product K x, to be centered.
+   */
+  static void CenterProduct(const arma::mat& x,
+                            const arma::vec& rowMean,
+                            const double mean,
+                            arma::mat& y)
+  {
+    const arma::rowvec colSum = arma::sum(x, 0);
+    y.each_row() -= rowMean.t() * x - mean * colSum;
+    y -= rowMean * colSum;
+  }
+};
+
+} // namespace kpca
+} // namespace mlpack
+
+#endif
@@ -236,6 +236,10 @@ class LMNNFunction
   arma::uvec points;
   //! Flag for controlling use of bounds over impostors.
   bool impBounds;
+  //! Sum of the norms of all changes in transformation so far.
+  double movement;
+  //! Value of movement when the impostors of each point were last calculated.
+  arma::vec searchMovement;
   /**
   * Precalculate the gradient part due to target neighbors and stores
   * the result as a matrix. Used for L-BFGS like optimizers which does not
@@ -246,6 +250,13 @@ class LMNNFunction
   inline void UpdateCache(const arma::mat& transformation,
                           const size_t begin,
                           const size_t batchSize);
+  /**
+   * Re-calculate the impostors of the points whose impostors may have changed
+   * since they were last calculated, judging by how much the transformation
+   * has changed since then.  Used for L-BFGS like optimizers which do not use
+   * batches.
+   */
+  inline void UpdateImpostors();
   //! Calculate norm of change in transformation.
   inline void TransDiff(std::map<size_t, double>& transformationDiffs,
                         const arma::mat& transformation,
@@ -35,7 +35,8 @@ LMNNFunction<MetricType>::LMNNFunction(const arma::mat& dataset,
     range(range),
     constraint(dataset, labels, k),
     points(dataset.n_cols),
-    impBounds(false)
+    impBounds(false),
+    movement(0.0)
 {
   // Initialize the initial learning point.
   initialPoint.eye(dataset.n_rows, dataset.n_rows);
@@ -59,6 +60,8 @@ LMNNFunction<MetricType>::LMNNFunction(const arma::mat& dataset,
   lastTransformationIndices.set_size(dataset.n_cols);
   lastTransformationIndices.zeros();
 
+  searchMovement.zeros(dataset.n_cols);
+
   // Reserve the first element of cache.
   arma::mat emptyMat;
   oldTransformationMatrices.push_back(emptyMat);
@@ -101,6 +104,7 @@ void LMNNFunction<MetricType>::Shuffle()
   arma::vec newlastTransformationIndices = lastTransformationIndices;
   arma::mat newMaxImpNorm = maxImpNorm;
   arma::vec newNorm = norm;
+  arma::vec newSearchMovement = searchMovement;
 
   // Generate ordering.
   arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
@@ -114,6 +118,7 @@ void LMNNFunction<MetricType>::Shuffle()
   maxImpNorm = newMaxImpNorm.cols(ordering);
   lastTransformationIndices = newlastTransformationIndices.elem(ordering);
   norm = newNorm.elem(ordering);
+  searchMovement = newSearchMovement.elem(ordering);
 
   for (size_t i = 0; i < ordering.n_elem; ++i)
   {
@@ -222,42 +227,23 @@ double LMNNFunction<MetricType>::Evaluate(const arma::mat& transformation)
   {
     // Calculate norm of change in transformation.
     transformationDiff = arma::norm(transformation - transformationOld);
+    movement += transformationDiff;
   }
 
   if (!transformationOld.is_empty() && iteration++ % range == 0)
   {
-    if (impBounds)
-    {
-      // Track number of data points to use for impostors calculatiom.
-      size_t numPoints = 0;
-
-      for (size_t i = 0; i < dataset.n_cols; ++i)
-      {
-        if (transformationDiff * (2 * norm(i) + norm(impostors(k - 1, i)) +
-            norm(impostors(k, i))) > distance(k, i) - distance(k - 1, i))
-        {
-          points(numPoints++) = i;
-        }
-      }
-
-      // Re-calculate impostors on transformed dataset.
-      constraint.Impostors(impostors, distance,
-          transformedDataset, labels, norm, points, numPoints);
-    }
-    else
-    {
-      // Re-calculate impostors on transformed dataset.
-      constraint.Impostors(impostors, distance, transformedDataset, labels,
-          norm);
-    }
+    // Re-calculate impostors of the points whose impostors may have changed.
+    UpdateImpostors();
   }
   else if (iteration++ % range == 0)
   {
     // Re-calculate impostors on transformed dataset.
     constraint.Impostors(impostors, distance, transformedDataset, labels, norm);
+    searchMovement.fill(movement);
   }
 
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  #pragma omp parallel for schedule(dynamic, 16) reduction(+: cost)
+  for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
   {
     for (size_t j = 0; j < k ; ++j)
     {
@@ -475,41 +461,25 @@ void LMNNFunction<MetricType>::Gradient(const arma::mat& transformation,
   transformedDataset = transformation * dataset;
 
   double transformationDiff = 0;
-  if (!transformationOld.is_empty() && iteration++ % range == 0)
+  if (!transformationOld.is_empty())
   {
-    // Calculate norm of change in transformation.
+    // Calculate norm of change in transformation.  This is needed for the
+    // bounds below even when the impostors are not re-calculated.
     transformationDiff = arma::norm(transformation - transformationOld);
+    movement += transformationDiff;
+  }
 
-    if (impBounds)
-    {
-      // Track number of data points to use for impostors calculatiom.
-      size_t numPoints = 0;
-
-      for (size_t i = 0; i < dataset.n_cols; ++i)
-      {
-        if (transformationDiff * (2 * norm(i) + norm(impostors(k - 1, i)) +
-            norm(impostors(k, i))) > distance(k, i) - distance(k - 1, i))
-        {
-          points(numPoints++) = i;
-        }
-      }
-
-      // Re-calculate impostors on transformed dataset.
-      constraint.Impostors(impostors, distance,
-          transformedDataset, labels, norm, points, numPoints);
-    }
-    else
-    {
-      // Re-calculate impostors on transformed dataset.
-      constraint.Impostors(impostors, distance, transformedDataset, labels,
-          norm);
-    }
+  if (!transformationOld.is_empty() && iteration++ % range == 0)
+  {
+    // Re-calculate impostors of the points whose impostors may have changed.
+    UpdateImpostors();
   }
   else if (iteration++ % range == 0)
   {
-      // Re-calculate impostors on transformed dataset.
-      constraint.Impostors(impostors, distance, transformedDataset, labels,
-          norm);
+    // Re-calculate impostors on transformed dataset.
+    constraint.Impostors(impostors, distance, transformedDataset, labels,
+        norm);
+    searchMovement.fill(movement);
   }
 
   gradient.zeros(transformation.n_rows, transformation.n_cols);
@@ -520,73 +490,85 @@ void LMNNFunction<MetricType>::Gradient(const arma::mat& transformation,
   // Calculate gradient due to impostors.
   arma::mat cil = arma::zeros(dataset.n_rows, dataset.n_rows);
 
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  // Each thread accumulates the gradient due to impostors for its own
+  // points; the results are combined at the end.
+  #pragma omp parallel
   {
-    for (int j = k - 1; j >= 0; j--)
+    arma::mat localCil(dataset.n_rows, dataset.n_rows, arma::fill::zeros);
+
+    #pragma omp for schedule(dynamic, 16)
+    for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
     {
-      // Bound constraints to avoid uneccesary computation.
-      for (size_t l = 0, bp = k; l < bp ; l++)
+      for (int j = k - 1; j >= 0; j--)
       {
-        // Calculate cost due to {data point, target neighbors, impostors}
-        // triplets.
-        double eval = 0;
-
-        // Bounds for eval.
-        if (!transformationOld.is_empty() && evalOld(l, j, i) < -1)
+        // Bound constraints to avoid uneccesary computation.
+        for (size_t l = 0, bp = k; l < bp ; l++)
         {
-          // Update cache max impostor norm.
-          maxImpNorm(l, i) = std::max(maxImpNorm(l, i), norm(impostors(l, i)));
+          // Calculate cost due to {data point, target neighbors, impostors}
+          // triplets.
+          double eval = 0;
 
-          eval = evalOld(l, j, i) + transformationDiff *
-              (norm(targetNeighbors(j, i)) + maxImpNorm(l, i) +
-              2 * norm(i));
-        }
-
-        // Calculate exact eval value.
-        if (eval > -1)
-        {
-          if (iteration - 1 % range == 0)
+          // Bounds for eval.
+          if (!transformationOld.is_empty() && evalOld(l, j, i) < -1)
           {
-            eval = metric.Evaluate(transformedDataset.col(i),
-                     transformedDataset.col(targetNeighbors(j, i))) -
-                 distance(l, i);
+            // Update cache max impostor norm.
+            maxImpNorm(l, i) = std::max(maxImpNorm(l, i),
+                norm(impostors(l, i)));
+
+            eval = evalOld(l, j, i) + transformationDiff *
+                (norm(targetNeighbors(j, i)) + maxImpNorm(l, i) +
+                2 * norm(i));
           }
-          else
+
+          // Calculate exact eval value.
+          if (eval > -1)
           {
-            eval = metric.Evaluate(transformedDataset.col(i),
-                     transformedDataset.col(targetNeighbors(j, i))) -
-                   metric.Evaluate(transformedDataset.col(i),
-                       transformedDataset.col(impostors(l, i)));
+            if (iteration - 1 % range == 0)
+            {
+              eval = metric.Evaluate(transformedDataset.col(i),
+                       transformedDataset.col(targetNeighbors(j, i))) -
+                   distance(l, i);
+            }
+            else
+            {
+              eval = metric.Evaluate(transformedDataset.col(i),
+                       transformedDataset.col(targetNeighbors(j, i))) -
+                     metric.Evaluate(transformedDataset.col(i),
+                         transformedDataset.col(impostors(l, i)));
+            }
           }
-        }
 
-        // Update cache eval value.
-        evalOld(l, j, i) = eval;
+          // Update cache eval value.
+          evalOld(l, j, i) = eval;
 
-        // Check bounding condition.
-        if (eval <= -1)
-        {
-          // update bound.
-          bp = l;
-          break;
-        }
+          // Check bounding condition.
+          if (eval <= -1)
+          {
+            // update bound.
+            bp = l;
+            break;
+          }
 
-        // Reset cache.
-        if (eval > -1)
-        {
-          // update bound.
-          evalOld(l, j, i) = 0;
-          maxImpNorm(l, i) = 0;
-        }
+          // Reset cache.
+          if (eval > -1)
+          {
+            // update bound.
+            evalOld(l, j, i) = 0;
+            maxImpNorm(l, i) = 0;
+          }
 
-        // Caculate gradient due to impostors.
-        arma::vec diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
-        cil += diff * arma::trans(diff);
+          // Caculate gradient due to impostors.
+          arma::vec diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
+          localCil += diff * arma::trans(diff);
 
-        diff = dataset.col(i) - dataset.col(impostors(l, i));
-        cil -= diff * arma::trans(diff);
+          diff = dataset.col(i) - dataset.col(impostors(l, i));
+          localCil -= diff * arma::trans(diff);
+        }
       }
     }
+
+    #pragma omp critical
+    cil += localCil;
   }
 
   gradient = 2 * transformation * ((1 - regularization) * cij +
@@ -751,40 +733,20 @@ double LMNNFunction<MetricType>::EvaluateWithGradient(
   {
     // Calculate norm of change in transformation.
     transformationDiff = arma::norm(transformation - transformationOld);
+    movement += transformationDiff;
   }
 
   if (!transformationOld.is_empty() && iteration++ % range == 0)
   {
-    if (impBounds)
-    {
-      // Track number of data points to use for impostors calculatiom.
-      size_t numPoints = 0;
-
-      for (size_t i = 0; i < dataset.n_cols; ++i)
-      {
-        if (transformationDiff * (2 * norm(i) + norm(impostors(k - 1, i)) +
-            norm(impostors(k, i))) > distance(k, i) - distance(k - 1, i))
-        {
-          points(numPoints++) = i;
-        }
-      }
-
-      // Re-calculate impostors on transformed dataset.
-      constraint.Impostors(impostors, distance,
-          transformedDataset, labels, norm, points, numPoints);
-    }
-    else
-    {
-      // Re-calculate impostors on transformed dataset.
-      constraint.Impostors(impostors, distance, transformedDataset, labels,
-          norm);
-    }
+    // Re-calculate impostors of the points whose impostors may have changed.
+    UpdateImpostors();
   }
   else if (iteration++ % range == 0)
   {
-      // Re-calculate impostors on transformed dataset.
-      constraint.Impostors(impostors, distance, transformedDataset, labels,
-          norm);
+    // Re-calculate impostors on transformed dataset.
+    constraint.Impostors(impostors, distance, transformedDataset, labels,
+        norm);
+    searchMovement.fill(movement);
   }
 
   gradient.zeros(transformation.n_rows, transformation.n_cols);
@@ -795,75 +757,87 @@ double LMNNFunction<MetricType>::EvaluateWithGradient(
   // Calculate gradient due to impostors.
   arma::mat cil = arma::zeros(dataset.n_rows, dataset.n_rows);
 
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  // Each thread accumulates the gradient due to impostors for its own
+  // points; the results are combined at the end.
+  #pragma omp parallel
   {
-    for (size_t j = 0; j < k ; ++j)
-    {
-      // Calculate cost due to distance between target neighbors & data point.
-      double eval = metric.Evaluate(transformedDataset.col(i),
-                        transformedDataset.col(targetNeighbors(j, i)));
-      cost += (1 - regularization) * eval;
-    }
+    arma::mat localCil(dataset.n_rows, dataset.n_rows, arma::fill::zeros);
 
-    for (int j = k - 1; j >= 0; j--)
+    #pragma omp for schedule(dynamic, 16) reduction(+: cost)
+    for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
     {
-      // Bound constraints to avoid uneccesary computation.
-      for (size_t l = 0, bp = k; l < bp ; l++)
+      for (size_t j = 0; j < k ; ++j)
       {
-        // Calculate cost due to {data point, target neighbors, impostors}
-        // triplets.
-        double eval = 0;
+        // Calculate cost due to distance between target neighbors & data point.
+        double eval = metric.Evaluate(transformedDataset.col(i),
+                          transformedDataset.col(targetNeighbors(j, i)));
+        cost += (1 - regularization) * eval;
+      }
 
-        // Bounds for eval.
-        if (!transformationOld.is_empty() && evalOld(l, j, i) < -1)
+      for (int j = k - 1; j >= 0; j--)
+      {
+        // Bound constraints to avoid uneccesary computation.
+        for (size_t l = 0, bp = k; l < bp ; l++)
         {
-          // Update cache max impostor norm.
-          maxImpNorm(l, i) = std::max(maxImpNorm(l, i), norm(impostors(l, i)));
+          // Calculate cost due to {data point, target neighbors, impostors}
+          // triplets.
+          double eval = 0;
 
-          eval = evalOld(l, j, i) + transformationDiff *
-              (norm(targetNeighbors(j, i)) + maxImpNorm(l, i) +
-              2 * norm(i));
-        }
-
-        // Calculate exact eval value.
-        if (eval > -1)
-        {
-          if (iteration - 1 % range == 0)
+          // Bounds for eval.
+          if (!transformationOld.is_empty() && evalOld(l, j, i) < -1)
           {
-            eval = metric.Evaluate(transformedDataset.col(i),
-                     transformedDataset.col(targetNeighbors(j, i))) -
-                 distance(l, i);
+            // Update cache max impostor norm.
+            maxImpNorm(l, i) = std::max(maxImpNorm(l, i),
+                norm(impostors(l, i)));
+
+            eval = evalOld(l, j, i) + transformationDiff *
+                (norm(targetNeighbors(j, i)) + maxImpNorm(l, i) +
+                2 * norm(i));
           }
-          else
+
+          // Calculate exact eval value.
+          if (eval > -1)
           {
-            eval = metric.Evaluate(transformedDataset.col(i),
-                     transformedDataset.col(targetNeighbors(j, i))) -
-                   metric.Evaluate(transformedDataset.col(i),
-                       transformedDataset.col(impostors(l, i)));
+            if (iteration - 1 % range == 0)
+            {
+              eval = metric.Evaluate(transformedDataset.col(i),
+                       transformedDataset.col(targetNeighbors(j, i))) -
+                   distance(l, i);
+            }
+            else
+            {
+              eval = metric.Evaluate(transformedDataset.col(i),
+                       transformedDataset.col(targetNeighbors(j, i))) -
+                     metric.Evaluate(transformedDataset.col(i),
+                         transformedDataset.col(impostors(l, i)));
+            }
           }
-        }
 
-        // Update cache eval value.
-        evalOld(l, j, i) = eval;
+          // Update cache eval value.
+          evalOld(l, j, i) = eval;
 
-        // Check bounding condition.
-        if (eval <= -1)
-        {
-          // update bound.
-          bp = l;
-          break;
-        }
+          // Check bounding condition.
+          if (eval <= -1)
+          {
+            // update bound.
+            bp = l;
+            break;
+          }
 
-        cost += regularization * (1 + eval);
+          cost += regularization * (1 + eval);
 
-        // Caculate gradient due to impostors.
-        arma::vec diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
-        cil += diff * arma::trans(diff);
+          // Caculate gradient due to impostors.
+          arma::vec diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
+          localCil += diff * arma::trans(diff);
 
-        diff = dataset.col(i) - dataset.col(impostors(l, i));
-        cil -= diff * arma::trans(diff);
+          diff = dataset.col(i) - dataset.col(impostors(l, i));
+          localCil -= diff * arma::trans(diff);
+        }
       }
     }
+
+    #pragma omp critical
+    cil += localCil;
   }
 
   gradient = 2 * transformation * ((1 - regularization) * cij +
@@ -1015,6 +989,46 @@ double LMNNFunction<MetricType>::EvaluateWithGradient(
   return cost;
 }
 
+// Re-calculate impostors of the points whose impostors may have changed.
+template<typename MetricType>
+inline void LMNNFunction<MetricType>::UpdateImpostors()
+{
+  if (!impBounds)
+  {
+    // Without the (k + 1)'th impostor we can't bound anything.
+    constraint.Impostors(impostors, distance, transformedDataset, labels,
+        norm);
+    searchMovement.fill(movement);
+    return;
+  }
+
+  // Since the impostors of point i were last calculated, the distance between
+  // two points a and b can have changed by at most
+  // || L - L_old || * || x_a - x_b ||, and || L - L_old || is at most the sum
+  // of the changes in transformation since then.  So the k'th and (k + 1)'th
+  // impostors can only have swapped if the gap between their distances was
+  // smaller than that.  Otherwise, we don't need to search again.
+  size_t numPoints = 0;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    if ((movement - searchMovement(i)) * (2 * norm(i) +
+        norm(impostors(k - 1, i)) + norm(impostors(k, i))) >
+        distance(k, i) - distance(k - 1, i))
+    {
+      points(numPoints++) = i;
+    }
+  }
+
+  if (numPoints == 0)
+    return;
+
+  // Re-calculate impostors on transformed dataset.
+  constraint.Impostors(impostors, distance, transformedDataset, labels, norm,
+      points, numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+    searchMovement(points(i)) = movement;
+}
+
 template<typename MetricType>
 inline void LMNNFunction<MetricType>::Precalculate()
 {
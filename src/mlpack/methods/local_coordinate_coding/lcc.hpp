@@ -145,13 +145,23 @@ class LocalCoordinateCoding
                    DictionaryInitializer());
 
   /**
-   * Code each point via distance-weighted LARS.
+   * Code each point via distance-weighted LARS.  The points are encoded in
+   * parallel with OpenMP.
    *
    * @param data Matrix containing points to encode.
    * @param codes Output matrix to store codes in.
    */
   void Encode(const arma::mat& data, arma::mat& codes);
 
+  /**
+   * Code each point via distance-weighted LARS, and store the codes in the
+   * given sparse matrix.
+   *
+   * @param data Matrix containing points to encode.
+   * @param codes Output sparse matrix to store codes in.
+   */
+  void Encode(const arma::mat& data, arma::sp_mat& codes);
+
   /**
    * Learn dictionary by solving linear system.
    *
@@ -221,6 +231,14 @@ class LocalCoordinateCoding
   size_t maxIterations;
   //! Tolerance for main objective.
   double tolerance;
+
+  /**
+   * Code each point in the given dataset in parallel, and pass each code to
+   * store(i, code), where i is the index of the point.  store() may be called
+   * from several threads at once.
+   */
+  template<typename StoreFunction>
+  void EncodePoints(const arma::mat& data, StoreFunction store) const;
 };
 
 } // namespace lcc
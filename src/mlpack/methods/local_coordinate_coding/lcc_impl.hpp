@@ -106,6 +106,45 @@ double LocalCoordinateCoding::Train(
   return lastObjVal;
 }
 
+template<typename StoreFunction>
+void LocalCoordinateCoding::EncodePoints(const arma::mat& data,
+                                         StoreFunction store) const
+{
+  const arma::mat invSqDists = 1.0 / (repmat(trans(sum(square(dictionary))), 1,
+      data.n_cols) + repmat(sum(square(data)), atoms, 1) - 2 * trans(dictionary)
+      * data);
+
+  // All threads share the Gram matrix of the dictionary.
+  const arma::mat dictGram = trans(dictionary) * dictionary;
+
+  Log::Debug << "Encoding " << data.n_cols << " points." << std::endl;
+
+  #pragma omp parallel
+  {
+    // Each thread reuses one LARS object for all of its points.  The LARS
+    // object refers to dictGramTD, which is overwritten for each point.
+    arma::mat dictGramTD(atoms, atoms);
+    arma::mat dictPrime;
+    arma::vec code;
+    const bool useCholesky = false;
+    regression::LARS lars(useCholesky, dictGramTD, 0.5 * lambda);
+
+    #pragma omp for schedule(dynamic, 16)
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    {
+      const arma::vec invW = invSqDists.col(i);
+      dictPrime = dictionary * diagmat(invW);
+      dictGramTD = diagmat(invW) * dictGram * diagmat(invW);
+
+      // Run LARS for this point.
+      arma::rowvec responses = data.col(i).t();
+      lars.Train(dictPrime, responses, code, false);
+      code %= invW;
+      store((size_t) i, code);
+    }
+  }
+}
+
 template<typename Archive>
 void LocalCoordinateCoding::serialize(Archive& ar,
                                       const uint32_t /* version */)
@@ -86,6 +86,13 @@ class NCA
   const OptimizerType& Optimizer() const { return optimizer; }
   OptimizerType& Optimizer() { return optimizer; }
 
+  //! Get the number of nearest neighbors that the stochastic neighbor
+  //! assignment of each point is restricted to (0 for all points).
+  size_t Neighbors() const { return errorFunction.Neighbors(); }
+  //! Modify the number of nearest neighbors that the stochastic neighbor
+  //! assignment of each point is restricted to (0 for all points).
+  size_t& Neighbors() { return errorFunction.Neighbors(); }
+
  private:
   //! Dataset reference.
   const arma::mat& dataset;
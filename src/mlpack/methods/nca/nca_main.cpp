@@ -92,7 +92,13 @@ BINDING_LONG_DESC(
     "mlpack L-BFGS documentation (in lbfgs.hpp) or the vast set of published "
     "literature on L-BFGS."
     "\n\n"
-    "By default, the SGD optimizer is used.");
+    "By default, the SGD optimizer is used."
+    "\n\n"
+    "Each evaluation of the objective takes time quadratic in the number of "
+    "points.  For large datasets, the " + PRINT_PARAM_STRING("neighbors") +
+    " parameter can be used to only consider that many nearest neighbors of "
+    "each point (under the current distance) in its stochastic neighbor "
+    "assignment, which is much faster.");
 
 // See also...
 BINDING_SEE_ALSO("@lmnn", "#lmnn");
@@ -135,6 +141,9 @@ PARAM_DOUBLE_IN("min_step", "Minimum step of line search for L-BFGS.", "m",
 PARAM_DOUBLE_IN("max_step", "Maximum step of line search for L-BFGS.", "M",
     1e20);
 
+PARAM_INT_IN("neighbors", "If not 0, only consider this many nearest "
+    "neighbors of each point in its stochastic neighbor assignment.", "k", 0);
+
 PARAM_INT_IN("seed", "Random seed.  If 0, 'std::time(NULL)' is used.", "s", 0);
 
 using namespace mlpack;
@@ -188,6 +197,10 @@ static void mlpackMain()
   const double maxStep = IO::GetParam<double>("max_step");
   const size_t batchSize = (size_t) IO::GetParam<int>("batch_size");
 
+  RequireParamValue<int>("neighbors", [](int x) { return x >= 0; }, true,
+      "number of neighbors must be nonnegative");
+  const size_t neighbors = (size_t) IO::GetParam<int>("neighbors");
+
   // Load data.
   arma::mat data = std::move(IO::GetParam<arma::mat>("input"));
 
@@ -241,6 +254,7 @@ static void mlpackMain()
   if (optimizerType == "sgd")
   {
     NCA<LMetric<2> > nca(data, labels);
+    nca.Neighbors() = neighbors;
     nca.Optimizer().StepSize() = stepSize;
     nca.Optimizer().MaxIterations() = maxIterations;
     nca.Optimizer().Tolerance() = tolerance;
@@ -252,6 +266,7 @@ static void mlpackMain()
   else if (optimizerType == "lbfgs")
   {
     NCA<LMetric<2>, ens::L_BFGS> nca(data, labels);
+    nca.Neighbors() = neighbors;
     nca.Optimizer().NumBasis() = numBasis;
     nca.Optimizer().MaxIterations() = maxIterations;
     nca.Optimizer().ArmijoConstant() = armijoConstant;
@@ -17,6 +17,7 @@
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/math/make_alias.hpp>
 #include <mlpack/core/math/shuffle_data.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 
 namespace mlpack {
 namespace nca {
@@ -40,6 +41,13 @@ namespace nca {
  * optimizers use, overloads of Evaluate() and Gradient() are given which only
  * operate on one point in the dataset.  This is useful for optimizers like
  * stochastic gradient descent (see mlpack::optimization::SGD).
+ *
+ * Evaluating the function over the whole dataset takes O(n^2) time.  For large
+ * datasets, the softmax of each point can instead be truncated to its k nearest
+ * neighbors under the current scaling, which are found with a tree search; then
+ * each sum over k != i above is only over those neighbors, and p_ij is 0 for
+ * any other j.  If MetricType is an LMetric, the neighbors are found with a
+ * kd-tree search; for any other metric, they are found with a linear scan.
  */
 template<typename MetricType = metric::SquaredEuclideanDistance>
 class SoftmaxErrorFunction
@@ -54,10 +62,13 @@ class SoftmaxErrorFunction
    * @param dataset Matrix containing the dataset.
    * @param labels Vector of class labels for each point in the dataset.
    * @param metric Instantiated metric (optional).
+   * @param neighbors If not 0, truncate the softmax of each point to this many
+   *     nearest neighbors.
    */
   SoftmaxErrorFunction(const arma::mat& dataset,
                        const arma::Row<size_t>& labels,
-                       MetricType metric = MetricType());
+                       MetricType metric = MetricType(),
+                       const size_t neighbors = 0);
 
   /**
    * Shuffle the dataset.
@@ -131,6 +142,11 @@ class SoftmaxErrorFunction
    */
   size_t NumFunctions() const { return dataset.n_cols; }
 
+  //! Get the number of neighbors the softmax is truncated to (0 for none).
+  size_t Neighbors() const { return neighbors; }
+  //! Modify the number of neighbors the softmax is truncated to (0 for none).
+  size_t& Neighbors() { return neighbors; }
+
  private:
   //! The dataset.  This is an alias until Shuffle() is called.
   arma::mat dataset;
@@ -140,6 +156,8 @@ class SoftmaxErrorFunction
 
   //! The instantiated metric.
   MetricType metric;
+  //! Number of neighbors the softmax is truncated to, or 0 for no truncation.
+  size_t neighbors;
 
   //! Last coordinates.  Used for the non-separable Evaluate() and Gradient().
   arma::mat lastCoordinates;
@@ -150,6 +168,14 @@ class SoftmaxErrorFunction
   //! Holds denominators for calculation of p_ij, for the non-separable
   //! Evaluate() and Gradient().
   arma::vec denominators;
+  //! Number of neighbors used by the last precalculation (0 for all points).
+  size_t lastNeighbors;
+  //! Nearest neighbors of each point, if the softmax is truncated, for the
+  //! non-separable Evaluate() and Gradient().
+  arma::Mat<size_t> neighborIndices;
+  //! Distances to the nearest neighbors of each point, if the softmax is
+  //! truncated, for the non-separable Evaluate() and Gradient().
+  arma::mat neighborDistances;
 
   //! False if nothing has ever been precalculated (only at construction time).
   bool precalculated;
@@ -163,11 +189,45 @@ class SoftmaxErrorFunction
    * This will update last_coordinates_ and stretched_dataset_, and also
    * calculate the p_i and denominators_ which are used in the calculation of
    * p_i or p_ij.  The calculation will be O((n * (n + 1)) / 2), which is not
-   * great.
+   * great, unless the softmax is truncated; then the nearest neighbors of each
+   * point are found and stored too.
    *
    * @param coordinates Coordinates matrix to use for precalculation.
    */
   void Precalculate(const arma::mat& coordinates);
+
+  /**
+   * Find the lastNeighbors nearest neighbors of each point in the stretched
+   * dataset, and store them in neighborIndices and neighborDistances.  For an
+   * LMetric, this uses a dual-tree search with the true (rooted) metric, since
+   * the unrooted distance does not satisfy the triangle inequality that the
+   * tree pruning relies on; the distances are then raised back to the power.
+   *
+   * @param metric Instantiated metric.
+   */
+  template<int Power, bool TakeRoot>
+  void SearchNeighbors(const metric::LMetric<Power, TakeRoot>& metric);
+
+  /**
+   * Find the lastNeighbors nearest neighbors of each point in the stretched
+   * dataset with a linear scan, for metrics that can't be used with kd-trees.
+   *
+   * @param metric Instantiated metric.
+   */
+  template<typename OtherMetricType>
+  void SearchNeighbors(const OtherMetricType& metric);
+
+  /**
+   * Find the points that the softmax of the given point is taken over, and
+   * exp(-d(A x_i, A x_k)) for each of them, using the stretched dataset.  This
+   * is used by the separable Evaluate() and Gradient(), and takes O(n) time
+   * whether or not the softmax is truncated.
+   *
+   * @param i Index of point.
+   * @param indices Vector to store the indices of the points in.
+   * @param evals Vector to store exp(-d(A x_i, A x_k)) in.
+   */
+  void SoftmaxTerms(const size_t i, arma::uvec& indices, arma::vec& evals);
 };
 
 } // namespace nca
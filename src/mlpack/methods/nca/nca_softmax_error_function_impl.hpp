@@ -25,10 +25,13 @@ template<typename MetricType>
 SoftmaxErrorFunction<MetricType>::SoftmaxErrorFunction(
     const arma::mat& dataset,
     const arma::Row<size_t>& labels,
-    MetricType metric) :
+    MetricType metric,
+    const size_t neighbors) :
     dataset(math::MakeAlias(const_cast<arma::mat&>(dataset), false)),
     labels(math::MakeAlias(const_cast<arma::Row<size_t>&>(labels), false)),
     metric(metric),
+    neighbors(neighbors),
+    lastNeighbors(0),
     precalculated(false)
 { /* nothing to do */ }
 
@@ -68,35 +71,35 @@ double SoftmaxErrorFunction<MetricType>::Evaluate(const arma::mat& coordinates,
 {
   // Unfortunately each evaluation will take O(N) time because it requires a
   // scan over all points in the dataset.  Our objective is to compute p_i.
-  double denominator = 0;
-  double numerator = 0;
   double result = 0;
 
   // It's quicker to do this now than one point at a time later.
   stretchedDataset = coordinates * dataset;
-  for (size_t i = begin; i < begin + batchSize; ++i)
-  {
-    for (size_t k = 0; k < dataset.n_cols; ++k)
-    {
-      // Don't consider the case where the points are the same.
-      if (k == i)
-        continue;
 
-      // We want to evaluate exp(-D(A x_i, A x_k)).
-      double eval = std::exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                              stretchedDataset.unsafe_col(k)));
+  #pragma omp parallel for reduction(+: result)
+  for (omp_size_t i = (omp_size_t) begin; i < (omp_size_t) (begin + batchSize);
+      ++i)
+  {
+    arma::uvec indices;
+    arma::vec evals;
+    SoftmaxTerms(i, indices, evals);
 
+    double denominator = 0;
+    double numerator = 0;
+    for (size_t m = 0; m < indices.n_elem; ++m)
+    {
       // If they are in the same class, update the numerator.
-      if (labels[i] == labels[k])
-        numerator += eval;
+      if (labels[i] == labels[indices[m]])
+        numerator += evals[m];
 
-      denominator += eval;
+      denominator += evals[m];
     }
 
     // Now the result is just a simple division, but we have to be sure that the
     // denominator is not 0.
     if (denominator == 0.0)
     {
+      #pragma omp critical
       Log::Warn << "Denominator of p_" << i << " is 0!" << std::endl;
       continue;
     }
@@ -127,28 +130,63 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
   //     (((p_i - (1 / p_i)) p_ik) + ((p_k - (1 / p_k)) p_ki)) x_ik x_ik^T
   //   otherwise, add
   //     (p_i p_ik + p_k p_ki) x_ik x_ik^T
+  //
+  // If the softmax is truncated, p_ik is 0 unless k is one of the nearest
+  // neighbors of i, so we instead loop over each i and its neighbors k, and
+  // add (p_i - 1) p_ik x_ik x_ik^T or p_i p_ik x_ik x_ik^T.
+  //
+  // Each thread accumulates its own sum, and the sums are added at the end.
   arma::mat sum;
   sum.zeros(stretchedDataset.n_rows, stretchedDataset.n_rows);
-  for (size_t i = 0; i < stretchedDataset.n_cols; ++i)
+  #pragma omp parallel
   {
-    for (size_t k = (i + 1); k < stretchedDataset.n_cols; ++k)
+    arma::mat localSum(stretchedDataset.n_rows, stretchedDataset.n_rows,
+        arma::fill::zeros);
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) stretchedDataset.n_cols; ++i)
     {
-      // Calculate p_ik and p_ki first.
-      double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                         stretchedDataset.unsafe_col(k)));
-      double p_ik = 0, p_ki = 0;
-      p_ik = eval / denominators(i);
-      p_ki = eval / denominators(k);
-
-      // Subtract x_i from x_k.  We are not using stretched points here.
-      arma::vec x_ik = dataset.col(i) - dataset.col(k);
-      arma::mat secondTerm = (x_ik * trans(x_ik));
-
-      if (labels[i] == labels[k])
-        sum += ((p[i] - 1) * p_ik + (p[k] - 1) * p_ki) * secondTerm;
-      else
-        sum += (p[i] * p_ik + p[k] * p_ki) * secondTerm;
+      if (lastNeighbors > 0)
+      {
+        for (size_t m = 0; m < lastNeighbors; ++m)
+        {
+          const size_t k = neighborIndices(m, i);
+          const double p_ik = std::exp(-neighborDistances(m, i)) /
+              denominators(i);
+
+          // Subtract x_i from x_k.  We are not using stretched points here.
+          arma::vec x_ik = dataset.col(i) - dataset.col(k);
+          if (labels[i] == labels[k])
+            localSum += ((p[i] - 1) * p_ik) * (x_ik * trans(x_ik));
+          else
+            localSum += (p[i] * p_ik) * (x_ik * trans(x_ik));
+        }
+
+        continue;
+      }
+
+      for (size_t k = (i + 1); k < stretchedDataset.n_cols; ++k)
+      {
+        // Calculate p_ik and p_ki first.
+        double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
+                                           stretchedDataset.unsafe_col(k)));
+        double p_ik = 0, p_ki = 0;
+        p_ik = eval / denominators(i);
+        p_ki = eval / denominators(k);
+
+        // Subtract x_i from x_k.  We are not using stretched points here.
+        arma::vec x_ik = dataset.col(i) - dataset.col(k);
+        arma::mat secondTerm = (x_ik * trans(x_ik));
+
+        if (labels[i] == labels[k])
+          localSum += ((p[i] - 1) * p_ik + (p[k] - 1) * p_ki) * secondTerm;
+        else
+          localSum += (p[i] * p_ik + p[k] * p_ki) * secondTerm;
+      }
     }
+
+    #pragma omp critical
+    sum += localSum;
   }
 
   // Assemble the final gradient.
@@ -163,71 +201,85 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
                                                 GradType& gradient,
                                                 const size_t batchSize)
 {
-  // The gradient involves two matrix terms which are eventually combined into
-  // one.
-  GradType firstTerm, secondTerm;
-  // We will need to calculate p_i before this evaluation is done, so
-  // these two variables will hold the information necessary for that.
-  double numerator, denominator;
-
   gradient.zeros(coordinates.n_rows, coordinates.n_rows);
 
   // Compute the stretched dataset.
   stretchedDataset = coordinates * dataset;
-  for (size_t i = begin; i < begin + batchSize; ++i)
+
+  // Each thread accumulates the gradient for its own points, and the results
+  // are added at the end.
+  #pragma omp parallel
   {
-    numerator = 0;
-    denominator = 0;
+    GradType localGradient;
+    localGradient.zeros(coordinates.n_rows, coordinates.n_rows);
 
-    firstTerm.zeros(coordinates.n_rows, coordinates.n_cols);
-    secondTerm.zeros(coordinates.n_rows, coordinates.n_cols);
+    // The gradient involves two matrix terms which are eventually combined
+    // into one.
+    GradType firstTerm, secondTerm;
 
-    for (size_t k = 0; k < dataset.n_cols; ++k)
+    #pragma omp for
+    for (omp_size_t i = (omp_size_t) begin;
+        i < (omp_size_t) (begin + batchSize); ++i)
     {
-      // Don't consider the case where the points are the same.
-      if (i == k)
-        continue;
+      // We will need to calculate p_i before this evaluation is done, so
+      // these two variables will hold the information necessary for that.
+      double numerator = 0;
+      double denominator = 0;
+
+      firstTerm.zeros(coordinates.n_rows, coordinates.n_cols);
+      secondTerm.zeros(coordinates.n_rows, coordinates.n_cols);
 
-      // Calculate the numerator of p_ik.
-      double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                         stretchedDataset.unsafe_col(k)));
+      arma::uvec indices;
+      arma::vec evals;
+      SoftmaxTerms(i, indices, evals);
 
-      // If the points are in the same class, we must add to the second term of
-      // the gradient as well as the numerator of p_i.  We will divide by the
-      // denominator of p_ik later.  For x_ik we are not using stretched points.
-      GradType x_ik = dataset.col(i) - dataset.col(k);
-      if (labels[i] == labels[k])
+      for (size_t m = 0; m < indices.n_elem; ++m)
       {
-        numerator += eval;
-        secondTerm += eval * x_ik * trans(x_ik);
+        const size_t k = indices[m];
+
+        // If the points are in the same class, we must add to the second term
+        // of the gradient as well as the numerator of p_i.  We will divide by
+        // the denominator of p_ik later.  For x_ik we are not using stretched
+        // points.
+        GradType x_ik = dataset.col(i) - dataset.col(k);
+        if (labels[i] == labels[k])
+        {
+          numerator += evals[m];
+          secondTerm += evals[m] * x_ik * trans(x_ik);
+        }
+
+        // We always have to add to the denominator of p_i
+        // and the first term of the gradient computation.
+        // We will divide by the denominator of p_ik later.
+        denominator += evals[m];
+        firstTerm += evals[m] * x_ik * trans(x_ik);
       }
 
-      // We always have to add to the denominator of p_i
-      // and the first term of the gradient computation.
-      // We will divide by the denominator of p_ik later.
-      denominator += eval;
-      firstTerm += eval * x_ik * trans(x_ik);
-    }
+      // Calculate p_i.
+      double p = 0;
+      if (denominator == 0)
+      {
+        #pragma omp critical
+        Log::Warn << "Denominator of p_" << i << " is 0!" << std::endl;
+        // If the denominator is zero, then all p_ik should be zero and there
+        // is no gradient contribution from this point.
+        continue;
+      }
+      else
+      {
+        p = numerator / denominator;
+        firstTerm /= denominator;
+        secondTerm /= denominator;
+      }
 
-    // Calculate p_i.
-    double p = 0;
-    if (denominator == 0)
-    {
-      Log::Warn << "Denominator of p_" << i << " is 0!" << std::endl;
-      // If the denominator is zero, then all p_ik should be zero and there is
-      // no gradient contribution from this point.
-      continue;
-    }
-    else
-    {
-      p = numerator / denominator;
-      firstTerm /= denominator;
-      secondTerm /= denominator;
+      // Now multiply the first term by p_i, and add the two together and
+      // multiply all by 2 * A.  We negate it though, because our optimizer is
+      // a minimizer.
+      localGradient += -2 * coordinates * (p * firstTerm - secondTerm);
     }
 
-    // Now multiply the first term by p_i, and add the two together and multiply
-    // all by 2 * A.  We negate it though, because our optimizer is a minimizer.
-    gradient += -2 * coordinates * (p * firstTerm - secondTerm);
+    #pragma omp critical
+    gradient += localGradient;
   }
 }
 
@@ -248,7 +300,8 @@ void SoftmaxErrorFunction<MetricType>::Precalculate(
     lastCoordinates.set_size(coordinates.n_rows, coordinates.n_cols);
   }
   else if ((accu(coordinates == lastCoordinates) == coordinates.n_elem) &&
-      precalculated)
+      precalculated && lastNeighbors == std::min(neighbors,
+      (size_t) dataset.n_cols - 1))
   {
     return; // No need to calculate; we already have this stuff saved.
   }
@@ -256,6 +309,7 @@ void SoftmaxErrorFunction<MetricType>::Precalculate(
   // Coordinates are different; save the new ones, and stretch the dataset.
   lastCoordinates = coordinates;
   stretchedDataset = coordinates * dataset;
+  lastNeighbors = std::min(neighbors, (size_t) dataset.n_cols - 1);
 
   // For each point i, we must evaluate the softmax function:
   //   p_ij = exp( -K(x_i, x_j) ) / ( sum_{k != i} ( exp( -K(x_i, x_k) )))
@@ -265,23 +319,62 @@ void SoftmaxErrorFunction<MetricType>::Precalculate(
   // order of O((n * (n + 1)) / 2), which really isn't all that great.
   p.zeros(stretchedDataset.n_cols);
   denominators.zeros(stretchedDataset.n_cols);
-  for (size_t i = 0; i < stretchedDataset.n_cols; ++i)
+  if (lastNeighbors > 0)
+  {
+    // Only the nearest neighbors of each point count, so find them; the
+    // distances are just what we need.
+    SearchNeighbors(metric);
+
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) stretchedDataset.n_cols; ++i)
+    {
+      for (size_t m = 0; m < lastNeighbors; ++m)
+      {
+        const double eval = exp(-neighborDistances(m, i));
+        denominators[i] += eval;
+        if (labels[i] == labels[neighborIndices(m, i)])
+          p[i] += eval;
+      }
+    }
+  }
+  else
   {
-    for (size_t j = (i + 1); j < stretchedDataset.n_cols; ++j)
+    neighborIndices.reset();
+    neighborDistances.reset();
+
+    // Each thread keeps its own sums, since every pair adds to two points.
+    #pragma omp parallel
     {
-      // Evaluate exp(-d(x_i, x_j)).
-      double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                         stretchedDataset.unsafe_col(j)));
+      arma::vec localP(stretchedDataset.n_cols, arma::fill::zeros);
+      arma::vec localDenominators(stretchedDataset.n_cols, arma::fill::zeros);
 
-      // Add this to the denominators of both p_i and p_j: K(i, j) = K(j, i).
-      denominators[i] += eval;
-      denominators[j] += eval;
+      #pragma omp for schedule(dynamic)
+      for (omp_size_t i = 0; i < (omp_size_t) stretchedDataset.n_cols; ++i)
+      {
+        for (size_t j = (i + 1); j < stretchedDataset.n_cols; ++j)
+        {
+          // Evaluate exp(-d(x_i, x_j)).
+          double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
+                                             stretchedDataset.unsafe_col(j)));
+
+          // Add this to the denominators of both p_i and p_j: K(i, j) =
+          // K(j, i).
+          localDenominators[i] += eval;
+          localDenominators[j] += eval;
+
+          // If i and j are the same class, add to numerator of both.
+          if (labels[i] == labels[j])
+          {
+            localP[i] += eval;
+            localP[j] += eval;
+          }
+        }
+      }
 
-      // If i and j are the same class, add to numerator of both.
-      if (labels[i] == labels[j])
+      #pragma omp critical
       {
-        p[i] += eval;
-        p[j] += eval;
+        p += localP;
+        denominators += localDenominators;
       }
     }
   }
@@ -306,6 +399,84 @@ void SoftmaxErrorFunction<MetricType>::Precalculate(
   precalculated = true;
 }
 
+template<typename MetricType>
+template<int Power, bool TakeRoot>
+void SoftmaxErrorFunction<MetricType>::SearchNeighbors(
+    const metric::LMetric<Power, TakeRoot>& /* metric */)
+{
+  // The kd-tree bounds are only valid for the rooted metric.
+  neighbor::NeighborSearch<neighbor::NearestNeighborSort,
+      metric::LMetric<Power, true>> knn(stretchedDataset,
+      neighbor::DUAL_TREE_MODE);
+  knn.Search(lastNeighbors, neighborIndices, neighborDistances);
+
+  // LMetric<INT_MAX, false> is the same as LMetric<INT_MAX, true>.
+  if (!TakeRoot && Power != INT_MAX)
+    neighborDistances = arma::pow(neighborDistances, (double) Power);
+}
+
+template<typename MetricType>
+template<typename OtherMetricType>
+void SoftmaxErrorFunction<MetricType>::SearchNeighbors(
+    const OtherMetricType& metric)
+{
+  neighborIndices.set_size(lastNeighbors, stretchedDataset.n_cols);
+  neighborDistances.set_size(lastNeighbors, stretchedDataset.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) stretchedDataset.n_cols; ++i)
+  {
+    arma::vec distances(stretchedDataset.n_cols);
+    for (size_t k = 0; k < stretchedDataset.n_cols; ++k)
+    {
+      distances[k] = metric.Evaluate(stretchedDataset.unsafe_col(i),
+                                     stretchedDataset.unsafe_col(k));
+    }
+
+    // Make sure the point itself is never one of its neighbors.
+    distances[i] = std::numeric_limits<double>::infinity();
+
+    const arma::uvec order = arma::stable_sort_index(distances);
+    for (size_t m = 0; m < lastNeighbors; ++m)
+    {
+      neighborIndices(m, i) = order[m];
+      neighborDistances(m, i) = distances[order[m]];
+    }
+  }
+}
+
+template<typename MetricType>
+void SoftmaxErrorFunction<MetricType>::SoftmaxTerms(const size_t i,
+                                                    arma::uvec& indices,
+                                                    arma::vec& evals)
+{
+  // Find the distance to every other point.
+  arma::vec distances(dataset.n_cols - 1);
+  indices.set_size(dataset.n_cols - 1);
+  for (size_t k = 0, m = 0; k < dataset.n_cols; ++k)
+  {
+    // Don't consider the case where the points are the same.
+    if (k == i)
+      continue;
+
+    distances[m] = metric.Evaluate(stretchedDataset.unsafe_col(i),
+                                   stretchedDataset.unsafe_col(k));
+    indices[m++] = k;
+  }
+
+  // If the softmax is truncated, keep only the nearest neighbors.
+  if (neighbors > 0 && neighbors < distances.n_elem)
+  {
+    const arma::uvec order = arma::sort_index(distances);
+    const arma::uvec nearest = order.head(neighbors);
+    indices = indices.elem(nearest);
+    distances = distances.elem(nearest);
+  }
+
+  // We want to evaluate exp(-D(A x_i, A x_k)).
+  evals = arma::exp(-distances);
+}
+
 } // namespace nca
 } // namespace mlpack
 
@@ -333,9 +333,10 @@ static void mlpackMain()
           << "not been provided." << endl;
     }
 
-    // Now run the search.
-    arma::Mat<size_t> neighbors;
-    arma::mat distances;
+    // Now run the search.  The results are written directly to the output
+    // parameters, so that a binding can give the memory to hold them.
+    arma::Mat<size_t>& neighbors = IO::GetParam<arma::Mat<size_t>>("neighbors");
+    arma::mat& distances = IO::GetParam<arma::mat>("distances");
 
     if (IO::HasParam("query"))
       knn->Search(std::move(queryData), k, neighbors, distances);
@@ -389,10 +390,6 @@ static void mlpackMain()
 
       Log::Info << "Recall: " << KNN::Recall(neighbors, trueNeighbors) << endl;
     }
-
-    // Save output.
-    IO::GetParam<arma::Mat<size_t>>("neighbors") = std::move(neighbors);
-    IO::GetParam<arma::mat>("distances") = std::move(distances);
   }
 
   IO::GetParam<KNNModel*>("output_model") = knn;
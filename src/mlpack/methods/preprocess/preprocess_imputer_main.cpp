@@ -178,17 +178,19 @@ static void mlpackMain()
       Log::Info << "Performing '" << strategy << "' imputation strategy "
           << "to replace '" << missingValue << "' on all dimensions." << endl;
 
+      // The statistics of all dimensions are computed in one pass, and then
+      // all dimensions are imputed at once.
       if (strategy == "mean")
       {
         Imputer<double, MapperType, MeanImputation<double>> imputer(info);
-        for (size_t i : dirtyDimensions)
-          imputer.Impute(input, missingValue, i);
+        imputer.Fit(input, missingValue, dirtyDimensions);
+        imputer.Impute(input);
       }
       else if (strategy == "median")
       {
         Imputer<double, MapperType, MedianImputation<double>> imputer(info);
-        for (size_t i : dirtyDimensions)
-          imputer.Impute(input, missingValue, i);
+        imputer.Fit(input, missingValue, dirtyDimensions);
+        imputer.Impute(input);
       }
       else if (strategy == "listwise_deletion")
       {
@@ -201,8 +203,8 @@ static void mlpackMain()
         CustomImputation<double> strat(customValue);
         Imputer<double, MapperType, CustomImputation<double>> imputer(
             info, strat);
-        for (size_t i : dirtyDimensions)
-          imputer.Impute(input, missingValue, i);
+        imputer.Fit(input, missingValue, dirtyDimensions);
+        imputer.Impute(input);
       }
       else
       {
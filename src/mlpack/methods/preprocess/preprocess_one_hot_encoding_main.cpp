@@ -14,6 +14,7 @@
 #include <mlpack/core/util/mlpack_main.hpp>
 #include <mlpack/core.hpp>
 #include <mlpack/core/data/one_hot_encoding.hpp>
+#include <mlpack/core/data/chunk_writer.hpp>
 
 // Program Name.
 BINDING_NAME("One Hot Encoding");
@@ -28,7 +29,17 @@ BINDING_LONG_DESC(
     "the IDs of the dimensions to be one-hot encoded."
     "\n\n"
     "The output matrix with encoded features may be saved with the " +
-    PRINT_PARAM_STRING("output") + " parameters.");
+    PRINT_PARAM_STRING("output") + " parameters."
+    "\n\n"
+    "Datasets that do not fit in memory can be encoded by giving the name of "
+    "the file with " + PRINT_PARAM_STRING("input_file") + " instead of " +
+    PRINT_PARAM_STRING("input") + "; the file is then read in chunks of " +
+    PRINT_PARAM_STRING("chunk_size") + " points, twice, and the encoded "
+    "points are written to " + PRINT_PARAM_STRING("output_file") + " as they "
+    "are encoded, one point per line (comma-separated if the name ends in "
+    "'.csv', tab-separated for '.tsv', and space-separated otherwise).  "
+    "Categorical (non-numeric) values in the file are mapped to numbers "
+    "first.");
 
 // Example.
 BINDING_EXAMPLE(
@@ -47,10 +58,17 @@ BINDING_SEE_ALSO("One-hot encoding on Wikipedia",
         "https://en.m.wikipedia.org/wiki/One-hot");
 
 // Define parameters for data.
-PARAM_MATRIX_IN_REQ("input", "Matrix containing data.", "i");
+PARAM_MATRIX_IN("input", "Matrix containing data.", "i");
 PARAM_MATRIX_OUT("output", "Matrix to save one-hot encoded features "
     "data to.", "o");
 
+PARAM_STRING_IN("input_file", "File containing data to encode in chunks, "
+    "instead of loading it all into memory.", "I", "");
+PARAM_STRING_IN("output_file", "File to write the encoded points to when "
+    "encoding in chunks.", "O", "");
+PARAM_INT_IN("chunk_size", "Number of points in each chunk when encoding in "
+    "chunks.", "c", 100000);
+
 PARAM_VECTOR_IN_REQ(int, "dimensions", "Index of dimensions that"
     "need to be one-hot encoded.", "d");
 
@@ -61,10 +79,64 @@ using namespace std;
 
 static void mlpackMain()
 {
-  // Load the data.
-  const arma::mat& data = IO::GetParam<arma::mat>("input");
+  RequireOnlyOnePassed({ "input", "input_file" }, true);
+
   vector<int>& indices = IO::GetParam<vector<int> >("dimensions");
   vector<size_t> copyIndices(indices.size());
+  RequireParamValue<std::vector<int>>("dimensions", [](std::vector<int> x)
+      {
+        for (int dim : x)
+        {
+          if (dim < 0)
+            return false;
+        }
+        return true;
+      }, true, "dimensions must be greater than 0");
+  for (size_t i = 0; i < indices.size(); ++i)
+  {
+    copyIndices[i] = (size_t)indices[i];
+  }
+
+  if (IO::HasParam("input_file"))
+  {
+    RequireAtLeastOnePassed({ "output_file" }, true, "the encoded points must "
+        "be written to a file when encoding in chunks");
+    RequireParamValue<int>("chunk_size", [](int x) { return x > 0; }, true,
+        "chunk size must be positive");
+
+    const string inputFile = IO::GetParam<string>("input_file");
+    const string outputFile = IO::GetParam<string>("output_file");
+    data::DatasetInfo info;
+    data::ChunkReader<double> reader(inputFile,
+        (size_t) IO::GetParam<int>("chunk_size"), info);
+
+    for (size_t dim : copyIndices)
+    {
+      if (dim >= reader.Dimensionality())
+      {
+        Log::Fatal << "Invalid value for dimensions: " << dim << " is not "
+            << "less than the number of dimensions ("
+            << reader.Dimensionality() << ")!" << endl;
+      }
+    }
+
+    data::ChunkWriter writer(outputFile);
+    size_t numPoints = 0;
+    data::OneHotEncoding(reader, arma::Col<size_t>(copyIndices),
+        [&](const arma::sp_mat& chunk)
+        {
+          writer.Write(chunk);
+          numPoints += chunk.n_cols;
+          Log::Info << "Encoded " << numPoints << " of "
+              << reader.NumPoints() << " points." << endl;
+        });
+
+    writer.Close();
+    return;
+  }
+
+  // Load the data.
+  const arma::mat& data = IO::GetParam<arma::mat>("input");
   RequireParamValue<std::vector<int>>("dimensions", [data](std::vector<int> x)
       {
         for (int dim : x)
@@ -77,10 +149,6 @@ static void mlpackMain()
         return true;
       }, true, "dimensions must be greater than 0 "
       "and less than the number of dimensions");
-  for (size_t i = 0; i < indices.size(); ++i)
-  {
-    copyIndices[i] = (size_t)indices[i];
-  }
   arma::mat output;
   data::OneHotEncoding(data, (arma::Col<size_t>)(copyIndices), output);
   if (IO::HasParam("output"))
@@ -20,6 +20,8 @@
 #include <mlpack/core/data/scaler_methods/pca_whitening.hpp>
 #include <mlpack/core/data/scaler_methods/zca_whitening.hpp>
 #include <mlpack/core/data/scaler_methods/standard_scaler.hpp>
+#include <mlpack/core/data/chunk_reader.hpp>
+#include <mlpack/core/data/chunk_writer.hpp>
 #include "mlpack/methods/preprocess/scaling_model.hpp"
 
 using namespace mlpack;
@@ -52,7 +54,15 @@ BINDING_LONG_DESC(
     "\n\n"
     "The model to scale features can be saved using " +
     PRINT_PARAM_STRING("output_model") + " and later can be loaded back using"
-    + PRINT_PARAM_STRING("input_model") + ".");
+    + PRINT_PARAM_STRING("input_model") + "."
+    "\n\n"
+    "Datasets too large to fit in memory can be scaled in chunks by giving " +
+    PRINT_PARAM_STRING("input_file") + " instead of " +
+    PRINT_PARAM_STRING("input") + ".  The scaler is then fitted with one pass "
+    "over the file, reading " + PRINT_PARAM_STRING("chunk_size") + " points "
+    "at a time, and the scaled points are written to " +
+    PRINT_PARAM_STRING("output_file") + " in a second pass.  Only one chunk is "
+    "held in memory at a time, and each chunk is scaled in place.");
 
 // Example.
 BINDING_EXAMPLE(
@@ -93,8 +103,15 @@ BINDING_SEE_ALSO("@preprocess_describe", "#preprocess_describe");
 BINDING_SEE_ALSO("@preprocess_imputer", "#preprocess_imputer");
 
 // Define parameters for data.
-PARAM_MATRIX_IN_REQ("input", "Matrix containing data.", "i");
+PARAM_MATRIX_IN("input", "Matrix containing data.", "i");
 PARAM_MATRIX_OUT("output", "Matrix to save scaled data to.", "o");
+
+PARAM_STRING_IN("input_file", "File containing data to scale in chunks, "
+    "instead of loading it all into memory.", "I", "");
+PARAM_STRING_IN("output_file", "File to write the scaled points to when "
+    "scaling in chunks.", "O", "");
+PARAM_INT_IN("chunk_size", "Number of points in each chunk when scaling in "
+    "chunks.", "c", 100000);
 PARAM_STRING_IN("scaler_method", "method to use for scaling, the "
     "default is standard_scaler.", "a", "standard_scaler");
 PARAM_DOUBLE_IN("epsilon", "regularization Parameter for pcawhitening,"
@@ -120,17 +137,27 @@ static void mlpackMain()
   else
     mlpack::math::RandomSeed((size_t) IO::GetParam<int>("seed"));
 
+  RequireOnlyOnePassed({ "input", "input_file" }, true);
+  const bool chunked = IO::HasParam("input_file");
+
   // Make sure the user specified output filenames.
-  RequireAtLeastOnePassed({ "output", "output_model"}, false,
+  RequireAtLeastOnePassed({ "output", "output_model", "output_file" }, false,
       "no output will be saved");
+  if (chunked)
+  {
+    ReportIgnoredParam({{ "input_file", true }}, "output");
+    RequireParamValue<int>("chunk_size", [](int x) { return x > 0; }, true,
+        "chunk size must be positive");
+  }
+  else
+  {
+    ReportIgnoredParam({{ "input", true }}, "output_file");
+  }
   // Check scaler method.
   RequireParamInSet<std::string>("scaler_method", { "min_max_scaler",
     "standard_scaler", "max_abs_scaler", "mean_normalization", "pca_whitening",
     "zca_whitening" }, true, "unknown scaler type");
 
-  // Load the data.
-  arma::mat& input = IO::GetParam<arma::mat>("input");
-  arma::mat output;
   ScalingModel* m;
   Timer::Start("feature_scaling");
   if (IO::HasParam("input_model"))
@@ -171,7 +198,20 @@ static void mlpackMain()
     // and clean the memory in that situation.
     try
     {
-      m->Fit(input);
+      if (chunked)
+      {
+        // Fit the scaler with one pass over the file.
+        data::DatasetInfo info;
+        data::ChunkReader<double> reader(IO::GetParam<string>("input_file"),
+            (size_t) IO::GetParam<int>("chunk_size"), info);
+        arma::mat chunk;
+        while (reader.Next(chunk))
+          m->PartialFit(chunk);
+      }
+      else
+      {
+        m->Fit(IO::GetParam<arma::mat>("input"));
+      }
     }
     catch (std::exception& e)
     {
@@ -180,17 +220,57 @@ static void mlpackMain()
     }
   }
 
+  if (IO::HasParam("inverse_scaling") && !IO::HasParam("input_model"))
+  {
+    delete m;
+    throw std::runtime_error("Please provide a saved model.");
+  }
+
+  if (chunked)
+  {
+    if (IO::HasParam("output_file"))
+    {
+      data::ChunkWriter writer(IO::GetParam<string>("output_file"));
+
+      // Scale the points with a second pass over the file.
+      data::DatasetInfo info;
+      data::ChunkReader<double> reader(IO::GetParam<string>("input_file"),
+          (size_t) IO::GetParam<int>("chunk_size"), info);
+      arma::mat chunk, output;
+      while (reader.Next(chunk))
+      {
+        if (!IO::HasParam("inverse_scaling"))
+        {
+          m->Transform(chunk);
+          writer.Write(chunk);
+        }
+        else
+        {
+          m->InverseTransform(chunk, output);
+          writer.Write(output);
+        }
+
+        Log::Info << "Scaled " << reader.Position() << " of "
+            << reader.NumPoints() << " points." << endl;
+      }
+
+      writer.Close();
+    }
+
+    Timer::Stop("feature_scaling");
+    IO::GetParam<ScalingModel*>("output_model") = m;
+    return;
+  }
+
+  // Load the data.
+  arma::mat& input = IO::GetParam<arma::mat>("input");
+  arma::mat output;
   if (!IO::HasParam("inverse_scaling"))
   {
     m->Transform(input, output);
   }
   else
   {
-    if (!IO::HasParam("input_model"))
-    {
-      delete m;
-      throw std::runtime_error("Please provide a saved model.");
-    }
     m->InverseTransform(input, output);
   }
 
@@ -144,48 +144,48 @@ static void mlpackMain()
   // Load the data.
   arma::mat& data = IO::GetParam<arma::mat>("input");
 
+  // Only the indices of the points are shuffled, and each output is selected
+  // directly from the input, so that no intermediate copies are made.
+  Timer::Start("splitting_data");
+  arma::uvec trainIndices, testIndices;
+  if (IO::HasParam("input_labels") && stratifyData)
+  {
+    const arma::Mat<size_t>& labels =
+        IO::GetParam<arma::Mat<size_t>>("input_labels");
+    data::StratifiedSplitIndices(arma::Row<size_t>(labels.row(0)),
+        trainIndices, testIndices, testRatio, !shuffleData);
+  }
+  else
+  {
+    data::SplitIndices(data.n_cols, trainIndices, testIndices, testRatio,
+        !shuffleData);
+  }
+
+  if (IO::HasParam("training"))
+    IO::GetParam<arma::mat>("training") = data.cols(trainIndices);
+  if (IO::HasParam("test"))
+    IO::GetParam<arma::mat>("test") = data.cols(testIndices);
+
   // If parameters for labels exist, we must split the labels too.
   if (IO::HasParam("input_labels"))
   {
-    arma::Mat<size_t>& labels =
+    const arma::Mat<size_t>& labels =
         IO::GetParam<arma::Mat<size_t>>("input_labels");
-    arma::Row<size_t> labelsRow = labels.row(0);
-
-    Timer::Start("splitting_data");
-    const auto value =
-        data::Split(data, labelsRow, testRatio, !shuffleData, stratifyData);
-    Timer::Stop("splitting_data");
-
-    Log::Info << "Training data contains "
-        << get<0>(value).n_cols << " points." << endl;
-    Log::Info << "Test data contains "
-        << get<1>(value).n_cols << " points." << endl;
-
-    if (IO::HasParam("training"))
-      IO::GetParam<arma::mat>("training") = std::move(get<0>(value));
-    if (IO::HasParam("test"))
-      IO::GetParam<arma::mat>("test") = std::move(get<1>(value));
     if (IO::HasParam("training_labels"))
+    {
       IO::GetParam<arma::Mat<size_t>>("training_labels") =
-          std::move(get<2>(value));
+          labels.cols(trainIndices);
+    }
     if (IO::HasParam("test_labels"))
+    {
       IO::GetParam<arma::Mat<size_t>>("test_labels") =
-          std::move(get<3>(value));
-  }
-  else // We have no labels, so just split the dataset.
-  {
-    Timer::Start("splitting_data");
-    const auto value = data::Split(data, testRatio, !shuffleData);
-    Timer::Stop("splitting_data");
-
-    Log::Info << "Training data contains " << get<0>(value).n_cols << " points."
-        << endl;
-    Log::Info << "Test data contains " << get<1>(value).n_cols << " points."
-        << endl;
-
-    if (IO::HasParam("training"))
-      IO::GetParam<arma::mat>("training") = std::move(get<0>(value));
-    if (IO::HasParam("test"))
-      IO::GetParam<arma::mat>("test") = std::move(get<1>(value));
+          labels.cols(testIndices);
+    }
   }
+  Timer::Stop("splitting_data");
+
+  Log::Info << "Training data contains " << trainIndices.n_elem << " points."
+      << endl;
+  Log::Info << "Test data contains " << testIndices.n_elem << " points."
+      << endl;
 }
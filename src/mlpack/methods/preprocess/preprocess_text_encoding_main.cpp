@@ -0,0 +1,210 @@
+/**
+ * @file methods/preprocess/preprocess_text_encoding_main.cpp
+ *
+ * A binding to encode a file of text documents as a sparse bag-of-words or
+ * tf-idf matrix.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/io.hpp>
+#include <mlpack/core/util/mlpack_main.hpp>
+#include <mlpack/core.hpp>
+#include <mlpack/core/data/input_file.hpp>
+#include <mlpack/core/data/string_encoding.hpp>
+#include <mlpack/core/data/string_encoding_policies/bag_of_words_encoding_policy.hpp>
+#include <mlpack/core/data/string_encoding_policies/tf_idf_encoding_policy.hpp>
+#include <mlpack/core/data/tokenizers/split_by_any_of.hpp>
+
+// Program Name.
+BINDING_NAME("Text Encoding");
+
+// Short description.
+BINDING_SHORT_DESC(
+    "A utility to encode text documents as a sparse bag-of-words or tf-idf "
+    "matrix.");
+
+// Long description.
+BINDING_LONG_DESC(
+    "This utility reads a text file with one document on each line, splits "
+    "the documents into tokens at the characters given with " +
+    PRINT_PARAM_STRING("delimiters") + ", and encodes each document as a "
+    "sparse vector.  With the 'bag_of_words' " + PRINT_PARAM_STRING("encoding")
+    + " the value of each token is the number of times it occurs in the "
+    "document; with the 'tf_idf' encoding it is the tf-idf statistic of the "
+    "token, whose term frequency is chosen with " +
+    PRINT_PARAM_STRING("tf_type") + " ('binary', 'raw_count', "
+    "'term_frequency' or 'sublinear_tf').  The inverse document frequency is "
+    "smoothed unless " + PRINT_PARAM_STRING("no_smooth_idf") + " is given."
+    "\n\n"
+    "Tokens are labeled in the order in which they first appear, and the "
+    "tokens may be saved in that order, one per line, with " +
+    PRINT_PARAM_STRING("vocabulary_file") + ".  If " +
+    PRINT_PARAM_STRING("hash_buckets") + " is positive, the hashing trick is "
+    "used instead: each token is labeled by its hash modulo the given number "
+    "of buckets, so that no vocabulary has to be kept in memory."
+    "\n\n"
+    "The documents are tokenized in parallel.  The encoded matrix, with one "
+    "row for each document, is saved to " + PRINT_PARAM_STRING("output_file") +
+    " in coordinate format ('.txt' or '.tsv') or in Armadillo's binary format "
+    "('.bin').  The input file may be compressed with gzip or zstd.");
+
+// Example.
+BINDING_EXAMPLE(
+    "For example, to encode the documents in 'reviews.txt' with tf-idf and "
+    "sublinear term frequencies, save the result to 'reviews_tfidf.txt', and "
+    "save the vocabulary to 'vocabulary.txt', we could run:"
+    "\n\n" +
+    PRINT_CALL("preprocess_text_encoding", "input_file", "reviews.txt",
+        "output_file", "reviews_tfidf.txt", "encoding", "tf_idf", "tf_type",
+        "sublinear_tf", "vocabulary_file", "vocabulary.txt"));
+
+// See also...
+BINDING_SEE_ALSO("@preprocess_one_hot_encoding",
+        "#preprocess_one_hot_encoding");
+BINDING_SEE_ALSO("tf-idf on Wikipedia", "https://en.wikipedia.org/wiki/Tf-idf");
+BINDING_SEE_ALSO("Feature hashing on Wikipedia",
+        "https://en.wikipedia.org/wiki/Feature_hashing");
+
+PARAM_STRING_IN_REQ("input_file", "File containing the documents, one on each "
+    "line.", "i");
+PARAM_STRING_OUT("output_file", "File to save the encoded matrix to.", "o");
+PARAM_STRING_OUT("vocabulary_file", "File to save the tokens to, in the order "
+    "of their labels.", "V");
+PARAM_STRING_IN("encoding", "Encoding to use: 'bag_of_words' or 'tf_idf'.",
+    "e", "bag_of_words");
+PARAM_STRING_IN("tf_type", "Type of the term frequency for tf-idf: 'binary', "
+    "'raw_count', 'term_frequency' or 'sublinear_tf'.", "t", "raw_count");
+PARAM_FLAG("no_smooth_idf", "Don't smooth the inverse document frequency.",
+    "S");
+PARAM_STRING_IN("delimiters", "Characters that separate tokens.", "d",
+    " \t,.;:!?\"");
+PARAM_INT_IN("hash_buckets", "If positive, use the hashing trick with this "
+    "many buckets instead of a vocabulary.", "b", 0);
+
+using namespace mlpack;
+using namespace mlpack::data;
+using namespace mlpack::util;
+using namespace std;
+
+// Encode the documents with the given encoder.
+template<typename EncoderType>
+void EncodeDocuments(EncoderType& encoder,
+                     const vector<string>& documents,
+                     arma::sp_mat& output)
+{
+  SplitByAnyOf tokenizer(IO::GetParam<string>("delimiters"));
+
+  Timer::Start("encoding");
+  encoder.Encode(documents, output, tokenizer);
+  Timer::Stop("encoding");
+
+  Log::Info << "Encoded " << documents.size() << " documents with "
+      << encoder.Dictionary().Size() << " distinct labels." << endl;
+}
+
+// Save the tokens of the given dictionary in the order of their labels.
+void SaveVocabulary(const StringEncodingDictionary<boost::string_view>& dict,
+                    const string& filename)
+{
+  ofstream stream(filename);
+  if (!stream.is_open())
+  {
+    Log::Fatal << "Cannot open file '" << filename << "' for writing."
+        << endl;
+  }
+
+  for (const string& token : dict.Tokens())
+    stream << token << '\n';
+}
+
+static void mlpackMain()
+{
+  const string encoding = IO::GetParam<string>("encoding");
+  const string tfTypeString = IO::GetParam<string>("tf_type");
+  const int hashBuckets = IO::GetParam<int>("hash_buckets");
+
+  RequireParamInSet<string>("encoding", { "bag_of_words", "tf_idf" }, true,
+      "unknown encoding");
+  RequireParamInSet<string>("tf_type", { "binary", "raw_count",
+      "term_frequency", "sublinear_tf" }, true, "unknown term frequency type");
+  RequireParamValue<int>("hash_buckets", [](int x) { return x >= 0; }, true,
+      "number of buckets must be nonnegative");
+  RequireAtLeastOnePassed({ "output_file" }, false, "no output will be saved");
+
+  if (encoding != "tf_idf")
+  {
+    ReportIgnoredParam("tf_type", "not using tf-idf encoding");
+    ReportIgnoredParam("no_smooth_idf", "not using tf-idf encoding");
+  }
+  if (hashBuckets > 0)
+    ReportIgnoredParam("vocabulary_file", "the hashing trick is used");
+
+  // Read the documents.
+  const string inputFile = IO::GetParam<string>("input_file");
+  InputFile stream(inputFile);
+  if (!stream.is_open())
+    Log::Fatal << "Cannot open file '" << inputFile << "'." << endl;
+
+  Timer::Start("loading_data");
+  vector<string> documents;
+  string line;
+  while (getline(stream, line))
+    documents.push_back(std::move(line));
+  Timer::Stop("loading_data");
+
+  using TfTypes = TfIdfEncodingPolicy::TfTypes;
+  TfTypes tfType = TfTypes::RAW_COUNT;
+  if (tfTypeString == "binary")
+    tfType = TfTypes::BINARY;
+  else if (tfTypeString == "term_frequency")
+    tfType = TfTypes::TERM_FREQUENCY;
+  else if (tfTypeString == "sublinear_tf")
+    tfType = TfTypes::SUBLINEAR_TF;
+  const TfIdfEncodingPolicy tfIdfPolicy(tfType,
+      !IO::HasParam("no_smooth_idf"));
+
+  arma::sp_mat output;
+  if (hashBuckets > 0)
+  {
+    const HashingDictionary<boost::string_view> dictionary(hashBuckets);
+    if (encoding == "bag_of_words")
+    {
+      HashingBagOfWordsEncoding<boost::string_view> encoder;
+      encoder.Dictionary() = dictionary;
+      EncodeDocuments(encoder, documents, output);
+    }
+    else
+    {
+      HashingTfIdfEncoding<boost::string_view> encoder(tfIdfPolicy);
+      encoder.Dictionary() = dictionary;
+      EncodeDocuments(encoder, documents, output);
+    }
+  }
+  else if (encoding == "bag_of_words")
+  {
+    BagOfWordsEncoding<boost::string_view> encoder;
+    EncodeDocuments(encoder, documents, output);
+    if (IO::HasParam("vocabulary_file"))
+    {
+      SaveVocabulary(encoder.Dictionary(),
+          IO::GetParam<string>("vocabulary_file"));
+    }
+  }
+  else
+  {
+    TfIdfEncoding<boost::string_view> encoder(tfIdfPolicy);
+    EncodeDocuments(encoder, documents, output);
+    if (IO::HasParam("vocabulary_file"))
+    {
+      SaveVocabulary(encoder.Dictionary(),
+          IO::GetParam<string>("vocabulary_file"));
+    }
+  }
+
+  if (IO::HasParam("output_file"))
+    data::Save(IO::GetParam<string>("output_file"), output, true);
+}
@@ -84,6 +84,14 @@ class ScalingModel
   template<typename MatType>
   void Fit(const MatType& input);
 
+  //! Transform to scale features in place, without a copy of the dataset.
+  template<typename MatType>
+  void Transform(MatType& input);
+
+  //! Fit incrementally, adding the given points to those fitted so far.
+  template<typename MatType>
+  void PartialFit(const MatType& input);
+
   // Scale back the dataset to their original values.
   template<typename MatType>
   void InverseTransform(const MatType& input, MatType& output);
@@ -204,6 +204,48 @@ void ScalingModel::Fit(const MatType& input)
   }
 }
 
+template<typename MatType>
+void ScalingModel::PartialFit(const MatType& input)
+{
+  // The scaler is only created before the first chunk.
+  if (scalerType == ScalerTypes::STANDARD_SCALER)
+  {
+    if (!standardscale)
+      standardscale = new data::StandardScaler();
+    standardscale->PartialFit(input);
+  }
+  else if (scalerType == ScalerTypes::MIN_MAX_SCALER)
+  {
+    if (!minmaxscale)
+      minmaxscale = new data::MinMaxScaler(minValue, maxValue);
+    minmaxscale->PartialFit(input);
+  }
+  else if (scalerType == ScalerTypes::MEAN_NORMALIZATION)
+  {
+    if (!meanscale)
+      meanscale = new data::MeanNormalization();
+    meanscale->PartialFit(input);
+  }
+  else if (scalerType == ScalerTypes::MAX_ABS_SCALER)
+  {
+    if (!maxabsscale)
+      maxabsscale = new data::MaxAbsScaler();
+    maxabsscale->PartialFit(input);
+  }
+  else if (scalerType == ScalerTypes::PCA_WHITENING)
+  {
+    if (!pcascale)
+      pcascale = new data::PCAWhitening(epsilon);
+    pcascale->PartialFit(input);
+  }
+  else if (scalerType == ScalerTypes::ZCA_WHITENING)
+  {
+    if (!zcascale)
+      zcascale = new data::ZCAWhitening(epsilon);
+    zcascale->PartialFit(input);
+  }
+}
+
 template<typename MatType>
 void ScalingModel::Transform(const MatType& input, MatType& output)
 {
@@ -233,6 +275,35 @@ void ScalingModel::Transform(const MatType& input, MatType& output)
   }
 }
 
+template<typename MatType>
+void ScalingModel::Transform(MatType& input)
+{
+  if (scalerType == ScalerTypes::STANDARD_SCALER)
+  {
+    standardscale->Transform(input);
+  }
+  else if (scalerType == ScalerTypes::MIN_MAX_SCALER)
+  {
+    minmaxscale->Transform(input);
+  }
+  else if (scalerType == ScalerTypes::MEAN_NORMALIZATION)
+  {
+    meanscale->Transform(input);
+  }
+  else if (scalerType == ScalerTypes::MAX_ABS_SCALER)
+  {
+    maxabsscale->Transform(input);
+  }
+  else if (scalerType == ScalerTypes::PCA_WHITENING)
+  {
+    pcascale->Transform(input);
+  }
+  else if (scalerType == ScalerTypes::ZCA_WHITENING)
+  {
+    zcascale->Transform(input);
+  }
+}
+
 template<typename MatType>
 void ScalingModel::InverseTransform(const MatType& input, MatType& output)
 {
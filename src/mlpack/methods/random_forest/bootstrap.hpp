@@ -35,9 +35,18 @@ void Bootstrap(const MatType& dataset,
   if (UseWeights)
     bootstrapWeights.set_size(weights.n_elem);
 
-  // Random sampling with replacement.
-  arma::uvec indices = arma::randi<arma::uvec>(dataset.n_cols,
-      arma::distr_param(0, dataset.n_cols - 1));
+  // Random sampling with replacement.  The indices are drawn from the
+  // generator of the active random stream (see math::RandGen()), so this is
+  // safe to call from many threads with their own streams; a size_t draw
+  // avoids the int range of math::RandInt().
+  arma::uvec indices(dataset.n_cols);
+  if (dataset.n_cols > 0)
+  {
+    std::mt19937& generator = math::RandGen();
+    std::uniform_int_distribution<size_t> distribution(0, dataset.n_cols - 1);
+    for (size_t i = 0; i < indices.n_elem; ++i)
+      indices[i] = (arma::uword) distribution(generator);
+  }
   bootstrapDataset = dataset.cols(indices);
   bootstrapLabels = labels.cols(indices);
   if (UseWeights)
@@ -338,7 +338,7 @@ void RandomForest<
   // Check edge case.
   if (trees.size() == 0)
   {
-    probabilities.clear();
+    probabilities.set_size(0);
     prediction = 0;
 
     throw std::invalid_argument("RandomForest::Classify(): no random forest "
@@ -384,7 +384,9 @@ void RandomForest<
   // Check edge case.
   if (trees.size() == 0)
   {
-    predictions.clear();
+    // Unlike clear(), set_size() leaves an output of the right size alone, so
+    // an empty output that can't be resized doesn't throw here.
+    predictions.set_size(0);
 
     throw std::invalid_argument("RandomForest::Classify(): no random forest "
         "trained!");
@@ -420,8 +422,10 @@ void RandomForest<
   // Check edge case.
   if (trees.size() == 0)
   {
-    predictions.clear();
-    probabilities.clear();
+    // Unlike clear(), set_size() leaves an output of the right size alone, so
+    // an empty output that can't be resized doesn't throw here.
+    predictions.set_size(0);
+    probabilities.set_size(probabilities.n_rows, 0);
 
     throw std::invalid_argument("RandomForest::Classify(): no random forest "
         "trained!");
@@ -504,10 +508,17 @@ double RandomForest<
   // Convert avgGain to total gain.
   double totalGain = avgGain * oldNumTrees;
 
+  // Each tree draws from its own random stream, so the forest only depends on
+  // the random seed, and not on the number of threads.
+  const size_t seed = math::RandomStreamSeed();
+
   // Train each tree individually.
   #pragma omp parallel for reduction( + : totalGain)
   for (omp_size_t i = 0; i < numTrees; ++i)
   {
+    math::RandomStream stream(seed, oldNumTrees + i);
+    math::RandomStreamScope scope(stream);
+
     MatType bootstrapDataset;
     arma::Row<size_t> bootstrapLabels;
     arma::rowvec bootstrapWeights;
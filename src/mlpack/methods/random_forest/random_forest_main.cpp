@@ -271,9 +271,11 @@ static void mlpackMain()
     arma::mat testData = std::move(IO::GetParam<arma::mat>("test"));
     Timer::Start("rf_prediction");
 
-    // Get predictions and probabilities.
-    arma::Row<size_t> predictions;
-    arma::mat probabilities;
+    // Get predictions and probabilities.  They are written directly to the
+    // output parameters, so that a binding can give the memory to hold them.
+    arma::Row<size_t>& predictions =
+        IO::GetParam<arma::Row<size_t>>("predictions");
+    arma::mat& probabilities = IO::GetParam<arma::mat>("probabilities");
     rfModel->rf.Classify(testData, predictions, probabilities);
 
     // Did we want to calculate test accuracy?
@@ -289,10 +291,6 @@ static void mlpackMain()
           << ")." << endl;
       Timer::Stop("rf_prediction");
     }
-
-    // Save the outputs.
-    IO::GetParam<arma::mat>("probabilities") = std::move(probabilities);
-    IO::GetParam<arma::Row<size_t>>("predictions") = std::move(predictions);
   }
 
   // Save the output model.
@@ -85,6 +85,13 @@ void AsyncLearning<
   for (size_t i = 0; i <= config.NumWorkers(); ++i)
     tasks.push(i);
 
+  // Each worker draws its exploration from its own random stream, since the
+  // global generator can't be shared by the threads.
+  const size_t seed = math::RandomStreamSeed();
+  std::vector<math::RandomStream> streams;
+  for (size_t i = 0; i <= config.NumWorkers(); ++i)
+    streams.push_back(math::RandomStream(seed, i));
+
   /**
    * Compute the number of threads for the for-loop. In general, we should use
    * OpenMP task rather than for-loop, here we do so to be compatible with some
@@ -96,7 +103,7 @@ void AsyncLearning<
   Log::Debug << numThreads << " threads will be used in total." << std::endl;
 
   #pragma omp parallel for shared(stop, workers, tasks, learningNetwork, \
-      targetNetwork, totalSteps, policy)
+      targetNetwork, totalSteps, policy, streams)
   for (omp_size_t i = 0; i < numThreads; ++i)
   {
     #pragma omp critical
@@ -128,6 +135,7 @@ void AsyncLearning<
 
       // Get corresponding worker.
       WorkerType& worker = workers[task];
+      math::RandomStreamScope scope(streams[task]);
       double episodeReturn;
       if (worker.Step(learningNetwork, targetNetwork, totalSteps,
           policy, episodeReturn) && !task)
@@ -35,27 +35,27 @@ SparseCoding::SparseCoding(
 
 void SparseCoding::Encode(const arma::mat& data, arma::mat& codes)
 {
-  // When using the Cholesky version of LARS, this is correct even if
-  // lambda2 > 0.
-  arma::mat matGram = trans(dictionary) * dictionary;
-
   codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
+  EncodePoints(data, [&codes](const size_t i, const arma::vec& code)
   {
-    // Report progress.
-    if ((i % 100) == 0)
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
-
-    bool useCholesky = true;
-    regression::LARS lars(useCholesky, matGram, lambda1, lambda2);
-
-    // Create an alias of the code (using the same memory), and then LARS will
-    // place the result directly into that; then we will not need to have an
-    // extra copy.
-    arma::vec code = codes.unsafe_col(i);
-    arma::rowvec responses = data.unsafe_col(i).t();
-    lars.Train(dictionary, responses, code, false);
-  }
+    codes.col(i) = code;
+  });
+}
+
+void SparseCoding::Encode(const arma::mat& data, arma::sp_mat& codes)
+{
+  // Each code goes straight into the storage of its column; then the sparse
+  // matrix is assembled in one pass.
+  std::vector<arma::uvec> rowIndices(data.n_cols);
+  std::vector<arma::vec> values(data.n_cols);
+  EncodePoints(data, [&rowIndices, &values](const size_t i,
+                                            const arma::vec& code)
+  {
+    rowIndices[i] = arma::find(code);
+    values[i] = code.elem(rowIndices[i]);
+  });
+
+  math::ColumnsToSparse(rowIndices, values, atoms, codes);
 }
 
 // Dictionary step for optimization.
@@ -137,16 +137,10 @@ double SparseCoding::OptimizeDictionary(const arma::mat& data,
   arma::mat codesXT;
   arma::mat codesZT;
 
-  if (inactiveAtoms.empty())
-  {
-    codesXT = codes * trans(data);
-    codesZT = codes * trans(codes);
-  }
-  else
-  {
-    codesXT = matActiveZ * trans(data);
-    codesZT = matActiveZ * trans(matActiveZ);
-  }
+  // These products are over all points, so they are computed in parallel.
+  const arma::mat& activeCodes = inactiveAtoms.empty() ? codes : matActiveZ;
+  math::BlockedOuterProduct(activeCodes, data, codesXT);
+  math::BlockedOuterProduct(activeCodes, activeCodes, codesZT);
 
   double normGradient = 0;
   double improvement = 0;
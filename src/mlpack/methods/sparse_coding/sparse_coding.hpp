@@ -187,13 +187,25 @@ class SparseCoding
 
   /**
    * Sparse code each point in the given dataset via LARS, using the current
-   * dictionary and store the encoded data in the codes matrix.
+   * dictionary and store the encoded data in the codes matrix.  The points are
+   * encoded in parallel with OpenMP.
    *
    * @param data Input data matrix to be encoded.
    * @param codes Output codes matrix.
    */
   void Encode(const arma::mat& data, arma::mat& codes);
 
+  /**
+   * Sparse code each point in the given dataset via LARS, using the current
+   * dictionary, and store the encoded data in the given sparse matrix.  Since
+   * most codes are zero, this takes much less memory than the dense codes
+   * when there are many atoms.
+   *
+   * @param data Input data matrix to be encoded.
+   * @param codes Output sparse codes matrix.
+   */
+  void Encode(const arma::mat& data, arma::sp_mat& codes);
+
   /**
    * Learn dictionary via Newton method based on Lagrange dual.
    *
@@ -276,6 +288,14 @@ class SparseCoding
   double objTolerance;
   //! Tolerance for Newton's method (dictionary training).
   double newtonTolerance;
+
+  /**
+   * Sparse code each point in the given dataset in parallel, and pass each
+   * code to store(i, code), where i is the index of the point.  store() may be
+   * called from several threads at once.
+   */
+  template<typename StoreFunction>
+  void EncodePoints(const arma::mat& data, StoreFunction store) const;
 };
 
 } // namespace sparse_coding
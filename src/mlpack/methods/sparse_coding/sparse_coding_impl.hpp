@@ -109,6 +109,34 @@ double SparseCoding::Train(
   return lastObjVal;
 }
 
+template<typename StoreFunction>
+void SparseCoding::EncodePoints(const arma::mat& data, StoreFunction store)
+    const
+{
+  // When using the Cholesky version of LARS, this is correct even if
+  // lambda2 > 0.  All threads share the Gram matrix.
+  const arma::mat matGram = trans(dictionary) * dictionary;
+
+  Log::Debug << "Encoding " << data.n_cols << " points." << std::endl;
+
+  #pragma omp parallel
+  {
+    // Each thread reuses one LARS object (and the memory it holds) for all of
+    // its points.
+    const bool useCholesky = true;
+    regression::LARS lars(useCholesky, matGram, lambda1, lambda2);
+    arma::vec code;
+
+    #pragma omp for schedule(dynamic, 16)
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    {
+      arma::rowvec responses = data.col(i).t();
+      lars.Train(dictionary, responses, code, false);
+      store((size_t) i, code);
+    }
+  }
+}
+
 template<typename Archive>
 void SparseCoding::serialize(Archive& ar, const uint32_t /* version */)
 {
@@ -419,6 +419,12 @@ TEST_CASE("FilterNANCVTest", "[CVTest]")
   const double result = kfoldcv.Evaluate();
   REQUIRE(!std::isnan(result));
   REQUIRE(!std::isinf(result));
+
+  // The same holds for the folds run with a budget.
+  NaiveBayesClassifier<> model;
+  const double budgetResult = kfoldcv.EvaluateWithBudget(1.0, model);
+  REQUIRE(!std::isnan(budgetResult));
+  REQUIRE(!std::isinf(budgetResult));
 }
 
 template<typename... DTArgs>
@@ -765,6 +771,138 @@ TEST_CASE("KFoldCVWithDTTestUnevenBinsWeighted", "[CVTest]")
   REQUIRE(accuracy > 0.7);
 }
 
+/**
+ * Make sure that k-fold cross-validation gives the same scores when the folds
+ * are run in parallel, that each fold is trained on all the other bins, and
+ * that the data is left in its original order.
+ */
+TEST_CASE("KFoldCVParallelTest", "[CVTest]")
+{
+  // 7 does not divide 200, so the last bin is bigger than the others.
+  const size_t k = 7;
+  arma::mat data(3, 200, arma::fill::randu);
+  arma::rowvec responses = arma::sum(data) + 0.1 *
+      arma::randn<arma::rowvec>(200);
+
+  // Compute the expected score by hand.
+  const size_t binSize = data.n_cols / k;
+  double expectedMSE = 0.0;
+  for (size_t i = 0; i < k; ++i)
+  {
+    const size_t first = binSize * i;
+    const size_t last = (i == k - 1) ? data.n_cols - 1 : first + binSize - 1;
+    arma::uvec trainingIndices;
+    if (i == 0)
+    {
+      trainingIndices = arma::regspace<arma::uvec>(last + 1, data.n_cols - 1);
+    }
+    else if (i == k - 1)
+    {
+      trainingIndices = arma::regspace<arma::uvec>(0, first - 1);
+    }
+    else
+    {
+      trainingIndices = arma::join_cols(
+          arma::regspace<arma::uvec>(0, first - 1),
+          arma::regspace<arma::uvec>(last + 1, data.n_cols - 1));
+    }
+
+    arma::mat trainingData = data.cols(trainingIndices);
+    arma::rowvec trainingResponses = responses.cols(trainingIndices);
+    LinearRegression lr(trainingData, trainingResponses);
+    arma::mat validationData = data.cols(first, last);
+    arma::rowvec validationResponses = responses.cols(first, last);
+    expectedMSE += MSE::Evaluate(lr, validationData, validationResponses) / k;
+  }
+
+  KFoldCV<LinearRegression, MSE> cv(k, data, responses, false);
+  const double serialMSE = cv.Evaluate();
+  REQUIRE(serialMSE == Approx(expectedMSE).epsilon(1e-7));
+
+  cv.Parallel() = true;
+  REQUIRE(cv.Parallel());
+  REQUIRE(cv.Evaluate() == Approx(serialMSE).epsilon(1e-7));
+  REQUIRE_NOTHROW(cv.Model());
+
+  // Running again must give the same score, so the data was not left out of
+  // order.
+  cv.Parallel() = false;
+  REQUIRE(cv.Evaluate() == Approx(serialMSE).epsilon(1e-7));
+
+  // Now check weighted learning with decision trees.
+  arma::mat dtData;
+  arma::Row<size_t> labels;
+  data::DatasetInfo datasetInfo;
+  MockCategoricalData(dtData, labels, datasetInfo);
+  arma::rowvec weights(dtData.n_cols, arma::fill::randu);
+
+  KFoldCV<DecisionTree<InformationGain>, Accuracy> dtCV(k, dtData,
+      datasetInfo, labels, 5, weights, false);
+  const double serialAccuracy = dtCV.Evaluate(5);
+  dtCV.Parallel() = true;
+  REQUIRE(dtCV.Evaluate(5) == Approx(serialAccuracy).epsilon(1e-7));
+}
+
+/**
+ * Make sure that k-fold cross-validation rejects an empty dataset.
+ */
+TEST_CASE("KFoldCVEmptyDataTest", "[CVTest]")
+{
+  arma::mat data(3, 0);
+  arma::rowvec responses;
+  arma::rowvec weights;
+
+  REQUIRE_THROWS_AS(KFoldCV<LinearRegression, MSE>(3, data, responses),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(KFoldCV<LinearRegression, MSE>(3, data, responses,
+      weights), std::invalid_argument);
+}
+
+/**
+ * Make sure that cross-validation with a budget trains on the expected subsets
+ * and that the full budget gives the usual score.
+ */
+TEST_CASE("CVEvaluateWithBudgetTest", "[CVTest]")
+{
+  arma::mat data(3, 100, arma::fill::randu);
+  arma::rowvec responses = arma::sum(data) + 0.1 *
+      arma::randn<arma::rowvec>(100);
+  LinearRegression model;
+
+  // SimpleCV trains on the first points of the training set.
+  SimpleCV<LinearRegression, MSE> simpleCV(0.2, data, responses);
+  REQUIRE(simpleCV.EvaluateWithBudget(1.0, model) ==
+      Approx(simpleCV.Evaluate()).epsilon(1e-7));
+
+  arma::mat halfData = data.cols(0, 39);
+  arma::rowvec halfResponses = responses.cols(0, 39);
+  LinearRegression halfLR(halfData, halfResponses);
+  arma::mat validationData = data.cols(80, 99);
+  arma::rowvec validationResponses = responses.cols(80, 99);
+  REQUIRE(simpleCV.EvaluateWithBudget(0.5, model) ==
+      Approx(MSE::Evaluate(halfLR, validationData, validationResponses))
+      .epsilon(1e-7));
+
+  // KFoldCV runs the first folds; the first one validates on the last bin.
+  KFoldCV<LinearRegression, MSE> kFoldCV(4, data, responses, false);
+  REQUIRE(kFoldCV.EvaluateWithBudget(1.0, model) ==
+      Approx(kFoldCV.Evaluate()).epsilon(1e-7));
+
+  arma::mat trainingData = data.cols(0, 74);
+  arma::rowvec trainingResponses = responses.cols(0, 74);
+  LinearRegression firstFoldLR(trainingData, trainingResponses);
+  validationData = data.cols(75, 99);
+  validationResponses = responses.cols(75, 99);
+  REQUIRE(kFoldCV.EvaluateWithBudget(0.25, model) ==
+      Approx(MSE::Evaluate(firstFoldLR, validationData, validationResponses))
+      .epsilon(1e-7));
+
+  REQUIRE_THROWS_AS(kFoldCV.EvaluateWithBudget(0.0, model),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(simpleCV.EvaluateWithBudget(1.5, model),
+      std::invalid_argument);
+}
+
 /**
  * Test Silhouette Score
  */
@@ -779,3 +917,74 @@ TEST_CASE("SilhouetteScoreTest", "[CVTest]")
   double silhouetteScore = SilhouetteScore::Overall(X, labels, metric);
   REQUIRE(silhouetteScore == Approx(0.1121684822489150).epsilon(1e-7));
 }
+
+/**
+ * Test that the blocked silhouette scores match the ones computed from the
+ * precomputed distances, for a dataset bigger than one block.
+ */
+TEST_CASE("SilhouetteScoreBlockedTest", "[CVTest]")
+{
+  arma::mat X(3, 1500, arma::fill::randu);
+  X.cols(500, 999) += 2.0;
+  X.cols(1000, 1499) += 4.0;
+  arma::Row<size_t> labels(1500);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    labels[i] = (i < 30) ? 7 : 2 * (i / 500);
+
+  metric::EuclideanDistance euclidean;
+  arma::rowvec expected = SilhouetteScore::SamplesScore(
+      PairwiseDistances(X, euclidean), labels);
+  arma::rowvec scores = SilhouetteScore::SamplesScore(X, labels, euclidean);
+  REQUIRE(scores.n_elem == expected.n_elem);
+  for (size_t i = 0; i < scores.n_elem; ++i)
+    REQUIRE(scores[i] == Approx(expected[i]).epsilon(1e-7).margin(1e-10));
+
+  metric::ManhattanDistance manhattan;
+  expected = SilhouetteScore::SamplesScore(PairwiseDistances(X, manhattan),
+      labels);
+  scores = SilhouetteScore::SamplesScore(X, labels, manhattan);
+  for (size_t i = 0; i < scores.n_elem; ++i)
+    REQUIRE(scores[i] == Approx(expected[i]).epsilon(1e-7).margin(1e-10));
+
+  // Scoring only some of the points should give the same scores.
+  const arma::uvec points = { 3, 600, 601, 1499 };
+  const arma::rowvec pointScores = SilhouetteScore::SamplesScore(X, labels,
+      points, manhattan);
+  for (size_t i = 0; i < points.n_elem; ++i)
+  {
+    REQUIRE(pointScores[i] ==
+        Approx(expected[points[i]]).epsilon(1e-7).margin(1e-10));
+  }
+}
+
+/**
+ * Test that the sampled silhouette score is close to the overall score.
+ */
+TEST_CASE("SilhouetteScoreSampledTest", "[CVTest]")
+{
+  arma::mat X(2, 2000, arma::fill::randu);
+  X.cols(1000, 1999) += 1.5;
+  arma::Row<size_t> labels(2000);
+  labels.head(1000).fill(0);
+  labels.tail(1000).fill(1);
+
+  metric::EuclideanDistance metric;
+  const double overall = SilhouetteScore::Overall(X, labels, metric);
+
+  double bound;
+  const double sampled = SilhouetteScore::SampledOverall(X, labels, metric,
+      400, bound, 0.9999);
+  REQUIRE(bound > 0.0);
+  REQUIRE(std::abs(sampled - overall) <= bound);
+
+  // With all the points, the score is exact.
+  const double exact = SilhouetteScore::SampledOverall(X, labels, metric,
+      2000, bound);
+  REQUIRE(bound == 0.0);
+  REQUIRE(exact == Approx(overall).epsilon(1e-10));
+
+  REQUIRE_THROWS_AS(SilhouetteScore::SampledOverall(X, labels, metric, 0,
+      bound), std::invalid_argument);
+  REQUIRE_THROWS_AS(SilhouetteScore::SampledOverall(X, labels, metric, 10,
+      bound, 1.0), std::invalid_argument);
+}
@@ -324,6 +324,110 @@ TEST_CASE("HPTTest", "[HPTTest]")
   REQUIRE(expectedObjective == Approx(objective).epsilon(1e-7));
 }
 
+/**
+ * Test ParallelGridSearch finds the same hyper-parameters and model as
+ * GridSearch.
+ */
+TEST_CASE("HPTParallelGridSearchTest", "[HPTTest]")
+{
+  arma::mat xs;
+  arma::rowvec ys;
+  double validationSize;
+  InitProneToOverfittingData(xs, ys, validationSize);
+
+  bool transposeData = true;
+  bool useCholesky = false;
+  arma::vec lambda1Set("0 0.001 0.01 0.1 1.0 10.0 100.0");
+  arma::vec lambda2Set("0.0 0.05 0.5 5.0");
+
+  double expectedLambda1, expectedLambda2, expectedObjective;
+  FindLARSBestLambdas(xs, ys, validationSize, transposeData, useCholesky,
+      lambda1Set, lambda2Set, expectedLambda1, expectedLambda2,
+      expectedObjective);
+
+  double actualLambda1, actualLambda2;
+  HyperParameterTuner<LARS, MSE, SimpleCV, ParallelGridSearch>
+      hpt(validationSize, xs, ys);
+  std::tie(actualLambda1, actualLambda2) = hpt.Optimize(Fixed(transposeData),
+      Fixed(useCholesky), lambda1Set, lambda2Set);
+
+  REQUIRE(expectedObjective == Approx(hpt.BestObjective()).epsilon(1e-7));
+  REQUIRE(expectedLambda1 == Approx(actualLambda1).epsilon(1e-7));
+  REQUIRE(expectedLambda2 == Approx(actualLambda2).epsilon(1e-7));
+
+  size_t validationFirstColumn = round(xs.n_cols * (1.0 - validationSize));
+  arma::mat validationXs = xs.cols(validationFirstColumn, xs.n_cols - 1);
+  arma::rowvec validationYs = ys.cols(validationFirstColumn, ys.n_cols - 1);
+  double objective = MSE::Evaluate(hpt.BestModel(), validationXs, validationYs);
+  REQUIRE(expectedObjective == Approx(objective).epsilon(1e-7));
+}
+
+/**
+ * Test SuccessiveHalving and Hyperband return hyper-parameters whose objective
+ * with the full budget is the one they report, and that SuccessiveHalving
+ * with the full budget from the start is a grid search.
+ */
+TEST_CASE("HPTSuccessiveHalvingTest", "[HPTTest]")
+{
+  arma::mat xs;
+  arma::rowvec ys;
+  double validationSize;
+  InitProneToOverfittingData(xs, ys, validationSize);
+
+  bool transposeData = true;
+  bool useCholesky = false;
+  arma::vec lambda1Set("0 0.001 0.01 0.1 1.0 10.0 100.0");
+  arma::vec lambda2Set("0.0 0.05 0.5 5.0");
+
+  double expectedLambda1, expectedLambda2, expectedObjective;
+  FindLARSBestLambdas(xs, ys, validationSize, transposeData, useCholesky,
+      lambda1Set, lambda2Set, expectedLambda1, expectedLambda2,
+      expectedObjective);
+
+  SimpleCV<LARS, MSE> cv(validationSize, xs, ys);
+  double actualLambda1, actualLambda2;
+
+  // With the full budget only one round is run, over the whole grid.
+  HyperParameterTuner<LARS, MSE, SimpleCV, SuccessiveHalving>
+      fullHPT(validationSize, xs, ys);
+  fullHPT.Optimizer().MinBudget() = 1.0;
+  std::tie(actualLambda1, actualLambda2) = fullHPT.Optimize(
+      Fixed(transposeData), Fixed(useCholesky), lambda1Set, lambda2Set);
+  REQUIRE(expectedObjective == Approx(fullHPT.BestObjective()).epsilon(1e-7));
+  REQUIRE(expectedLambda1 == Approx(actualLambda1).epsilon(1e-7));
+  REQUIRE(expectedLambda2 == Approx(actualLambda2).epsilon(1e-7));
+
+  // The dataset is tiny, so the smallest budget has to keep a few points.
+  HyperParameterTuner<LARS, MSE, SimpleCV, SuccessiveHalving>
+      halvingHPT(validationSize, xs, ys);
+  halvingHPT.Optimizer().Eta() = 2;
+  halvingHPT.Optimizer().MinBudget() = 0.5;
+  std::tie(actualLambda1, actualLambda2) = halvingHPT.Optimize(
+      Fixed(transposeData), Fixed(useCholesky), lambda1Set, lambda2Set);
+  double objective = cv.Evaluate(transposeData, useCholesky, actualLambda1,
+      actualLambda2);
+  REQUIRE(objective == Approx(halvingHPT.BestObjective()).epsilon(1e-7));
+  REQUIRE(objective >= expectedObjective - 1e-7);
+
+  HyperParameterTuner<LARS, MSE, SimpleCV, Hyperband>
+      hyperbandHPT(validationSize, xs, ys);
+  hyperbandHPT.Optimizer().Eta() = 2;
+  hyperbandHPT.Optimizer().MinBudget() = 0.5;
+  std::tie(actualLambda1, actualLambda2) = hyperbandHPT.Optimize(
+      Fixed(transposeData), Fixed(useCholesky), lambda1Set, lambda2Set);
+  objective = cv.Evaluate(transposeData, useCholesky, actualLambda1,
+      actualLambda2);
+  REQUIRE(objective == Approx(hyperbandHPT.BestObjective()).epsilon(1e-7));
+  REQUIRE(objective >= expectedObjective - 1e-7);
+
+  // The best model has to be the one of the returned hyper-parameters.
+  size_t validationFirstColumn = round(xs.n_cols * (1.0 - validationSize));
+  arma::mat validationXs = xs.cols(validationFirstColumn, xs.n_cols - 1);
+  arma::rowvec validationYs = ys.cols(validationFirstColumn, ys.n_cols - 1);
+  REQUIRE(MSE::Evaluate(hyperbandHPT.BestModel(), validationXs, validationYs)
+      == Approx(objective).epsilon(1e-7));
+}
+
 /**
  * Test HyperParamterTuner maximizes Accuracy rather than minimizes it.
  */
@@ -24,6 +24,7 @@
 
 #include "test_catch_tools.hpp"
 #include "catch.hpp"
+#include "serialization.hpp"
 
 using namespace mlpack;
 using namespace mlpack::data;
@@ -313,3 +314,108 @@ TEST_CASE("DatasetMapperPointerMapping", "[ImputationTest]")
   REQUIRE(dm.UnmapString(1, 0) == &b);
   REQUIRE(dm.UnmapString(2, 0) == &c);
 }
+
+/**
+ * Create a dataset with missing values (0 or NaN) in every dimension, and a
+ * DatasetMapper that maps "a" to 0 in every dimension.
+ */
+void CreateMissingDataset(arma::mat& dataset,
+                          DatasetMapper<IncrementPolicy>& info,
+                          const bool columnMajor)
+{
+  // Use an odd number of points in some dimensions and an even number in the
+  // others, to check both cases of the median.
+  dataset.randu(5, 3001);
+  dataset.row(2) *= 100.0;
+  for (size_t i = 0; i < dataset.n_elem; i += 7)
+    dataset[i] = 0.0;
+  for (size_t i = 3; i < dataset.n_elem; i += 101)
+    dataset[i] = std::numeric_limits<double>::quiet_NaN();
+  if (!columnMajor)
+    dataset = arma::mat(dataset.t());
+
+  info = DatasetMapper<IncrementPolicy>(5);
+  for (size_t d = 0; d < 5; ++d)
+    info.MapString<double>("a", d);
+}
+
+/**
+ * Check that imputing all dimensions at once with Fit() gives the same result
+ * as imputing each dimension separately.
+ */
+template<typename StrategyType>
+void CheckBatchImputation(const StrategyType& strategy, const bool columnMajor)
+{
+  arma::mat dataset;
+  DatasetMapper<IncrementPolicy> info;
+  CreateMissingDataset(dataset, info, columnMajor);
+
+  arma::mat expected(dataset);
+  Imputer<double, DatasetMapper<IncrementPolicy>, StrategyType> imputer(info,
+      strategy, columnMajor);
+  for (size_t d = 0; d < 5; ++d)
+    imputer.Impute(expected, "a", d);
+
+  imputer.Fit(dataset, "a", { 0, 1, 2, 3, 4 });
+  REQUIRE(imputer.FittedValues().n_elem == 5);
+  imputer.Impute(dataset);
+
+  CheckMatrices(dataset, expected, 1e-7);
+}
+
+/**
+ * Test imputing all dimensions at once with each strategy.
+ */
+TEST_CASE("ImputerBatchImputationTest", "[ImputationTest]")
+{
+  CheckBatchImputation(MeanImputation<double>(), true);
+  CheckBatchImputation(MeanImputation<double>(), false);
+  CheckBatchImputation(MedianImputation<double>(), true);
+  CheckBatchImputation(MedianImputation<double>(), false);
+  CheckBatchImputation(CustomImputation<double>(-3.0), true);
+  CheckBatchImputation(CustomImputation<double>(-3.0), false);
+}
+
+/**
+ * Make sure a fitted imputer can be saved, and imputes other chunks of data
+ * with the statistics of the data it was fitted on.
+ */
+TEST_CASE("ImputerSerializationTest", "[ImputationTest]")
+{
+  arma::mat dataset;
+  DatasetMapper<IncrementPolicy> info;
+  CreateMissingDataset(dataset, info, true);
+
+  using ImputerType = Imputer<double, DatasetMapper<IncrementPolicy>,
+      MedianImputation<double>>;
+  ImputerType imputer(info);
+  imputer.Fit(dataset, "a", { 1, 3 });
+
+  ImputerType newImputer((DatasetMapper<IncrementPolicy>()));
+  SerializeObject<ImputerType, cereal::BinaryInputArchive,
+      cereal::BinaryOutputArchive>(imputer, newImputer);
+  REQUIRE(arma::all(newImputer.FittedDimensions() ==
+      imputer.FittedDimensions()));
+  CheckMatrices(newImputer.FittedValues(), imputer.FittedValues());
+
+  // Only the missing values of the fitted dimensions are replaced.
+  arma::mat chunk("1 0 2;"
+                  "0 3 4;"
+                  "0 5 6;"
+                  "7 0 0;"
+                  "8 9 0;");
+  chunk(3, 2) = std::numeric_limits<double>::quiet_NaN();
+  newImputer.Impute(chunk);
+
+  const arma::vec& values = imputer.FittedValues();
+  REQUIRE(chunk(0, 1) == 0.0);
+  REQUIRE(chunk(1, 0) == values[0]);
+  REQUIRE(chunk(2, 0) == 0.0);
+  REQUIRE(chunk(3, 1) == values[1]);
+  REQUIRE(chunk(3, 2) == values[1]);
+  REQUIRE(chunk(4, 2) == 0.0);
+
+  // The chunk must have all the fitted dimensions.
+  arma::mat smallChunk(3, 4, arma::fill::zeros);
+  REQUIRE_THROWS_AS(newImputer.Impute(smallChunk), std::invalid_argument);
+}
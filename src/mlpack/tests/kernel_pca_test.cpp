@@ -12,6 +12,7 @@
 #include <mlpack/core.hpp>
 #include <mlpack/core/kernels/gaussian_kernel.hpp>
 #include <mlpack/methods/kernel_pca/kernel_rules/nystroem_method.hpp>
+#include <mlpack/methods/kernel_pca/kernel_rules/randomized_method.hpp>
 #include <mlpack/methods/kernel_pca/kernel_pca.hpp>
 
 #include "catch.hpp"
@@ -147,3 +148,49 @@ TEST_CASE("CircleTransformationTestNystroem", "[KernelPCATest]")
   REQUIRE(ranges[0].Contains(ranges[2]) == false);
   REQUIRE(ranges[1].Contains(ranges[2]) == false);
 }
+
+/**
+ * Make sure that the randomized eigensolver finds the same leading eigenvalues
+ * and the same transformation (up to sign) as the naive method.
+ */
+TEST_CASE("RandomizedMatchesNaiveTest", "[KernelPCATest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(3, 400);
+
+  KernelPCA<GaussianKernel> naive;
+  arma::mat naiveData, naiveEigvec;
+  arma::vec naiveEigval;
+  naive.Apply(dataset, naiveData, naiveEigval, naiveEigvec, 3);
+
+  KernelPCA<GaussianKernel, RandomizedKernelRule<GaussianKernel> > randomized;
+  arma::mat randomizedData, randomizedEigvec;
+  arma::vec randomizedEigval;
+  randomized.Apply(dataset, randomizedData, randomizedEigval, randomizedEigvec,
+      3);
+
+  // Only the requested dimensions are computed.
+  REQUIRE(randomizedEigval.n_elem == 3);
+  REQUIRE(randomizedEigvec.n_rows == 400);
+  REQUIRE(randomizedEigvec.n_cols == 3);
+  REQUIRE(randomizedData.n_rows == 3);
+  REQUIRE(randomizedData.n_cols == 400);
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    REQUIRE(randomizedEigval[i] == Approx(naiveEigval[i]).epsilon(1e-5));
+
+    // The sign of each dimension is arbitrary.
+    const double sign = (arma::dot(randomizedData.row(i),
+        naiveData.row(i)) < 0.0) ? -1.0 : 1.0;
+    for (size_t j = 0; j < 400; ++j)
+    {
+      REQUIRE(sign * randomizedData(i, j) ==
+          Approx(naiveData(i, j)).epsilon(1e-3).margin(1e-4));
+    }
+  }
+
+  // Reducing the dimensionality of the data in place works too.
+  randomized.Apply(dataset, 2);
+  REQUIRE(dataset.n_rows == 2);
+  REQUIRE(dataset.n_cols == 400);
+}
@@ -20,6 +20,8 @@
 #include <mlpack/core/kernels/spherical_kernel.hpp>
 #include <mlpack/core/kernels/pspectrum_string_kernel.hpp>
 #include <mlpack/core/kernels/cauchy_kernel.hpp>
+#include <mlpack/core/kernels/triangular_kernel.hpp>
+#include <mlpack/core/kernels/kernel_matrix.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/metrics/mahalanobis_distance.hpp>
 
@@ -632,3 +634,130 @@ TEST_CASE("CauchyKernelTest", "[KernelTest]")
   REQUIRE(ck.Evaluate(a, b) == Approx(0.92592588).epsilon(1e-7));
   REQUIRE(ck.Evaluate(b, a) == Approx(0.92592588).epsilon(1e-7));
 }
+
+/**
+ * Make sure that the batch Evaluate() of a kernel gives the same values as
+ * evaluating each pair of points on its own.
+ */
+template<typename KernelType>
+void CheckKernelMatrix(KernelType& kernel)
+{
+  arma::mat a = arma::randu<arma::mat>(5, 30);
+  arma::mat b = arma::randu<arma::mat>(5, 20);
+  // Include identical points and a zero vector.
+  b.col(0) = a.col(3);
+  b.col(1).zeros();
+
+  arma::mat k;
+  KernelMatrix(kernel, a, b, k);
+  REQUIRE(k.n_rows == a.n_cols);
+  REQUIRE(k.n_cols == b.n_cols);
+  for (size_t i = 0; i < a.n_cols; ++i)
+  {
+    for (size_t j = 0; j < b.n_cols; ++j)
+    {
+      REQUIRE(k(i, j) == Approx(kernel.Evaluate(a.col(i), b.col(j))).
+          epsilon(1e-5).margin(1e-6));
+    }
+  }
+
+  // Subviews work too.
+  arma::mat subK;
+  KernelMatrix(kernel, a.cols(5, 9), b, subK);
+  CheckMatrices(subK, k.rows(5, 9));
+}
+
+TEST_CASE("KernelMatrixTest", "[KernelTest]")
+{
+  GaussianKernel gk(0.8);
+  CheckKernelMatrix(gk);
+  LaplacianKernel lk(0.8);
+  CheckKernelMatrix(lk);
+  EpanechnikovKernel ek(1.5);
+  CheckKernelMatrix(ek);
+  CauchyKernel ck(0.8);
+  CheckKernelMatrix(ck);
+  TriangularKernel tk(2.0);
+  CheckKernelMatrix(tk);
+  LinearKernel lin;
+  CheckKernelMatrix(lin);
+  PolynomialKernel pk(3.0, 1.0);
+  CheckKernelMatrix(pk);
+  HyperbolicTangentKernel hk(0.5, 1.0);
+  CheckKernelMatrix(hk);
+  CosineDistance cd;
+  CheckKernelMatrix(cd);
+  // The spherical kernel is a step function, so points near the boundary could
+  // land on either side; use a bandwidth that no pair comes close to.
+  SphericalKernel sk(5.0);
+  CheckKernelMatrix(sk);
+}
+
+/**
+ * A kernel with a KernelTraits specialization that does not define
+ * HasBatchEvaluate, as one written before it existed would.
+ */
+class OldTraitsKernel
+{
+ public:
+  template<typename VecTypeA, typename VecTypeB>
+  double Evaluate(const VecTypeA& a, const VecTypeB& b) const
+  {
+    return arma::dot(a, b) + 1.0;
+  }
+};
+
+namespace mlpack {
+namespace kernel {
+
+template<>
+class KernelTraits<OldTraitsKernel>
+{
+ public:
+  static const bool IsNormalized = false;
+  static const bool UsesSquaredDistance = false;
+};
+
+} // namespace kernel
+} // namespace mlpack
+
+/**
+ * Make sure that a kernel whose KernelTraits specialization doesn't define
+ * HasBatchEvaluate falls back to evaluating one pair at a time.
+ */
+TEST_CASE("KernelMatrixOldTraitsTest", "[KernelTest]")
+{
+  REQUIRE(!KernelHasBatchEvaluate<OldTraitsKernel>::value);
+  REQUIRE(KernelHasBatchEvaluate<GaussianKernel>::value);
+
+  OldTraitsKernel kernel;
+  CheckKernelMatrix(kernel);
+}
+
+/**
+ * Make sure that tiled, symmetric, and implicit kernel matrix computations give
+ * the same results as computing the whole kernel matrix at once, including
+ * when the number of points is not a multiple of the tile size.
+ */
+TEST_CASE("TiledKernelMatrixTest", "[KernelTest]")
+{
+  arma::mat a = arma::randu<arma::mat>(4, 53);
+  arma::mat b = arma::randu<arma::mat>(4, 31);
+  GaussianKernel gk(0.5);
+
+  arma::mat k, tiled;
+  KernelMatrix(gk, a, b, k);
+  TiledKernelMatrix(gk, a, b, tiled, 7);
+  CheckMatrices(tiled, k);
+
+  arma::mat symmetric;
+  KernelMatrix(gk, a, a, k);
+  SymmetricKernelMatrix(gk, a, symmetric, 7);
+  CheckMatrices(symmetric, k);
+  REQUIRE(arma::approx_equal(symmetric, symmetric.t(), "absdiff", 0.0));
+
+  arma::mat x = arma::randu<arma::mat>(53, 3);
+  arma::mat y;
+  KernelMatrixProduct(gk, a, x, y, 7);
+  CheckMatrices(y, k * x);
+}
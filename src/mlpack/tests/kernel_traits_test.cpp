@@ -54,4 +54,12 @@ TEST_CASE("IsNormalizedTest", "[KernelTraitsTest]")
   REQUIRE((bool) KernelTraits<LinearKernel>::IsNormalized == false);
   REQUIRE((bool) KernelTraits<PolynomialKernel>::IsNormalized == false);
   REQUIRE((bool) KernelTraits<PSpectrumStringKernel>::IsNormalized == false);
+
+  // Kernels with a batch Evaluate().
+  REQUIRE((bool) KernelTraits<GaussianKernel>::HasBatchEvaluate == true);
+  REQUIRE((bool) KernelTraits<LinearKernel>::HasBatchEvaluate == true);
+  REQUIRE((bool) KernelTraits<CosineDistance>::HasBatchEvaluate == true);
+  REQUIRE((bool) KernelTraits<PSpectrumStringKernel>::HasBatchEvaluate ==
+      false);
+  REQUIRE((bool) KernelTraits<int>::HasBatchEvaluate == false);
 }
@@ -266,3 +266,51 @@ TEST_CASE("TestSymKronId", "[LinAlgTest]")
       REQUIRE(lhs(j) == Approx(rhs(j)).epsilon(1e-7));
   }
 }
+
+/**
+ * Make sure that BlockedOuterProduct() gives the same result as a plain matrix
+ * product, including when the last block is partial.
+ */
+TEST_CASE("TestBlockedOuterProduct", "[LinAlgTest]")
+{
+  const arma::mat a = arma::randu<arma::mat>(6, 53);
+  const arma::mat b = arma::randu<arma::mat>(4, 53);
+
+  arma::mat ab, aa;
+  BlockedOuterProduct(a, b, ab, 7);
+  BlockedOuterProduct(a, a, aa, 100);
+
+  CheckMatrices(ab, a * b.t());
+  CheckMatrices(aa, a * a.t());
+}
+
+/**
+ * Make sure that ColumnsToSparse() puts every element in the right place,
+ * including in empty columns.
+ */
+TEST_CASE("TestColumnsToSparse", "[LinAlgTest]")
+{
+  arma::mat dense(8, 6, arma::fill::zeros);
+  dense(1, 0) = 1.0;
+  dense(5, 0) = -2.0;
+  dense(7, 2) = 3.0;
+  dense(0, 3) = 4.0;
+  dense(2, 3) = 5.0;
+  dense(3, 3) = -6.0;
+
+  std::vector<arma::uvec> rowIndices(dense.n_cols);
+  std::vector<arma::vec> values(dense.n_cols);
+  for (size_t i = 0; i < dense.n_cols; ++i)
+  {
+    rowIndices[i] = arma::find(dense.col(i));
+    values[i] = dense.col(i).eval().elem(rowIndices[i]);
+  }
+
+  arma::sp_mat sparse;
+  ColumnsToSparse(rowIndices, values, dense.n_rows, sparse);
+
+  REQUIRE(sparse.n_rows == dense.n_rows);
+  REQUIRE(sparse.n_cols == dense.n_cols);
+  REQUIRE(sparse.n_nonzero == 6);
+  CheckMatrices(arma::mat(sparse), dense);
+}
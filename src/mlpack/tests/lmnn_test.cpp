@@ -193,6 +193,43 @@ TEST_CASE("LMNNInitialEvaluateWithGradientTest", "[LMNNTest]")
   REQUIRE(gradient(1, 1) == Approx(12.0).epsilon(1e-7));
 }
 
+/**
+ * Ensure that impostors kept up to date incrementally while the transformation
+ * changes give the same objective and gradient as impostors calculated from
+ * scratch.
+ */
+TEST_CASE("LMNNIncrementalImpostorsTest", "[LMNNTest]")
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  if (!data::Load("iris.csv", dataset))
+    FAIL("Cannot load dataset iris.csv");
+  if (!data::Load("iris_labels.txt", labels))
+    FAIL("Cannot load dataset iris_labels.txt");
+
+  LMNNFunction<> lmnnfn(dataset, labels, 1, 0.6, 1);
+
+  // Take a number of small steps away from the identity.
+  arma::mat direction(dataset.n_rows, dataset.n_rows, arma::fill::randn);
+  arma::mat coordinates, gradient;
+  double objective = 0.0;
+  for (size_t i = 0; i <= 20; ++i)
+  {
+    coordinates = arma::eye<arma::mat>(dataset.n_rows, dataset.n_rows) +
+        0.002 * i * direction;
+    objective = lmnnfn.EvaluateWithGradient(coordinates, gradient);
+  }
+
+  // A new function calculates all impostors on its first evaluation.
+  LMNNFunction<> freshfn(dataset, labels, 1, 0.6, 1);
+  arma::mat freshGradient;
+  const double freshObjective = freshfn.EvaluateWithGradient(coordinates,
+      freshGradient);
+
+  REQUIRE(objective == Approx(freshObjective).epsilon(1e-7));
+  CheckMatrices(gradient, freshGradient, 1e-5);
+}
+
 /**
  * Ensure the separable objective function is right.
  */
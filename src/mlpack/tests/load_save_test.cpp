@@ -13,10 +13,18 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/core/data/load_arff.hpp>
+#include <mlpack/core/data/chunk_reader.hpp>
+#include <mlpack/core/data/chunk_writer.hpp>
 #include <mlpack/core/data/map_policies/missing_policy.hpp>
+#include <mlpack/core/data/map_policies/concurrent_increment_policy.hpp>
+#include <mlpack/methods/linear_regression/linear_regression.hpp>
 #include "catch.hpp"
 #include "test_catch_tools.hpp"
 
+#ifdef HAS_ZLIB
+  #include <zlib.h>
+#endif
+
 using namespace mlpack;
 using namespace mlpack::data;
 using namespace std;
@@ -2504,3 +2512,1019 @@ TEST_CASE("LoadCSVHeaderTest", "[LoadSaveTest]")
   REQUIRE(dataset.n_rows == 4);
   REQUIRE(dataset.n_cols == 2);
 }
+
+/**
+ * Make sure that a CSV large enough to be split into several chunks by the
+ * parallel parser loads correctly, and that categorical values are mapped in
+ * the order they appear in the file.
+ */
+TEST_CASE("LargeCategoricalCSVLoadTest", "[LoadSaveTest]")
+{
+  const size_t points = 200000;
+  const char* categories[] = { "red", "green", "blue", "yellow" };
+
+  fstream f;
+  f.open("test.csv", fstream::out);
+  for (size_t i = 0; i < points; ++i)
+  {
+    f << i << ", " << (0.5 * i) << ", " << categories[(i / 3) % 4] << ", "
+        << (i % 7) << endl;
+  }
+  f.close();
+
+  arma::mat dataset;
+  data::DatasetInfo info;
+  REQUIRE(data::Load("test.csv", dataset, info, false, true));
+
+  REQUIRE(dataset.n_rows == 4);
+  REQUIRE(dataset.n_cols == points);
+
+  REQUIRE(info.Type(0) == Datatype::numeric);
+  REQUIRE(info.Type(1) == Datatype::numeric);
+  REQUIRE(info.Type(2) == Datatype::categorical);
+  REQUIRE(info.Type(3) == Datatype::numeric);
+  REQUIRE(info.NumMappings(2) == 4);
+
+  for (size_t i = 0; i < points; ++i)
+  {
+    REQUIRE(dataset(0, i) == (double) i);
+    REQUIRE(dataset(1, i) == 0.5 * i);
+    REQUIRE(dataset(2, i) == (double) ((i / 3) % 4));
+    REQUIRE(dataset(3, i) == (double) (i % 7));
+  }
+
+  for (size_t c = 0; c < 4; ++c)
+    REQUIRE(info.UnmapString(c, 2) == categories[c]);
+
+  // Now make sure that a malformed line anywhere in the file is caught.
+  f.open("test.csv", fstream::out | fstream::app);
+  f << "1, 2, red" << endl;
+  f.close();
+
+  data::DatasetInfo info2;
+  REQUIRE(!data::Load("test.csv", dataset, info2, false, true));
+
+  remove("test.csv");
+}
+
+/**
+ * Make sure that a matrix saved as .mlbin is loaded correctly, with and without
+ * conversion.
+ */
+TEST_CASE("BinaryMatrixLoadSaveTest", "[LoadSaveTest]")
+{
+  arma::mat test = arma::randu<arma::mat>(13, 1000);
+  REQUIRE(data::Save("test.mlbin", test, true));
+
+  arma::mat loaded;
+  REQUIRE(data::Load("test.mlbin", loaded, true));
+  REQUIRE(loaded.n_rows == test.n_rows);
+  REQUIRE(loaded.n_cols == test.n_cols);
+  for (size_t i = 0; i < test.n_elem; ++i)
+    REQUIRE(loaded[i] == test[i]);
+
+  // The matrix owns its memory, so it can be resized.
+  loaded.set_size(3, 3);
+  loaded.zeros();
+
+  // A different element type gives a converted copy.
+  arma::fmat floatLoaded;
+  REQUIRE(data::Load("test.mlbin", floatLoaded, true));
+  REQUIRE(floatLoaded.n_rows == test.n_rows);
+  REQUIRE(floatLoaded.n_cols == test.n_cols);
+  for (size_t i = 0; i < test.n_elem; ++i)
+    REQUIRE(floatLoaded[i] == Approx((float) test[i]).epsilon(1e-7));
+
+  // Without transposition, we get a copy too.
+  arma::mat transLoaded;
+  REQUIRE(data::Load("test.mlbin", transLoaded, true, false));
+  REQUIRE(transLoaded.n_rows == test.n_cols);
+  REQUIRE(transLoaded.n_cols == test.n_rows);
+  for (size_t i = 0; i < test.n_rows; ++i)
+    for (size_t j = 0; j < test.n_cols; ++j)
+      REQUIRE(transLoaded(j, i) == test(i, j));
+
+  // Saving without transposition writes the transpose, block by block.
+  REQUIRE(data::Save("test.mlbin", test, true, false));
+  REQUIRE(data::Load("test.mlbin", loaded, true));
+  REQUIRE(loaded.n_rows == test.n_cols);
+  REQUIRE(loaded.n_cols == test.n_rows);
+  for (size_t i = 0; i < test.n_rows; ++i)
+    for (size_t j = 0; j < test.n_cols; ++j)
+      REQUIRE(loaded(j, i) == test(i, j));
+
+  remove("test.mlbin");
+}
+
+// A model with matrices large enough to get sections of their own in a bulk
+// model file, and some that are small enough to be stored inline.
+class BulkTest
+{
+ public:
+  BulkTest() : inner(1, 2) { }
+
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar(CEREAL_NVP(large));
+    ar(CEREAL_NVP(labels));
+    ar(CEREAL_NVP(small));
+    ar(CEREAL_NVP(inner));
+  }
+
+  // Public members for testing.
+  arma::mat large;
+  arma::Row<size_t> labels;
+  arma::vec small;
+  Test inner;
+};
+
+/**
+ * Make sure that a model saved as .mlpk or .mlpkz is recovered.
+ */
+TEST_CASE("BulkModelLoadSaveTest", "[LoadSaveTest]")
+{
+  BulkTest x;
+  x.large = arma::randu<arma::mat>(20, 1000);
+  // A pattern that compresses well.
+  x.labels = arma::conv_to<arma::Row<size_t>>::from(
+      arma::regspace<arma::uvec>(0, 9999) / 100);
+  x.small = arma::randu<arma::vec>(5);
+  x.inner.x = 10;
+  x.inner.ina.s = "bulk";
+
+  const std::string filenames[] = { "test.mlpk", "test.mlpkz" };
+  for (size_t f = 0; f < 2; ++f)
+  {
+    REQUIRE(data::Save(filenames[f], "x", x, true));
+
+    BulkTest y;
+    y.small = arma::randu<arma::vec>(10);
+    REQUIRE(data::Load(filenames[f], "x", y, true));
+
+    REQUIRE(y.large.n_rows == x.large.n_rows);
+    REQUIRE(y.large.n_cols == x.large.n_cols);
+    for (size_t i = 0; i < x.large.n_elem; ++i)
+      REQUIRE(y.large[i] == x.large[i]);
+    REQUIRE(y.labels.n_elem == x.labels.n_elem);
+    REQUIRE(y.labels.n_rows == 1);
+    for (size_t i = 0; i < x.labels.n_elem; ++i)
+      REQUIRE(y.labels[i] == x.labels[i]);
+    REQUIRE(y.small.n_elem == x.small.n_elem);
+    for (size_t i = 0; i < x.small.n_elem; ++i)
+      REQUIRE(y.small[i] == x.small[i]);
+    REQUIRE(y.inner.x == 10);
+    REQUIRE(y.inner.ina.s == "bulk");
+
+    // The matrices can be modified and resized without touching the file.
+    y.large.zeros();
+    y.labels.set_size(3);
+    BulkTest z;
+    REQUIRE(data::Load(filenames[f], "x", z, true));
+    REQUIRE(z.large[0] == x.large[0]);
+    REQUIRE(z.labels.n_elem == x.labels.n_elem);
+
+    remove(filenames[f].c_str());
+  }
+
+  // A file that is not a bulk model file can't be loaded.
+  std::fstream f;
+  f.open("test.mlpk", std::fstream::out);
+  f << "not a model" << std::endl;
+  f.close();
+
+  BulkTest y;
+  REQUIRE(!data::Load("test.mlpk", "x", y, false));
+
+  remove("test.mlpk");
+}
+
+/**
+ * Make sure that a MappedMatrix aliases the mapping of a .mlbin file, that it
+ * can be moved, and that copies of its matrix don't point into the mapping.
+ */
+TEST_CASE("BinaryMatrixMappedMatrixTest", "[LoadSaveTest]")
+{
+  arma::mat test = arma::randu<arma::mat>(13, 1000);
+  REQUIRE(data::Save("test.mlbin", test, true));
+
+  arma::mat copy;
+  {
+    data::DatasetInfo info;
+    data::MappedMatrix<double> mapped("test.mlbin", &info);
+    REQUIRE(mapped.IsMapped());
+    REQUIRE(info.Dimensionality() == test.n_rows);
+    REQUIRE(mapped.Matrix().n_rows == test.n_rows);
+    REQUIRE(mapped.Matrix().n_cols == test.n_cols);
+    for (size_t i = 0; i < test.n_elem; ++i)
+      REQUIRE(mapped.Matrix()[i] == test[i]);
+
+    // Moving the MappedMatrix keeps the matrix where it is.
+    const double* address = mapped.Matrix().memptr();
+    data::MappedMatrix<double> moved(std::move(mapped));
+    REQUIRE(moved.IsMapped());
+    REQUIRE(moved.Matrix().memptr() == address);
+    REQUIRE(!mapped.IsMapped());
+    REQUIRE(mapped.Matrix().n_elem == 0);
+
+    // Moving the matrix itself out makes a copy.
+    copy = std::move(moved.Matrix());
+    REQUIRE(copy.memptr() != address);
+    REQUIRE(moved.Matrix().memptr() == address);
+
+    // Modifying the matrix must not touch the file.
+    moved.Matrix().zeros();
+  }
+
+  // The copy outlives the mapping.
+  for (size_t i = 0; i < test.n_elem; ++i)
+    REQUIRE(copy[i] == test[i]);
+
+  data::MappedMatrix<double> reloaded("test.mlbin");
+  for (size_t i = 0; i < test.n_elem; ++i)
+    REQUIRE(reloaded.Matrix()[i] == test[i]);
+
+  // A different element type can't be mapped, so it is converted.
+  data::MappedMatrix<float> converted("test.mlbin");
+  REQUIRE(!converted.IsMapped());
+  for (size_t i = 0; i < test.n_elem; ++i)
+    REQUIRE(converted.Matrix()[i] == Approx((float) test[i]).epsilon(1e-7));
+
+  remove("test.mlbin");
+}
+
+/**
+ * Make sure that a .mlbin file whose size in the header overflows is rejected.
+ */
+TEST_CASE("BinaryMatrixOverflowTest", "[LoadSaveTest]")
+{
+  arma::mat test = arma::randu<arma::mat>(2, 4);
+  REQUIRE(data::Save("test.mlbin", test, true));
+
+  // (2^61 + 1) * 8 wraps around to 8, the number of elements in the file.
+  data::BinaryMatrixHeader header;
+  std::fstream f("test.mlbin", std::ios::in | std::ios::out |
+      std::ios::binary);
+  f.read(reinterpret_cast<char*>(&header), sizeof(header));
+  header.nRows = (((uint64_t) 1) << 61) + 1;
+  header.nCols = 8;
+  f.seekp(0);
+  f.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  f.close();
+
+  arma::mat loaded;
+  REQUIRE(!data::Load("test.mlbin", loaded, false));
+
+  remove("test.mlbin");
+}
+
+/**
+ * Make sure that a bulk model loaded in read-only mode aliases the mapping of
+ * the file, which is owned by the caller, and that copies of the model don't.
+ */
+TEST_CASE("BulkModelReadOnlyTest", "[LoadSaveTest]")
+{
+  BulkTest x;
+  x.large = arma::randu<arma::mat>(20, 1000);
+  x.labels = arma::randi<arma::Row<size_t>>(10000, arma::distr_param(0, 9));
+  x.small = arma::randu<arma::vec>(5);
+  REQUIRE(data::Save("test.mlpk", "x", x, true));
+
+  BulkTest copy;
+  {
+    std::unique_ptr<data::MappedFile> mapping;
+    BulkTest y;
+    data::LoadBulkModel("test.mlpk", "x", y, mapping);
+    REQUIRE(mapping.get() != NULL);
+
+    // Only large matrices are aliased.
+    const char* begin = mapping->Data();
+    const char* end = begin + mapping->Size();
+    const char* large = reinterpret_cast<const char*>(y.large.memptr());
+    const char* labels = reinterpret_cast<const char*>(y.labels.memptr());
+    const char* small = reinterpret_cast<const char*>(y.small.memptr());
+    REQUIRE(large >= begin);
+    REQUIRE(large < end);
+    REQUIRE(labels >= begin);
+    REQUIRE(labels < end);
+    REQUIRE((small < begin || small >= end));
+
+    // Copying or moving the model copies the aliased matrices.
+    copy = y;
+    BulkTest moved(std::move(y));
+    REQUIRE(reinterpret_cast<const char*>(copy.large.memptr()) != large);
+    REQUIRE(reinterpret_cast<const char*>(moved.large.memptr()) != large);
+  }
+
+  // The copy outlives the mapping.
+  for (size_t i = 0; i < x.large.n_elem; ++i)
+    REQUIRE(copy.large[i] == x.large[i]);
+  for (size_t i = 0; i < x.labels.n_elem; ++i)
+    REQUIRE(copy.labels[i] == x.labels[i]);
+
+  remove("test.mlpk");
+}
+
+/**
+ * Make sure that a real model loaded from a bulk model file can be moved,
+ * retrained and destroyed.
+ */
+TEST_CASE("BulkModelRetrainTest", "[LoadSaveTest]")
+{
+  arma::mat predictors = arma::randu<arma::mat>(600, 1000);
+  arma::rowvec responses = arma::randu<arma::rowvec>(1000);
+  regression::LinearRegression lr(predictors, responses);
+  REQUIRE(lr.Parameters().n_elem * sizeof(double) >=
+      data::BulkModelSectionThreshold);
+  REQUIRE(data::Save("test.mlpk", "lr", lr, true));
+
+  {
+    regression::LinearRegression loaded;
+    REQUIRE(data::Load("test.mlpk", "lr", loaded, true));
+    CheckMatrices(loaded.Parameters(), lr.Parameters());
+
+    // Retraining with a different dimensionality resizes the parameters.
+    regression::LinearRegression moved(std::move(loaded));
+    CheckMatrices(moved.Parameters(), lr.Parameters());
+    moved.Train(predictors.rows(0, 9), responses);
+    REQUIRE(moved.Parameters().n_elem == 11);
+  }
+
+  remove("test.mlpk");
+}
+
+/**
+ * Make sure that a DatasetInfo saved with a .mlbin file is recovered.
+ */
+TEST_CASE("BinaryMatrixDatasetInfoTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test.csv", fstream::out);
+  f << "1, 2, hello" << endl;
+  f << "3, 4, goodbye" << endl;
+  f << "5, 6, coffee" << endl;
+  f << "7, 8, confusion" << endl;
+  f << "9, 10, hello" << endl;
+  f.close();
+
+  arma::mat dataset;
+  data::DatasetInfo info;
+  REQUIRE(data::Load("test.csv", dataset, info, true));
+  REQUIRE(data::Save("test.mlbin", dataset, info, true));
+
+  arma::mat loaded;
+  data::DatasetInfo loadedInfo;
+  REQUIRE(data::Load("test.mlbin", loaded, loadedInfo, true));
+
+  REQUIRE(loaded.n_rows == dataset.n_rows);
+  REQUIRE(loaded.n_cols == dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_elem; ++i)
+    REQUIRE(loaded[i] == dataset[i]);
+
+  REQUIRE(loadedInfo.Dimensionality() == 3);
+  REQUIRE(loadedInfo.Type(0) == Datatype::numeric);
+  REQUIRE(loadedInfo.Type(1) == Datatype::numeric);
+  REQUIRE(loadedInfo.Type(2) == Datatype::categorical);
+  REQUIRE(loadedInfo.NumMappings(2) == 4);
+  REQUIRE(loadedInfo.UnmapString(1, 2) == "goodbye");
+
+  // A file saved without a DatasetInfo gives numeric dimensions.
+  REQUIRE(data::Save("test.mlbin", dataset, true));
+  data::DatasetInfo plainInfo;
+  REQUIRE(data::Load("test.mlbin", loaded, plainInfo, true));
+  REQUIRE(plainInfo.Dimensionality() == 3);
+  REQUIRE(plainInfo.Type(2) == Datatype::numeric);
+
+  remove("test.csv");
+  remove("test.mlbin");
+}
+
+/**
+ * Make sure that reading a CSV in chunks gives the same matrix and mappings as
+ * loading it all at once, on every pass, with and without read-ahead.
+ */
+TEST_CASE("ChunkReaderCSVTest", "[LoadSaveTest]")
+{
+  const char* categories[] = { "red", "green", "blue" };
+
+  fstream f;
+  f.open("test.csv", fstream::out);
+  for (size_t i = 0; i < 100; ++i)
+    f << i << ", " << categories[(i / 5) % 3] << ", " << (0.25 * i) << endl;
+  f.close();
+
+  arma::mat dataset;
+  data::DatasetInfo info;
+  REQUIRE(data::Load("test.csv", dataset, info, true));
+
+  for (size_t readAhead = 0; readAhead < 2; ++readAhead)
+  {
+    data::DatasetInfo chunkInfo;
+    data::ChunkReader<> reader("test.csv", 7, chunkInfo, readAhead == 1);
+    REQUIRE(reader.Dimensionality() == 3);
+    REQUIRE(reader.NumPoints() == 100);
+    REQUIRE(chunkInfo.Type(1) == Datatype::categorical);
+
+    for (size_t pass = 0; pass < 2; ++pass)
+    {
+      arma::mat chunk;
+      size_t col = 0;
+      while (reader.Next(chunk))
+      {
+        REQUIRE(chunk.n_rows == 3);
+        REQUIRE(chunk.n_cols <= 7);
+        for (size_t j = 0; j < chunk.n_cols; ++j, ++col)
+          for (size_t i = 0; i < 3; ++i)
+            REQUIRE(chunk(i, j) == dataset(i, col));
+      }
+
+      REQUIRE(col == 100);
+      REQUIRE(reader.Position() == 100);
+      reader.Reset();
+    }
+
+    for (size_t c = 0; c < 3; ++c)
+      REQUIRE(chunkInfo.UnmapString(c, 1) == info.UnmapString(c, 1));
+  }
+
+  remove("test.csv");
+}
+
+/**
+ * Make sure that the types of a given DatasetInfo are kept: a numeric dimension
+ * that holds a string is an error, and a categorical one is mapped.
+ */
+TEST_CASE("ChunkReaderGivenInfoTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test.csv", fstream::out);
+  for (size_t i = 0; i < 20; ++i)
+    f << i << ", " << ((i == 15) ? "red" : std::to_string(i)) << endl;
+  f.close();
+
+  // The string is only found in the third chunk.
+  data::DatasetInfo numericInfo(2);
+  data::ChunkReader<> numericReader("test.csv", 7, numericInfo);
+  arma::mat chunk;
+  REQUIRE(numericReader.Next(chunk));
+  REQUIRE(numericReader.Next(chunk));
+  REQUIRE_THROWS_AS(numericReader.Next(chunk), std::runtime_error);
+  REQUIRE(numericInfo.Type(1) == Datatype::numeric);
+
+  data::DatasetInfo categoricalInfo(2);
+  categoricalInfo.Type(1) = Datatype::categorical;
+  data::ChunkReader<> categoricalReader("test.csv", 7, categoricalInfo);
+  size_t points = 0;
+  while (categoricalReader.Next(chunk))
+    points += chunk.n_cols;
+  REQUIRE(points == 20);
+  REQUIRE(categoricalInfo.Type(0) == Datatype::numeric);
+  REQUIRE(categoricalInfo.NumMappings(1) == 20);
+
+  remove("test.csv");
+}
+
+/**
+ * Make sure that a .mlbin file can be read in chunks.
+ */
+TEST_CASE("ChunkReaderBinaryTest", "[LoadSaveTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(4, 53);
+  REQUIRE(data::Save("test.mlbin", dataset, true));
+
+  data::DatasetInfo info;
+  data::ChunkReader<float> reader("test.mlbin", 10, info);
+  REQUIRE(reader.Dimensionality() == 4);
+  REQUIRE(reader.NumPoints() == 53);
+  REQUIRE(info.Dimensionality() == 4);
+
+  arma::fmat chunk;
+  size_t col = 0;
+  while (reader.Next(chunk))
+  {
+    for (size_t j = 0; j < chunk.n_cols; ++j, ++col)
+      for (size_t i = 0; i < 4; ++i)
+        REQUIRE(chunk(i, j) == (float) dataset(i, col));
+  }
+  REQUIRE(col == 53);
+
+  // The wrong dimensionality is an error.
+  data::DatasetInfo wrongInfo(3);
+  REQUIRE_THROWS_AS(data::ChunkReader<>("test.mlbin", 10, wrongInfo),
+      std::invalid_argument);
+
+  remove("test.mlbin");
+}
+
+/**
+ * Make sure that reading an ARFF file in chunks gives the same matrix and
+ * mappings as loading it all at once, on every pass, with and without
+ * read-ahead.
+ */
+TEST_CASE("ChunkReaderARFFTest", "[LoadSaveTest]")
+{
+  const char* categories[] = { "red", "green", "blue" };
+
+  fstream f;
+  f.open("test.arff", fstream::out);
+  f << "@relation test" << endl;
+  f << "% A comment." << endl;
+  f << "@attribute one NUMERIC" << endl;
+  f << "@attribute two {red, green, blue}" << endl;
+  f << "@attribute three STRING" << endl;
+  f << endl;
+  f << "@data" << endl;
+  for (size_t i = 0; i < 50; ++i)
+  {
+    f << (0.5 * i) << ", " << categories[(i / 3) % 3] << ", word"
+        << (i % 7) << endl;
+  }
+  f.close();
+
+  arma::mat dataset;
+  data::DatasetInfo info;
+  REQUIRE(data::Load("test.arff", dataset, info, true));
+
+  for (size_t readAhead = 0; readAhead < 2; ++readAhead)
+  {
+    data::DatasetInfo chunkInfo;
+    data::ChunkReader<> reader("test.arff", 8, chunkInfo, readAhead == 1);
+    REQUIRE(reader.Dimensionality() == 3);
+    REQUIRE(reader.NumPoints() == 50);
+    REQUIRE(chunkInfo.Type(0) == Datatype::numeric);
+    REQUIRE(chunkInfo.Type(1) == Datatype::categorical);
+    REQUIRE(chunkInfo.Type(2) == Datatype::categorical);
+
+    for (size_t pass = 0; pass < 2; ++pass)
+    {
+      arma::mat chunk;
+      size_t col = 0;
+      while (reader.Next(chunk))
+      {
+        REQUIRE(chunk.n_cols <= 8);
+        for (size_t j = 0; j < chunk.n_cols; ++j, ++col)
+          for (size_t i = 0; i < 3; ++i)
+            REQUIRE(chunk(i, j) == dataset(i, col));
+      }
+
+      REQUIRE(col == 50);
+      reader.Reset();
+    }
+
+    for (size_t c = 0; c < 3; ++c)
+      REQUIRE(chunkInfo.UnmapString(c, 1) == info.UnmapString(c, 1));
+  }
+
+  // A category that the header doesn't list is an error.
+  f.open("test.arff", fstream::out | fstream::app);
+  f << "1.0, purple, word0" << endl;
+  f.close();
+  data::DatasetInfo badInfo;
+  data::ChunkReader<> reader("test.arff", 100, badInfo);
+  arma::mat chunk;
+  REQUIRE_THROWS_AS(reader.Next(chunk), std::runtime_error);
+
+  remove("test.arff");
+}
+
+/**
+ * Make sure that reading a libsvm file in chunks gives the same points and
+ * labels as loading it all at once.
+ */
+TEST_CASE("ChunkReaderLibSVMTest", "[LoadSaveTest]")
+{
+  arma::sp_mat matrix;
+  matrix.sprandu(15, 200, 0.2);
+  arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(200,
+      arma::distr_param(0, 3));
+  REQUIRE(data::Save("test.svm", matrix, labels, true));
+
+  arma::sp_mat expected;
+  arma::Row<size_t> expectedLabels;
+  REQUIRE(data::Load("test.svm", expected, expectedLabels, true));
+
+  for (size_t readAhead = 0; readAhead < 2; ++readAhead)
+  {
+    data::DatasetInfo info;
+    data::ChunkReader<> reader("test.svm", 30, info, readAhead == 1);
+    REQUIRE(reader.Dimensionality() == expected.n_rows);
+    REQUIRE(reader.NumPoints() == 200);
+
+    arma::mat chunk;
+    arma::Row<size_t> chunkLabels;
+    arma::mat points;
+    arma::Row<size_t> allLabels;
+    while (reader.Next(chunk, chunkLabels))
+    {
+      REQUIRE(chunk.n_cols <= 30);
+      REQUIRE(chunkLabels.n_elem == chunk.n_cols);
+      points = arma::join_rows(points, chunk);
+      allLabels = arma::join_rows(allLabels, chunkLabels);
+    }
+    CheckMatrices(points, arma::mat(expected));
+    REQUIRE(arma::all(allLabels == expectedLabels));
+
+    // The labels may also be left out.
+    reader.Reset();
+    points.clear();
+    while (reader.Next(chunk))
+      points = arma::join_rows(points, chunk);
+    CheckMatrices(points, arma::mat(expected));
+  }
+
+  // A file with the index 0 is 0-based, and a larger DatasetInfo gives the
+  // dimensionality.
+  fstream f;
+  f.open("test.svm", fstream::out);
+  f << "# A comment line." << endl;
+  f << "1 0:0.5 3:2" << endl;
+  f << endl;
+  f << "0 1:1.5" << endl;
+  f.close();
+
+  data::DatasetInfo info(6);
+  data::ChunkReader<> reader("test.svm", 10, info);
+  REQUIRE(reader.Dimensionality() == 6);
+  REQUIRE(reader.NumPoints() == 2);
+
+  arma::mat chunk;
+  arma::Row<size_t> chunkLabels;
+  REQUIRE(reader.Next(chunk, chunkLabels));
+  REQUIRE(chunk.n_rows == 6);
+  REQUIRE(chunk.n_cols == 2);
+  REQUIRE(chunk(0, 0) == 0.5);
+  REQUIRE(chunk(3, 0) == 2.0);
+  REQUIRE(chunk(1, 1) == 1.5);
+  REQUIRE(arma::accu(chunk != 0) == 3);
+  REQUIRE(chunkLabels[0] == 1);
+  REQUIRE(chunkLabels[1] == 0);
+
+  // Other files don't have labels.
+  f.open("test.csv", fstream::out);
+  f << "1, 2" << endl;
+  f.close();
+  data::DatasetInfo csvInfo;
+  data::ChunkReader<> csvReader("test.csv", 10, csvInfo);
+  REQUIRE_THROWS_AS(csvReader.Next(chunk, chunkLabels), std::runtime_error);
+
+  remove("test.svm");
+  remove("test.csv");
+}
+
+/**
+ * Make sure that the points written by a ChunkWriter, dense or sparse, load
+ * back exactly, with the delimiter given by the extension.
+ */
+TEST_CASE("ChunkWriterTest", "[LoadSaveTest]")
+{
+  arma::mat dataset = arma::randn<arma::mat>(4, 23);
+  arma::sp_mat sparse = arma::sprandu<arma::sp_mat>(5, 17, 0.3);
+
+  const char* filenames[] = { "test_chunks.csv", "test_chunks.tsv",
+      "test_chunks.txt" };
+  const char delimiters[] = { ',', '\t', ' ' };
+  for (size_t f = 0; f < 3; ++f)
+  {
+    data::ChunkWriter writer(filenames[f]);
+    REQUIRE(writer.Delimiter() == delimiters[f]);
+    for (size_t col = 0; col < dataset.n_cols; col += 5)
+    {
+      const size_t lastCol = std::min(col + 4, (size_t) dataset.n_cols - 1);
+      writer.Write(arma::mat(dataset.cols(col, lastCol)));
+    }
+    writer.Close();
+
+    arma::mat loaded;
+    REQUIRE(data::Load(filenames[f], loaded, true));
+    REQUIRE(loaded.n_rows == dataset.n_rows);
+    REQUIRE(loaded.n_cols == dataset.n_cols);
+    for (size_t i = 0; i < dataset.n_elem; ++i)
+      REQUIRE(loaded[i] == dataset[i]);
+
+    remove(filenames[f]);
+  }
+
+  data::ChunkWriter writer("test_chunks.csv");
+  writer.Write(sparse);
+  writer.Close();
+
+  arma::mat loaded;
+  REQUIRE(data::Load("test_chunks.csv", loaded, true));
+  const arma::mat expected(sparse);
+  REQUIRE(loaded.n_rows == expected.n_rows);
+  REQUIRE(loaded.n_cols == expected.n_cols);
+  for (size_t i = 0; i < expected.n_elem; ++i)
+    REQUIRE(loaded[i] == expected[i]);
+
+  remove("test_chunks.csv");
+
+  REQUIRE_THROWS_AS(data::ChunkWriter("no_such_directory/test.csv"),
+      std::runtime_error);
+}
+
+/**
+ * Make sure that libsvm files are loaded correctly, including comments, qid
+ * fields, unsorted indices and blank lines.
+ */
+TEST_CASE("LoadLibSVMTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test.svm", fstream::out);
+  f << "# A comment line." << endl;
+  f << "1 1:0.5 3:2" << endl;
+  f << "-1 qid:3 2:1.5 # comment" << endl;
+  f << endl;
+  f << "1 4:-3 1:1" << endl;
+  f.close();
+
+  arma::sp_mat matrix;
+  arma::Row<int> labels;
+  REQUIRE(data::Load("test.svm", matrix, labels, true));
+
+  REQUIRE(matrix.n_rows == 4);
+  REQUIRE(matrix.n_cols == 3);
+  REQUIRE(matrix.n_nonzero == 5);
+  REQUIRE(matrix(0, 0) == 0.5);
+  REQUIRE(matrix(2, 0) == 2.0);
+  REQUIRE(matrix(1, 1) == 1.5);
+  REQUIRE(matrix(0, 2) == 1.0);
+  REQUIRE(matrix(3, 2) == -3.0);
+
+  REQUIRE(labels.n_elem == 3);
+  REQUIRE(labels[0] == 1);
+  REQUIRE(labels[1] == -1);
+  REQUIRE(labels[2] == 1);
+
+  // A malformed line is an error.
+  f.open("test.svm", fstream::out | fstream::app);
+  f << "1 2:1 three" << endl;
+  f.close();
+  REQUIRE(!data::Load("test.svm", matrix, labels));
+
+  remove("test.svm");
+}
+
+/**
+ * Make sure that a large libsvm file survives a save and load, and that .txt
+ * files in libsvm format are detected.
+ */
+TEST_CASE("SaveLoadLibSVMTest", "[LoadSaveTest]")
+{
+  arma::sp_mat matrix;
+  matrix.sprandu(50, 20000, 0.05);
+  arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(20000,
+      arma::distr_param(0, 4));
+
+  REQUIRE(data::Save("test.svm", matrix, labels, true));
+
+  arma::sp_mat loaded;
+  arma::Row<size_t> loadedLabels;
+  REQUIRE(data::Load("test.svm", loaded, loadedLabels, true));
+
+  // Trailing empty rows can't be recovered from the file.
+  REQUIRE(loaded.n_rows <= matrix.n_rows);
+  REQUIRE(loaded.n_cols == matrix.n_cols);
+  REQUIRE(loaded.n_nonzero == matrix.n_nonzero);
+  REQUIRE(arma::all(loadedLabels == labels));
+  arma::sp_mat::const_iterator it = matrix.begin();
+  for (; it != matrix.end(); ++it)
+    REQUIRE(loaded(it.row(), it.col()) == (*it));
+
+  // Load through the regular sparse overload, from a .txt file.
+  rename("test.svm", "test.txt");
+  arma::sp_mat unlabeled;
+  REQUIRE(data::Load("test.txt", unlabeled, true));
+  REQUIRE(unlabeled.n_cols == matrix.n_cols);
+  REQUIRE(unlabeled.n_nonzero == matrix.n_nonzero);
+
+  remove("test.txt");
+}
+
+/**
+ * Make sure that trailing all-zero rows are lost in a libsvm round trip unless
+ * the dimensionality is given to data::Load(), and that a dimensionality
+ * smaller than the largest index is an error.
+ */
+TEST_CASE("SaveLoadLibSVMDimensionalityTest", "[LoadSaveTest]")
+{
+  arma::sp_mat matrix(10, 4);
+  matrix(0, 0) = 1.5;
+  matrix(6, 1) = -2.0;
+  matrix(2, 3) = 3.25;
+  arma::Row<size_t> labels("0 1 0 1");
+
+  REQUIRE(data::Save("test.svm", matrix, labels, true));
+
+  // Without the dimensionality, the rows after the last nonzero are lost.
+  arma::sp_mat loaded;
+  arma::Row<size_t> loadedLabels;
+  REQUIRE(data::Load("test.svm", loaded, loadedLabels, true));
+  REQUIRE(loaded.n_rows == 7);
+  REQUIRE(loaded.n_cols == 4);
+
+  REQUIRE(data::Load("test.svm", loaded, loadedLabels, true, 10));
+  REQUIRE(loaded.n_rows == 10);
+  REQUIRE(loaded.n_cols == 4);
+  REQUIRE(arma::approx_equal(arma::mat(loaded), arma::mat(matrix), "absdiff",
+      0.0));
+  REQUIRE(arma::all(loadedLabels == labels));
+
+  REQUIRE(!data::Load("test.svm", loaded, loadedLabels, false, 5));
+  REQUIRE_THROWS_AS(data::LoadLibSVM("test.svm", loaded, loadedLabels, 5),
+      std::runtime_error);
+
+  remove("test.svm");
+}
+
+#ifdef HAS_ZLIB
+
+/**
+ * Compress the given file with gzip, keeping the first `size` bytes of the
+ * compressed data (all of them by default).
+ */
+void GzipFile(const std::string& filename,
+              const std::string& compressedFilename,
+              const size_t size = size_t(-1))
+{
+  std::ifstream in(filename.c_str(), std::ios::binary);
+  std::stringstream contents;
+  contents << in.rdbuf();
+  const std::string data = contents.str();
+
+  gzFile out = gzopen(compressedFilename.c_str(), "wb");
+  gzwrite(out, data.data(), (unsigned) data.size());
+  gzclose(out);
+
+  if (size != size_t(-1))
+  {
+    std::ifstream compressedIn(compressedFilename.c_str(), std::ios::binary);
+    std::string compressed((std::istreambuf_iterator<char>(compressedIn)),
+        std::istreambuf_iterator<char>());
+    compressedIn.close();
+
+    std::ofstream compressedOut(compressedFilename.c_str(), std::ios::binary);
+    compressedOut << compressed.substr(0, size);
+  }
+}
+
+/**
+ * Make sure that gzip-compressed files load the same as the files they hold,
+ * through every loader.
+ */
+TEST_CASE("LoadGzipCompressedTest", "[LoadSaveTest]")
+{
+  arma::mat matrix = arma::randu<arma::mat>(5, 3000);
+  REQUIRE(data::Save("test.csv", matrix, true));
+  GzipFile("test.csv", "test.csv.gz");
+
+  arma::mat expected, loaded;
+  REQUIRE(data::Load("test.csv", expected, true));
+  REQUIRE(data::Load("test.csv.gz", loaded, true));
+  CheckMatrices(loaded, expected);
+
+  DatasetInfo info;
+  arma::mat loadedWithInfo;
+  REQUIRE(data::Load("test.csv.gz", loadedWithInfo, info, true));
+  CheckMatrices(loadedWithInfo, expected);
+
+  // The chunk reader decompresses as it goes, and has to start over for a
+  // second pass.
+  DatasetInfo chunkInfo;
+  data::ChunkReader<> reader("test.csv.gz", 1000, chunkInfo);
+  REQUIRE(reader.NumPoints() == 3000);
+  arma::mat chunk;
+  size_t points = 0;
+  while (reader.Next(chunk))
+  {
+    CheckMatrices(chunk, expected.cols(points, points + chunk.n_cols - 1));
+    points += chunk.n_cols;
+  }
+  REQUIRE(points == 3000);
+  reader.Reset();
+  REQUIRE(reader.Next(chunk));
+  CheckMatrices(chunk, expected.cols(0, 999));
+
+  // A truncated file is an error, not a shorter dataset.
+  GzipFile("test.csv", "test.csv.gz", 1000);
+  REQUIRE(!data::Load("test.csv.gz", loaded));
+  REQUIRE(!data::Load("test.csv.gz", loadedWithInfo, info));
+  DatasetInfo truncatedInfo;
+  REQUIRE_THROWS_AS(data::ChunkReader<>("test.csv.gz", 1000, truncatedInfo),
+      std::runtime_error);
+
+  remove("test.csv");
+  remove("test.csv.gz");
+}
+
+/**
+ * Make sure that compressed ARFF and libsvm files can be loaded.
+ */
+TEST_CASE("LoadGzipCompressedARFFLibSVMTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test.arff", fstream::out);
+  f << "@relation test" << endl;
+  f << endl;
+  f << "@attribute one NUMERIC" << endl;
+  f << "@attribute two {a, b}" << endl;
+  f << endl;
+  f << "@data" << endl;
+  f << "1, a" << endl;
+  f << "3, b" << endl;
+  f << "5, a" << endl;
+  f.close();
+  GzipFile("test.arff", "test.arff.gz");
+
+  arma::mat dataset;
+  DatasetInfo info;
+  REQUIRE(data::Load("test.arff.gz", dataset, info, true));
+  REQUIRE(info.Dimensionality() == 2);
+  REQUIRE(info.Type(0) == Datatype::numeric);
+  REQUIRE(info.Type(1) == Datatype::categorical);
+  REQUIRE(dataset.n_rows == 2);
+  REQUIRE(dataset.n_cols == 3);
+  REQUIRE(dataset(0, 1) == 3.0);
+  REQUIRE(dataset(1, 0) == dataset(1, 2));
+  REQUIRE(dataset(1, 0) != dataset(1, 1));
+
+  // Cut off the end of the compressed data.
+  GzipFile("test.arff", "test.arff.gz", 40);
+  DatasetInfo truncatedInfo;
+  REQUIRE(!data::Load("test.arff.gz", dataset, truncatedInfo));
+
+  arma::sp_mat matrix;
+  matrix.sprandu(20, 500, 0.1);
+  arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(500,
+      arma::distr_param(0, 2));
+  REQUIRE(data::Save("test.svm", matrix, labels, true));
+  GzipFile("test.svm", "test.svm.gz");
+
+  arma::sp_mat expected, loaded;
+  arma::Row<size_t> expectedLabels, loadedLabels;
+  REQUIRE(data::Load("test.svm", expected, expectedLabels, true));
+  REQUIRE(data::Load("test.svm.gz", loaded, loadedLabels, true));
+  CheckMatrices(arma::mat(loaded), arma::mat(expected));
+  REQUIRE(arma::all(loadedLabels == expectedLabels));
+
+  remove("test.arff");
+  remove("test.arff.gz");
+  remove("test.svm");
+  remove("test.svm.gz");
+}
+
+#endif
+
+/**
+ * Make sure that ConcurrentIncrementPolicy gives the same mappings as
+ * IncrementPolicy for a file with many distinct categories, with and without
+ * transposing, and when the mapper already holds some mappings.
+ */
+TEST_CASE("ConcurrentIncrementPolicyLoadTest", "[LoadSaveTest]")
+{
+  const size_t points = 150000;
+  fstream f;
+  f.open("test.csv", fstream::out);
+  for (size_t i = 0; i < points; ++i)
+  {
+    f << "user" << ((i * 7919) % 40000) << ", " << (0.25 * i) << ", "
+        << ((i % 5 == 0) ? "x" : "y") << endl;
+  }
+  f.close();
+
+  for (size_t t = 0; t < 2; ++t)
+  {
+    const bool transpose = (t == 0);
+    arma::mat expected, dataset;
+    data::DatasetInfo expectedInfo;
+    data::DatasetMapper<data::ConcurrentIncrementPolicy> info;
+    REQUIRE(data::Load("test.csv", expected, expectedInfo, true, transpose));
+    REQUIRE(data::Load("test.csv", dataset, info, true, transpose));
+
+    CheckMatrices(dataset, expected);
+    REQUIRE(info.Dimensionality() == expectedInfo.Dimensionality());
+    for (size_t d = 0; d < info.Dimensionality(); ++d)
+    {
+      REQUIRE(info.Type(d) == expectedInfo.Type(d));
+      REQUIRE(info.NumMappings(d) == expectedInfo.NumMappings(d));
+      for (size_t i = 0; i < info.NumMappings(d); ++i)
+        REQUIRE(info.UnmapString(i, d) == expectedInfo.UnmapString(i, d));
+    }
+  }
+
+  // Existing mappings must be kept.
+  data::DatasetMapper<data::ConcurrentIncrementPolicy> info(3);
+  info.Type(0) = Datatype::categorical;
+  info.MapString<double>("user3", 0);
+  info.MapString<double>("unseen", 0);
+  arma::mat dataset;
+  REQUIRE(data::Load("test.csv", dataset, info, true));
+  REQUIRE(info.NumMappings(0) == 40001);
+  REQUIRE(info.UnmapString(0, 0) == "user3");
+  REQUIRE(info.UnmapString(1, 0) == "unseen");
+  REQUIRE(info.UnmapString(2, 0) == "user0");
+  REQUIRE(dataset(0, 0) == 2.0);
+  REQUIRE(dataset(0, 1) == 3.0);
+  REQUIRE(info.UnmapString(3, 0) == "user7919");
+
+  remove("test.csv");
+}
@@ -123,6 +123,31 @@ TEST_CASE("LocalCoordinateCodingTestDictionaryStep",
   REQUIRE(norm(grad, "fro") == Approx(0.0).margin(tol));
 }
 
+/**
+ * Make sure that encoding into a sparse matrix gives the same codes as encoding
+ * into a dense matrix.
+ */
+TEST_CASE("LocalCoordinateCodingSparseEncodeTest",
+          "[LocalCoordinateCodingTest]")
+{
+  mat X;
+  X.load("mnist_first250_training_4s_and_9s.arm");
+  for (uword i = 0; i < X.n_cols; ++i)
+    X.col(i) /= norm(X.col(i), 2);
+
+  LocalCoordinateCoding lcc(X, 10, 0.1, 2);
+
+  mat Z;
+  sp_mat sparseZ;
+  lcc.Encode(X, Z);
+  lcc.Encode(X, sparseZ);
+
+  REQUIRE(sparseZ.n_rows == Z.n_rows);
+  REQUIRE(sparseZ.n_cols == Z.n_cols);
+  REQUIRE(sparseZ.n_nonzero == (size_t) accu(Z != 0));
+  CheckMatrices(Z, mat(sparseZ));
+}
+
 TEST_CASE("LocalCoordinateCodingSerializationTest",
           "[LocalCoordinateCodingTest]")
 {
@@ -363,3 +363,37 @@ TEST_CASE_METHOD(KernelPCATestFixture, "KernelPCASamplingSchemeTest",
   REQUIRE(arma::any(arma::vectorise(output2 != output3)));
   REQUIRE(arma::any(arma::vectorise(output1 != output3)));
 }
+
+/**
+ * Make sure the randomized method gives output of the right size, and that it
+ * can't be combined with the Nystroem method.
+ */
+TEST_CASE_METHOD(KernelPCATestFixture, "KernelPCARandomizedMethodTest",
+                 "[KernelPCAMainTest][BindingTests]")
+{
+  arma::mat x = arma::randu<arma::mat>(5, 300);
+
+  SetInputParam("input", x);
+  SetInputParam("new_dimensionality", (int) 3);
+  SetInputParam("kernel", (std::string) "gaussian");
+  SetInputParam("randomized_method", true);
+
+  mlpackMain();
+
+  const arma::mat& output = IO::GetParam<arma::mat>("output");
+  REQUIRE(output.n_rows == 3);
+  REQUIRE(output.n_cols == 300);
+  REQUIRE(output.is_finite());
+
+  ResetSettings();
+
+  SetInputParam("input", std::move(x));
+  SetInputParam("new_dimensionality", (int) 3);
+  SetInputParam("kernel", (std::string) "gaussian");
+  SetInputParam("randomized_method", true);
+  SetInputParam("nystroem_method", true);
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(mlpackMain(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
@@ -175,3 +175,81 @@ TEST_CASE_METHOD(
   REQUIRE(dataset.n_rows == output.n_rows);
   CheckMatrices(output, dataset);
 }
+
+/**
+ * Test that encoding a file in chunks gives the same result as encoding the
+ * matrix in memory.
+ */
+TEST_CASE_METHOD(
+    PreprocessOneHotEncodingTestFixture, "ChunkedOneHotEncodingTest",
+    "[PreprocessOneHotEncodingMainTest][BindingTests]")
+{
+  arma::mat dataset;
+  dataset = "1 1 -1 -1 -1 -1 1 1;"
+            "-1 1 -1 -1 -1 -1 1 -1;"
+            "1 1 -1 -1 -1 -1 1 1;"
+            "-1 1 -1 -1 -1 -1 1 -1;"
+            "1 1 -1 -1 -1 -1 1 1;";
+  data::Save("one_hot_chunks_input.csv", dataset);
+
+  arma::mat expected;
+  data::OneHotEncoding(dataset, arma::Col<size_t>("1 3"), expected);
+
+  SetInputParam("input_file", (std::string) "one_hot_chunks_input.csv");
+  SetInputParam("output_file", (std::string) "one_hot_chunks_output.csv");
+  SetInputParam("chunk_size", 3);
+  SetInputParam<vector<int>>("dimensions", {1, 3});
+
+  mlpackMain();
+
+  arma::mat output;
+  REQUIRE(data::Load("one_hot_chunks_output.csv", output));
+  CheckMatrices(output, expected);
+
+  remove("one_hot_chunks_input.csv");
+  remove("one_hot_chunks_output.csv");
+}
+
+/**
+ * Since files can be encoded in chunks, "input" is no longer a required
+ * parameter; check that either a matrix or a file must still be given, but
+ * not both.
+ */
+TEST_CASE_METHOD(
+    PreprocessOneHotEncodingTestFixture, "InputOrInputFileRequiredTest",
+    "[PreprocessOneHotEncodingMainTest][BindingTests]")
+{
+  REQUIRE(!IO::Parameters()["input"].required);
+
+  SetInputParam<vector<int>>("dimensions", {1});
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(mlpackMain(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+
+  SetInputParam("input", arma::mat(3, 3, arma::fill::ones));
+  SetInputParam("input_file", (std::string) "one_hot_input.csv");
+  SetInputParam("output_file", (std::string) "one_hot_output.csv");
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(mlpackMain(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
+
+/**
+ * Check that an output file that can't be written is reported.
+ */
+TEST_CASE_METHOD(
+    PreprocessOneHotEncodingTestFixture, "UnwritableOutputFileTest",
+    "[PreprocessOneHotEncodingMainTest][BindingTests]")
+{
+  arma::mat dataset(3, 5, arma::fill::ones);
+  data::Save("one_hot_unwritable_input.csv", dataset);
+
+  SetInputParam("input_file", (std::string) "one_hot_unwritable_input.csv");
+  SetInputParam("output_file",
+      (std::string) "no_such_directory/one_hot_output.csv");
+  SetInputParam<vector<int>>("dimensions", {1});
+
+  REQUIRE_THROWS_AS(mlpackMain(), std::runtime_error);
+
+  remove("one_hot_unwritable_input.csv");
+}
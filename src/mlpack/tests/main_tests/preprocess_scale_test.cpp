@@ -365,3 +365,84 @@ TEST_CASE_METHOD(PreprocessScaleTestFixture, "MeanNormalizationBindingTest",
   SetInputParam("inverse_scaling", true);
   REQUIRE_NOTHROW(mlpackMain());
 }
+
+/**
+ * Check that scaling a file in chunks gives the same result as scaling it in
+ * memory.
+ */
+TEST_CASE_METHOD(PreprocessScaleTestFixture, "ChunkedScalingTest",
+                 "[PreprocessScaleMainTest][BindingTests]")
+{
+  arma::mat data = arma::randu<arma::mat>(3, 50);
+  data.row(2) *= 20.0;
+  data::Save("scale_chunks_input.csv", data);
+
+  const std::string methods[] = { "standard_scaler", "min_max_scaler",
+      "zca_whitening" };
+  for (const std::string& method : methods)
+  {
+    SetInputParam("input", data);
+    SetInputParam("scaler_method", method);
+
+    mlpackMain();
+    const arma::mat expected = IO::GetParam<arma::mat>("output");
+
+    bindings::tests::CleanMemory();
+    IO::ClearSettings();
+    IO::RestoreSettings(testName);
+
+    SetInputParam("input_file", (std::string) "scale_chunks_input.csv");
+    SetInputParam("output_file", (std::string) "scale_chunks_output.csv");
+    SetInputParam("scaler_method", method);
+    SetInputParam("chunk_size", 7);
+
+    mlpackMain();
+
+    arma::mat output;
+    REQUIRE(data::Load("scale_chunks_output.csv", output));
+    CheckMatrices(output, expected);
+
+    // The model fitted in chunks can be used on other data.
+    ScalingModel* model = IO::GetParam<ScalingModel*>("output_model");
+    arma::mat modelOutput;
+    model->Transform(data, modelOutput);
+    CheckMatrices(modelOutput, expected);
+
+    bindings::tests::CleanMemory();
+    IO::ClearSettings();
+    IO::RestoreSettings(testName);
+  }
+
+  remove("scale_chunks_input.csv");
+  remove("scale_chunks_output.csv");
+}
+
+/**
+ * Check that a matrix and a file can't both be given.
+ */
+TEST_CASE_METHOD(PreprocessScaleTestFixture, "InputAndInputFileTest",
+                 "[PreprocessScaleMainTest][BindingTests]")
+{
+  SetInputParam("input", dataset);
+  SetInputParam("input_file", (std::string) "scale_input.csv");
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(mlpackMain(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
+
+/**
+ * Since files can be scaled in chunks, "input" is no longer a required
+ * parameter; check that a matrix or a file must still be given.
+ */
+TEST_CASE_METHOD(PreprocessScaleTestFixture, "NoInputTest",
+                 "[PreprocessScaleMainTest][BindingTests]")
+{
+  REQUIRE(!IO::Parameters()["input"].required);
+
+  SetInputParam("scaler_method", std::string("min_max_scaler"));
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(mlpackMain(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file tests/main_tests/preprocess_text_encoding_test.cpp
+ *
+ * Test mlpackMain() of preprocess_text_encoding_main.cpp.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#define BINDING_TYPE BINDING_TYPE_TEST
+
+#include <mlpack/core.hpp>
+static const std::string testName = "PreprocessTextEncoding";
+
+#include <mlpack/core/util/mlpack_main.hpp>
+#include <mlpack/methods/preprocess/preprocess_text_encoding_main.cpp>
+
+#include "test_helper.hpp"
+#include "../test_catch_tools.hpp"
+#include "../catch.hpp"
+
+using namespace mlpack;
+
+struct PreprocessTextEncodingTestFixture
+{
+ public:
+  PreprocessTextEncodingTestFixture()
+  {
+    // Cache in the options for this program.
+    IO::RestoreSettings(testName);
+  }
+
+  ~PreprocessTextEncodingTestFixture()
+  {
+    // Clear the settings.
+    bindings::tests::CleanMemory();
+    IO::ClearSettings();
+  }
+};
+
+//! Write a small set of documents to the given file.
+static void WriteDocuments(const std::string& filename)
+{
+  std::ofstream stream(filename);
+  stream << "the cat sat on the mat" << std::endl;
+  stream << "the dog, the cat." << std::endl;
+  stream << "a bird" << std::endl;
+}
+
+/**
+ * Check that the bag-of-words encoding and the vocabulary are saved.
+ */
+TEST_CASE_METHOD(
+    PreprocessTextEncodingTestFixture, "PreprocessTextEncodingBagOfWordsTest",
+    "[PreprocessTextEncodingMainTest][BindingTests]")
+{
+  WriteDocuments("text_encoding_test.txt");
+
+  SetInputParam("input_file", (std::string) "text_encoding_test.txt");
+  SetInputParam("output_file", (std::string) "text_encoding_output.bin");
+  SetInputParam("vocabulary_file",
+      (std::string) "text_encoding_vocabulary.txt");
+
+  mlpackMain();
+
+  arma::sp_mat output;
+  REQUIRE(data::Load("text_encoding_output.bin", output));
+
+  // The vocabulary is the, cat, sat, on, mat, dog, a, bird.
+  REQUIRE(output.n_rows == 8);
+  REQUIRE(output.n_cols == 3);
+  REQUIRE(output(0, 0) == 2);
+  REQUIRE(output(1, 0) == 1);
+  REQUIRE(output(0, 1) == 2);
+  REQUIRE(output(5, 1) == 1);
+  REQUIRE(output(7, 2) == 1);
+  REQUIRE(output.n_nonzero == 10);
+
+  std::ifstream vocabulary("text_encoding_vocabulary.txt");
+  std::vector<std::string> tokens;
+  std::string token;
+  while (std::getline(vocabulary, token))
+    tokens.push_back(token);
+
+  REQUIRE(tokens == std::vector<std::string>({ "the", "cat", "sat", "on",
+      "mat", "dog", "a", "bird" }));
+
+  remove("text_encoding_test.txt");
+  remove("text_encoding_output.bin");
+  remove("text_encoding_vocabulary.txt");
+}
+
+/**
+ * Check that the hashing trick gives the requested number of rows, and that
+ * tf-idf gives the same values with and without it when no tokens collide.
+ */
+TEST_CASE_METHOD(
+    PreprocessTextEncodingTestFixture, "PreprocessTextEncodingHashingTest",
+    "[PreprocessTextEncodingMainTest][BindingTests]")
+{
+  WriteDocuments("text_encoding_test.txt");
+
+  SetInputParam("input_file", (std::string) "text_encoding_test.txt");
+  SetInputParam("output_file", (std::string) "text_encoding_output.bin");
+  SetInputParam("encoding", (std::string) "tf_idf");
+  SetInputParam("hash_buckets", 1000);
+
+  mlpackMain();
+
+  arma::sp_mat output;
+  REQUIRE(data::Load("text_encoding_output.bin", output));
+  REQUIRE(output.n_rows == 1000);
+  REQUIRE(output.n_cols == 3);
+
+  // Compute the expected values without the hashing trick.
+  std::vector<std::string> documents = { "the cat sat on the mat",
+      "the dog, the cat.", "a bird" };
+  data::TfIdfEncoding<boost::string_view> encoder;
+  data::SplitByAnyOf tokenizer(" \t,.;:!?\"");
+  arma::sp_mat expected;
+  encoder.Encode(documents, expected, tokenizer);
+
+  // None of the eight tokens collide in 1000 buckets.
+  REQUIRE(output.n_nonzero == expected.n_nonzero);
+  for (size_t i = 0; i < 3; ++i)
+  {
+    arma::vec column = arma::sort(arma::nonzeros(output.col(i)));
+    arma::vec expectedColumn = arma::sort(arma::nonzeros(expected.col(i)));
+    CheckMatrices(column, expectedColumn);
+  }
+
+  remove("text_encoding_test.txt");
+  remove("text_encoding_output.bin");
+}
@@ -16,6 +16,7 @@
 #include <ensmallen.hpp>
 
 #include "catch.hpp"
+#include "test_catch_tools.hpp"
 
 using namespace mlpack;
 using namespace mlpack::metric;
@@ -246,6 +247,134 @@ TEST_CASE("SoftmaxSeparableGradient", "[NCATesT]")
   REQUIRE(gradient(1, 1) == Approx(-2.0 * -0.1435886).epsilon(0.0001));
 }
 
+/**
+ * Ensure that evaluating a batch of points gives the sum of the separable
+ * objectives and gradients of each point.
+ */
+TEST_CASE("SoftmaxSeparableBatch", "[NCATesT]")
+{
+  arma::mat data = arma::randu<arma::mat>(3, 40);
+  arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(40,
+      arma::distr_param(0, 2));
+
+  SoftmaxErrorFunction<SquaredEuclideanDistance> sef(data, labels);
+
+  arma::mat coordinates = arma::randu<arma::mat>(3, 3);
+  double objective = 0.0;
+  arma::mat gradient, sumGradient(3, 3, arma::fill::zeros);
+  for (size_t i = 5; i < 25; ++i)
+  {
+    objective += sef.Evaluate(coordinates, i, 1);
+    sef.Gradient(coordinates, i, gradient, 1);
+    sumGradient += gradient;
+  }
+
+  REQUIRE(sef.Evaluate(coordinates, 5, 20) == Approx(objective).epsilon(1e-7));
+  sef.Gradient(coordinates, 5, gradient, 20);
+  CheckMatrices(gradient, sumGradient);
+}
+
+/**
+ * Ensure that truncating the softmax to all of the other points gives the
+ * same results as not truncating it.
+ */
+TEST_CASE("SoftmaxTruncatedAllNeighbors", "[NCATesT]")
+{
+  arma::mat data = arma::randu<arma::mat>(3, 50);
+  arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(50,
+      arma::distr_param(0, 2));
+
+  SoftmaxErrorFunction<SquaredEuclideanDistance> sef(data, labels);
+  SoftmaxErrorFunction<SquaredEuclideanDistance> truncated(data, labels,
+      SquaredEuclideanDistance(), 49);
+
+  arma::mat coordinates = arma::randu<arma::mat>(3, 3);
+  REQUIRE(truncated.Evaluate(coordinates) ==
+      Approx(sef.Evaluate(coordinates)).epsilon(1e-7));
+
+  arma::mat gradient, truncatedGradient;
+  sef.Gradient(coordinates, gradient);
+  truncated.Gradient(coordinates, truncatedGradient);
+  CheckMatrices(truncatedGradient, gradient);
+}
+
+/**
+ * Ensure that the truncated non-separable objective and gradient (which use a
+ * tree search) match the sum of the truncated separable objectives and
+ * gradients (which use a linear scan), and that changing the number of
+ * neighbors changes the objective.
+ */
+TEST_CASE("SoftmaxTruncatedSeparable", "[NCATesT]")
+{
+  arma::mat data = arma::randu<arma::mat>(3, 100);
+  arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(100,
+      arma::distr_param(0, 2));
+
+  SoftmaxErrorFunction<SquaredEuclideanDistance> sef(data, labels,
+      SquaredEuclideanDistance(), 5);
+  REQUIRE(sef.Neighbors() == 5);
+
+  arma::mat coordinates = 3.0 * arma::randu<arma::mat>(3, 3);
+  const double objective = sef.Evaluate(coordinates);
+  REQUIRE(sef.Evaluate(coordinates, 0, 100) ==
+      Approx(objective).epsilon(1e-7));
+
+  arma::mat gradient, separableGradient;
+  sef.Gradient(coordinates, gradient);
+  sef.Gradient(coordinates, 0, separableGradient, 100);
+  CheckMatrices(gradient, separableGradient);
+
+  // With the same coordinates, the precalculation must still be redone.
+  sef.Neighbors() = 0;
+  REQUIRE(sef.Evaluate(coordinates) != Approx(objective).epsilon(1e-7));
+}
+
+/**
+ * A metric that can't be used with kd-trees, for the truncated softmax test
+ * below.
+ */
+class ScaledSquaredEuclideanDistance
+{
+ public:
+  template<typename VecTypeA, typename VecTypeB>
+  double Evaluate(const VecTypeA& a, const VecTypeB& b) const
+  {
+    return 0.5 * SquaredEuclideanDistance::Evaluate(a, b);
+  }
+};
+
+/**
+ * Ensure that the truncated non-separable objective and gradient match the
+ * separable ones for an unrooted LMetric other than the squared Euclidean
+ * distance, and for a metric that is not an LMetric at all.
+ */
+TEST_CASE("SoftmaxTruncatedOtherMetrics", "[NCATesT]")
+{
+  arma::mat data = arma::randu<arma::mat>(3, 100);
+  arma::Row<size_t> labels = arma::randi<arma::Row<size_t>>(100,
+      arma::distr_param(0, 2));
+  arma::mat coordinates = 3.0 * arma::randu<arma::mat>(3, 3);
+
+  SoftmaxErrorFunction<LMetric<3, false>> cubed(data, labels,
+      LMetric<3, false>(), 5);
+  REQUIRE(cubed.Evaluate(coordinates, 0, 100) ==
+      Approx(cubed.Evaluate(coordinates)).epsilon(1e-7));
+
+  arma::mat gradient, separableGradient;
+  cubed.Gradient(coordinates, gradient);
+  cubed.Gradient(coordinates, 0, separableGradient, 100);
+  CheckMatrices(gradient, separableGradient);
+
+  SoftmaxErrorFunction<ScaledSquaredEuclideanDistance> scaled(data, labels,
+      ScaledSquaredEuclideanDistance(), 5);
+  REQUIRE(scaled.Evaluate(coordinates, 0, 100) ==
+      Approx(scaled.Evaluate(coordinates)).epsilon(1e-7));
+
+  scaled.Gradient(coordinates, gradient);
+  scaled.Gradient(coordinates, 0, separableGradient, 100);
+  CheckMatrices(gradient, separableGradient);
+}
+
 //
 // Tests for the NCA algorithm.
 //
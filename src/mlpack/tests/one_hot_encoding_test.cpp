@@ -230,3 +230,142 @@ TEST_CASE("OneHotEncodingDatasetinfoTest", "[OneHotEncodingTest]")
 
   remove("test.csv");
 }
+
+/**
+ * Test that one hot encoding into a sparse matrix gives the same result as the
+ * dense encoding, with numeric dimensions that hold zeros.
+ */
+TEST_CASE("OneHotEncodingSparseOutputTest", "[OneHotEncodingTest]")
+{
+  arma::mat input(6, 500);
+  for (size_t i = 0; i < input.n_cols; ++i)
+  {
+    input(0, i) = (i % 3 == 0) ? 0.0 : i * 0.5;
+    input(1, i) = (i * 7) % 23;
+    input(2, i) = 0.0;
+    input(3, i) = (i * i) % 101;
+    input(4, i) = (i % 2 == 0) ? -1.0 : 0.0;
+    input(5, i) = i % 2;
+  }
+
+  arma::Col<size_t> indices("1 3 5");
+  arma::mat denseOutput;
+  arma::sp_mat sparseOutput;
+  data::OneHotEncoding(input, indices, denseOutput);
+  data::OneHotEncoding(input, indices, sparseOutput);
+
+  REQUIRE(sparseOutput.n_rows == denseOutput.n_rows);
+  REQUIRE(sparseOutput.n_cols == denseOutput.n_cols);
+  REQUIRE(sparseOutput.n_nonzero == arma::accu(denseOutput != 0));
+  CheckMatrices(arma::mat(sparseOutput), denseOutput);
+
+  // Without any dimensions to encode, the data is only copied.
+  data::OneHotEncoding(input, arma::Col<size_t>(), sparseOutput);
+  CheckMatrices(arma::mat(sparseOutput), input);
+
+  // An index that is not a dimension is an error.
+  REQUIRE_THROWS_AS(data::OneHotEncoding(input, arma::Col<size_t>("6"),
+      sparseOutput), std::invalid_argument);
+
+  // NaN can't be encoded, but is fine in a dimension that is only copied.
+  input(3, 17) = std::numeric_limits<double>::quiet_NaN();
+  REQUIRE_THROWS_AS(data::OneHotEncoding(input, indices, sparseOutput),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(data::OneHotEncoding(input, indices, denseOutput),
+      std::invalid_argument);
+  REQUIRE_NOTHROW(data::OneHotEncoding(input, arma::Col<size_t>("1 5"),
+      sparseOutput));
+}
+
+/**
+ * Test one hot encoding into a sparse matrix using a DatasetInfo object with
+ * mixed numeric and categorical dimensions.
+ */
+TEST_CASE("OneHotEncodingSparseDatasetInfoTest", "[OneHotEncodingTest]")
+{
+  fstream f;
+  f.open("test_sparse.csv", fstream::out);
+  f << "1, a, 0, hello" << endl;
+  f << "0, b, 4, goodbye" << endl;
+  f << "5, a, 0, coffee" << endl;
+  f << "7, c, 8, hello" << endl;
+  f.close();
+
+  arma::mat matrix;
+  DatasetInfo info;
+  if (!data::Load("test_sparse.csv", matrix, info))
+    FAIL("Cannot load dataset test_sparse.csv");
+
+  arma::mat denseOutput;
+  arma::sp_mat sparseOutput;
+  data::OneHotEncoding(matrix, denseOutput, info);
+  data::OneHotEncoding(matrix, sparseOutput, info);
+
+  // Two numeric dimensions, three letters and three words.
+  REQUIRE(sparseOutput.n_rows == 8);
+  REQUIRE(sparseOutput.n_cols == 4);
+  CheckMatrices(arma::mat(sparseOutput), denseOutput);
+
+  REQUIRE(sparseOutput(0, 0) == 1);
+  REQUIRE(sparseOutput(1, 0) == 1);
+  REQUIRE(sparseOutput(5, 0) == 1);
+  REQUIRE(sparseOutput(2, 1) == 1);
+  REQUIRE(sparseOutput(4, 1) == 4);
+  REQUIRE(sparseOutput(6, 1) == 1);
+  REQUIRE(sparseOutput(3, 3) == 1);
+  REQUIRE(sparseOutput(5, 3) == 1);
+  // The zeros of the numeric dimensions are not stored.
+  REQUIRE(sparseOutput.n_nonzero == 13);
+
+  remove("test_sparse.csv");
+}
+
+/**
+ * Test that one hot encoding a dataset in chunks gives the same result as
+ * encoding it in memory.
+ */
+TEST_CASE("OneHotEncodingChunkReaderTest", "[OneHotEncodingTest]")
+{
+  fstream f;
+  f.open("test_chunks.csv", fstream::out);
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    f << (i % 5) << ", user" << ((i * 31) % 97) << ", " << (i * 0.25) << ", "
+        << ((i % 7 == 0) ? "yes" : "no") << endl;
+  }
+  f.close();
+
+  arma::mat matrix;
+  DatasetInfo info;
+  if (!data::Load("test_chunks.csv", matrix, info))
+    FAIL("Cannot load dataset test_chunks.csv");
+
+  arma::sp_mat expected;
+  data::OneHotEncoding(matrix, expected, info);
+
+  // Encode the categorical dimensions and the first one.
+  arma::sp_mat expectedIndices;
+  data::OneHotEncoding(matrix, arma::Col<size_t>("0 1 3"), expectedIndices);
+
+  DatasetInfo chunkInfo;
+  ChunkReader<double> reader("test_chunks.csv", 64, chunkInfo);
+
+  arma::mat output;
+  data::OneHotEncoding(reader, [&](const arma::sp_mat& chunk)
+      {
+        REQUIRE(chunk.n_rows == expected.n_rows);
+        REQUIRE(chunk.n_cols <= 64);
+        output = arma::join_rows(output, arma::mat(chunk));
+      });
+  CheckMatrices(output, arma::mat(expected));
+
+  output.clear();
+  data::OneHotEncoding(reader, arma::Col<size_t>("0 1 3"),
+      [&](const arma::sp_mat& chunk)
+      {
+        output = arma::join_rows(output, arma::mat(chunk));
+      });
+  CheckMatrices(output, arma::mat(expectedIndices));
+
+  remove("test_chunks.csv");
+}
@@ -94,6 +94,41 @@ TEST_CASE("BootstrapWeightsTest", "[RandomForestTest]")
   }
 }
 
+/**
+ * Make sure bootstrap samples drawn with the same random stream are the same,
+ * and that every column, including the last, can be drawn.
+ */
+TEST_CASE("BootstrapRandomStreamTest", "[RandomForestTest]")
+{
+  arma::mat dataset(1, 10);
+  dataset.row(0) = arma::linspace<arma::rowvec>(0, 9, 10);
+  arma::Row<size_t> labels(10, arma::fill::zeros);
+  arma::rowvec weights; // Unused.
+
+  arma::mat bootstrapDataset[2];
+  arma::Row<size_t> bootstrapLabels;
+  arma::rowvec bootstrapWeights;
+  arma::uvec counts(10, arma::fill::zeros);
+  for (size_t trial = 0; trial < 100; ++trial)
+  {
+    for (size_t i = 0; i < 2; ++i)
+    {
+      math::RandomStream stream(42, trial);
+      math::RandomStreamScope scope(stream);
+      Bootstrap<false>(dataset, labels, weights, bootstrapDataset[i],
+          bootstrapLabels, bootstrapWeights);
+    }
+
+    REQUIRE(arma::approx_equal(bootstrapDataset[0], bootstrapDataset[1],
+        "absdiff", 0.0));
+    for (size_t i = 0; i < bootstrapDataset[0].n_cols; ++i)
+      counts[(size_t) bootstrapDataset[0](0, i)]++;
+  }
+
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    REQUIRE(counts[i] > 0);
+}
+
 /**
  * Make sure an empty forest cannot predict.
  */
@@ -114,6 +149,45 @@ TEST_CASE("EmptyClassifyTest", "[RandomForestTest]")
       pointProbabilities), std::invalid_argument);
 }
 
+/**
+ * Make sure an empty test set can be classified, also into preallocated outputs
+ * that can't be resized (as the Python bindings give).
+ */
+TEST_CASE("EmptyTestSetClassifyTest", "[RandomForestTest]")
+{
+  arma::mat dataset(4, 100, arma::fill::randu);
+  arma::Row<size_t> labels(100);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    labels[i] = (dataset(0, i) > 0.5) ? 1 : 0;
+
+  arma::mat emptySet(4, 0);
+  size_t predictionMemory[1];
+  double probabilityMemory[1];
+  arma::Row<size_t> predictions(predictionMemory, 0, false, true);
+  arma::mat probabilities(probabilityMemory, 2, 0, false, true);
+
+  // Without training, the usual exception is thrown.
+  RandomForest<> untrained;
+  REQUIRE_THROWS_AS(untrained.Classify(emptySet, predictions),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(untrained.Classify(emptySet, predictions, probabilities),
+      std::invalid_argument);
+
+  RandomForest<> rf(dataset, labels, 2, 5 /* 5 trees */);
+  REQUIRE_NOTHROW(rf.Classify(emptySet, predictions));
+  REQUIRE_NOTHROW(rf.Classify(emptySet, predictions, probabilities));
+  REQUIRE(predictions.n_elem == 0);
+  REQUIRE(probabilities.n_rows == 2);
+  REQUIRE(probabilities.n_cols == 0);
+
+  arma::Row<size_t> newPredictions;
+  arma::mat newProbabilities;
+  rf.Classify(emptySet, newPredictions, newProbabilities);
+  REQUIRE(newPredictions.n_elem == 0);
+  REQUIRE(newProbabilities.n_rows == 2);
+  REQUIRE(newProbabilities.n_cols == 0);
+}
+
 /**
  * Test unweighted numeric learning, making sure that we get better performance
  * than a single decision tree.
@@ -499,6 +573,44 @@ TEST_CASE("DifferentTreesTest", "[RandomForestTest]")
   REQUIRE(success == true);
 }
 
+/**
+ * Test that a forest trained with a given random seed is the same whatever the
+ * number of threads.
+ */
+TEST_CASE("ReproducibleForestTest", "[RandomForestTest]")
+{
+  arma::mat d(10, 200, arma::fill::randu);
+  arma::Row<size_t> l(200);
+  for (size_t i = 0; i < 200; ++i)
+    l(i) = (d(0, i) + d(3, i) > 1.0) ? 1 : 0;
+  arma::mat testData(10, 100, arma::fill::randu);
+
+  math::RandomSeed(17);
+  RandomForest<> rf1(d, l, 2, 20);
+  arma::mat probabilities1;
+  arma::Row<size_t> predictions1;
+  rf1.Classify(testData, predictions1, probabilities1);
+
+  #ifdef HAS_OPENMP
+    const int numThreads = omp_get_max_threads();
+    omp_set_num_threads(1);
+  #endif
+
+  math::RandomSeed(17);
+  RandomForest<> rf2(d, l, 2, 20);
+  arma::mat probabilities2;
+  arma::Row<size_t> predictions2;
+  rf2.Classify(testData, predictions2, probabilities2);
+
+  #ifdef HAS_OPENMP
+    omp_set_num_threads(numThreads);
+  #endif
+
+  REQUIRE(arma::all(predictions1 == predictions2));
+  REQUIRE(arma::approx_equal(probabilities1, probabilities2, "absdiff",
+      1e-12));
+}
+
 /**
  * Test that RandomForest::Train() when passed warmStart = True trains on top
  * of exixting forest and adds the newly trained trees to the previously
@@ -94,3 +94,63 @@ TEST_CASE("WeightedRandomTest", "[RandomTest]")
     }
   }
 }
+
+// Test that random streams are reproducible and independent, and that the
+// random functions draw from the active stream.
+TEST_CASE("RandomStreamTest", "[RandomTest]")
+{
+  RandomStream a(42, 0), b(42, 0), c(42, 1);
+  arma::vec drawsA(100), drawsB(100), drawsC(100);
+  for (size_t i = 0; i < 100; ++i)
+  {
+    drawsA[i] = a.Random();
+    drawsB[i] = b.Random();
+    drawsC[i] = c.Random();
+  }
+  REQUIRE(arma::approx_equal(drawsA, drawsB, "absdiff", 0.0));
+  REQUIRE(!arma::approx_equal(drawsA, drawsC, "absdiff", 1e-5));
+
+  RandomStream d(42, 0);
+  REQUIRE(ActiveRandomStream() == NULL);
+  {
+    RandomStreamScope scope(d);
+    REQUIRE(ActiveRandomStream() == &d);
+    for (size_t i = 0; i < 100; ++i)
+      REQUIRE(Random() == drawsA[i]);
+
+    // Scopes nest.
+    RandomStream e(42, 1);
+    {
+      RandomStreamScope inner(e);
+      REQUIRE(Random() == drawsC[0]);
+    }
+    REQUIRE(ActiveRandomStream() == &d);
+  }
+  REQUIRE(ActiveRandomStream() == NULL);
+}
+
+// Test that streams used from a parallel loop give the same numbers whatever
+// the number of threads.
+TEST_CASE("RandomStreamParallelTest", "[RandomTest]")
+{
+  const size_t seed = RandomStreamSeed();
+  arma::mat serial(10, 64), parallel(10, 64);
+  for (size_t i = 0; i < 64; ++i)
+  {
+    RandomStream stream(seed, i);
+    RandomStreamScope scope(stream);
+    for (size_t j = 0; j < 10; ++j)
+      serial(j, i) = (j % 2 == 0) ? Random() : RandNormal();
+  }
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < 64; ++i)
+  {
+    RandomStream stream(seed, i);
+    RandomStreamScope scope(stream);
+    for (size_t j = 0; j < 10; ++j)
+      parallel(j, i) = (j % 2 == 0) ? Random() : RandNormal();
+  }
+
+  REQUIRE(arma::approx_equal(serial, parallel, "absdiff", 0.0));
+}
@@ -16,6 +16,8 @@
 #include <mlpack/core/data/scaler_methods/standard_scaler.hpp>
 #include <mlpack/core/data/scaler_methods/mean_normalization.hpp>
 
+#include <thread>
+
 #include "test_catch_tools.hpp"
 #include "catch.hpp"
 
@@ -172,3 +174,174 @@ TEST_CASE("ZCAWhiteningTest", "[ScalingTest]")
   scale.InverseTransform(output, temp);
   CheckMatrices(dataset, temp);
 }
+
+/**
+ * Check that fitting a scaler one chunk at a time with PartialFit() gives the
+ * same scaler as fitting it with the whole dataset at once.
+ */
+template<typename ScalerType>
+void CheckPartialFit(ScalerType scaler)
+{
+  arma::mat data = arma::randu<arma::mat>(4, 2000);
+  data.row(1) *= 100.0;
+  data.row(2) += data.row(0);
+
+  ScalerType fullScaler(scaler);
+  fullScaler.Fit(data);
+
+  // Use chunks of different sizes, some too small to be split among threads.
+  const size_t chunkSizes[] = { 1, 37, 500, 1462 };
+  size_t begin = 0;
+  for (size_t chunkSize : chunkSizes)
+  {
+    const arma::mat chunk = data.cols(begin, begin + chunkSize - 1);
+    scaler.PartialFit(chunk);
+    begin += chunkSize;
+  }
+
+  REQUIRE(scaler.Statistics().Count() == data.n_cols);
+  CheckMatrices(scaler.Statistics().Mean(), fullScaler.Statistics().Mean());
+  CheckMatrices(scaler.Statistics().M2(), fullScaler.Statistics().M2());
+
+  // The eigenvectors of PCA whitening may have their signs flipped.
+  arma::mat fullOutput, output;
+  fullScaler.Transform(data, fullOutput);
+  scaler.Transform(data, output);
+  CheckMatrices(arma::abs(output), arma::abs(fullOutput));
+}
+
+/**
+ * Test PartialFit() for each scaler.
+ */
+TEST_CASE("ScalerPartialFitTest", "[ScalingTest]")
+{
+  CheckPartialFit(data::MinMaxScaler(-2, 3));
+  CheckPartialFit(data::MaxAbsScaler());
+  CheckPartialFit(data::StandardScaler());
+  CheckPartialFit(data::MeanNormalization());
+  CheckPartialFit(data::PCAWhitening());
+  CheckPartialFit(data::ZCAWhitening());
+}
+
+/**
+ * Check that a PCA whitening scaler fitted with PartialFit() can be used from
+ * several threads at once, even though its eigendecomposition is only computed
+ * when it is first needed.
+ */
+TEST_CASE("PCAWhiteningConcurrentTransformTest", "[ScalingTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(20, 1000);
+  data::PCAWhitening scaler;
+  scaler.PartialFit(data);
+
+  std::vector<arma::mat> outputs(4);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < outputs.size(); ++i)
+  {
+    threads.push_back(std::thread([&scaler, &data, &outputs, i]()
+        { scaler.Transform(data, outputs[i]); }));
+  }
+  for (size_t i = 0; i < threads.size(); ++i)
+    threads[i].join();
+
+  for (size_t i = 1; i < outputs.size(); ++i)
+    CheckMatrices(outputs[i], outputs[0]);
+
+  // A copy of the scaler gives the same results.
+  data::PCAWhitening copy(scaler);
+  arma::mat output;
+  copy.Transform(data, output);
+  CheckMatrices(output, outputs[0]);
+}
+
+/**
+ * Check that the statistics computed in parallel blocks match those computed
+ * directly.
+TEST_CASE("ScalerStatisticsTest", "[ScalingTest]")
+{
+  arma::mat data = arma::randn<arma::mat>(5, 5000);
+  data.row(3) += 1000.0;
+
+  data::ScalerStatistics statistics(true);
+  statistics.Update(arma::mat(data.cols(0, 2999)));
+  statistics.Update(arma::mat(data.cols(3000, 4999)));
+
+  REQUIRE(statistics.Count() == 5000);
+  CheckMatrices(statistics.Mean(), arma::vec(arma::mean(data, 1)));
+  CheckMatrices(statistics.Min(), arma::vec(arma::min(data, 1)));
+  CheckMatrices(statistics.Max(), arma::vec(arma::max(data, 1)));
+  CheckMatrices(statistics.Variance(1),
+      arma::vec(arma::var(data, 1, 1)), 1e-5);
+  CheckMatrices(statistics.Covariance(),
+      mlpack::math::ColumnCovariance(data), 1e-5);
+
+  // Points of the wrong dimensionality can't be added.
+  REQUIRE_THROWS_AS(statistics.Update(arma::mat(4, 10)),
+      std::invalid_argument);
+}
+
+/**
+ * Check that the statistics are exactly the same whatever the number of
+ * threads.
+ */
+TEST_CASE("ScalerStatisticsThreadsTest", "[ScalingTest]")
+{
+  arma::mat data = arma::randn<arma::mat>(4, 10000);
+
+  data::ScalerStatistics statistics(true);
+  statistics.Update(data);
+
+  #ifdef HAS_OPENMP
+    const int threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+  #endif
+
+  data::ScalerStatistics serialStatistics(true);
+  serialStatistics.Update(data);
+
+  #ifdef HAS_OPENMP
+    omp_set_num_threads(threads);
+  #endif
+
+  REQUIRE(arma::all(statistics.Mean() == serialStatistics.Mean()));
+  REQUIRE(arma::all(statistics.M2() == serialStatistics.M2()));
+  REQUIRE(arma::all(arma::vectorise(statistics.Covariance() ==
+      serialStatistics.Covariance())));
+}
+
+/**
+ * Check that transforming in place gives the same result as transforming into
+ * another matrix.
+ */
+template<typename ScalerType>
+void CheckInPlaceTransform(ScalerType scaler)
+{
+  arma::mat data = arma::randu<arma::mat>(3, 3000);
+  data.row(1) *= 10.0;
+
+  // The scaler can't be used before it is fitted.
+  arma::mat copy(data);
+  REQUIRE_THROWS_AS(scaler.Transform(copy), std::runtime_error);
+
+  scaler.Fit(data);
+  arma::mat output;
+  scaler.Transform(data, output);
+
+  const double* memory = copy.memptr();
+  scaler.Transform(copy);
+  REQUIRE(copy.memptr() == memory);
+  CheckMatrices(copy, output, 1e-5);
+}
+
+/**
+ * Test the in-place Transform() of each scaler.
+ */
+TEST_CASE("ScalerInPlaceTransformTest", "[ScalingTest]")
+{
+  CheckInPlaceTransform(data::MinMaxScaler());
+  CheckInPlaceTransform(data::MaxAbsScaler());
+  CheckInPlaceTransform(data::StandardScaler());
+  CheckInPlaceTransform(data::MeanNormalization());
+  CheckInPlaceTransform(data::PCAWhitening());
+  CheckInPlaceTransform(data::ZCAWhitening());
+}
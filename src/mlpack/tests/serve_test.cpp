@@ -0,0 +1,345 @@
+/**
+ * @file tests/serve_test.cpp
+ *
+ * Test the serve mode of the CLI bindings: requests are read, run, and
+ * answered through in-memory streams.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/bindings/cli/cli_option.hpp>
+#include <mlpack/bindings/cli/serve.hpp>
+#include <mlpack/core/kernels/gaussian_kernel.hpp>
+
+#include "catch.hpp"
+#include "test_catch_tools.hpp"
+
+using namespace std;
+using namespace mlpack;
+using namespace mlpack::bindings;
+using namespace mlpack::bindings::cli;
+using namespace mlpack::kernel;
+
+/**
+ * The program run for each request: it scales the input points, sends back the
+ * bandwidth of the input model, and changes an input parameter, which must not
+ * be seen by the next request.
+ */
+static void ServeTestMain()
+{
+  GaussianKernel* kernel = IO::GetParam<GaussianKernel*>("kernel");
+  const arma::mat& points = IO::GetParam<arma::mat>("points");
+
+  IO::GetParam<arma::mat>("values") = IO::GetParam<double>("scale") * points;
+  IO::GetParam<double>("bandwidth") = kernel->Bandwidth();
+  IO::GetParam<GaussianKernel*>("output_kernel") = kernel;
+  IO::GetParam<double>("scale") = -1.0;
+}
+
+/**
+ * Register the parameters of ServeTestMain() as a command-line program would,
+ * and load its model as Serve() would.
+ */
+struct ServeTestFixture
+{
+ public:
+  ServeTestFixture()
+  {
+    IO::ClearSettings();
+    CLIOption<GaussianKernel*>(NULL, "kernel", "Input kernel.", "",
+        "GaussianKernel*");
+    CLIOption<arma::mat>(arma::mat(), "points", "Input points.", "",
+        "arma::mat");
+    CLIOption<double>(1.0, "scale", "Scale of the points.", "", "double");
+    CLIOption<arma::mat>(arma::mat(), "values", "Scaled points.", "",
+        "arma::mat", false, false);
+    CLIOption<double>(0.0, "bandwidth", "Bandwidth of the kernel.", "",
+        "double", false, false);
+    CLIOption<GaussianKernel*>(NULL, "output_kernel", "Output kernel.", "",
+        "GaussianKernel*", false, false);
+
+    // The model is given on the command line.
+    GaussianKernel kernel(3.0);
+    data::Save("serve_kernel.bin", "model", kernel);
+    util::ParamData& d = IO::Parameters()["kernel"];
+    std::get<1>(*boost::any_cast<tuple<GaussianKernel*, string>>(&d.value)) =
+        "serve_kernel.bin";
+    d.wasPassed = true;
+
+    ServeInitialize(state);
+
+    // The model must not be loaded again by any request.
+    remove("serve_kernel.bin");
+  }
+
+  ~ServeTestFixture()
+  {
+    delete IO::GetParam<GaussianKernel*>("kernel");
+    IO::ClearSettings();
+  }
+
+  //! The state of the server.
+  ServeState state;
+};
+
+/**
+ * Answer the given requests as a connection would, and return the responses.
+ * The requests and responses go through temporary files, since the serve mode
+ * reads and writes C streams.
+ */
+static string ServeRequests(const string& requests, ServeState& state)
+{
+  FILE* in = tmpfile();
+  FILE* out = tmpfile();
+  REQUIRE(in != NULL);
+  REQUIRE(out != NULL);
+  fwrite(requests.data(), 1, requests.size(), in);
+  rewind(in);
+
+  ServeConnection(in, out, &ServeTestMain, state);
+
+  rewind(out);
+  string responses;
+  char buffer[1024];
+  size_t size;
+  while ((size = fread(buffer, 1, sizeof(buffer), out)) > 0)
+    responses.append(buffer, size);
+
+  fclose(in);
+  fclose(out);
+  return responses;
+}
+
+//! Return the bytes of the given matrix, as the binary format sends them.
+static string MatrixBytes(const arma::mat& matrix)
+{
+  return string((const char*) matrix.memptr(), matrix.n_elem * sizeof(double));
+}
+
+/**
+ * Make sure that a request with a CSV matrix is answered with every output,
+ * and that outputs that are not matrices are sent as text.
+ */
+TEST_CASE_METHOD(ServeTestFixture, "ServeCSVMatrixTest", "[ServeTest]")
+{
+  const string response = ServeRequests(
+      "param scale 2\n"
+      "matrix points 2 3 csv\n"
+      "1,2,3\n"
+      "4, 5, 6.5\n"
+      "end\n", state);
+
+  // The output model is not sent.
+  REQUIRE(response ==
+      "value bandwidth 3\n"
+      "matrix values 2 3 csv\n"
+      "2,4,6\n"
+      "8,10,13\n"
+      "end\n");
+}
+
+/**
+ * Make sure that binary matrices can be given in a request and sent back, and
+ * that only the outputs that were asked for are sent.
+ */
+TEST_CASE_METHOD(ServeTestFixture, "ServeBinaryMatrixTest", "[ServeTest]")
+{
+  // Each column is a line of the data.
+  arma::mat points(3, 4, arma::fill::randu);
+  const string response = ServeRequests(
+      "format binary\n"
+      "output values\n"
+      "param scale 0.5\n"
+      "matrix points 4 3 binary\n" + MatrixBytes(points) +
+      "end\n", state);
+
+  // Halving is exact, so the values can be compared byte for byte.
+  REQUIRE(response == "matrix values 4 3 binary\n" +
+      MatrixBytes(0.5 * points) + "end\n");
+}
+
+/**
+ * Make sure that the parameters a request sets, and those the program changes,
+ * are restored before the next request.
+ */
+TEST_CASE_METHOD(ServeTestFixture, "ServeRestoreParametersTest", "[ServeTest]")
+{
+  const string response = ServeRequests(
+      "param scale 3\n"
+      "output values\n"
+      "matrix points 1 2 csv\n"
+      "1,2\n"
+      "end\n"
+      "matrix points 1 2 csv\n"
+      "5,7\n"
+      "end\n", state);
+
+  // The second request uses the default scale, and sends back every output.
+  REQUIRE(response ==
+      "matrix values 1 2 csv\n"
+      "3,6\n"
+      "end\n"
+      "value bandwidth 3\n"
+      "matrix values 1 2 csv\n"
+      "5,7\n"
+      "end\n");
+
+  // The parameters are as they were after the model was loaded.
+  REQUIRE(IO::GetParam<double>("scale") == 1.0);
+  REQUIRE(!IO::Parameters()["scale"].wasPassed);
+  REQUIRE(!IO::Parameters()["points"].wasPassed);
+  REQUIRE(!IO::Parameters()["values"].wasPassed);
+  REQUIRE(IO::GetParam<arma::mat>("values").n_elem == 0);
+}
+
+/**
+ * Make sure that the model loaded by ServeInitialize() is used by every
+ * request, and that it is kept even when the program also gives it as an
+ * output.
+ */
+TEST_CASE_METHOD(ServeTestFixture, "ServeModelReuseTest", "[ServeTest]")
+{
+  GaussianKernel* kernel = IO::GetParam<GaussianKernel*>("kernel");
+  REQUIRE(kernel != NULL);
+  REQUIRE(state.memory.count((void*) kernel) == 1);
+
+  ServeRequest request;
+  ServeValue points;
+  points.hasValue = true;
+  points.isMatrix = true;
+  points.matrix = arma::mat(2, 2, arma::fill::ones);
+  request.inputs.push_back(make_pair(string("points"), points));
+  request.outputs.push_back("bandwidth");
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    vector<pair<string, ServeValue>> outputs;
+    ServeRun(&ServeTestMain, state, request, outputs);
+
+    REQUIRE(outputs.size() == 1);
+    REQUIRE(outputs[0].first == "bandwidth");
+    REQUIRE(outputs[0].second.text == "3");
+
+    // The model was neither loaded again nor freed.
+    REQUIRE(IO::GetParam<GaussianKernel*>("kernel") == kernel);
+    REQUIRE(IO::GetParam<GaussianKernel*>("output_kernel") == NULL);
+    REQUIRE(kernel->Bandwidth() == 3.0);
+  }
+}
+
+/**
+ * Make sure that a request that fails is answered with an error, after which
+ * the connection goes on.
+ */
+TEST_CASE_METHOD(ServeTestFixture, "ServeFailedRequestTest", "[ServeTest]")
+{
+  const string response = ServeRequests(
+      "param scale abc\n"
+      "end\n"
+      "param nothing 1\n"
+      "end\n"
+      "output scale\n"
+      "end\n"
+      "matrix scale 1 1 csv\n"
+      "1\n"
+      "end\n"
+      "output bandwidth\n"
+      "matrix points 1 1 csv\n"
+      "1\n"
+      "end\n", state);
+
+  REQUIRE(response ==
+      "error cannot parse 'abc'\nend\n"
+      "error unknown input parameter 'nothing'\nend\n"
+      "error unknown output parameter 'scale'\nend\n"
+      "error 'scale' is not a matrix\nend\n"
+      "value bandwidth 3\nend\n");
+
+  // The failed requests changed nothing.
+  REQUIRE(IO::GetParam<double>("scale") == 1.0);
+  REQUIRE(!IO::Parameters()["scale"].wasPassed);
+}
+
+/**
+ * Make sure that a malformed request is answered with an error, after which
+ * the connection is closed, since the rest of it can't be trusted.
+ */
+TEST_CASE_METHOD(ServeTestFixture, "ServeMalformedRequestTest", "[ServeTest]")
+{
+  // The valid request after the malformed one is never answered.
+  const string valid = "output bandwidth\nend\n";
+
+  REQUIRE(ServeRequests("launch\nend\n" + valid, state) ==
+      "error unknown command 'launch'\nend\n");
+  REQUIRE(ServeRequests("param\nend\n" + valid, state) ==
+      "error malformed command 'param'\nend\n");
+  REQUIRE(ServeRequests("format xml\nend\n" + valid, state) ==
+      "error malformed command 'format xml'\nend\n");
+  REQUIRE(ServeRequests("matrix points 2 csv\nend\n" + valid, state) ==
+      "error malformed command 'matrix points 2 csv'\nend\n");
+  REQUIRE(ServeRequests("matrix points 1 3 csv\n1,2\nend\n" + valid,
+      state) == "error line '1,2' of a matrix does not hold 3 values\nend\n");
+  REQUIRE(ServeRequests("matrix points 1 1 csv\n1,2\nend\n" + valid,
+      state) == "error line '1,2' of a matrix holds more than 1 values\nend\n");
+  REQUIRE(ServeRequests("matrix points 2 2 csv\n1,2\n", state) ==
+      "error the data of a matrix ended early\nend\n");
+  REQUIRE(ServeRequests("matrix points 2 2 binary\n" +
+      MatrixBytes(arma::mat(2, 1, arma::fill::zeros)), state) ==
+      "error the binary data of a matrix ended early\nend\n");
+  REQUIRE(ServeRequests("param scale 2\n", state) ==
+      "error the request did not end with 'end'\nend\n");
+
+  // A connection that ends between requests gets no error.
+  REQUIRE(ServeRequests("", state) == "");
+  REQUIRE(ServeRequests("\n\n", state) == "");
+}
+
+/**
+ * Make sure that ServeReadRequest() reads every command of a request, and stops
+ * at its end.
+ */
+TEST_CASE("ServeReadRequestTest", "[ServeTest]")
+{
+  const string requests =
+      "param k 5\n"
+      "param name two words\r\n"
+      "\n"
+      "output a b\n"
+      "format binary\n"
+      "matrix m 2 1 csv\n"
+      "1\n"
+      "2\n"
+      "end\n"
+      "end\n";
+  FILE* in = tmpfile();
+  REQUIRE(in != NULL);
+  fwrite(requests.data(), 1, requests.size(), in);
+  rewind(in);
+
+  ServeRequest request;
+  REQUIRE(ServeReadRequest(in, request));
+  REQUIRE(request.binary);
+  REQUIRE(request.outputs == vector<string>({ "a", "b" }));
+  REQUIRE(request.inputs.size() == 3);
+  REQUIRE(request.inputs[0].first == "k");
+  REQUIRE(request.inputs[0].second.text == "5");
+  REQUIRE(request.inputs[1].first == "name");
+  REQUIRE(request.inputs[1].second.text == "two words");
+  REQUIRE(request.inputs[2].first == "m");
+  REQUIRE(request.inputs[2].second.isMatrix);
+  REQUIRE(request.inputs[2].second.matrix.n_rows == 1);
+  REQUIRE(request.inputs[2].second.matrix.n_cols == 2);
+  REQUIRE(request.inputs[2].second.matrix(0, 1) == 2.0);
+
+  // The second request is empty, and then the stream ends.
+  ServeRequest empty;
+  REQUIRE(ServeReadRequest(in, empty));
+  REQUIRE(empty.inputs.empty());
+  ServeRequest none;
+  REQUIRE(!ServeReadRequest(in, none));
+
+  fclose(in);
+}
@@ -137,6 +137,31 @@ TEST_CASE("SparseCodingTestDictionaryStep", "[SparseCodingTest]")
   REQUIRE(normGradient == Approx(0.0).margin(tol));
 }
 
+/**
+ * Make sure that encoding into a sparse matrix gives the same codes as encoding
+ * into a dense matrix.
+ */
+TEST_CASE("SparseCodingSparseEncodeTest", "[SparseCodingTest]")
+{
+  mat X;
+  X.load("mnist_first250_training_4s_and_9s.arm");
+  for (uword i = 0; i < X.n_cols; ++i)
+    X.col(i) /= norm(X.col(i), 2);
+
+  SparseCoding sc(25, 0.1, 0.01);
+  DataDependentRandomInitializer::Initialize(X, 25, sc.Dictionary());
+
+  mat Z;
+  sp_mat sparseZ;
+  sc.Encode(X, Z);
+  sc.Encode(X, sparseZ);
+
+  REQUIRE(sparseZ.n_rows == Z.n_rows);
+  REQUIRE(sparseZ.n_cols == Z.n_cols);
+  REQUIRE(sparseZ.n_nonzero == (size_t) accu(Z != 0));
+  CheckMatrices(Z, mat(sparseZ));
+}
+
 TEST_CASE("SerializationTest", "[SparseCodingTest]")
 {
   mat X = randu<mat>(100, 100);
@@ -421,3 +421,85 @@ TEST_CASE("SplitLabeledDataResultField", "[SplitDataTest]")
   CheckFields(input, inputConcat);
   CheckFields(label, labelConcat);
 }
+
+/**
+ * Check that SplitIndices() and StratifiedSplitIndices() pick the same points
+ * as Split() with the same random seed.
+ */
+TEST_CASE("SplitIndicesTest", "[SplitDataTest]")
+{
+  mat input(3, 501);
+  input.randu();
+  Row<size_t> labels = randi<Row<size_t>>(501, distr_param(0, 3));
+
+  for (const bool stratify : { false, true })
+  {
+    math::RandomSeed(17);
+    const auto value = Split(input, labels, 0.3, true, stratify);
+
+    math::RandomSeed(17);
+    uvec trainIndices, testIndices;
+    if (stratify)
+      StratifiedSplitIndices(labels, trainIndices, testIndices, 0.3);
+    else
+      SplitIndices(input.n_cols, trainIndices, testIndices, 0.3);
+
+    REQUIRE(trainIndices.n_elem + testIndices.n_elem == input.n_cols);
+    CheckMatrices(input.cols(trainIndices), std::get<0>(value));
+    CheckMatrices(input.cols(testIndices), std::get<1>(value));
+    REQUIRE(accu(labels.cols(trainIndices) != std::get<2>(value)) == 0);
+    REQUIRE(accu(labels.cols(testIndices) != std::get<3>(value)) == 0);
+  }
+
+  // Without shuffling, the points are taken in order.
+  uvec trainIndices, testIndices;
+  SplitIndices(10, trainIndices, testIndices, 0.2, false);
+  REQUIRE(trainIndices.n_elem == 8);
+  REQUIRE(testIndices.n_elem == 2);
+  for (size_t i = 0; i < 8; ++i)
+    REQUIRE(trainIndices[i] == i);
+  REQUIRE(testIndices[0] == 8);
+  REQUIRE(testIndices[1] == 9);
+}
+
+/**
+ * Check that SplitInPlace() partitions the dataset and labels into the same
+ * sets as Split() with the same random seed, and that aliases of the sets can
+ * be made.
+ */
+TEST_CASE("SplitInPlaceTest", "[SplitDataTest]")
+{
+  mat input(4, 333);
+  input.randu();
+  const Row<size_t> labels = randi<Row<size_t>>(333, distr_param(0, 2));
+
+  for (const bool stratify : { false, true })
+  {
+    math::RandomSeed(5);
+    const auto value = Split(input, labels, 0.25, true, stratify);
+
+    mat inPlace(input);
+    Row<size_t> inPlaceLabels(labels);
+    const double* memory = inPlace.memptr();
+    math::RandomSeed(5);
+    const size_t trainSize = SplitInPlace(inPlace, inPlaceLabels, 0.25, true,
+        stratify);
+    REQUIRE(inPlace.memptr() == memory);
+    REQUIRE(trainSize == std::get<0>(value).n_cols);
+
+    const mat trainData(inPlace.colptr(0), inPlace.n_rows, trainSize, false,
+        true);
+    const mat testData(inPlace.colptr(trainSize), inPlace.n_rows,
+        inPlace.n_cols - trainSize, false, true);
+    CheckMatrices(trainData, std::get<0>(value));
+    CheckMatrices(testData, std::get<1>(value));
+    REQUIRE(accu(inPlaceLabels.head(trainSize) != std::get<2>(value)) == 0);
+    REQUIRE(accu(inPlaceLabels.tail(inPlace.n_cols - trainSize) !=
+        std::get<3>(value)) == 0);
+  }
+
+  // Without labels or shuffling, the data is unchanged.
+  mat inPlace(input);
+  REQUIRE(SplitInPlace(inPlace, 0.1, false) == 300);
+  CheckMatrices(inPlace, input);
+}
@@ -1434,3 +1434,161 @@ TEST_CASE("SplitByAnyOfTfIdfEncodingSerialization", "[StringEncodingTest]")
 
   CheckMatrices(output, xmlOutput, jsonOutput, binaryOutput);
 }
+
+/**
+ * Make a corpus large enough to be split between threads, with tokens that
+ * first appear in late strings.
+ */
+static vector<string> LargeStringEncodingInput()
+{
+  vector<string> input(1000);
+  for (size_t i = 0; i < input.size(); ++i)
+  {
+    for (size_t j = 0; j < i % 17; ++j)
+      input[i] += "w" + to_string((i * 7 + j * j) % (i + 1)) + " ";
+  }
+
+  return input;
+}
+
+/**
+ * Test that the Bag of Words encoding gives the same result and the same
+ * dictionary when the output is sparse as when it is dense.
+ */
+TEST_CASE("SparseBagOfWordsEncodingTest", "[StringEncodingTest]")
+{
+  const vector<string> largeInput = LargeStringEncodingInput();
+  SplitByAnyOf tokenizer(" ,.");
+
+  const vector<string>* inputs[] = { &stringEncodingInput, &largeInput };
+  for (const vector<string>* input : inputs)
+  {
+    BagOfWordsEncoding<SplitByAnyOf::TokenType> denseEncoder, sparseEncoder;
+    arma::mat denseOutput;
+    arma::sp_mat sparseOutput;
+
+    denseEncoder.Encode(*input, denseOutput, tokenizer);
+    sparseEncoder.Encode(*input, sparseOutput, tokenizer);
+
+    REQUIRE(sparseEncoder.Dictionary().Size() ==
+        denseEncoder.Dictionary().Size());
+    for (auto& keyValue : denseEncoder.Dictionary().Mapping())
+    {
+      REQUIRE(sparseEncoder.Dictionary().Value(keyValue.first) ==
+          keyValue.second);
+    }
+
+    CheckMatrices(arma::mat(sparseOutput), denseOutput);
+  }
+
+  // Encoding more strings keeps the labels of the known tokens.
+  BagOfWordsEncoding<SplitByAnyOf::TokenType> encoder;
+  arma::sp_mat output;
+  encoder.Encode(stringEncodingInput, output, tokenizer);
+  const size_t dictionarySize = encoder.Dictionary().Size();
+  const size_t mlpackLabel = encoder.Dictionary().Value("mlpack");
+
+  encoder.Encode({ "new mlpack tokens mlpack" }, output, tokenizer);
+
+  REQUIRE(encoder.Dictionary().Size() == dictionarySize + 2);
+  REQUIRE(encoder.Dictionary().Value("new") == dictionarySize + 1);
+  REQUIRE(output.n_rows == dictionarySize + 2);
+  REQUIRE(output.n_cols == 1);
+  REQUIRE(output(mlpackLabel - 1, 0) == 2);
+  REQUIRE(output(dictionarySize, 0) == 1);
+  REQUIRE(output(dictionarySize + 1, 0) == 1);
+  REQUIRE(output.n_nonzero == 3);
+}
+
+/**
+ * Test that the Tf-Idf encoding gives the same result for each term frequency
+ * type when the output is sparse as when it is dense.
+ */
+TEST_CASE("SparseTfIdfEncodingTest", "[StringEncodingTest]")
+{
+  using TfTypes = TfIdfEncodingPolicy::TfTypes;
+
+  const vector<string> input = LargeStringEncodingInput();
+  SplitByAnyOf tokenizer(" ");
+
+  for (TfTypes tfType : { TfTypes::BINARY, TfTypes::RAW_COUNT,
+      TfTypes::TERM_FREQUENCY, TfTypes::SUBLINEAR_TF })
+  {
+    for (bool smoothIdf : { true, false })
+    {
+      TfIdfEncoding<SplitByAnyOf::TokenType> encoder(tfType, smoothIdf);
+      arma::mat denseOutput;
+      arma::sp_mat sparseOutput;
+
+      encoder.Encode(input, denseOutput, tokenizer);
+      encoder.Clear();
+      encoder.Encode(input, sparseOutput, tokenizer);
+
+      CheckMatrices(arma::mat(sparseOutput), denseOutput, 1e-12);
+    }
+  }
+
+  // Individual characters are encoded the same way.
+  vector<string> charInput = { "GACCA", "ABCABCD", "GAB" };
+  TfIdfEncoding<CharExtract::TokenType> denseEncoder, sparseEncoder;
+  arma::mat denseOutput;
+  arma::sp_mat sparseOutput;
+
+  denseEncoder.Encode(charInput, denseOutput, CharExtract());
+  sparseEncoder.Encode(charInput, sparseOutput, CharExtract());
+
+  CheckMatrices(arma::mat(sparseOutput), denseOutput, 1e-12);
+}
+
+/**
+ * Test the Bag of Words encoding with the hashing trick.
+ */
+TEST_CASE("HashingBagOfWordsEncodingTest", "[StringEncodingTest]")
+{
+  using EncoderType = HashingBagOfWordsEncoding<SplitByAnyOf::TokenType>;
+
+  const vector<string> input = LargeStringEncodingInput();
+  SplitByAnyOf tokenizer(" ");
+
+  EncoderType encoder;
+  encoder.Dictionary().NumBuckets() = 64;
+  arma::sp_mat output;
+  arma::mat denseOutput;
+
+  encoder.Encode(input, output, tokenizer);
+  encoder.Encode(input, denseOutput, tokenizer);
+
+  REQUIRE(output.n_rows == 64);
+  REQUIRE(output.n_cols == input.size());
+  CheckMatrices(arma::mat(output), denseOutput);
+
+  // Each token is counted in the bucket of its hash.
+  for (size_t i = 0; i < input.size(); ++i)
+  {
+    arma::vec expected(64, arma::fill::zeros);
+    boost::string_view strView(input[i]);
+    boost::string_view token = tokenizer(strView);
+    while (!token.empty())
+    {
+      const size_t label = encoder.Dictionary().Value(token);
+      REQUIRE(label >= 1);
+      REQUIRE(label <= 64);
+      expected[label - 1]++;
+      token = tokenizer(strView);
+    }
+
+    CheckMatrices(arma::vec(output.col(i)), expected);
+  }
+
+  // The labels only depend on the number of buckets.
+  EncoderType xmlEncoder, jsonEncoder, binaryEncoder;
+  SerializeObjectAll(encoder, xmlEncoder, jsonEncoder, binaryEncoder);
+
+  arma::sp_mat xmlOutput, jsonOutput, binaryOutput;
+  xmlEncoder.Encode(input, xmlOutput, tokenizer);
+  jsonEncoder.Encode(input, jsonOutput, tokenizer);
+  binaryEncoder.Encode(input, binaryOutput, tokenizer);
+
+  CheckMatrices(arma::mat(output), arma::mat(xmlOutput),
+      arma::mat(jsonOutput), arma::mat(binaryOutput));
+}
@@ -128,6 +128,42 @@ TEST_CASE("MultithreadTimerTest", "[TimerTest]")
   REQUIRE(Timer::Get("thread_timer") > std::chrono::microseconds(50000));
 }
 
+/**
+ * Stopping the timers of one thread should let it start them again, and should
+ * leave the timers of other threads running.
+ */
+TEST_CASE("StopThreadTimersTest", "[TimerTest]")
+{
+  Timer::EnableTiming();
+  Timer::Start("main_timer");
+
+  bool restarted = false;
+  std::thread thread([&restarted]()
+      {
+        Timer::Start("stopped_timer");
+        IO::GetSingleton().timer.StopThreadTimers(std::this_thread::get_id());
+
+        try
+        {
+          Timer::Start("stopped_timer");
+          Timer::Stop("stopped_timer");
+          restarted = true;
+        }
+        catch (std::runtime_error&)
+        {
+          // The timer was not stopped.
+        }
+      });
+  thread.join();
+
+  REQUIRE(restarted);
+  REQUIRE(IO::GetSingleton().timer.GetState("main_timer",
+      std::this_thread::get_id()));
+
+  Timer::Stop("main_timer");
+  Timer::DisableTiming();
+}
+
 TEST_CASE("DisabledTimingTest", "[TimerTest]")
 {
   // It should be disabled by default but let's be paranoid.
@@ -143,3 +179,109 @@ TEST_CASE("DisabledTimingTest", "[TimerTest]")
 
   REQUIRE(Timer::Get("test_timer") == std::chrono::microseconds(0));
 }
+
+/**
+ * Spans should nest, and their statistics should be kept per stack of names.
+ */
+TEST_CASE("TracerNestingTest", "[TimerTest]")
+{
+  Tracer tracer;
+  tracer.Enabled() = true;
+
+  for (size_t i = 0; i < 4; ++i)
+  {
+    TraceSpan outer(tracer, "outer");
+    {
+      TraceSpan inner(tracer, "inner");
+      #ifdef _WIN32
+      Sleep(2);
+      #else
+      usleep(2000);
+      #endif
+    }
+    TraceSpan other(tracer, "other");
+  }
+
+  // Spans begun while the tracer is disabled aren't recorded.
+  tracer.Enabled() = false;
+  {
+    TraceSpan ignored(tracer, "ignored");
+  }
+
+  std::map<std::string, SpanStatistics> statistics = tracer.Statistics();
+  REQUIRE(statistics.size() == 3);
+  REQUIRE(statistics.count("outer") == 1);
+  REQUIRE(statistics.count("outer;inner") == 1);
+  REQUIRE(statistics.count("outer;other") == 1);
+
+  const SpanStatistics& outer = statistics["outer"];
+  const SpanStatistics& inner = statistics["outer;inner"];
+  REQUIRE(outer.count == 4);
+  REQUIRE(inner.count == 4);
+  REQUIRE(inner.min >= std::chrono::milliseconds(2));
+  REQUIRE(inner.min <= inner.median);
+  REQUIRE(inner.median <= inner.p90);
+  REQUIRE(inner.p90 <= inner.p99);
+  REQUIRE(inner.p99 <= inner.max);
+  REQUIRE(outer.total >= inner.total);
+  REQUIRE(outer.self + inner.total + statistics["outer;other"].total ==
+      outer.total);
+
+  // The folded stacks have one line per stack.
+  std::ostringstream folded;
+  tracer.ExportFoldedStacks(folded);
+  const std::string foldedStacks = folded.str();
+  REQUIRE(foldedStacks.find("outer;inner ") != std::string::npos);
+  REQUIRE(std::count(foldedStacks.begin(), foldedStacks.end(), '\n') == 3);
+
+  // The Chrome trace has one event per span.
+  std::ostringstream chrome;
+  tracer.ExportChromeTrace(chrome);
+  const std::string trace = chrome.str();
+  size_t events = 0;
+  for (size_t pos = trace.find("\"ph\":\"X\""); pos != std::string::npos;
+       pos = trace.find("\"ph\":\"X\"", pos + 1))
+    ++events;
+  REQUIRE(events == 12);
+
+  tracer.Reset();
+  REQUIRE(tracer.Statistics().empty());
+}
+
+/**
+ * Each thread should record its own spans, and spans ended by name should end
+ * the innermost span with that name.
+ */
+TEST_CASE("TracerMultithreadTest", "[TimerTest]")
+{
+  Tracer tracer;
+  tracer.Enabled() = true;
+
+  std::thread threads[3];
+  for (size_t i = 0; i < 3; ++i)
+  {
+    threads[i] = std::thread([&tracer]()
+        {
+          tracer.Begin("thread");
+          tracer.Begin("work");
+          tracer.End("thread");
+          tracer.End("work");
+          // Ending an unknown name does nothing.
+          tracer.End("unknown");
+        });
+  }
+
+  for (size_t i = 0; i < 3; ++i)
+    threads[i].join();
+
+  std::map<std::string, SpanStatistics> statistics = tracer.Statistics();
+  REQUIRE(statistics.size() == 2);
+  REQUIRE(statistics["thread"].count == 3);
+  REQUIRE(statistics["thread;work"].count == 3);
+
+  // Open spans are not reported until they are ended.
+  tracer.Begin("open");
+  REQUIRE(tracer.Statistics().count("open") == 0);
+  tracer.EndAll();
+  REQUIRE(tracer.Statistics()["open"].count == 1);
+}